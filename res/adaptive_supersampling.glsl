@@ -1,8 +1,9 @@
 #include "real.glsl"
 
-// needs function evaluate(dvec2) -> real (evaluation of a pixel-space coordinate)
+// needs function evaluate(dvec2) -> real (evaluation of a pixel-space coordinate), unless ADAPTIVE_SUPER_SAMPLING_SAMPLES_ONLY is defined
 
 
+#ifndef SAMPLE_OFFSETS_BUFFER // otherwise the PMJ02 sequence in the buffer of static_supersampling.glsl
 // pmj02bn samples from https://github.com/Andrew-Helmer/pmj-cpp/blob/master/sample_sequences/pmj02bn/1024_samples_00.txt
 #define MAX_SAMPLES 16
 const vec2 offsets[MAX_SAMPLES] = vec2[](
@@ -22,1026 +23,16 @@ const vec2 offsets[MAX_SAMPLES] = vec2[](
     vec2(0.3086305612034951, 0.05419428038956031),
     vec2(-0.3117787331141107, 0.23123407093109194),
     vec2(0.19021486592645764, -0.28258149109763075)
-    /*
-    ,
-    vec2(-0.15809740236546804, -0.22002085815928946),
-    vec2(0.34311654153186455, 0.28073262534571863),
-    vec2(-0.055887816801843404, 0.46497030351619995),
-    vec2(0.47172529509549843, -0.0329591914670071),
-    vec2(-0.4702819835134301, -0.41130995665641806),
-    vec2(0.029054026419489176, 0.09264033463652688),
-    vec2(-0.24895948160751946, 0.0012394400159095875),
-    vec2(0.2504900612143476, -0.48072733079290914),
-    vec2(-0.34389523071133477, -0.0957268877603979),
-    vec2(0.1539052104518367, 0.40457937885312),
-    vec2(-0.4034900596151533, 0.3241683467196622),
-    vec2(0.09437732355411821, -0.1763629223755282),
-    vec2(-0.0836884067861996, -0.3433563848828414),
-    vec2(0.406106644941877, 0.15966373412494317),
-    vec2(-0.35946050000052227, 0.03209545229743016),
-    vec2(0.14001959735680558, -0.46828723214448686)
-    */
-    /*
-    ,
-    vec2(-0.2226048882006012, -0.09279874883180295),
-    vec2(0.27901574133555673, 0.40626716893609105),
-    vec2(-0.06279979880700626, 0.35920868740356704),
-    vec2(0.3889380252697464, -0.14218711651370708),
-    vec2(-0.3761765809569117, -0.3601236302635455),
-    vec2(0.12468145922648932, 0.1553810322206608),
-    vec2(-0.1865501825572462, 0.20052130475945573),
-    vec2(0.3136031785611594, -0.26524018630045376),
-    vec2(-0.29077402299748567, -0.18776929777244933),
-    vec2(0.2039206388519681, 0.31236469239945885),
-    vec2(-0.4852357963730051, 0.46930791335598987),
-    vec2(0.01538936075215136, -0.029974224968517982),
-    vec2(-0.03170942211460187, -0.39054500712738605),
-    vec2(0.48563549266259676, 0.12375546970678375),
-    vec2(-0.40672503498905216, 0.18640930955963186),
-    vec2(0.09306486488641719, -0.3133493289549862),
-    vec2(-0.09403697337080735, -0.1568289381658074),
-    vec2(0.4210392888056207, 0.34054690508339724),
-    vec2(-0.20429787346262718, 0.38401060193968983),
-    vec2(0.28129514283806956, -0.12418782624033536),
-    vec2(-0.3435637632752946, -0.48501328096413915),
-    vec2(0.15783010046360446, 0.031009857691556286),
-    vec2(-0.015528159048394496, 0.06389084479708296),
-    vec2(0.45318484276018245, -0.42686958477690073),
-    vec2(-0.45359396182762174, -0.05343532905407583),
-    vec2(0.03431456903307184, 0.4527721755909646),
-    vec2(-0.2515595166815243, 0.26436590429479345),
-    vec2(0.2341819585703676, -0.2347910528218538),
-    vec2(-0.15602322814880204, -0.302160382016884),
-    vec2(0.35879107164334434, 0.23523619657611305),
-    vec2(-0.3900351285880142, 0.015657105299904828),
-    vec2(0.10943377042709201, -0.49979751004074946),
-    vec2(-0.07044172945143967, -0.10967909070876458),
-    vec2(0.3759583346887614, 0.3813025518897648),
-    vec2(-0.23407388799445022, 0.32823742530856514),
-    vec2(0.26569894848348674, -0.17177803046095708),
-    vec2(-0.3680415940134302, -0.3204025321727513),
-    vec2(0.1299435900121897, 0.17958088911063164),
-    vec2(-0.03973891537503438, 0.24236279142018358),
-    vec2(0.4998456659160019, -0.30578896619359197),
-    vec2(-0.4926591441406685, -0.2424200598005029),
-    vec2(0.007746645227175386, 0.25507701755269807),
-    vec2(-0.2819501580845217, 0.4440476523036262),
-    vec2(0.21844770536657454, -0.05685879340431749),
-    vec2(-0.1735851362162381, -0.43039077236454676),
-    vec2(0.3275302716449783, 0.07796179587718965),
-    vec2(-0.3283582085141495, 0.14077622399824052),
-    vec2(0.16574865413952955, -0.37479980655454126),
-    vec2(-0.21175471004015506, -0.1559218350783408),
-    vec2(0.2967013661556238, 0.34440449288136077),
-    vec2(-0.10839063817288946, 0.4154855247013217),
-    vec2(0.41392433488851177, -0.07824997330939776),
-    vec2(-0.41442585965348755, -0.4608637300118682),
-    vec2(0.08274705522108583, 0.03988154514607889),
-    vec2(-0.14822380884745057, 0.1099569767265346),
-    vec2(0.34428316613882903, -0.38274635741878527),
-    vec2(-0.26498540809830884, -0.023330759956057046),
-    vec2(0.21881260330469332, 0.4765897860663728),
-    vec2(-0.4685420573161552, 0.29691972866139416),
-    vec2(0.03926946444680279, -0.20218530952112157),
-    vec2(-0.00770602559069139, -0.25735073108084044),
-    vec2(0.4679389790489501, 0.19520246699149135),
-    vec2(-0.2734928097499114, 0.07966211614494312),
-    vec2(0.23534471431542614, -0.41415697604484),
-    vec2(-0.13977508635376162, -0.03914448922903735),
-    vec2(0.3703444214072751, 0.4608725901220744),
-    vec2(-0.02216811252815104, 0.273346887992833),
-    vec2(0.4376616055789275, -0.22820709375413772),
-    vec2(-0.43751508681422246, -0.2913096595140523),
-    vec2(0.06240356921956858, 0.21922303042922198),
-    vec2(-0.20305505176376076, 0.16431236643712432),
-    vec2(0.2969151901611028, -0.3323572001454921),
-    vec2(-0.3277445069149056, -0.1798194647493282),
-    vec2(0.1719278127364644, 0.31828906813023583),
-    vec2(-0.42887555668322963, 0.39821230599659174),
-    vec2(0.0635106668576979, -0.10209952807615003),
-    vec2(-0.10965448588231408, -0.4762817317306479),
-    vec2(0.4297767642633604, 0.015525783304876861),
-    vec2(-0.47660570923893153, 0.2108038384285077),
-    vec2(0.02232277265855953, -0.2811267531524969),
-    vec2(-0.05220257776224563, -0.20820550192999293),
-    vec2(0.47678338261595266, 0.2897980362502607),
-    vec2(-0.17037320863463445, 0.4843917041293191),
-    vec2(0.3343758131339286, -0.01557198485229433),
-    vec2(-0.29742543072111466, -0.3939125698735782),
-    vec2(0.2024455665940944, 0.10900744028148934),
-    vec2(-0.09251248133765916, 0.054788018232165836),
-    vec2(0.39118586823189383, -0.45309584354822696),
-    vec2(-0.39805693069004, -0.07290612956874581),
-    vec2(0.10191727224942715, 0.4296857505979519),
-    vec2(-0.35176646023291724, 0.3671559587375133),
-    vec2(0.14842028634446303, -0.13381343423539532),
-    vec2(-0.23458182783590859, -0.3520842390173429),
-    vec2(0.2649660318711262, 0.14061784327146487),
-    vec2(-0.42977020250345965, 0.07072774989542574),
-    vec2(0.07417024783204995, -0.4371104949989969),
-    vec2(-0.12113376051594149, -0.062272712710743916),
-    vec2(0.427402794295204, 0.43810307407573656),
-    vec2(-0.1953119163072194, 0.25381864533149945),
-    vec2(0.3052712383018784, -0.2461171092991904),
-    vec2(-0.3129362550432341, -0.3120885535495417),
-    vec2(0.17970464757141147, 0.24620063196008002),
-    vec2(-0.02819078333842656, 0.17192619017790411),
-    vec2(0.45299319466283894, -0.32470432210723943),
-    vec2(-0.45268437858514615, -0.16790302029411003),
-    vec2(0.05097552605640132, 0.33215250458816514),
-    vec2(-0.26925728341364275, 0.3783546504186701),
-    vec2(0.24629042241891086, -0.11339844885097583),
-    vec2(-0.12870516265278797, -0.49596334345373405),
-    vec2(0.36692880403210104, 0.02339988644994695),
-    vec2(-0.3509484230143356, 0.19136328504529632),
-    vec2(0.14847649498659765, -0.2503098250441015),
-    vec2(-0.2423020985214812, -0.19794964266927717),
-    vec2(0.25770816660462403, 0.30097876860202477),
-    vec2(-0.08177451819758713, 0.4841822443003052),
-    vec2(0.39863607827157377, -0.019301886795758394),
-    vec2(-0.4021614865635942, -0.3786850078696969),
-    vec2(0.09815786824659045, 0.1132841188767757),
-    vec2(-0.1639939565140024, 0.04318150690073996),
-    vec2(0.3359863753767074, -0.45567184653979453),
-    vec2(-0.3049398015826819, -0.08243945335378983),
-    vec2(0.19530503842006885, 0.42147300118010866),
-    vec2(-0.4761756690647688, 0.35147575861296154),
-    vec2(0.02443180744518303, -0.14855386461754932),
-    vec2(-0.061467388451924176, -0.37095263021648606),
-    vec2(0.4733886061290289, 0.14835195992956185),
-    vec2(-0.29675085463038914, 0.011552066120249393),
-    vec2(0.2070923244380629, -0.4691666002536176),
-    vec2(-0.1798012623227354, -0.10872294928316473),
-    vec2(0.32027662300710436, 0.39131456165888734),
-    vec2(-0.03880626330805825, 0.31628250849525974),
-    vec2(0.4883478312840118, -0.18425571752335412),
-    vec2(-0.48867512740683194, -0.3320138740860463),
-    vec2(0.011711801933667276, 0.16856526817254336),
-    vec2(-0.2263532127607279, 0.2228207463801033),
-    vec2(0.2735267125589498, -0.2932529936637591),
-    vec2(-0.3669701934583576, -0.2342605972437064),
-    vec2(0.13294166330896307, 0.2693666662817764),
-    vec2(-0.3824024629968195, 0.4569855119497479),
-    vec2(0.1175559434143163, -0.043102120191314486),
-    vec2(-0.06971941916939117, -0.4218500375774318),
-    vec2(0.38660397115791467, 0.08550055853340555),
-    vec2(-0.4609093986968419, 0.13662934618371325),
-    vec2(0.035208340242672276, -0.35572917404430815),
-    vec2(-0.011532873875433447, -0.1377000604671798),
-    vec2(0.46055687935392564, 0.36313758551378483),
-    vec2(-0.15233653361461236, 0.4257182207168504),
-    vec2(0.35156549260331904, -0.0759554852919036),
-    vec2(-0.2570336346784516, -0.4489238890675868),
-    vec2(0.2304039684200666, 0.058670112913221106),
-    vec2(-0.09766997885117518, 0.1024592591271477),
-    vec2(0.414340766580208, -0.39819591442070584),
-    vec2(-0.41352498631491785, -0.011510777490247703),
-    vec2(0.0859865636821473, 0.48858284186545065),
-    vec2(-0.33749495573696864, 0.2967700592050826),
-    vec2(0.16348860502940288, -0.2031945952000962),
-    vec2(-0.21088083599889917, -0.27398393461964843),
-    vec2(0.28879971393841486, 0.20320996872341734),
-    vec2(-0.4999886156094822, 0.047118535761557556),
-    vec2(0.003070596625959654, -0.44099035693265254),
-    vec2(-0.04425795009053218, -0.06250449829009552),
-    vec2(0.49239793280852906, 0.43372277346400256),
-    vec2(-0.17619813729057265, 0.3675145363350283),
-    vec2(0.3240873948991012, -0.1323925564974877),
-    vec2(-0.28517032396768993, -0.3475664283503126),
-    vec2(0.21482956278422827, 0.13276462155710522),
-    vec2(-0.07780999292343505, 0.2150953643536736),
-    vec2(0.38245898076815565, -0.26942108365531325),
-    vec2(-0.3863900618363767, -0.21496968406489259),
-    vec2(0.11337482697994283, 0.2886508017057261),
-    vec2(-0.37492938522119035, 0.49615039121752924),
-    vec2(0.12672798654638884, -6.276797039872495e-05),
-    vec2(-0.22665041726321294, -0.4049231575804649),
-    vec2(0.27296711311406996, 0.0937843495417291),
-    vec2(-0.2616925691119683, 0.16095170837058392),
-    vec2(0.22528731443083005, -0.3397250639225363),
-    vec2(-0.14233844191864758, -0.17199521391686645),
-    vec2(0.3505859081608921, 0.3280873814562586),
-    vec2(-0.0037117998792027818, 0.3985984260252292),
-    vec2(0.4647564802191181, -0.10064386160948774),
-    vec2(-0.4647717180579527, -0.4796859347688467),
-    vec2(0.04624633222069008, 0.007555793478212669),
-    vec2(-0.2149145071646923, 0.08945499313891203),
-    vec2(0.29290826610122145, -0.40958452560176656),
-    vec2(-0.3354299160763369, -0.03535916167620323),
-    vec2(0.1681866216225899, 0.46466734638530627),
-    vec2(-0.4206817913304095, 0.2735549936314571),
-    vec2(0.08133377345890902, -0.2265526108439641),
-    vec2(-0.10167862992602511, -0.28642178721694855),
-    vec2(0.41010634231520093, 0.2277013755826467),
-    vec2(-0.320358248349393, 0.11726698333534136),
-    vec2(0.17961909988324432, -0.38658941084246135),
-    vec2(-0.19731610031824787, -0.026921919308782016),
-    vec2(0.30198821033050416, 0.47307586051661465),
-    vec2(-0.1133625906687542, 0.3083798100519438),
-    vec2(0.43548220459022036, -0.19144429908860922),
-    vec2(-0.42188773255999185, -0.2580175083557078),
-    vec2(0.07012410384172307, 0.19547294821859384),
-    vec2(-0.13658506377924706, 0.15223670684819102),
-    vec2(0.37463386873023596, -0.3633956900566416),
-    vec2(-0.27766079142627076, -0.1445914279499101),
-    vec2(0.24074535141423237, 0.3554474760000026),
-    vec2(-0.4449869306194248, 0.4139315053819086),
-    vec2(0.05541026641930613, -0.08597168077453005),
-    vec2(-0.01919763868180896, -0.4644631306587046),
-    vec2(0.4452632900864788, 0.039039613044011046),
-    vec2(-0.390864768967872, 0.2386567960116317),
-    vec2(0.1093377683515867, -0.2970286048624332),
-    vec2(-0.08976398763870624, -0.23922200777784053),
-    vec2(0.3947360723172767, 0.2615112962193238),
-    vec2(-0.23834488152094663, 0.4490452530273479),
-    vec2(0.26141400712817, -0.04863356134723773),
-    vec2(-0.3558870592681781, -0.4225901255005211),
-    vec2(0.14074672938896038, 0.07009144138672607),
-    vec2(-0.05030113720281881, 0.027159191620448664),
-    vec2(0.4841965967835521, -0.4885303888908733),
-    vec2(-0.48428102864385186, -0.11771509185388046),
-    vec2(0.01951826519186428, 0.38700247221583983),
-    vec2(-0.3038139404611948, 0.3378733621482658),
-    vec2(0.19885184039086967, -0.16044591936076963),
-    vec2(-0.16783891691600938, -0.3202692850037813),
-    vec2(0.33167443041205835, 0.1796984419173019),
-    vec2(-0.4726491450214579, 0.09001550014343018),
-    vec2(0.029592606639410213, -0.4137974658377011),
-    vec2(-0.05844141138435843, -0.03326321892022899),
-    vec2(0.4706512974473064, 0.46707159311279267),
-    vec2(-0.16012398509762327, 0.27776172440994473),
-    vec2(0.33992966742497677, -0.2225390872685713),
-    vec2(-0.30868330835804386, -0.28328507048672374),
-    vec2(0.189323724275142, 0.23250718271354387),
-    vec2(-0.08398705756352176, 0.15808774763771272),
-    vec2(0.40235083375645153, -0.3399594379698512),
-    vec2(-0.40621612411258323, -0.17785923161854378),
-    vec2(0.09572596726946148, 0.3221802809834604),
-    vec2(-0.34649493957779864, 0.4042925125891039),
-    vec2(0.15455121026782426, -0.09384323368182085),
-    vec2(-0.24632469252535627, -0.48425010058013807),
-    vec2(0.25213583361769043, 0.0038409133290144837),
-    vec2(-0.2706859025730518, 0.2111277185733732),
-    vec2(0.24423366326974705, -0.2704316431631962),
-    vec2(-0.13088787965672388, -0.21321320466705934),
-    vec2(0.3632778866781212, 0.2831692929520083),
-    vec2(-0.023439041282739936, 0.49413040419121634),
-    vec2(0.4471961192108098, -0.00758242595710068),
-    vec2(-0.44734950697104703, -0.3984641444259518),
-    vec2(0.048739496989398834, 0.10145732209318614),
-    vec2(-0.19121133040799831, 0.05236768086707699),
-    vec2(0.3108359321027824, -0.44150352597546316),
-    vec2(-0.3181100608794274, -0.06649080372276323),
-    vec2(0.1836210164156281, 0.4333729490168995),
-    vec2(-0.4353945115049477, 0.37115601217345995),
-    vec2(0.0779603058437025, -0.1267437366179009),
-    vec2(-0.12103041498987621, -0.3494826991450838),
-    vec2(0.4235246142458863, 0.12700080527143276),
-    vec2(-0.33993370955801416, 0.027546773317116968),
-    vec2(0.15986315552149144, -0.48824515229236604),
-    vec2(-0.206957035316631, -0.12299389977920167),
-    vec2(0.28502223893466216, 0.38496089445939075),
-    vec2(-0.09732870939691002, 0.34322777395896087),
-    vec2(0.4197957675637508, -0.15955601921459617),
-    vec2(-0.40822392845668276, -0.31618188243003037),
-    vec2(0.09179501566796444, 0.18404752718062056),
-    vec2(-0.15241584421961724, 0.23633250683652818),
-    vec2(0.3555059219241493, -0.30452589279970166),
-    vec2(-0.2519744915170734, -0.23771307909236056),
-    vec2(0.23054909818986358, 0.2618059307941393),
-    vec2(-0.45513638481568053, 0.44935355590520076),
-    vec2(0.03289472186647746, -0.05271867456584994),
-    vec2(-0.013638682556165405, -0.4279746048995575),
-    vec2(0.4568766672427591, 0.06630632215858279),
-    vec2(-0.3770551149450494, 0.15243407723067892),
-    vec2(0.12121016560436315, -0.3614541832630005),
-    vec2(-0.06451162049147363, -0.1430067598240753),
-    vec2(0.38844272776294564, 0.35550119296905547),
-    vec2(-0.22032063326551626, 0.410098945174586),
-    vec2(0.2798514822756287, -0.08989227709213848),
-    vec2(-0.363163441955333, -0.46493119795604154),
-    vec2(0.13672580958246372, 0.03472318266725083),
-    vec2(-0.03428446206879787, 0.12114917474816977),
-    vec2(0.48632974067221135, -0.38675915351733275),
-    vec2(-0.48662218224570963, -0.027580737484454),
-    vec2(0.01182212352875256, 0.4725147093274301),
-    vec2(-0.2912744885829829, 0.3086143738512618),
-    vec2(0.20580615921340162, -0.19138091606399849),
-    vec2(-0.18364162700861036, -0.2618086048426998),
-    vec2(0.31639512666371206, 0.2029477582881627),
-    vec2(-0.4160437809375318, 0.04113578565489295),
-    vec2(0.08558873519306054, -0.4589633535848536),
-    vec2(-0.10566023935831037, -0.08194852950921566),
-    vec2(0.410211715855878, 0.4160400441850014),
-    vec2(-0.21310328951932606, 0.3476376782964782),
-    vec2(0.29489324051952026, -0.15420322046665952),
-    vec2(-0.331972425710774, -0.37129808977204587),
-    vec2(0.1661206016325052, 0.1440593699435233),
-    vec2(-0.005622524897770376, 0.19327703235795268),
-    vec2(0.4667900329601974, -0.2555991384659436),
-    vec2(-0.4665409067625655, -0.20101817272702743),
-    vec2(0.04104357772809375, 0.29893229133899824),
-    vec2(-0.26361249082830257, 0.4798847770890162),
-    vec2(0.22225323208551884, -0.019556666714846738),
-    vec2(-0.14647198601295308, -0.38070915832818664),
-    vec2(0.347612489632944, 0.11309255907261118),
-    vec2(-0.37103431390199765, 0.17667700159915123),
-    vec2(0.13278599292517312, -0.3239648393599562),
-    vec2(-0.23241758101842425, -0.1694207236035819),
-    vec2(0.2677495817565836, 0.3312505500095647),
-    vec2(-0.0742110918867695, 0.38076717043365893),
-    vec2(0.37706431606422497, -0.11156600976044867),
-    vec2(-0.3886361271466717, -0.4964756677781149),
-    vec2(0.11150595722757839, 0.019346996756112955),
-    vec2(-0.1739104742977562, 0.07615116224018159),
-    vec2(0.3261175459309412, -0.4318437376668385),
-    vec2(-0.2832797800818356, -0.05469952691648694),
-    vec2(0.21670978114920303, 0.44331492241094705),
-    vec2(-0.49420743930627403, 0.2560353513089296),
-    vec2(0.0058099205009465305, -0.2445176545630982),
-    vec2(-0.04104819382404168, -0.30680150572615744),
-    vec2(0.49627414681659665, 0.24426880341852109),
-    vec2(-0.2989340508493925, 0.10546922413784099),
-    vec2(0.20110017155562476, -0.39215936056616923),
-    vec2(-0.1679854535131714, -0.011809495516823643),
-    vec2(0.3338297067933814, 0.4880764503261197),
-    vec2(-0.05467150906660245, 0.29112873969127373),
-    vec2(0.47864558726844053, -0.21087655777405628),
-    vec2(-0.4789652166751227, -0.2773466272743005),
-    vec2(0.021398645063445687, 0.20889500266740868),
-    vec2(-0.23637958924749464, 0.13678266725231814),
-    vec2(0.2631864184347178, -0.355374124892334),
-    vec2(-0.3552684146773399, -0.13661945914524087),
-    vec2(0.14595232586973417, 0.3633087933736223),
-    vec2(-0.3962356040566143, 0.4258341924372565),
-    vec2(0.1035905096288664, -0.07219807764538544),
-    vec2(-0.09022224209544277, -0.44925914857083593),
-    vec2(0.3944556584611906, 0.05677569674290883),
-    vec2(-0.43949826826657057, 0.22241018219396513),
-    vec2(0.06052390485247672, -0.29073981100502266),
-    vec2(-0.021443021471501233, -0.22904313235858165),
-    vec2(0.43959460221178537, 0.26963627457524286),
-    vec2(-0.13681686922298175, 0.45895837326223143),
-    vec2(0.36744704676895357, -0.041212312204668144),
-    vec2(-0.2755629498247423, -0.41778593565757377),
-    vec2(0.23776255075105168, 0.08199014663699433),
-    vec2(-0.11313976785801971, 0.01174742068244583),
-    vec2(0.4317595719817583, -0.472723676155805),
-    vec2(-0.4258590623527187, -0.10371195073668243),
-    vec2(0.0645955273378035, 0.396397694336292),
-    vec2(-0.32438218104152805, 0.3201911511148119),
-    vec2(0.17568710768783014, -0.18168797094654326),
-    vec2(-0.20116564714355384, -0.33538322773666773),
-    vec2(0.29896120390282566, 0.1662150704998715),
-    vec2(-0.40020532017655724, 0.11528224562772427),
-    vec2(0.09976025354683771, -0.3769109812983797),
-    vec2(-0.08002095683679966, -0.015932047589937992),
-    vec2(0.4022861888793815, 0.4823285136365444),
-    vec2(-0.24593275117466135, 0.30280275128108414),
-    vec2(0.25403229164979013, -0.19718644933330398),
-    vec2(-0.3477327526855229, -0.25367958369089394),
-    vec2(0.15215641584096962, 0.18934068409086424),
-    vec2(-0.058597537272921885, 0.14461302088737482),
-    vec2(0.4749087370563746, -0.3672412319041505),
-    vec2(-0.47459460829488037, -0.15080153255118178),
-    vec2(0.02557734133213707, 0.3494524207621791),
-    vec2(-0.3066584128778781, 0.4182526036917513),
-    vec2(0.1932780937694225, -0.08590603199246583),
-    vec2(-0.16031779695475956, -0.45501229728190584),
-    vec2(0.3398040791411623, 0.04507759935923239),
-    vec2(-0.3162537491382206, 0.24998606849386007),
-    vec2(0.18177044393351638, -0.31054248075229474),
-    vec2(-0.19328609213991738, -0.24815171698532107),
-    vec2(0.30668152749795774, 0.25006438308169987),
-    vec2(-0.1230587985981304, 0.43967255514738635),
-    vec2(0.42968148700410336, -0.05868737664578072),
-    vec2(-0.43346674943514674, -0.43362714259933155),
-    vec2(0.07213566742688171, 0.07420182130509922),
-    vec2(-0.12677223237978802, 0.02114261392613692),
-    vec2(0.36513831695263343, -0.49234226726749447),
-    vec2(-0.26580272952729345, -0.11531543956300466),
-    vec2(0.2499591213318717, 0.37692825843775457),
-    vec2(-0.4497003344308643, 0.33407086160773247),
-    vec2(0.054431706105807165, -0.16592465215197943),
-    vec2(-0.029625664956321074, -0.32800252889850234),
-    vec2(0.4495056924271025, 0.17395963717794583),
-    vec2(-0.25395342299522206, 0.06075573294705916),
-    vec2(0.22818163461151642, -0.4453894931944601),
-    vec2(-0.15020263635152997, -0.07807892591232302),
-    vec2(0.353565851887924, 0.42204200525931457),
-    vec2(-0.009761718747980985, 0.36097284728037105),
-    vec2(0.45742803378230656, -0.14061459595866527),
-    vec2(-0.4570866401233918, -0.3582919822145815),
-    vec2(0.03721316563490107, 0.13459791058174964),
-    vec2(-0.20895984145051882, 0.20657841212767092),
-    vec2(0.28710099932306743, -0.2753988124986892),
-    vec2(-0.3398166372388668, -0.20687533330215513),
-    vec2(0.1605148645557335, 0.29299929284397974),
-    vec2(-0.41186202144968737, 0.49034582685580586),
-    vec2(0.08789403263507256, -0.00966144213514275),
-    vec2(-0.10131297143800377, -0.39454570313589854),
-    vec2(0.4163183870547926, 0.10353194420686651),
-    vec2(-0.4903519515725164, 0.1705337403634537),
-    vec2(0.00857490787549009, -0.3283423433372272),
-    vec2(-0.03533287848577815, -0.18569982882080316),
-    vec2(0.49210179558377165, 0.31438430533650363),
-    vec2(-0.1816828420937393, 0.3944523867690206),
-    vec2(0.3166569887662968, -0.10551659933217034),
-    vec2(-0.2948274265930494, -0.4724215574001307),
-    vec2(0.20929460875041628, 0.009658355868159885),
-    vec2(-0.06641490045275061, 0.08218223675463454),
-    vec2(0.38296568602685266, -0.4180989609987397),
-    vec2(-0.37921445498319006, -0.04503378698184346),
-    vec2(0.12087815376853173, 0.4550238961187798),
-    vec2(-0.3639589178091781, 0.26751015992116534),
-    vec2(0.13492985290215764, -0.2307857913260457),
-    vec2(-0.2242168205512471, -0.2968256106024124),
-    vec2(0.2756640448472477, 0.22617364883363333),
-    vec2(-0.46093850070433634, 0.005667244646311742),
-    vec2(0.04310744554089596, -0.47849860115835025),
-    vec2(-0.00012263792964917197, -0.09775759741666645),
-    vec2(0.4620481849322857, 0.40233568551438514),
-    vec2(-0.1443399415191809, 0.32609230234180375),
-    vec2(0.3478458290034291, -0.17391676459982836),
-    vec2(-0.25862513641235124, -0.33604106396816263),
-    vec2(0.22432606415848877, 0.16396703562254067),
-    vec2(-0.10534799769666614, 0.23046117003137212),
-    vec2(0.40813609532267625, -0.288767489561287),
-    vec2(-0.4198831631540367, -0.22305781333275948),
-    vec2(0.07827790386062217, 0.2754709911069434),
-    vec2(-0.333708358614316, 0.4628530209507863),
-    vec2(0.16994589615549915, -0.037242478117568145),
-    vec2(-0.21683182302610893, -0.407525517149259),
-    vec2(0.2908360161481818, 0.08611828952525402),
-    vec2(-0.2876319207888773, 0.13079356598913638),
-    vec2(0.21097781676408567, -0.3451855432613694),
-    vec2(-0.17789910966213096, -0.130826134085821),
-    vec2(0.3215416897589244, 0.3691621785902881),
-    vec2(-0.04511682805077649, 0.4355742349715108),
-    vec2(0.496057572278751, -0.06634059281537358),
-    vec2(-0.4979731491048818, -0.43921286605985804),
-    vec2(0.0017926384528161865, 0.04883235567978694),
-    vec2(-0.23025873197768204, 0.09765085690791042),
-    vec2(0.2696116859893686, -0.4026910556016447),
-    vec2(-0.37128363550435706, -0.00385744205043298),
-    vec2(0.12886970298240652, 0.4981109453336241),
-    vec2(-0.3846114877372075, 0.28700532987691774),
-    vec2(0.11533852247025334, -0.21685470816381014),
-    vec2(-0.07459371513711482, -0.26750998469387977),
-    vec2(0.3808434450019621, 0.21685770594136222),
-    vec2(-0.35921185188546784, 0.0683550511231813),
-    vec2(0.14443353285519034, -0.4238630293840204),
-    vec2(-0.24023999061224205, -0.050761713822583654),
-    vec2(0.25796363864779326, 0.4471513934115475),
-    vec2(-0.08606381930334228, 0.2597622855210341),
-    vec2(0.39826375977919826, -0.2405179373338222),
-    vec2(-0.392651829834437, -0.29904613322452855),
-    vec2(0.10547702573533613, 0.24031924408029193),
-    vec2(-0.16408474989768657, 0.1822137496562265),
-    vec2(0.3281403501133172, -0.3181062399202042),
-    vec2(-0.3025696690572437, -0.1622786444372712),
-    vec2(0.19545628272417204, 0.33975645904180507),
-    vec2(-0.48207372839167856, 0.3906015675214195),
-    vec2(0.017403834813368713, -0.12061911384266999),
-    vec2(-0.048745977641220795, -0.49039884412460816),
-    vec2(0.4805919944592446, 0.023440955823352705),
-    vec2(-0.42554313338017885, 0.19917954644729718),
-    vec2(0.06819720851900002, -0.2598239726030116),
-    vec2(-0.11537710839682758, -0.19340274429092907),
-    vec2(0.4360976379717141, 0.30658645474969926),
-    vec2(-0.19720671537641882, 0.47506832777835983),
-    vec2(0.3028554529306182, -0.024904456351660997),
-    vec2(-0.32237384367486976, -0.38450916217637776),
-    vec2(0.17708386752699112, 0.11915510444476596),
-    vec2(-0.017563974181012132, 0.03537291306652679),
-    vec2(0.44333050504841, -0.4611488856933012),
-    vec2(-0.4432530819851197, -0.08817466051849382),
-    vec2(0.05687688839223959, 0.4120118366182317),
-    vec2(-0.2793011790539949, 0.3515801488680558),
-    vec2(0.2387137812214415, -0.1483691637550038),
-    vec2(-0.1331175200696295, -0.36557669103680923),
-    vec2(0.37114946784147784, 0.1488044819656611),
-    vec2(-0.48730857250386633, 0.12459963189855727),
-    vec2(0.012777692858705003, -0.3886791174663788),
-    vec2(-0.0332153738352195, -0.03058892651147288),
-    vec2(0.4882663784242959, 0.47053962402950245),
-    vec2(-0.18536721034161302, 0.3115205375141745),
-    vec2(0.31445425202298116, -0.18928678245718),
-    vec2(-0.2929125050052996, -0.2638070795447287),
-    vec2(0.20691859686014513, 0.19931649145419728),
-    vec2(-0.06625610099623436, 0.15520561121895837),
-    vec2(0.38765730357226147, -0.36039165506456106),
-    vec2(-0.37885032580961053, -0.1413963793189736),
-    vec2(0.12208561562672238, 0.3576136426972055),
-    vec2(-0.3622987942240433, 0.40806453615915317),
-    vec2(0.13769959816767674, -0.09192879751909994),
-    vec2(-0.21881049964631089, -0.4668830742719565),
-    vec2(0.28039160773346805, 0.03225094044234811),
-    vec2(-0.2537154883924311, 0.23535214792730264),
-    vec2(0.23158170450685955, -0.30173780776757203),
-    vec2(-0.15337145666938634, -0.23632313925510096),
-    vec2(0.3564667487841262, 0.2647427154146399),
-    vec2(-0.012584226809915777, 0.4512082914807184),
-    vec2(0.45598245563153894, -0.05441664217634329),
-    vec2(-0.4560589075545037, -0.42671678385955203),
-    vec2(0.032079928218385345, 0.0625414296100757),
-    vec2(-0.20603749646491099, 0.029297599186404955),
-    vec2(0.28416601206445913, -0.48624525870300217),
-    vec2(-0.3408213377563979, -0.12306019364255244),
-    vec2(0.15910418075742672, 0.38286530547058983),
-    vec2(-0.4099121423161687, 0.3417389717346865),
-    vec2(0.09000878486861474, -0.15723868372171323),
-    vec2(-0.09589289326174094, -0.3144228661463281),
-    vec2(0.41892704332818165, 0.18748756981719383),
-    vec2(-0.3164436205674733, 0.05358891300717983),
-    vec2(0.18459482901306945, -0.443392918206532),
-    vec2(-0.18958128851497758, -0.06937475866522547),
-    vec2(0.31173909809908784, 0.43161478944373066),
-    vec2(-0.11986182035422943, 0.3749078067182756),
-    vec2(0.42254634754877196, -0.12695958209343955),
-    vec2(-0.4335981523761443, -0.3496267790727156),
-    vec2(0.07618914191640846, 0.12591832802280623),
-    vec2(-0.13189421379796873, 0.21302433793139486),
-    vec2(0.36133053926363734, -0.27232107748085477),
-    vec2(-0.27049150456959925, -0.2121185783841274),
-    vec2(0.24517052033538678, 0.28422879479208685),
-    vec2(-0.4482948100927617, 0.4941700042950067),
-    vec2(0.04778954509088573, -0.0048489913235337245),
-    vec2(-0.024601024453205167, -0.4013582739127825),
-    vec2(0.446285292426561, 0.09880959462316663),
-    vec2(-0.40495288978975286, 0.15820546955525017),
-    vec2(0.09755065678143227, -0.3427677725469079),
-    vec2(-0.08506161915564109, -0.17768810260329226),
-    vec2(0.40333118010904245, 0.3223619992410831),
-    vec2(-0.24801617946450738, 0.40534040813709105),
-    vec2(0.2538717432372707, -0.09674717107090619),
-    vec2(-0.34764839498118594, -0.48148822104068045),
-    vec2(0.15623850331910005, 0.0007548679956338455),
-    vec2(-0.056705129419879874, 0.09374553651767625),
-    vec2(0.4696112607339944, -0.4102015425698491),
-    vec2(-0.47072881393912547, -0.032173607328642495),
-    vec2(0.030295417459184737, 0.4667785584753896),
-    vec2(-0.3098631734559086, 0.2802590631508787),
-    vec2(0.18842289334960183, -0.21971533615479372),
-    vec2(-0.15913888423821565, -0.2813039586059065),
-    vec2(0.34083313015142813, 0.23174975330911984),
-    vec2(-0.42763757825242554, 0.014145006736991594),
-    vec2(0.06640311709339675, -0.4746367382353647),
-    vec2(-0.11220720131115608, -0.10350530425525217),
-    vec2(0.4327930499749252, 0.39652033328769387),
-    vec2(-0.20019522042057303, 0.31718307111265964),
-    vec2(0.2998272856578551, -0.18076300746278634),
-    vec2(-0.32614511696178067, -0.33396204436818044),
-    vec2(0.1746299504644836, 0.16598192686604574),
-    vec2(-0.019776316748934597, 0.2198377486641675),
-    vec2(0.44136821059074605, -0.2927403524162407),
-    vec2(-0.4413557710216684, -0.22746165920247702),
-    vec2(0.05861815665110559, 0.27154423401340466),
-    vec2(-0.2764126363460233, 0.4599443173067139),
-    vec2(0.23724977832558558, -0.04008026518486879),
-    vec2(-0.13771792231103047, -0.4159572481537326),
-    vec2(0.36825565480824896, 0.07818293560034406),
-    vec2(-0.3544560849962592, 0.13872605860826293),
-    vec2(0.14548083913229026, -0.35261522489892566),
-    vec2(-0.23823173415134108, -0.13376097678537857),
-    vec2(0.2626837830384269, 0.36535532799750947),
-    vec2(-0.09084196205501638, 0.4285060868735189),
-    vec2(0.3926128910612553, -0.07332838418902038),
-    vec2(-0.3945983963173131, -0.4511825389840992),
-    vec2(0.10536764470728421, 0.056482568604265815),
-    vec2(-0.16988286332557428, 0.10745458293212995),
-    vec2(0.3320688752676837, -0.39343802855908633),
-    vec2(-0.30074045345465433, -0.014633327599956836),
-    vec2(0.19926381041396457, 0.48609853685131554),
-    vec2(-0.48043710265653294, 0.2901037039179959),
-    vec2(0.0195595676755832, -0.2079804564879011),
-    vec2(-0.05279485389069499, -0.2802267498033625),
-    vec2(0.48046393454972525, 0.2098697990731071),
-    vec2(-0.2851479597182048, 0.07619126630007678),
-    vec2(0.2150287090206755, -0.4306701345324563),
-    vec2(-0.17481471336157534, -0.05777793822785615),
-    vec2(0.3249549633228742, 0.4453055582383264),
-    vec2(-0.04293103117120367, 0.25483461219179127),
-    vec2(0.4970893767763417, -0.24389303634104875),
-    vec2(-0.4951508798487509, -0.30486371617815033),
-    vec2(0.004027968535450954, 0.24321198723081805),
-    vec2(-0.23141206101960582, 0.17863442357222425),
-    vec2(0.2687001641164608, -0.3222209758987772),
-    vec2(-0.3691536803963863, -0.17077283862138964),
-    vec2(0.13173483138493203, 0.3291156735837848),
-    vec2(-0.3876258040132533, 0.3819256445794753),
-    vec2(0.11236549480192526, -0.11130230074298758),
-    vec2(-0.07247764767709075, -0.4980561060811827),
-    vec2(0.378862072548782, 0.016601730871721343),
-    vec2(-0.46488591627694076, 0.19348180755605093),
-    vec2(0.042004662769901224, -0.2559027099502793),
-    vec2(-0.004812018661986939, -0.20141121508376542),
-    vec2(0.4649150600527362, 0.29878435304578077),
-    vec2(-0.1454998657368568, 0.47851326074796807),
-    vec2(0.34656047246334, -0.022449573084357743),
-    vec2(-0.2617395249754517, -0.380959887990731),
-    vec2(0.22166827969585756, 0.11102042024298853),
-    vec2(-0.10737515920251417, 0.04013390384640525),
-    vec2(0.41206402978670376, -0.4598507337105574),
-    vec2(-0.41795255525695135, -0.08003523533007595),
-    vec2(0.08401472183994874, 0.4140985343720345),
-    vec2(-0.33072803270312534, 0.3456955682533449),
-    vec2(0.16796213983305563, -0.1544070915724492),
-    vec2(-0.214003308398524, -0.37399431799364213),
-    vec2(0.2930645890438519, 0.14172480597905124),
-    vec2(-0.3808444811572067, 0.0848304001505894),
-    vec2(0.11920151499508069, -0.4201639076785493),
-    vec2(-0.06825979482950534, -0.04480508422810198),
-    vec2(0.3847498950779612, 0.4551211307541807),
-    vec2(-0.2226622330700615, 0.268197760839725),
-    vec2(0.2764516187833327, -0.23244704417022832),
-    vec2(-0.36430750285135105, -0.2939850237277145),
-    vec2(0.13665383072135517, 0.2238794872808182),
-    vec2(-0.037077609745225504, 0.16898915896273614),
-    vec2(0.49023501096445066, -0.33011214881100126),
-    vec2(-0.49124741840046193, -0.1853628063076284),
-    vec2(0.008799387416188909, 0.31531647859316014),
-    vec2(-0.29391469414159777, 0.39245264062000995),
-    vec2(0.2108625020006304, -0.10831429424840355),
-    vec2(-0.1826979367299812, -0.4706553470979527),
-    vec2(0.3175250995963813, 0.010730446345022071),
-    vec2(-0.33793087917989373, 0.2050544699442105),
-    vec2(0.16209763034755476, -0.2753870809290334),
-    vec2(-0.20704007790170764, -0.20478271449190005),
-    vec2(0.28612358225259127, 0.29531012599979867),
-    vec2(-0.10057273330877142, 0.48998422250504714),
-    vec2(0.41791448309550006, -0.009782316512164657),
-    vec2(-0.4111117452336698, -0.39741236125408064),
-    vec2(0.08892432660510707, 0.10256547905165081),
-    vec2(-0.1484663858447372, 0.06053171477931574),
-    vec2(0.355462288591621, -0.44730761777803774),
-    vec2(-0.2557572511151486, -0.07517095132653462),
-    vec2(0.2274309052068847, 0.4238551130556033),
-    vec2(-0.4581151552612982, 0.36224579873759466),
-    vec2(0.0389976480547074, -0.1368776613730574),
-    vec2(-0.00867026289580114, -0.3574027245607591),
-    vec2(0.4580587948517847, 0.13481268689253223),
-    vec2(-0.2675187512851799, 0.022456846909701622),
-    vec2(0.24808482784921548, -0.49510791864303905),
-    vec2(-0.12592654167836365, -0.11517889276291587),
-    vec2(0.3633641993836719, 0.37696402784339134),
-    vec2(-0.03031850059476443, 0.3339539165660841),
-    vec2(0.450332136993591, -0.16694706024315598),
-    vec2(-0.45113337602612585, -0.325230470566606),
-    vec2(0.05290756394410634, 0.1728547311066223),
-    vec2(-0.19158628256351068, 0.24710017004969853),
-    vec2(0.3076782189912348, -0.3106896417177886),
-    vec2(-0.3154060219012411, -0.24720465723134855),
-    vec2(0.18344641227823855, 0.25289302772721134),
-    vec2(-0.43167907799222294, 0.4384834614794735),
-    vec2(0.07121690897186883, -0.06055914330206097),
-    vec2(-0.12417132119638008, -0.43645638498068384),
-    vec2(0.4277355202947839, 0.07204505991156096),
-    vec2(-0.4736231017769802, 0.14739497036719562),
-    vec2(0.02644939470924268, -0.37008081265660797),
-    vec2(-0.059594600325319436, -0.15038799022228422),
-    vec2(0.47636040440245453, 0.34967424157487026),
-    vec2(-0.1620602300720126, 0.42012323637373894),
-    vec2(0.3379778146107899, -0.08397598126077516),
-    vec2(-0.30847612160271554, -0.4561265121027799),
-    vec2(0.19236301762783903, 0.044710683772844595),
-    vec2(-0.07814423700788509, 0.11517183017713073),
-    vec2(0.4012464826061124, -0.37786548111091706),
-    vec2(-0.3984431516302524, -0.018530399769273342),
-    vec2(0.10149805389420274, 0.48246729771451735),
-    vec2(-0.3495316726123912, 0.30272882370481013),
-    vec2(0.15040143580718535, -0.19837350624170363),
-    vec2(-0.24427320898314936, -0.2519419251650732),
-    vec2(0.25574483471546494, 0.18951679483982886),
-    vec2(-0.4423638535525666, 0.03714615251156228),
-    vec2(0.057618553033637276, -0.46296423976430245),
-    vec2(-0.016523296430255796, -0.08694662960506944),
-    vec2(0.4422832172542851, 0.41305633270849096),
-    vec2(-0.13467036874139404, 0.35354073187796575),
-    vec2(0.37208154912195845, -0.14627917110245064),
-    vec2(-0.280471835423001, -0.3651960593340993),
-    vec2(0.24016944725454747, 0.15042326598937528),
-    vec2(-0.11623623816893097, 0.1963230386161149),
-    vec2(0.43654878446122714, -0.25966946643980704),
-    vec2(-0.4246000941574701, -0.19328251005749514),
-    vec2(0.06727548115131965, 0.3076162832633885),
-    vec2(-0.3232589088911057, 0.47455212008178604),
-    vec2(0.1766367910621507, -0.025392296923215818),
-    vec2(-0.19531554471851215, -0.385600803178572),
-    vec2(0.30467676833592405, 0.1181756390876958),
-    vec2(-0.3016926303955743, 0.18076339061968727),
-    vec2(0.1971280465719326, -0.31929615413507784),
-    vec2(-0.16599004031907205, -0.16123409318996407),
-    vec2(0.3291176310370125, 0.33690264475591736),
-    vec2(-0.046909933104654356, 0.3886217349941814),
-    vec2(0.48241201024084324, -0.11903214412149643),
-    vec2(-0.48142102055667535, -0.49018441266532997),
-    vec2(0.016569985096871798, 0.02539991982901646),
-    vec2(-0.2412743986089908, 0.06930406599489447),
-    vec2(0.258941667111943, -0.42377541623533116),
-    vec2(-0.35747338136840223, -0.04783214667936342),
-    vec2(0.14355368249204115, 0.44748654757985395),
-    vec2(-0.39435514577260383, 0.26072991694159986),
-    vec2(0.10683187482108103, -0.2402258205049287),
-    vec2(-0.08697194080192716, -0.29805516624006156),
-    vec2(0.39649920819775375, 0.2401747187291564),
-    vec2(-0.3721564807367199, 0.09570116436941256),
-    vec2(0.12791327140089548, -0.40530672973659776),
-    vec2(-0.22855782071184838, -0.0018115207251062637),
-    vec2(0.27059210799494804, 0.49718246838434166),
-    vec2(-0.0761475059929459, 0.28718276907406937),
-    vec2(0.37984991265160195, -0.21663617859662465),
-    vec2(-0.3835397823755166, -0.2676049302054989),
-    vec2(0.11623131937861064, 0.21639447719355398),
-    vec2(-0.17959656659973094, 0.1317890720718864),
-    vec2(0.3212604687430676, -0.3466730269635089),
-    vec2(-0.28902951452566733, -0.1309224356376369),
-    vec2(0.21192724204382207, 0.3691260744805861),
-    vec2(-0.49611747380722915, 0.4353652477934574),
-    vec2(0.0008368326805681114, -0.0635496696395082),
-    vec2(-0.04590815456028269, -0.4403756454290482),
-    vec2(0.49416679052546475, 0.04882153814393653),
-    vec2(-0.4180027979263232, 0.22753107715789678),
-    vec2(0.08000295103662991, -0.2852880868495421),
-    vec2(-0.10446916980229576, -0.22464302123094765),
-    vec2(0.40699298114085936, 0.27537613044167286),
-    vec2(-0.21871771278398983, 0.46358905070309053),
-    vec2(0.28906552140803354, -0.037019649063254056),
-    vec2(-0.332806935951077, -0.40909507959786356),
-    vec2(0.17119043924721922, 0.08789517445689432),
-    vec2(-0.0018788288885492888, 0.005907834676472379),
-    vec2(0.46099166811472136, -0.47902069557791555),
-    vec2(-0.4628561404905243, -0.1005798785742788),
-    vec2(0.043987978145697104, 0.3994607542054097),
-    vec2(-0.25976539960382755, 0.3266635574883131),
-    vec2(0.22360928901632393, -0.1728824407877334),
-    vec2(-0.1434871977125382, -0.33795436958195924),
-    vec2(0.34897011828277213, 0.16116550304919863),
-    vec2(-0.45503916990639426, 0.06449323549059638),
-    vec2(0.03387164463443948, -0.42964984938240786),
-    vec2(-0.014626103769863952, -0.050805610297222636),
-    vec2(0.4541119353662729, 0.4502398843409614),
-    vec2(-0.15431164615012416, 0.26291853413628197),
-    vec2(0.358352384097799, -0.2372665832550951),
-    vec2(-0.25095519954605616, -0.3035264121566169),
-    vec2(0.232769083368222, 0.23731107705741605),
-    vec2(-0.0947549329645927, 0.18463394635809538),
-    vec2(0.4208491327877538, -0.31540314174346945),
-    vec2(-0.4077071922031418, -0.1582084954417491),
-    vec2(0.09188024059647126, 0.3427545239058788),
-    vec2(-0.34208321376261236, 0.38580142669322337),
-    vec2(0.15709899359965074, -0.12116718151711114),
-    vec2(-0.20317590103631172, -0.48727616971243815),
-    vec2(0.28313407682646496, 0.02838811377529138),
-    vec2(-0.2900173813291592, 0.2011775012632374),
-    vec2(0.20499470289687183, -0.26272239316384394),
-    vec2(-0.18556908175513115, -0.18957966089962064),
-    vec2(0.3134718416835601, 0.30989199795763456),
-    vec2(-0.03227702206205735, 0.471241425881504),
-    vec2(0.4853165736058833, -0.028322528503162303),
-    vec2(-0.48560038329674754, -0.3877700978588299),
-    vec2(0.013730275152268212, 0.12219810720714686),
-    vec2(-0.22166675250120055, 0.03411645397056473),
-    vec2(0.2774600168042385, -0.4658417286600676),
-    vec2(-0.36131611249250833, -0.09100628381957382),
-    vec2(0.13869217014241753, 0.4091052317021542),
-    vec2(-0.3759730268562934, 0.35658778320523965),
-    vec2(0.12312508646269194, -0.1444335026994149),
-    vec2(-0.06439189946375667, -0.3623387222172468),
-    vec2(0.38966133892143384, 0.1536223330164509),
-    vec2(-0.3456703707910711, 0.001956205461297267),
-    vec2(0.15234587972604507, -0.4824222091964336),
-    vec2(-0.24909861004000028, -0.09568694835466351),
-    vec2(0.25176991041404373, 0.4033084492060741),
-    vec2(-0.08206036698213987, 0.320343120193604),
-    vec2(0.40431033805392447, -0.17964808932649573),
-    vec2(-0.402362656152337, -0.34173865186694574),
-    vec2(0.09564080634232441, 0.1562828129234216),
-    vec2(-0.15721939018644399, 0.23341371999256588),
-    vec2(0.3418021505433062, -0.28505965925843824),
-    vec2(-0.3106514502249834, -0.2207361387382521),
-    vec2(0.19123593055572596, 0.2792958968007917),
-    vec2(-0.46878477971476745, 0.46784571516173123),
-    vec2(0.028304276051373534, -0.035003514959208115),
-    vec2(-0.054770049920182695, -0.412150288912692),
-    vec2(0.4716672260813498, 0.09086693696332704),
-    vec2(-0.43654409686863693, 0.12794566489576498),
-    vec2(0.07422309701521812, -0.34846927437265285),
-    vec2(-0.11825019334912545, -0.1259513368215055),
-    vec2(0.42388692275403894, 0.3721311680671845),
-    vec2(-0.18845733660017472, 0.43259415104570487),
-    vec2(0.3095730607619297, -0.06745494230667759),
-    vec2(-0.31929679973777925, -0.4424016924433447),
-    vec2(0.1865334038801777, 0.05159690266432504),
-    vec2(-0.025658132213787377, 0.09961191036166217),
-    vec2(0.44739639125447217, -0.39942681748894526),
-    vec2(-0.44640199329868946, -0.006682271370572701),
-    vec2(0.05076276360074827, 0.49219404788811505),
-    vec2(-0.2724594968764009, 0.2820534676274541),
-    vec2(0.2431699010567503, -0.2147719292098627),
-    vec2(-0.12916464824991597, -0.2705657754648273),
-    vec2(0.35937809441287827, 0.21202757070895484),
-    vec2(-0.3965301011097825, 0.05852875595230578),
-    vec2(0.10349441656371039, -0.450374144906022),
-    vec2(-0.0928053610479373, -0.07038589217205093),
-    vec2(0.3916892046307128, 0.4277039089575031),
-    vec2(-0.23632246013863212, 0.36522874725915233),
-    vec2(0.2636795868555143, -0.13570271259674244),
-    vec2(-0.35255249746776884, -0.3537756177045668),
-    vec2(0.14654324079115255, 0.1378830026406337),
-    vec2(-0.050790614198580164, 0.2070989105656148),
-    vec2(0.4784913555398692, -0.27925961262487864),
-    vec2(-0.47841734844563055, -0.20983572441627174),
-    vec2(0.022496682094406917, 0.29216929021831683),
-    vec2(-0.29785987356966503, 0.48719901915272723),
-    vec2(0.20122802552967378, -0.012709123515167176),
-    vec2(-0.17093157907440476, -0.3913761191841831),
-    vec2(0.3349805447019517, 0.10653299838002284),
-    vec2(-0.32654337644017095, 0.16794608333740224),
-    vec2(0.17297841199696773, -0.3349451800663064),
-    vec2(-0.20214403664916458, -0.18279395767232476),
-    vec2(0.2978760514500428, 0.3193152776086364),
-    vec2(-0.11119652076788461, 0.39453321676643827),
-    vec2(0.43148302885709766, -0.10454271257822378),
-    vec2(-0.42869358895254106, -0.47457980352210566),
-    vec2(0.06343658905889149, 0.013518836332340967),
-    vec2(-0.13890522203990063, 0.08105015384206227),
-    vec2(0.3691559773574824, -0.41620184140971195),
-    vec2(-0.27451340388013556, -0.042060892392571936),
-    vec2(0.23616372072654013, 0.4579242307251694),
-    vec2(-0.4394340285146174, 0.2705242882529836),
-    vec2(0.06055570969563262, -0.23038838882491325),
-    vec2(-0.022526492247742613, -0.2890890576902134),
-    vec2(0.4394497666209448, 0.22096492008974256),
-    vec2(-0.2637432181029499, 0.11138328479576498),
-    vec2(0.2206073375052363, -0.37892366339372713),
-    vec2(-0.1474418165160441, -0.020537105587627225),
-    vec2(0.3456232127422112, 0.47857153768931826),
-    vec2(-0.00669790496310263, 0.29982699875469077),
-    vec2(0.46682664986222766, -0.19931384168805294),
-    vec2(-0.4668261624793307, -0.2539206419836296),
-    vec2(0.04007325389503813, 0.19236385714704052),
-    vec2(-0.21266163741955313, 0.14258714947380258),
-    vec2(0.29553715845762485, -0.37298779681747096),
-    vec2(-0.33000799094007016, -0.15236276924876946),
-    vec2(0.1649372774710821, 0.3457759749285131),
-    vec2(-0.41597556819050296, 0.41706111388890776),
-    vec2(0.08310897596204059, -0.08088611876209828),
-    vec2(-0.10842739206030222, -0.45704474295973213),
-    vec2(0.41302993435402513, 0.04202237293377675),
-    vec2(-0.4932025449756864, 0.24513013358039504),
-    vec2(0.006049808191003869, -0.3076259860386016),
-    vec2(-0.04099987765341817, -0.2459528164664916),
-    vec2(0.49805565635989846, 0.2576967062022145),
-    vec2(-0.17189439375128623, 0.44208621677388193),
-    vec2(0.3271101156060695, -0.055735551091119606),
-    vec2(-0.28301525850356135, -0.43353920587093875),
-    vec2(0.21687740083610463, 0.07512744002734195),
-    vec2(-0.0722088965728589, 0.017648978082071665),
-    vec2(0.37688563062886293, -0.49802419967280315),
-    vec2(-0.3895863916023084, -0.11231131971913583),
-    vec2(0.11049413990855961, 0.37984239024192346),
-    vec2(-0.3681778567450251, 0.33015823204565153),
-    vec2(0.1298499190630803, -0.16890912735281388),
-    vec2(-0.23244852118044879, -0.3231553624513843),
-    vec2(0.26751208673584104, 0.17678788947560997),
-    vec2(-0.4130771136339312, 0.10452589208090479),
-    vec2(0.08712624188220341, -0.3964635131101366),
-    vec2(-0.09955385860083449, -0.00785491670055255),
-    vec2(0.41586448503525386, 0.49205371135483456),
-    vec2(-0.20988965530916387, 0.2940449716268847),
-    vec2(0.28721204688179347, -0.20599800215353015),
-    vec2(-0.33609843494950375, -0.27733110192680616),
-    vec2(0.16297658453847852, 0.20600977094575013),
-    vec2(-0.010596107525671139, 0.1337199017205053),
-    vec2(0.45898534882469366, -0.3584680931535363),
-    vec2(-0.4590229884525194, -0.1387868925489235),
-    vec2(0.03709313005581061, 0.3602381740542061),
-    vec2(-0.256784922098404, 0.4237807595507407),
-    vec2(0.2294574327600407, -0.07709363351013843),
-    vec2(-0.15041458346287878, -0.4463234044316438),
-    vec2(0.35316553857990307, 0.06237399953449485),
-    vec2(-0.3653274961354364, 0.2246621311765814),
-    vec2(0.13475988075697676, -0.29534045369054746),
-    vec2(-0.2246218812031987, -0.23156046200957064),
-    vec2(0.27442522760815724, 0.26563200828736633),
-    vec2(-0.06926374261630935, 0.4531577663559003),
-    vec2(0.3856949600730756, -0.0467921822165675),
-    vec2(-0.3818312170680183, -0.41920591590233247),
-    vec2(0.11816829465125767, 0.08397578006550954),
-    vec2(-0.18160131974058652, 0.008772128866350926),
-    vec2(0.3185130901836304, -0.4716744180909354),
-    vec2(-0.29587980619890347, -0.1064570435633359),
-    vec2(0.20836149517583702, 0.39354976901101923),
-    vec2(-0.4892685406596646, 0.3127655346930879),
-    vec2(0.010637043367888288, -0.18655174075924164),
-    vec2(-0.038077271487188535, -0.32976985404685),
-    vec2(0.48926095187599516, 0.17158168112135952),
-    vec2(-0.3057026499979202, 0.04592209418464677),
-    vec2(0.19430064613863507, -0.4539943997493606),
-    vec2(-0.16304987960299144, -0.0849096849299581),
-    vec2(0.3369208060007963, 0.4189962039906423),
-    vec2(-0.06186370697527438, 0.34767873624136636),
-    vec2(0.47452919671984783, -0.1523341185607719),
-    vec2(-0.47553209070129676, -0.36897474660829166),
-    vec2(0.023552973412198086, 0.14637152206867643),
-    vec2(-0.2441050877403827, 0.1884733255827007),
-    vec2(0.2567815534173392, -0.2519614477579104),
-    vec2(-0.3505132041605066, -0.19539472190080936),
-    vec2(0.14947348190207577, 0.3046395305996036),
-    vec2(-0.40039677120622524, 0.4805602552389171),
-    vec2(0.09958674833319026, -0.017336896544716596),
-    vec2(-0.08101102009671224, -0.37596714735696996),
-    vec2(0.3994336545720887, 0.11716325672722483),
-    vec2(-0.4512455292259945, 0.17484182105107915),
-    vec2(0.051764077216433835, -0.3262131127223359),
-    vec2(-0.028521500827422608, -0.16407620201228718),
-    vec2(0.4513569795113115, 0.33498092173688976),
-    vec2(-0.12788435948004723, 0.3758742984897854),
-    vec2(0.3652688326693283, -0.11697168848346906),
-    vec2(-0.26846429797826543, -0.4940841779880316),
-    vec2(0.24727181761727668, 0.020506848428474833),
-    vec2(-0.1221455904475493, 0.0722705548037349),
-    vec2(0.42579188933674517, -0.4347168008086568),
-    vec2(-0.43070541486244307, -0.05991367227703903),
-    vec2(0.07235228797863247, 0.44137697353046323),
-    vec2(-0.31352137640860767, 0.2518162479730519),
-    vec2(0.18069629820073263, -0.24903881679876433),
-    vec2(-0.1934157716950004, -0.3085999269731807),
-    vec2(0.3056857040909078, 0.24808250507012697),
-    vec2(-0.48256289039656314, 0.02441499546861492),
-    vec2(0.01761197922421376, -0.4921764628168511),
-    vec2(-0.04883696579727048, -0.12008072265822262),
-    vec2(0.4833203211832524, 0.38873942984168364),
-    vec2(-0.1669305735704411, 0.3388569410301556),
-    vec2(0.33008255612605875, -0.16314519382790105),
-    vec2(-0.3027423930559073, -0.31734354831644307),
-    vec2(0.19741328748020193, 0.18266223425642936),
-    vec2(-0.08879894709288538, 0.2412561086553896),
-    vec2(0.3956751837767102, -0.300717464386612),
-    vec2(-0.3925714112011331, -0.24211653844667802),
-    vec2(0.10804453022709681, 0.25877792896404406),
-    vec2(-0.3564563419897877, 0.44536139324005397),
-    vec2(0.1425701590758327, -0.0497313048006624),
-    vec2(-0.24011538713192054, -0.4256704827563507),
-    vec2(0.2606591145205496, 0.06642527615157756),
-    vec2(-0.27918474780484315, 0.14975133702368215),
-    vec2(0.24145679174734325, -0.36633378586602616),
-    vec2(-0.13508733947829638, -0.14649295969648152),
-    vec2(0.3730565334966871, 0.3527448856183747),
-    vec2(-0.018546462325005453, 0.4109756644230603),
-    vec2(0.44416098834420437, -0.08888245802094447),
-    vec2(-0.44423036382243675, -0.46193379443938554),
-    vec2(0.0556864314779707, 0.03703634825821511),
-    vec2(-0.19920285261744775, 0.12018586596465886),
-    vec2(0.3017495767999472, -0.3836231282674574),
-    vec2(-0.3213097847080789, -0.023625609413408577),
-    vec2(0.1786698123619871, 0.47654524220032246),
-    vec2(-0.4238035685208777, 0.3048119894342879),
-    vec2(0.0692899610893769, -0.19478236969303248),
-    vec2(-0.11428542946926973, -0.26081845784130986),
-    vec2(0.43449198926024235, 0.19816787821781368),
-    vec2(-0.33402760037576695, 0.08788756580969892),
-    vec2(0.16900896732166504, -0.4071579198095756),
-    vec2(-0.21670496137779693, -0.039031108873901266),
-    vec2(0.29101563815644527, 0.46109259630792077),
-    vec2(-0.10346261691243647, 0.27734125383456487),
-    vec2(0.40911952301929655, -0.22365922723199883),
-    vec2(-0.4209108348625852, -0.28730120873851245),
-    vec2(0.08104791325343019, 0.22939843800984838),
-    vec2(-0.1415230032032619, 0.16308132894943705),
-    vec2(0.35154122780158625, -0.33781537948167173),
-    vec2(-0.26070961940291304, -0.17558803155942743),
-    vec2(0.22654380810116037, 0.325124970258423),
-    vec2(-0.4629113065631723, 0.4012916483950748),
-    vec2(0.04513128823091761, -0.09960575523282406),
-    vec2(-0.001970154837220628, -0.4774934243467592),
-    vec2(0.4638208570105967, 0.004865306824227034),
-    vec2(-0.38555911060736786, 0.21780944517216716),
-    vec2(0.11514900043341425, -0.2665562011770497),
-    vec2(-0.0761922714222012, -0.21778388740595184),
-    vec2(0.38176851806304746, 0.2859768108374606),
-    vec2(-0.22755273422443512, 0.49905729741034643),
-    vec2(0.27241334774520154, -0.0028951184564299237),
-    vec2(-0.3731049964443597, -0.40333815280607754),
-    vec2(0.1259531497561398, 0.09666539414715336),
-    vec2(-0.04314340973122943, 0.05075356719617019),
-    vec2(0.49318388467671914, -0.43767616822313377),
-    vec2(-0.4980919821307215, -0.06468108856965499),
-    vec2(0.002723150619493908, 0.4365355299628433),
-    vec2(-0.28704806561832863, 0.37019341467505384),
-    vec2(0.2132788515212004, -0.129848503857868),
-    vec2(-0.1768943399959686, -0.34465675044309296),
-    vec2(0.3231790794076319, 0.12986071687080447)
-    */
 );
+#endif
 
 
 // tolerances
-uniform real MEAN_DIFF_TOL; // = 0.003
-uniform real ABS_SE_TOL; // = 0.004
-uniform real REL_SE_TOL; // = 0.01
+uniform float MEAN_DIFF_TOL; // = 0.003
+uniform float ABS_SE_TOL; // = 0.004
+uniform float REL_SE_TOL; // = 0.01
 
+#ifndef ADAPTIVE_SUPER_SAMPLING_SAMPLES_ONLY // only the samples (if any) and tolerances, for shaders with their own loop (e.g. compute_shader_mandelbrot.glsl)
 // Written by ChatGPT
 real evaluateWithAdaptiveSuperSampling(dvec2 pixelCenter) {
     real sum = 0.0;      // sum of scalar samples
@@ -1090,6 +81,7 @@ real evaluateWithAdaptiveSuperSampling(dvec2 pixelCenter) {
 
     return sum / real(MAX_SAMPLES);
 }
+#endif
 
 
 
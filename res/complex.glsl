@@ -20,18 +20,42 @@ complex cdiv(complex a, complex b) {
     );
 }
 
-#ifndef USE_DOUBLE // For double, exp, sin, cos do not exist
-
 complex cexp(complex z) {
-    return exp(z.x) * complex(cos(z.y), sin(z.y));
+    return rexp(z.x) * complex(rcos(z.y), rsin(z.y));
 }
 
 complex cpow(complex z, real n) {
     real r = length(z);
-    real theta = atan(z.y, z.x);
-    return pow(r, n) * complex(cos(n * theta), sin(n * theta));
+    real theta = ratan(z.y, z.x);
+    return rpow(r, n) * complex(rcos(n * theta), rsin(n * theta));
+}
+
+#ifdef USE_DOUBLE_FLOAT
+// Double-float complex number: vec4(re hi, re lo, im hi, im lo)
+#define dfcomplex vec4
+
+dfcomplex dfc_add(dfcomplex a, dfcomplex b) {
+    return dfcomplex(df_add(a.xy, b.xy), df_add(a.zw, b.zw));
 }
 
+dfcomplex dfc_mul(dfcomplex a, dfcomplex b) {
+    return dfcomplex(
+        df_sub(df_mul(a.xy, b.xy), df_mul(a.zw, b.zw)),
+        df_add(df_mul(a.xy, b.zw), df_mul(a.zw, b.xy))
+    );
+}
+
+dfcomplex dfc_sqr(dfcomplex a) {
+    return dfcomplex(
+        df_sub(df_sqr(a.xy), df_sqr(a.zw)),
+        2.0 * df_mul(a.xy, a.zw) // times 2 is exact
+    );
+}
+
+// Rounded to float, enough for divergence checks and smoothing
+complex dfc_to_complex(dfcomplex a) {
+    return complex(a.x + a.y, a.z + a.w);
+}
 #endif
 
 #endif
\ No newline at end of file
@@ -0,0 +1,238 @@
+#version 430 core
+
+// Integrates all samples of the double pendulum (static super sampling), the fragment shader only colors the results (see COMPUTE_SAMPLES)
+// The step counts of the pixels differ by orders of magnitude, so in the fragment shader most lanes of a warp wait for the slowest one
+// Here a fixed number of persistent work groups takes work items (one sample of one pixel) from a queue until it is empty
+// Every loop iteration is one step, a lane that finished its sample takes the next one right away instead of waiting for the others
+// With SHARED_SAMPLES the samples are the lattice of shared_samples.glsl instead of sample_offsets
+
+#include "real.glsl"
+#include "zooming_and_tiling.glsl"
+#include "double_pendulum_rhs.glsl"
+
+#define RK45_DISABLE_ARR_METHODS // We only need vector methods (since 4 dimensions fit in one vector)
+#include "rk45.glsl"
+#include "symplectic.glsl"
+#include "static_supersampling.glsl"
+#include "shared_samples.glsl"
+
+#if RK_METHOD == RK_VERLET || RK_METHOD == RK_YOSHIDA4
+#define SYMPLECTIC_METHOD
+#endif
+
+layout(local_size_x = 64) in;
+
+uniform float v1_start;
+uniform float v2_start;
+
+// The image is split into tiles of TILE_SIZE x TILE_SIZE pixels, the work items of a tile are consecutive (neighboring lanes get neighboring pixels)
+const uint TILE_SIZE = 8u;
+const uint TILE_PIXELS = TILE_SIZE*TILE_SIZE;
+
+#ifdef USE_SHARED_SAMPLES
+const uint TEXEL_SAMPLES = LATTICE_SAMPLES;
+#else
+const uint TEXEL_SAMPLES = NUM_SAMPLES;
+#endif
+
+// Persistent work groups, at most this many per dispatch (same as model_double_pendulum.cpp)
+const uint PERSISTENT_WORK_GROUPS = 1024u;
+
+// Steps of all lanes of a dispatch together, every lane stops after its share (one step per loop iteration), its unfinished sample is
+// saved and continued by the next dispatch. A single dispatch must not run for too long (watchdog of the OS)
+uniform uint max_steps_per_dispatch;
+
+// llvmpipe stops a loop (including nested loops) after 65535 iterations
+const uint MAX_ITERATIONS_PER_LANE = 50000u;
+
+layout(std430, binding = 0) buffer WorkQueue {
+	uint next_continued_item; // index into continued_items, 0 at the start of every dispatch
+	uint next_queued_item;    // index of the next new work item, 0 at the start of the first dispatch only (the items no lane got to stay queued)
+	uint tile_order[];        // tiles by descending cost in the last frame, so that the expensive ones don't start last
+};
+
+layout(std430, binding = 1) buffer TileCost {
+	uint tile_cost[]; // steps of all samples of a tile, the order of the next frame
+};
+
+// Every dispatch first continues the samples that the previous one did not finish, then takes new ones from the queue
+layout(std430, binding = 2) readonly buffer ContinuedItems {
+	uvec3 continued_groups; // arguments of glDispatchComputeIndirect of this dispatch
+	uint num_continued_items;
+	uint continued_items[]; // texels of the samples (x + width*(y + height*layer))
+};
+
+layout(std430, binding = 3) buffer UnfinishedItems {
+	uint unfinished_groups;    // arguments of glDispatchComputeIndirect for the next dispatch, (0, 1, 1) at the start of every dispatch
+	uint unfinished_groups_y;
+	uint unfinished_groups_z;
+	uint num_unfinished_items; // 0 at the start of every dispatch
+	uint unfinished_items[];   // same as continued_items, for the next dispatch
+};
+
+// Results of every sample of every pixel (layer i is sample i), same layout as the state of INCREMENTAL in the fragment shader
+// With SHARED_SAMPLES the lattice of every pixel including the apron
+// Unfinished samples store (t, tau, same step counter, step counter) in state_t and (q1, q2, p1, p2) in state_y for symplectic methods
+layout(binding = 0, rgba32f) uniform image2DArray state_y; // (q1, q2, v1, v2)
+layout(binding = 1, rgba32f) uniform image2DArray state_t; // (t, tau, status, steps)
+
+// Takes the next work item, `continued` if it is a sample that the previous dispatch did not finish, returns false when there is none left
+// The last tiles of a row or column may be partly outside of the image, then `inside` is false and the item is skipped
+bool next_work_item(out ivec3 texel, out uint tile, out bool inside, out bool continued) {
+	uvec2 size = uvec2(imageSize(state_y).xy);
+	uvec2 num_tiles = (size + TILE_SIZE - 1u) / TILE_SIZE;
+	inside = false;
+	continued = false;
+
+	uint item = atomicAdd(next_continued_item, 1u);
+	if (item < num_continued_items) {
+		uint index = continued_items[item];
+		texel = ivec3(index % size.x, (index / size.x) % size.y, index / (size.x*size.y));
+		tile = uint(texel.y) / TILE_SIZE * num_tiles.x + uint(texel.x) / TILE_SIZE;
+		inside = true;
+		continued = true;
+		return true;
+	}
+
+	item = atomicAdd(next_queued_item, 1u);
+	if (item >= num_tiles.x*num_tiles.y*TILE_PIXELS*TEXEL_SAMPLES) {
+		return false;
+	}
+	tile = tile_order[item / (TILE_PIXELS*TEXEL_SAMPLES)];
+	uint rest = item % (TILE_PIXELS*TEXEL_SAMPLES);
+	uint pixel = rest % TILE_PIXELS;
+	uvec2 coord = uvec2(tile % num_tiles.x, tile / num_tiles.x)*TILE_SIZE + uvec2(pixel % TILE_SIZE, pixel / TILE_SIZE);
+	texel = ivec3(coord, rest / TILE_PIXELS);
+	inside = all(lessThan(coord, size));
+	return true;
+}
+
+// Work items that no lane took yet
+uint num_queued_items() {
+	uvec2 size = uvec2(imageSize(state_y).xy);
+	uvec2 num_tiles = (size + TILE_SIZE - 1u) / TILE_SIZE;
+	uint num_items = num_tiles.x*num_tiles.y*TILE_PIXELS*TEXEL_SAMPLES;
+	return num_items - min(atomicAdd(next_queued_item, 0u), num_items);
+}
+
+void main() {
+	bool has_item = false; // the lane is integrating a work item
+	ivec3 texel;
+	uint tile;
+	rvec4 y;
+	real t;
+	real tau;
+	uint step_counter;
+	uint same_step_counter;
+	#ifdef SYMPLECTIC_METHOD
+	rvec2 q;
+	rvec2 p;
+	uint num_steps;
+	#else
+	rvec4 z; // rhs(y)
+	#endif
+
+	uint max_iterations_per_lane = clamp(max_steps_per_dispatch / (gl_NumWorkGroups.x*gl_WorkGroupSize.x), 1u, MAX_ITERATIONS_PER_LANE);
+	bool done = false;
+	for (uint iteration = 0u; iteration < max_iterations_per_lane && !done; iteration++) {
+		if (!has_item) {
+			bool continued;
+			done = !next_work_item(texel, tile, has_item, continued);
+			if (has_item && continued) {
+				y = rvec4(imageLoad(state_y, texel));
+				vec4 time_state = imageLoad(state_t, texel);
+				t = real(time_state.x);
+				tau = real(time_state.y);
+				same_step_counter = uint(time_state.z);
+				step_counter = uint(time_state.w);
+				#ifdef SYMPLECTIC_METHOD
+				num_steps = symplectic_step_count(t0, t_end);
+				q = y.xy;
+				p = y.zw;
+				#else
+				z = rhs(y);
+				COST_COUNT(cost_rhs_evaluations, 1u);
+				#endif
+			} else if (has_item) {
+				// Same as the static super sampling loop of the fragment shader
+				#ifdef USE_SHARED_SAMPLES
+				dvec2 pixelCoord = dvec2(texel.xy - LATTICE_APRON) + 0.5; // center of the pixel, like gl_FragCoord
+				rvec2 planeCoord = rvec2(pixelCoordToPlaneCoord(pixelCoord + lattice_offset(uint(texel.z))));
+				#else
+				dvec2 pixelCoord = dvec2(texel.xy) + 0.5;
+				rvec2 planeCoord = rvec2(pixelCoordToPlaneCoord(pixelCoord + sample_offsets[texel.z]));
+				#endif
+				y = rvec4(planeCoord.x, planeCoord.y, v1_start, v2_start);
+				t = t0;
+				step_counter = 0u;
+				same_step_counter = 0u;
+				#ifdef SYMPLECTIC_METHOD
+				num_steps = symplectic_step_count(t0, t_end);
+				tau = num_steps > 0u ? (t_end - t0) / real(num_steps) : 0.0;
+				q = y.xy;
+				p = momentum(q, y.zw);
+				#else
+				z = rhs(y);
+				COST_COUNT(cost_rhs_evaluations, 1u);
+				tau = rk45_initial_tau(y, z);
+				#endif
+			}
+		}
+		if (has_item) { // not a skipped item or empty queue
+			uint status;
+			#ifdef SYMPLECTIC_METHOD
+			status = num_steps > MAX_STEPS ? ERR_TOO_MANY_STEPS : SUCCESS; // fail before integrating, like symplectic()
+			bool finished = status != SUCCESS || step_counter == num_steps;
+			#else
+			bool finished = rk45_is_finished(t, tau, t_end, step_counter, same_step_counter, status);
+			#endif
+
+			if (finished) {
+				#ifdef SYMPLECTIC_METHOD
+				if (step_counter > 0u) {
+					rvec2 dH_dq;
+					rvec2 dH_dp;
+					dH(q, p, dH_dq, dH_dp);
+					y = rvec4(q, dH_dp);
+					COST_COUNT(cost_rhs_evaluations, 1u);
+				}
+				t = status == SUCCESS ? t_end : t0;
+				#endif
+				imageStore(state_y, texel, vec4(y));
+				imageStore(state_t, texel, vec4(float(t), float(tau), float(status), float(step_counter)));
+				atomicAdd(tile_cost[tile], step_counter);
+				COST_COUNT_STATUS(status);
+				has_item = false;
+			} else {
+				#ifdef SYMPLECTIC_METHOD
+				symplectic_step(q, p, tau);
+				step_counter += 1u;
+				#else
+				rk45_advance(y, z, t, tau, t_end, step_counter, same_step_counter);
+				#endif
+			}
+		}
+	}
+
+	if (!done) { // out of iterations, the next dispatch continues
+		uint num_unfinished;
+		if (has_item) {
+			#ifdef SYMPLECTIC_METHOD
+			y = rvec4(q, p);
+			#endif
+			imageStore(state_y, texel, vec4(y));
+			imageStore(state_t, texel, vec4(float(t), float(tau), float(same_step_counter), float(step_counter)));
+			uvec2 size = uvec2(imageSize(state_y).xy);
+			num_unfinished = atomicAdd(num_unfinished_items, 1u) + 1u;
+			unfinished_items[num_unfinished - 1u] = uint(texel.x) + size.x*(uint(texel.y) + size.y*uint(texel.z));
+		} else {
+			num_unfinished = atomicAdd(num_unfinished_items, 0u);
+		}
+		// Enough work groups for the next dispatch (the lanes that stop later see more unfinished items, the largest count wins)
+		atomicMax(unfinished_groups, min((num_unfinished + num_queued_items() + gl_WorkGroupSize.x - 1u) / gl_WorkGroupSize.x, PERSISTENT_WORK_GROUPS));
+	}
+
+	#ifdef COST_INSTRUMENTATION
+	cost_record_totals(); // the steps of every pixel are in state_t for the heatmap of the fragment shader
+	#endif
+}
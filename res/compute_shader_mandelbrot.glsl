@@ -0,0 +1,299 @@
+#version 430 core
+
+// Computes the values of all pixels (COMPUTE_PIXELS, MARIANI_SILVER or PROGRESSIVE), the fragment shader only colors the results
+//
+// COMPUTE_PIXELS: one invocation per pixel, work groups of 8x8 pixels in a swizzled order (strips of tiles), so that neighboring work groups
+// run at the same time and cover a compact area. The lanes of a subgroup leave the iteration together as soon as all of them escaped or
+// repeat a value (see calcFractal), instead of every lane running its own loop
+//
+// MARIANI_SILVER: a block is a rectangle of pixels. Only its border is iterated, if all border pixels have the same value (e.g. inside the
+// set, or one band without smoothing), the interior gets that value without iterating. Otherwise the block is split into four, which the
+// next pass processes. The blocks of the last pass (and small ones) are iterated completely
+// Every pass is one dispatch, the number of work groups is written by the previous pass (indirect dispatch)
+//
+// SUPER_SAMPLING == 0 (adaptive): the first pass takes one sample at the center of every pixel. The second pass compares it with its 8
+// neighbors, only where they vary more than the tolerances of adaptive_supersampling.glsl, the pixel takes PMJ samples (of the sample
+// offsets buffer) until the mean and the standard error are within the tolerances. Takes precedence over MARIANI_SILVER
+//
+// PROGRESSIVE: every dispatch adds one sample per pixel (the next offset of the sample offsets buffer) to the mean in the pixel values,
+// the first one after a change of the view or the parameters replaces it. Takes precedence over everything else
+
+#extension GL_KHR_shader_subgroup_vote : enable
+#extension GL_ARB_shader_group_vote : enable
+
+#if defined(GL_KHR_shader_subgroup_vote)
+#define ALL_LANES(condition) subgroupAll(condition)
+#elif defined(GL_ARB_shader_group_vote)
+#define ALL_LANES(condition) allInvocationsARB(condition)
+#endif
+
+#include "mandelbrot_pixel.glsl"
+
+// (avgSmoothCount, outsideRatio, number of samples (adaptive and progressive only), computed), cleared to 0 before the first pass of MARIANI_SILVER
+// Neighboring blocks of one pass may iterate their shared border both, they store the same values
+layout(binding = 0, rgba32f) uniform coherent image2D pixel_values;
+
+#if defined(MARIANI_SILVER) && SUPER_SAMPLING != 0 && !defined(PROGRESSIVE)
+
+layout(local_size_x = 64) in;
+
+// Blocks of this pass, the header starts with the arguments of glDispatchComputeIndirect
+layout(std430, binding = 0) readonly buffer Blocks {
+	uvec4 blocks_header; // (work groups, 1, 1, number of blocks), a work group processes every work groups-th block
+	uvec4 blocks[];      // (min x, min y, max x, max y), inclusive, so that neighboring blocks share their border
+};
+
+// Blocks of the next pass, (0, 1, 1, 0) at the start of every pass
+layout(std430, binding = 1) buffer NextBlocks {
+	uint next_blocks_groups; // same layout as Blocks
+	uint next_blocks_groups_y;
+	uint next_blocks_groups_z;
+	uint num_next_blocks;
+	uvec4 next_blocks[];
+};
+
+// Blocks with a side of at most this many pixels are iterated completely
+const int MIN_BLOCK_SIZE = 8;
+
+// At least GL_MAX_COMPUTE_WORK_GROUP_COUNT of every implementation
+const uint MAX_WORK_GROUPS = 65535u;
+
+uniform bool final_pass;
+
+shared bool border_uniform;
+
+// i-th pixel of the border of the block from `lo` to `hi`
+ivec2 border_pixel(ivec2 lo, ivec2 hi, int i) {
+	ivec2 size = hi - lo + 1;
+	if (size.y == 1) {
+		return ivec2(lo.x + i, lo.y);
+	}
+	if (size.x == 1) {
+		return ivec2(lo.x, lo.y + i);
+	}
+	if (i < size.x) {
+		return ivec2(lo.x + i, lo.y);
+	}
+	i -= size.x;
+	if (i < size.x) {
+		return ivec2(lo.x + i, hi.y);
+	}
+	i -= size.x;
+	if (i < size.y - 2) {
+		return ivec2(lo.x, lo.y + 1 + i);
+	}
+	return ivec2(hi.x, lo.y + 1 + i - (size.y - 2));
+}
+
+void process_block(uvec4 block) {
+	ivec2 lo = ivec2(block.xy);
+	ivec2 hi = ivec2(block.zw);
+	ivec2 size = hi - lo + 1;
+	int num_border = size.x == 1 || size.y == 1 ? size.x * size.y : 2 * (size.x + size.y) - 4;
+	int local = int(gl_LocalInvocationID.x);
+
+	if (local == 0) {
+		border_uniform = true;
+	}
+
+	// Border (pixels of earlier passes are already computed)
+	for (int i = local; i < num_border; i += 64) {
+		ivec2 pixel = border_pixel(lo, hi, i);
+		if (imageLoad(pixel_values, pixel).w == 0.0) {
+			imageStore(pixel_values, pixel, vec4(mandelbrotPixel(vec2(pixel) + 0.5), 0.0, 1.0));
+		}
+	}
+	memoryBarrierImage();
+	barrier();
+
+	vec4 first = imageLoad(pixel_values, lo);
+	for (int i = local; i < num_border; i += 64) {
+		if (imageLoad(pixel_values, border_pixel(lo, hi, i)) != first) {
+			border_uniform = false;
+		}
+	}
+	barrier();
+
+	ivec2 interior = max(size - 2, ivec2(0));
+	int num_interior = interior.x * interior.y;
+	if (border_uniform) {
+		for (int i = local; i < num_interior; i += 64) {
+			imageStore(pixel_values, lo + 1 + ivec2(i % interior.x, i / interior.x), first);
+		}
+	} else if (!final_pass && size.x > MIN_BLOCK_SIZE && size.y > MIN_BLOCK_SIZE) {
+		if (local == 0) {
+			ivec2 mid = (lo + hi) / 2;
+			uint next = atomicAdd(num_next_blocks, 4u);
+			atomicMax(next_blocks_groups, min(next + 4u, MAX_WORK_GROUPS));
+			next_blocks[next] = uvec4(lo, mid);
+			next_blocks[next + 1u] = uvec4(mid.x, lo.y, hi.x, mid.y);
+			next_blocks[next + 2u] = uvec4(lo.x, mid.y, mid.x, hi.y);
+			next_blocks[next + 3u] = uvec4(mid, hi);
+		}
+	} else {
+		for (int i = local; i < num_interior; i += 64) {
+			ivec2 pixel = lo + 1 + ivec2(i % interior.x, i / interior.x);
+			imageStore(pixel_values, pixel, vec4(mandelbrotPixel(vec2(pixel) + 0.5), 0.0, 1.0));
+		}
+	}
+	barrier(); // border_uniform is reset by the next block
+}
+
+void main() {
+	for (uint i = gl_WorkGroupID.x; i < blocks_header.w; i += gl_NumWorkGroups.x) {
+		process_block(blocks[i]);
+	}
+}
+
+#else // COMPUTE_PIXELS, adaptive super sampling or PROGRESSIVE
+
+layout(local_size_x = 8, local_size_y = 8) in;
+
+// Work groups are numbered along strips of this many tiles width, top to bottom within a strip
+const uint SWIZZLE_STRIP_WIDTH = 8u;
+
+// Tile of the i-th work group
+uvec2 swizzled_tile(uint i, uvec2 num_tiles) {
+	uint tiles_per_strip = SWIZZLE_STRIP_WIDTH * num_tiles.y;
+	uint strip = i / tiles_per_strip;
+	uint in_strip = i % tiles_per_strip;
+	uint strip_width = min(SWIZZLE_STRIP_WIDTH, num_tiles.x - strip * SWIZZLE_STRIP_WIDTH); // the last strip may be narrower
+	return uvec2(strip * SWIZZLE_STRIP_WIDTH + in_strip % strip_width, in_strip / strip_width);
+}
+
+// Pixel of this invocation, false if it is outside of the image
+bool invocation_pixel(out ivec2 pixel) {
+	uvec2 size = uvec2(imageSize(pixel_values));
+	uvec2 num_tiles = (size + 7u) / 8u;
+	uint work_group = gl_WorkGroupID.x + gl_NumWorkGroups.x * gl_WorkGroupID.y; // 2D dispatch for more than 65535 work groups
+	uvec2 tile_pixel = swizzled_tile(work_group, num_tiles) * 8u + gl_LocalInvocationID.xy;
+	pixel = ivec2(tile_pixel);
+	return work_group < num_tiles.x * num_tiles.y && all(lessThan(tile_pixel, size));
+}
+
+#if defined(PROGRESSIVE)
+
+uniform uint progressive_samples; // in the pixel values (and index of the offset of this dispatch), 0 after a change
+
+void main() {
+	ivec2 pixel;
+	if (!invocation_pixel(pixel)) {
+		return;
+	}
+	vec2 sum = mandelbrotSample(dvec2(pixel) + 0.5 + dvec2(sample_offsets[progressive_samples])); // (sum of smoothCount, number outside)
+	float n = float(progressive_samples);
+	if (progressive_samples > 0u) {
+		vec4 last = imageLoad(pixel_values, pixel);
+		float last_outside = round(last.y * n);
+		sum += vec2(last.x * last_outside, last_outside);
+	}
+	imageStore(pixel_values, pixel, vec4(sum.y > 0.0 ? sum.x / sum.y : 0.0, sum.y / (n + 1.0), n + 1.0, 1.0));
+}
+
+#elif SUPER_SAMPLING == 0
+
+#define ADAPTIVE_SUPER_SAMPLING_SAMPLES_ONLY
+#include "adaptive_supersampling.glsl" // the tolerances
+
+uniform float colorScale = 50.0; // same as in the fragment shader, the tolerances are relative to the colormap
+uniform bool adaptive_first_pass;
+
+// (smoothCount, outside) of the center sample of every pixel (see mandelbrotSample)
+layout(binding = 1, rg32f) uniform image2D center_values;
+
+// What the colormap sees of a sample: (position in the colormap, outside), the mean is (outsideRatio * avgSmoothCount / colorScale, outsideRatio)
+vec2 color_value(vec2 sample_value) {
+	return vec2(sample_value.x / colorScale, sample_value.y);
+}
+
+// Standard error criterion of evaluateWithAdaptiveSuperSampling (adaptive_supersampling.glsl) for both components
+bool standard_error_ok(vec2 mean, vec2 m2, uint n) {
+	vec2 se = sqrt(m2 / float(n - 1u) / float(n));
+	bvec2 relative_ok = bvec2(abs(mean.x) > 1e-12 && se.x / abs(mean.x) <= REL_SE_TOL, abs(mean.y) > 1e-12 && se.y / abs(mean.y) <= REL_SE_TOL);
+	return (se.x <= ABS_SE_TOL || relative_ok.x) && (se.y <= ABS_SE_TOL || relative_ok.y);
+}
+
+// The center samples of the pixel and its neighbors vary more than the tolerances allow for the pixel
+bool is_edge(ivec2 pixel) {
+	ivec2 size = imageSize(center_values);
+	vec2 mean = vec2(0.0);
+	vec2 m2 = vec2(0.0);
+	uint n = 0u;
+	for (int dy = -1; dy <= 1; dy++) {
+		for (int dx = -1; dx <= 1; dx++) {
+			ivec2 neighbor = pixel + ivec2(dx, dy);
+			if (any(lessThan(neighbor, ivec2(0))) || any(greaterThanEqual(neighbor, size))) {
+				continue;
+			}
+			vec2 y = color_value(imageLoad(center_values, neighbor).xy);
+			n++;
+			vec2 delta = y - mean; // Welford
+			mean += delta / float(n);
+			m2 += delta * (y - mean);
+		}
+	}
+	return !standard_error_ok(mean, m2, n);
+}
+
+// (avgSmoothCount, outsideRatio, number of samples) with the NUM_SAMPLES PMJ samples in stages of 2, 4, 8, ..., until the mean changes at most
+// MEAN_DIFF_TOL from the last stage (the center sample for the first one) and the standard error is within the tolerances
+vec3 refine_pixel(ivec2 pixel, vec2 center_value) {
+	dvec2 pixel_center = dvec2(pixel) + 0.5;
+	float sum_count = 0.0;
+	float num_outside = 0.0;
+	vec2 mean = vec2(0.0);
+	vec2 m2 = vec2(0.0);
+	vec2 stage_mean = color_value(center_value);
+	uint n = 0u;
+	while (n < NUM_SAMPLES) {
+		vec2 sample_value = mandelbrotSample(pixel_center + dvec2(sample_offsets[n]));
+		sum_count += sample_value.x;
+		num_outside += sample_value.y;
+		vec2 y = color_value(sample_value);
+		n++;
+		vec2 delta = y - mean;
+		mean += delta / float(n);
+		m2 += delta * (y - mean);
+
+		if (n >= 2u && (n & (n - 1u)) == 0u) { // stage boundary (power of 2)
+			bool mean_stable = all(lessThanEqual(abs(mean - stage_mean), vec2(MEAN_DIFF_TOL)));
+			stage_mean = mean;
+			if (mean_stable && standard_error_ok(mean, m2, n)) {
+				break;
+			}
+		}
+	}
+	return vec3(num_outside > 0.0 ? sum_count / num_outside : 0.0, num_outside / float(n), float(n));
+}
+
+void main() {
+	ivec2 pixel;
+	if (!invocation_pixel(pixel)) {
+		return;
+	}
+	if (adaptive_first_pass) {
+		imageStore(center_values, pixel, vec4(mandelbrotSample(dvec2(pixel) + 0.5), 0.0, 0.0));
+		return;
+	}
+
+	vec2 center_value = imageLoad(center_values, pixel).xy;
+	vec4 result = vec4(center_value.x, center_value.y, 1.0, 1.0); // a single sample is (smoothCount, outside) = (avgSmoothCount, outsideRatio)
+	if (is_edge(pixel)) {
+		result.xyz = refine_pixel(pixel, center_value);
+	}
+	imageStore(pixel_values, pixel, result);
+}
+
+#else
+
+void main() {
+	ivec2 pixel;
+	if (!invocation_pixel(pixel)) {
+		return;
+	}
+	imageStore(pixel_values, pixel, vec4(mandelbrotPixel(vec2(pixel) + 0.5), 0.0, 1.0));
+}
+
+#endif
+
+#endif
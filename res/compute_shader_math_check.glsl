@@ -0,0 +1,62 @@
+#version 430 core
+
+// Evaluates one function of double_math.glsl (or its float counterpart) for MandelbrotMathCheck (src/tools/math_check.cpp)
+// MATH_FUNCTION: 0 sin, 1 cos, 2 exp, 3 log, 4 atan(y, x)
+// With FLOAT_FALLBACK the float function of GLSL is evaluated instead, i.e. what USE_DOUBLE used before double_math.glsl
+
+#include "double_math.glsl"
+
+layout(local_size_x = 64) in;
+
+uniform uint num_values;
+uniform uint repeats;     // for the benchmark, every invocation evaluates the function this many times (1 for the validation)
+uniform double step_size; // argument offset of each repetition
+
+layout(std430, binding = 0) readonly buffer Arguments {
+	dvec2 arguments[]; // (x, y), y only for atan
+};
+
+layout(std430, binding = 1) writeonly buffer Results {
+	double results[]; // sum of all repetitions
+};
+
+double evaluate(double x, double y) {
+	#ifdef FLOAT_FALLBACK
+	#if MATH_FUNCTION == 0
+	return double(sin(float(x)));
+	#elif MATH_FUNCTION == 1
+	return double(cos(float(x)));
+	#elif MATH_FUNCTION == 2
+	return double(exp(float(x)));
+	#elif MATH_FUNCTION == 3
+	return double(log(float(x)));
+	#else
+	return double(atan(float(y), float(x)));
+	#endif
+	#else
+	#if MATH_FUNCTION == 0
+	return dsin(x);
+	#elif MATH_FUNCTION == 1
+	return dcos(x);
+	#elif MATH_FUNCTION == 2
+	return dexp(x);
+	#elif MATH_FUNCTION == 3
+	return dlog(x);
+	#else
+	return datan(y, x);
+	#endif
+	#endif
+}
+
+void main() {
+	uint i = gl_GlobalInvocationID.x;
+	if (i >= num_values) {
+		return;
+	}
+
+	double sum = 0.0LF;
+	for (uint j = 0u; j < repeats; ++j) {
+		sum += evaluate(arguments[i].x + double(j)*step_size, arguments[i].y);
+	}
+	results[i] = sum;
+}
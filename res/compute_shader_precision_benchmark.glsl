@@ -0,0 +1,36 @@
+#version 430 core
+
+// Mandelbrot iterations in the precision of the defines (none, USE_DOUBLE or USE_DOUBLE_FLOAT) for the automatic precision of
+// MandelbrotModel (see src/precision_benchmark.cpp)
+
+#include "complex.glsl"
+
+layout(local_size_x = 64) in;
+
+uniform uint iterations;
+
+layout(std430, binding = 0) writeonly buffer Results {
+	float results[]; // only written, so that the iterations are not optimized away
+};
+
+void main() {
+	uint index = gl_GlobalInvocationID.x;
+	float t = float(index) / float(gl_NumWorkGroups.x * gl_WorkGroupSize.x);
+	vec2 start = vec2(-0.5 + 0.2*t, 0.1*t); // inside the main cardioid, so every invocation runs all iterations
+
+	#ifdef USE_DOUBLE_FLOAT
+	dfcomplex c = dfcomplex(df_from_float(start.x), df_from_float(start.y));
+	dfcomplex z = c;
+	for (uint n = 0u; n < iterations; n++) {
+		z = dfc_add(dfc_sqr(z), c);
+	}
+	results[index] = dfc_to_complex(z).x;
+	#else
+	complex c = complex(start);
+	complex z = c;
+	for (uint n = 0u; n < iterations; n++) {
+		z = cmul(z, z) + c;
+	}
+	results[index] = float(z.x);
+	#endif
+}
@@ -0,0 +1,67 @@
+#ifndef COST_INSTRUMENTATION_INCLUDED
+#define COST_INSTRUMENTATION_INCLUDED
+
+// Diagnostic output of every model (#define COST_INSTRUMENTATION, see Model::setCostInstrumentation)
+// The fragment shaders output a heatmap of the iterations per pixel (Mandelbrot iterations or integration steps) instead of the colors,
+// and the totals of a frame are summed up in an SSBO with atomic counters, which the app reads back in the next frame
+// The work is counted per invocation with COST_COUNT (a no-op without COST_INSTRUMENTATION), e.g. in rk45_advance
+
+#ifdef COST_INSTRUMENTATION
+
+layout(std430, binding = 4) buffer CostCounters { // same layout as read by Model::drawCall
+	uint cost_pixels;
+	uint cost_max_pixel_iterations;
+	uint cost_totals[6];        // 64 bit as (low, high): iterations, rhs evaluations, rejected steps
+	uint cost_status_counts[4]; // integrations per status of rk45 (SUCCESS, ERR_TOO_MANY_STEPS, ERR_TOO_MANY_SAME_STEPS, ERR_TAU_TOO_SMALL)
+};
+
+uniform float cost_heatmap_max; // iterations of a pixel at the end of the heatmap (log scale)
+
+// Work of this invocation
+uint cost_iterations = 0u;
+uint cost_rhs_evaluations = 0u;
+uint cost_rejected_steps = 0u;
+uint cost_status[4] = uint[4](0u, 0u, 0u, 0u);
+uint cost_computed_iterations = 0u; // iterations of this pixel done by a compute shader (only for the heatmap, the compute shader counts the totals)
+
+#define COST_COUNT(counter, n) counter += (n)
+#define COST_COUNT_STATUS(status) cost_status[min((status), 3u)] += 1u
+
+// Adds `value` to the 64 bit total i, the carry goes to the high word
+#define COST_ADD_TOTAL(i, value) if (atomicAdd(cost_totals[2*(i)], (value)) > 0xffffffffu - (value)) { atomicAdd(cost_totals[2*(i) + 1], 1u); }
+
+// Adds the work of this invocation to the totals
+void cost_record_totals() {
+	if (cost_iterations > 0u) {
+		COST_ADD_TOTAL(0, cost_iterations);
+	}
+	if (cost_rhs_evaluations > 0u) {
+		COST_ADD_TOTAL(1, cost_rhs_evaluations);
+	}
+	if (cost_rejected_steps > 0u) {
+		COST_ADD_TOTAL(2, cost_rejected_steps);
+	}
+	for (uint i = 0u; i < 4u; ++i) {
+		if (cost_status[i] > 0u) {
+			atomicAdd(cost_status_counts[i], cost_status[i]);
+		}
+	}
+}
+
+// Adds a pixel to the counters and returns its heatmap color (black, red, yellow, white)
+vec4 cost_record_pixel(uint iterations) {
+	atomicAdd(cost_pixels, 1u);
+	atomicMax(cost_max_pixel_iterations, iterations);
+
+	float value = log2(1.0 + float(iterations)) / log2(1.0 + max(cost_heatmap_max, 1.0));
+	return vec4(clamp(vec3(3.0*value, 3.0*value - 1.0, 3.0*value - 2.0), 0.0, 1.0), 1.0);
+}
+
+#else
+
+#define COST_COUNT(counter, n)
+#define COST_COUNT_STATUS(status)
+
+#endif
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef DOUBLE_FLOAT_INCLUDED
+#define DOUBLE_FLOAT_INCLUDED
+
+// Double-float arithmetic: a number is the unevaluated sum hi + lo of two floats (vec2(hi, lo)), which gives about 48 bits of mantissa
+// On most consumer GPUs fp64 runs at 1/32 to 1/64 of the fp32 rate, a double-float operation only needs a few fp32 operations
+// The algorithms are the error-free transformations of the QD library (two-sum, two-product with Dekker's split)
+// Everything is `precise`, otherwise the compiler may reassociate the sums (e.g. (a + b) - a = b) and lose the low parts
+// The exponent range stays the one of float, so zoomScale must stay above about 1e-30
+
+// a + b = s + e exactly
+vec2 df_two_sum(float a, float b) {
+	precise float s = a + b;
+	precise float bb = s - a;
+	precise float e = (a - (s - bb)) + (b - bb);
+	return vec2(s, e);
+}
+
+// Same as df_two_sum for |a| >= |b|
+vec2 df_quick_two_sum(float a, float b) {
+	precise float s = a + b;
+	precise float e = b - (s - a);
+	return vec2(s, e);
+}
+
+// a = hi + lo with 12 bits each, so products of the parts are exact
+vec2 df_split(float a) {
+	precise float t = 4097.0 * a; // 2^12 + 1
+	precise float hi = t - (t - a);
+	precise float lo = a - hi;
+	return vec2(hi, lo);
+}
+
+// a * b = p + e exactly
+// Not with fma(a, b, -p), because fma may be evaluated as a*b - p even for precise (e.g. llvmpipe), then e is always 0
+vec2 df_two_prod(float a, float b) {
+	precise float p = a * b;
+	vec2 as = df_split(a);
+	vec2 bs = df_split(b);
+	precise float e = ((as.x*bs.x - p) + as.x*bs.y + as.y*bs.x) + as.y*bs.y;
+	return vec2(p, e);
+}
+
+vec2 df_from_float(float a) {
+	return vec2(a, 0.0);
+}
+
+vec2 df_add(vec2 a, vec2 b) {
+	vec2 s = df_two_sum(a.x, b.x);
+	vec2 t = df_two_sum(a.y, b.y);
+	precise float e = s.y + t.x;
+	s = df_quick_two_sum(s.x, e);
+	e = s.y + t.y;
+	return df_quick_two_sum(s.x, e);
+}
+
+vec2 df_sub(vec2 a, vec2 b) {
+	return df_add(a, -b);
+}
+
+vec2 df_mul(vec2 a, vec2 b) {
+	vec2 p = df_two_prod(a.x, b.x);
+	precise float e = p.y + (a.x*b.y + a.y*b.x);
+	return df_quick_two_sum(p.x, e);
+}
+
+vec2 df_mul_f(vec2 a, float b) {
+	vec2 p = df_two_prod(a.x, b);
+	precise float e = p.y + a.y*b;
+	return df_quick_two_sum(p.x, e);
+}
+
+vec2 df_sqr(vec2 a) {
+	vec2 p = df_two_prod(a.x, a.x);
+	precise float e = p.y + 2.0*a.x*a.y;
+	return df_quick_two_sum(p.x, e);
+}
+
+vec2 df_div_f(vec2 a, float b) {
+	precise float q1 = a.x / b;
+	vec2 r = df_sub(a, df_two_prod(q1, b));
+	precise float q2 = r.x / b;
+	return df_quick_two_sum(q1, q2);
+}
+
+#endif
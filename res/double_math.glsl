@@ -0,0 +1,188 @@
+#ifndef DOUBLE_MATH_INCLUDED
+#define DOUBLE_MATH_INCLUDED
+
+// Transcendental functions for double precision, GLSL only provides basic arithmetic, sqrt and fma for doubles
+// Range reduction (Cody-Waite with fma) and the minimax polynomials of fdlibm, the error is about 1 ulp
+// The reductions are `precise`, otherwise the compiler may merge the parts of the constants again (e.g. Mesa turns
+// x - k*hi - k*lo into x - k*(hi + lo), which costs up to 80 ulp in dexp)
+// Validated against libm and benchmarked against the float functions with MandelbrotMathCheck (see src/tools/math_check.cpp)
+
+const double D_PI = 3.14159265358979311600LF;
+const double D_PI_2 = 1.57079632679489655800LF;
+const double D_LN2_HI = 6.93147180369123816490e-01LF; // ln(2) in two parts, k*D_LN2_HI is exact
+const double D_LN2_LO = 1.90821492927058770002e-10LF;
+
+double d_infinity(bool negative) {
+	return packDouble2x32(uvec2(0u, negative ? 0xfff00000u : 0x7ff00000u));
+}
+
+double d_nan() {
+	return packDouble2x32(uvec2(0u, 0x7ff80000u));
+}
+
+// sin and cos of x in [-pi/4, pi/4]
+double d_kernel_sin(double x) {
+	double z = x*x;
+	double r = fma(z, fma(z, fma(z, fma(z, fma(z, 1.58969099521155010221e-10LF, -2.50507602534068634195e-08LF),
+		2.75573137070700676789e-06LF), -1.98412698298579493134e-04LF), 8.33333333332248946124e-03LF), -1.66666666666666324348e-01LF);
+	return fma(x*z, r, x);
+}
+
+double d_kernel_cos(double x) {
+	double z = x*x;
+	double r = z*fma(z, fma(z, fma(z, fma(z, fma(z, -1.13596475577881948265e-11LF, 2.08757232129817482790e-09LF),
+		-2.75573143513906633035e-07LF), 2.48015872894767294178e-05LF), -1.38888888888741095749e-03LF), 4.16666666666666019037e-02LF);
+	return 1.0LF - (0.5LF*z - z*r);
+}
+
+// x = n*pi/2 + r with r in [-pi/4, pi/4], returns r, accurate for |x| < 2^20*pi/2 (pi/2 in three parts, n*part is exact)
+double d_reduce_pi_2(double x, out int n) {
+	double k = roundEven(x * 6.36619772367581382433e-01LF);
+	n = int(k);
+	precise double r = fma(-k, 1.57079632673412561417e+00LF, x);
+	r = fma(-k, 6.07710050630396597660e-11LF, r);
+	return fma(-k, 2.02226624871116645580e-21LF, r);
+}
+
+double dsin(double x) {
+	int n;
+	double r = d_reduce_pi_2(x, n);
+	double s = (n & 1) == 0 ? d_kernel_sin(r) : d_kernel_cos(r);
+	return (n & 2) == 0 ? s : -s;
+}
+
+double dcos(double x) {
+	int n;
+	double r = d_reduce_pi_2(x, n);
+	double c = (n & 1) == 0 ? d_kernel_cos(r) : d_kernel_sin(r);
+	return ((n + 1) & 2) == 0 ? c : -c;
+}
+
+double dexp(double x) {
+	if (x > 709.78LF) {
+		return d_infinity(false);
+	}
+	if (x < -745.2LF) {
+		return 0.0LF;
+	}
+
+	// x = k*ln(2) + r with |r| <= ln(2)/2, exp(x) = 2^k * exp(r)
+	double k = roundEven(x * 1.44269504088896338700LF);
+	precise double r = fma(-k, D_LN2_HI, x);
+	r = fma(-k, D_LN2_LO, r);
+
+	// Taylor polynomial of degree 13, the remainder is below 4e-18 for |r| <= ln(2)/2
+	double p = 1.0LF / 6227020800.0LF;
+	p = fma(p, r, 1.0LF / 479001600.0LF);
+	p = fma(p, r, 1.0LF / 39916800.0LF);
+	p = fma(p, r, 1.0LF / 3628800.0LF);
+	p = fma(p, r, 1.0LF / 362880.0LF);
+	p = fma(p, r, 1.0LF / 40320.0LF);
+	p = fma(p, r, 1.0LF / 5040.0LF);
+	p = fma(p, r, 1.0LF / 720.0LF);
+	p = fma(p, r, 1.0LF / 120.0LF);
+	p = fma(p, r, 1.0LF / 24.0LF);
+	p = fma(p, r, 1.0LF / 6.0LF);
+	p = fma(p, r, 0.5LF);
+	p = fma(p, r*r, r) + 1.0LF;
+
+	// 2^k in two factors, since 2^k alone is not representable for the subnormal results
+	int e = int(k);
+	return ldexp(ldexp(p, e / 2), e - e / 2);
+}
+
+double dlog(double x) {
+	if (x <= 0.0LF) {
+		return x == 0.0LF ? d_infinity(true) : d_nan();
+	}
+	if (isinf(x) || isnan(x)) {
+		return x;
+	}
+
+	// x = 2^k * (1 + f) with 1 + f in [sqrt(2)/2, sqrt(2))
+	int k;
+	double m = frexp(x, k);
+	if (m < 7.07106781186547524401e-01LF) {
+		m *= 2.0LF;
+		k -= 1;
+	}
+	double f = m - 1.0LF;
+
+	// log(1 + f) = 2*atanh(s) with s = f/(2 + f), polynomial in s^2
+	double s = f / (2.0LF + f);
+	double z = s*s;
+	double R = z*fma(z, fma(z, fma(z, fma(z, fma(z, fma(z, 1.479819860511658591e-01LF, 1.531383769920937332e-01LF),
+		1.818357216161805012e-01LF), 2.222219843214978396e-01LF), 2.857142874366239149e-01LF), 3.999999999940941908e-01LF), 6.666666666666735130e-01LF);
+	double hfsq = 0.5LF*f*f;
+	double dk = double(k);
+	precise double result = dk*D_LN2_HI - ((hfsq - (s*(hfsq + R) + dk*D_LN2_LO)) - f);
+	return result;
+}
+
+// atan of x in [0, inf), 7/16 and the atan of four breakpoints are the reduction of fdlibm
+double d_atan_positive(double x) {
+	const double atan_hi[4] = double[4](4.63647609000806093515e-01LF, 7.85398163397448278999e-01LF, 9.82793723247329054082e-01LF, 1.57079632679489655800e+00LF);
+	const double atan_lo[4] = double[4](2.26987774529616870924e-17LF, 3.06161699786838301793e-17LF, 1.39033110312309984516e-17LF, 6.12323399573676603587e-17LF);
+
+	int id = -1;
+	if (x >= 0.4375LF) {
+		if (x < 1.1875LF) {
+			if (x < 0.6875LF) {
+				id = 0;
+				x = (2.0LF*x - 1.0LF) / (2.0LF + x);
+			} else {
+				id = 1;
+				x = (x - 1.0LF) / (x + 1.0LF);
+			}
+		} else if (x < 2.4375LF) {
+			id = 2;
+			x = (x - 1.5LF) / (1.0LF + 1.5LF*x);
+		} else {
+			id = 3;
+			x = -1.0LF / x;
+		}
+	}
+
+	double z = x*x;
+	double w = z*z;
+	double s1 = z*fma(w, fma(w, fma(w, fma(w, fma(w, 1.62858201153657823623e-02LF, 4.97687799461593236017e-02LF),
+		6.66107313738753120669e-02LF), 9.09088713343650656196e-02LF), 1.42857142725034663711e-01LF), 3.33333333333329318027e-01LF);
+	double s2 = w*fma(w, fma(w, fma(w, fma(w, -3.65315727442169155270e-02LF, -5.83357013379057348645e-02LF),
+		-7.69187620504482999495e-02LF), -1.11111104054623557880e-01LF), -1.99999999998764832476e-01LF);
+	if (id < 0) {
+		return x - x*(s1 + s2);
+	}
+	precise double result = atan_hi[id] - ((x*(s1 + s2) - atan_lo[id]) - x);
+	return result;
+}
+
+double datan(double y, double x) {
+	if (x == 0.0LF && y == 0.0LF) {
+		return 0.0LF;
+	}
+	double a = abs(y) <= abs(x) ? d_atan_positive(abs(y) / abs(x)) : D_PI_2 - d_atan_positive(abs(x) / abs(y));
+	if (x < 0.0LF) {
+		a = D_PI - a;
+	}
+	return y < 0.0LF ? -a : a;
+}
+
+// Integer exponents (e.g. rpow(x, 2)) by repeated squaring, which also works for negative x
+double dpow(double x, double y) {
+	if (y == roundEven(y) && abs(y) <= 64.0LF) {
+		int n = int(abs(y));
+		double result = 1.0LF;
+		double base = x;
+		while (n > 0) {
+			if ((n & 1) != 0) {
+				result *= base;
+			}
+			base *= base;
+			n >>= 1;
+		}
+		return y < 0.0LF ? 1.0LF / result : result;
+	}
+	return dexp(y * dlog(x));
+}
+
+#endif
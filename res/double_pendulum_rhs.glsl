@@ -38,6 +38,14 @@ void dH(rvec2 q, rvec2 p, out rvec2 dH_dq, out rvec2 dH_dp) {
 	return;
 }
 
+// Conjugated momentums p = M(q) v (see DoublePendulum.md)
+rvec2 momentum(rvec2 q, rvec2 v) {
+	return rvec2(
+		(m1 + m2)*rpow(l1, 2)*v[0] + l1*l2*m2*rcos(q[0] - q[1])*v[1],
+		l1*l2*m2*rcos(q[0] - q[1])*v[0] + rpow(l2, 2)*m2*v[1]
+	);
+}
+
 rvec4 rhs(rvec4 y) {
 	real q1 = y[0];
 	real q2 = y[1];
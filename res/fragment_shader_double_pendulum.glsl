@@ -7,6 +7,15 @@
 
 #define RK45_DISABLE_ARR_METHODS // We only need vector methods (since 4 dimensions fit in one vector)
 #include "rk45.glsl"
+#include "symplectic.glsl"
+
+#if RK_METHOD == RK_VERLET || RK_METHOD == RK_YOSHIDA4
+#define integrate symplectic
+#define integrate_continue symplectic_continue
+#else
+#define integrate rk45
+#define integrate_continue rk45_continue
+#endif
 
 uniform float v1_start;
 uniform float v2_start;
@@ -14,10 +23,55 @@ uniform float v2_start;
 uniform sampler2D colormap;
 
 
+#if defined(COMPUTE_SAMPLES) && SUPER_SAMPLING != 0
+#define USE_COMPUTED_SAMPLES // integrated by compute_shader_double_pendulum.glsl before the draw call
+#elif defined(INCREMENTAL) && SUPER_SAMPLING != 0 && !defined(SCALAR_FIELD_OUTPUT)
+#define USE_INCREMENTAL_STATE
+#endif
+
+#if defined(USE_COMPUTED_SAMPLES) || defined(USE_INCREMENTAL_STATE)
+// State of every sample of every pixel (layer i is sample i)
+layout(binding = 0, rgba32f) uniform image2DArray state_y; // (q1, q2, v1, v2)
+layout(binding = 1, rgba32f) uniform image2DArray state_t; // (t, tau, status, steps of the compute shader)
+#endif
+
+#ifdef USE_INCREMENTAL_STATE
+// The state is kept between frames, so that a larger t_end only integrates the difference
+uniform bool reset_state; // start all samples at t0 again (anything but a larger t_end changed)
+
+// Continues the integration of a sample from its saved state (or from y_start after a reset) to t_end
+// Samples stopped by ERR_TOO_MANY_STEPS continue in the next frame (the status is only final for the other errors)
+rvec4 integrate_incremental(ivec3 texel, rvec4 y_start, out uint status) {
+	rvec4 y = y_start;
+	vec4 time_state = vec4(float(t0), 0.0, float(SUCCESS), 0.0); // tau = 0.0 guesses the initial step size
+	if (!reset_state) {
+		y = rvec4(imageLoad(state_y, texel));
+		time_state = imageLoad(state_t, texel);
+	}
+
+	real t = time_state.x;
+	real tau = time_state.y;
+	status = uint(time_state.z);
+	if (status == SUCCESS || status == ERR_TOO_MANY_STEPS) {
+		uint step_counter;
+		uint same_step_counter;
+		y = integrate_continue(y, t, tau, t_end, status, step_counter, same_step_counter);
+	}
+
+	imageStore(state_y, texel, vec4(y));
+	imageStore(state_t, texel, vec4(float(t), float(tau), float(status), 0.0));
+	return y;
+}
+#endif
+
+
 #if SUPER_SAMPLING != 0
 
 // Static super sampling
 #include "static_supersampling.glsl"
+#ifdef USE_COMPUTED_SAMPLES
+#include "shared_samples.glsl"
+#endif
 
 #else
 
@@ -35,7 +89,7 @@ real evaluate(dvec2 pixelCoord) {
 	uint status;
 	uint step_counter;
 	uint same_step_counter;
-	rvec4 y = rk45(y_start, t0, t_end, status, step_counter, same_step_counter);
+	rvec4 y = integrate(y_start, t0, t_end, status, step_counter, same_step_counter);
 	// status checks are useless here, since one cannot abort the fragment shader with an "error color" anyway
 
 	real q1 = y[0];
@@ -60,8 +114,27 @@ float remap(float x, float a, float b, float c, float d) {
 }
 
 
+#ifdef COST_INSTRUMENTATION
+#define main model_main // the heatmap replaces the output, see the end of the file
+#endif
+
 out vec4 fragColor;
 void main() {
+	#if defined(SCALAR_FIELD_OUTPUT) && SCALAR_FIELD_OUTPUT == 2
+	// Raw full state (q1, q2, v1, v2) at t_end, taken at the pixel center (averaging the states of different trajectories is meaningless)
+	{
+		rvec2 planeCoord = rvec2(pixelCoordToPlaneCoord(dvec2(gl_FragCoord.xy)));
+		rvec4 y_start = rvec4(planeCoord.x, planeCoord.y, v1_start, v2_start);
+
+		uint status;
+		uint step_counter;
+		uint same_step_counter;
+		rvec4 y = integrate(y_start, t0, t_end, status, step_counter, same_step_counter);
+		fragColor = status == SUCCESS ? vec4(y) : vec4(uintBitsToFloat(0x7fc00000u)); // NaN marks failed integrations
+		return;
+	}
+	#endif
+
 	// Adaptive super sampling
 	#if SUPER_SAMPLING == 0
 	real result = evaluateWithAdaptiveSuperSampling(dvec2(gl_FragCoord.xy));
@@ -71,7 +144,27 @@ void main() {
 	// Static super sampling
 	dvec2 pixelCoord = dvec2(gl_FragCoord.xy); // gl_FragCoord (vec4) gives the fragments center position in window coordinates, e.g. the lower left is vec4(0.5, 0.5, _, _) (0.5 because center)
 	real result = 0.0;
-	for (uint i = 0; i < NUM_SAMPLES; ++i) {
+	real weight_sum = 0.0;
+	#ifdef USE_SHARED_SAMPLES
+	const uint NUM_FILTER_SAMPLES = 9u*LATTICE_SAMPLES; // lattices of the pixel and its 8 neighbors
+	#else
+	const uint NUM_FILTER_SAMPLES = NUM_SAMPLES;
+	#endif
+	for (uint i = 0; i < NUM_FILTER_SAMPLES; ++i) {
+		#ifdef USE_SHARED_SAMPLES
+		ivec2 neighbor = ivec2((i / LATTICE_SAMPLES) % 3u, (i / LATTICE_SAMPLES) / 3u) - 1;
+		uint layer = i % LATTICE_SAMPLES;
+		real weight = lattice_weight(vec2(neighbor) + lattice_offset(layer));
+		if (weight == 0.0) {
+			continue;
+		}
+		#else
+		real weight = 1.0;
+		#endif
+
+		// Start value, only where this shader integrates (the compute shader integrated the others, and with USE_SHARED_SAMPLES
+		// i goes beyond the NUM_SAMPLES entries of sample_offsets)
+		#if !defined(USE_SHARED_SAMPLES) && !defined(USE_COMPUTED_SAMPLES)
 		rvec2 planeCoord = rvec2(pixelCoordToPlaneCoord(pixelCoord + sample_offsets[i]));
 		
 		rvec4 y_start = rvec4(
@@ -95,11 +188,41 @@ void main() {
 		// 	q2_start * v1_start,
 		// 	q2_start * v2_start
 		// );
+		#endif
 
 		uint status;
+		#if defined(USE_SHARED_SAMPLES)
+		ivec3 texel = ivec3(ivec2(gl_FragCoord.xy) + neighbor + LATTICE_APRON, layer);
+		rvec4 y = rvec4(imageLoad(state_y, texel));
+		vec4 time_state = imageLoad(state_t, texel);
+		status = uint(time_state.z);
+		if (neighbor == ivec2(0)) {
+			COST_COUNT(cost_computed_iterations, uint(time_state.w)); // the lattice of this pixel
+		} else if (status != SUCCESS) {
+			continue; // failed samples of neighbors don't paint their error color into this pixel
+		}
+		#elif defined(USE_COMPUTED_SAMPLES)
+		ivec3 texel = ivec3(ivec2(gl_FragCoord.xy), i);
+		rvec4 y = rvec4(imageLoad(state_y, texel));
+		vec4 time_state = imageLoad(state_t, texel);
+		status = uint(time_state.z);
+		COST_COUNT(cost_computed_iterations, uint(time_state.w));
+		#elif defined(USE_INCREMENTAL_STATE)
+		rvec4 y = integrate_incremental(ivec3(ivec2(gl_FragCoord.xy), i), y_start, status);
+		if (status == ERR_TOO_MANY_STEPS) {
+			status = SUCCESS; // not done yet, shows the state reached so far
+		}
+		#else
 		uint step_counter;
 		uint same_step_counter;
-		rvec4 y = rk45(y_start, t0, t_end, status, step_counter, same_step_counter);
+		rvec4 y = integrate(y_start, t0, t_end, status, step_counter, same_step_counter);
+		#endif
+		#ifdef SCALAR_FIELD_OUTPUT
+		if (status != SUCCESS) {
+			fragColor = vec4(0.0, float(status), 0.0, 0.0); // error colors are chosen when recoloring
+			return;
+		}
+		#endif
 		if (status == ERR_TOO_MANY_STEPS) {
 			fragColor = vec4(1.0, 0.7, 0.0, 1.0); // orange
 			return;
@@ -120,10 +243,16 @@ void main() {
 		real y1 = l1 * -rcos(q1);
 		real x2 = x1 + l2 * rsin(q2);
 		real y2 = y1 + l2 * -rcos(q2);
-		result += y2;
+		result += weight * y2;
+		weight_sum += weight;
 	}
-	result /= NUM_SAMPLES;
+	result /= weight_sum;
+
+	#endif
 
+	#ifdef SCALAR_FIELD_OUTPUT
+	fragColor = vec4(float(result), 0.0, 0.0, 0.0); // raw y2 and status SUCCESS (rendered to a float texture), colored later on the CPU
+	return;
 	#endif
 
 	float value = remap(float(result), -(l1+l2), l1+l2, 0.0, 1.0);
@@ -137,3 +266,12 @@ void main() {
 
 	fragColor = texture(colormap, vec2(value, 0.5));
 }
+
+#ifdef COST_INSTRUMENTATION
+#undef main
+void main() {
+	model_main();
+	cost_record_totals();
+	fragColor = cost_record_pixel(cost_iterations + cost_computed_iterations);
+}
+#endif
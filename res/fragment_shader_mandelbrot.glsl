@@ -1,10 +1,7 @@
 #version 430 core
 
-#include "complex.glsl"
-#include "zooming_and_tiling.glsl"
-#include "static_supersampling.glsl"
+#include "mandelbrot_pixel.glsl"
 
-uniform uint maxIterations = 400;
 uniform float colorScale = 50.0; // E.g. 50.0 means that the value range [0, 50] contains the entire colormap. Cyclic colormaps repeat, others are clamped. 
 uniform uint sliceValue = 0;
 uniform float sliceFactor = 0.5;
@@ -13,19 +10,10 @@ uniform sampler2D colormap;
 
 out vec4 fragColor;
 
-uint calcFractal(complex start, out complex escape) {
-	complex current = start;
-	for (uint n = 1u; n < maxIterations + 1u; n++) {
-		if (dot(current, current) > 65536.0) { // Divergence check // 4.0 would be enough, but higher values improve the smoothing
-			escape = current;
-			return n;
-		}
-		current = cmul(current, current) + start;
-	}
-
-	escape = current;
-	return 0;
-}
+#if (defined(MARIANI_SILVER) || defined(COMPUTE_PIXELS) || defined(PROGRESSIVE) || SUPER_SAMPLING == 0) && !defined(COST_INSTRUMENTATION)
+#define USE_COMPUTED_PIXELS // computed by compute_shader_mandelbrot.glsl before the draw call
+layout(binding = 0, rgba32f) uniform readonly image2D pixel_values; // (avgSmoothCount, outsideRatio, samples of adaptive super sampling or progressive accumulation, computed)
+#endif
 
 // #if FLOW_COLOR_TYPE == 0
 
@@ -75,31 +63,32 @@ uint calcFractal(complex start, out complex escape) {
 
 // #endif
 
+#ifdef COST_INSTRUMENTATION
+#define main model_main // the heatmap replaces the output, see the end of the file
+#endif
+
 void main() {
-	dvec2 pixelCoord = dvec2(gl_FragCoord.xy); // gl_FragCoord (vec4) gives the fragments center position in window coordinates, e.g. the lower left is vec4(0.5, 0.5, _, _)
-
-	uint numInside = 0;
-	float avgSmoothCount = 0.0;
-	for (uint i = 0; i < NUM_SAMPLES; ++i) {
-		complex start = complex(pixelCoordToPlaneCoord(pixelCoord + sample_offsets[i]));
-		complex escape;
-		uint count = calcFractal(start, escape);
-
-		#ifdef USE_SMOOTHING
-			float smoothCount = float(count) + 1.0 - log2(log(float(max(length(escape), 2.0)))); // Specifically for Mandelbrot set
-		#else
-			float smoothCount = float(count);
-		#endif
-
-		if (count > 0) { // not inside the mandelbrot
-			avgSmoothCount += smoothCount;
-		} else {
-			numInside += 1;
-		}
-	}
-	avgSmoothCount /= (NUM_SAMPLES - numInside); // Average of samples outside the mandelbrot
-	
+	#ifdef USE_COMPUTED_PIXELS
+	vec2 pixel = imageLoad(pixel_values, ivec2(gl_FragCoord.xy)).xy;
+	#else
+	vec2 pixel = mandelbrotPixel(gl_FragCoord.xy); // gl_FragCoord (vec4) gives the fragments center position in window coordinates, e.g. the lower left is vec4(0.5, 0.5, _, _)
+	#endif
+	float avgSmoothCount = pixel.x;
+	float outsideRatio = pixel.y;
+
+	#ifdef SCALAR_FIELD_OUTPUT
+	fragColor = vec4(avgSmoothCount, outsideRatio, 0.0, 0.0); // raw values (rendered to a float texture), colored later on the CPU
+	#else
 	float value = avgSmoothCount / colorScale;
-	float outsideRatio = (NUM_SAMPLES - numInside) / NUM_SAMPLES;
 	fragColor = vec4(outsideRatio * texture(colormap, vec2(value, 0.5)).xyz, 1.0); // interpolate between outside color and implicit black
+	#endif
+}
+
+#ifdef COST_INSTRUMENTATION
+#undef main
+void main() {
+	model_main();
+	cost_record_totals();
+	fragColor = cost_record_pixel(cost_iterations);
 }
+#endif
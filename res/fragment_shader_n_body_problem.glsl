@@ -1,56 +1,19 @@
 #version 430 core
 
-uniform uvec2 windowSize;
-uniform double zoomScale;
-uniform dvec2 numberStart;
-
-uniform float v1_start;
-uniform float v2_start;
-
 #include "real.glsl"
+#include "zooming_and_tiling.glsl"
 #include "colormaps.glsl"
 #include "n_body_problem_rhs.glsl" // Also defines D and N
 #define RK45_DISABLE_VEC_METHODS // we only need array methods (since a vector can be at most 4-dimensional)
 #include "rk45.glsl"
 
-out vec4 fragColor;
+// Start positions and momenta of all N bodies (the first D components are used)
+// The position of the last body in the first two dimensions is the plane coordinate of the pixel
+uniform vec3 q_start[N];
+uniform vec3 p_start[N];
+uniform float distance_scale; // distance between body 0 and 1 at t_end, which is mapped to the end of the colormap
 
-// rvec4 solve_semi_explicit_euler(
-// 	real q1_start, real q2_start
-// ) {
-// 	const real tau = real(t_end) / maxIterations;
-// 	rvec4 y = rvec4(
-// 		q1_start,
-// 		q2_start,
-// 		0.5,
-// 		-0.5
-// 	);
-
-// 	for (int n = 0; n < maxIterations; ++n) {
-// 		y.xy = y.xy + tau * rhs_1(y);
-// 		y.zw = y.zw + tau * rhs_2(y);
-// 	}
-
-// 	return y;
-// }
-
-
-// rvec4 solve_explicit_euler(
-// 	real q1_start, real q2_start
-// ) {
-// 	const real tau = real(t_end) / maxIterations;
-// 	rvec4 y = rvec4(
-// 		q1_start,
-// 		q2_start,
-// 		0.5,
-// 		-0.5
-// 	);
-
-// 	for (int n = 0; n < maxIterations; ++n) {
-// 		y = y + tau * rhs(y);
-// 	}
-// 	return y;
-// }
+uniform sampler2D colormap;
 
 
 // map interval (a, b) to (c, d)
@@ -58,44 +21,94 @@ float remap(float x, float a, float b, float c, float d) {
     return c + (x - a) * (d - c) / (b - a);
 }
 
-void main() {
-	real r = real(zoomScale * (double(gl_FragCoord.x) + 0.5) / windowSize.x + numberStart.x);
-	real s = real((zoomScale * (double(gl_FragCoord.y) + 0.5) + numberStart.y * windowSize.y) / windowSize.x);
+#if D == 1
+#define TO_RVECD(v) real((v).x)
+#elif D == 2
+#define TO_RVECD(v) rvecd((v).xy)
+#else
+#define TO_RVECD(v) rvecd(v)
+#endif
 
-	// Map parameters r, s to an initial state describing N bodies in a D-dimensional space and their momenta
-	rvecd y_start[M] = rvecd[M](
-		rvecd(0.0, 0.0, 0.0),     // position q[0]
-		rvecd(1.2, 0.0, 0.0),     // position q[1]
-		rvecd(1.2, s*1.2, r*1.2), // position q[2]
-		rvecd(0.0, 1.2, 0.0),     // momentum p[0]
-		rvecd(0.0, -1.2, 0.0),    // momentum p[1]
-		rvecd(0.0, 0.0, -0.6)    // momentum p[2]	
-	);
+// Integrates the bodies starting at a pixel-space coordinate, returns the distance between body 0 and 1 at t_end
+real evaluate(dvec2 pixelCoord, out uint status) {
+	rvec2 planeCoord = rvec2(pixelCoordToPlaneCoord(pixelCoord));
 
+	// Position of i-th body q[i] = y[i]
+	// Momentum of i-th body p[i] = y[N+i]
+	rvecd y_start[M];
+	for (int i = 0; i < N; ++i) {
+		y_start[i] = TO_RVECD(q_start[i]);
+		y_start[N+i] = TO_RVECD(p_start[i]);
+	}
+	#if D == 1
+	y_start[N-1] = planeCoord.x;
+	#else
+	y_start[N-1][0] = planeCoord.x;
+	y_start[N-1][1] = planeCoord.y;
+	#endif
 
-	uint status;
 	uint step_counter;
 	uint same_step_counter;
 	rvecd y[M];
 	rk45_arr(y_start, t0, t_end, status, step_counter, same_step_counter, y);
-	if (status == ERR_TOO_MANY_STEPS) {
-		fragColor = vec4(1.0, 0.7, 0.0, 1.0); // orange
-		return;
-	} else if (status == ERR_TOO_MANY_SAME_STEPS) { // did not reach end after MAX_STEPS
-		fragColor = vec4(1.0, 0.0, 0.7, 1.0); // purple
-		return;
-	} else if (status == ERR_TAU_TOO_SMALL) {
-		fragColor = vec4(1.0, 1.0, 1.0, 1.0); // white
-		return;
-	}
+	return length(y[0] - y[1]);
+}
 
-	// Position of i-th body q[i] = y[i]
-	// Momentum of i-th body p[i] = y[N+i]
 
-	float value = remap(float(length(y[0] - y[1])), 0.0, 30.0, 0.0, 1.0);
-	// float value = remap(float(y[0].x), -10.0, 10.0, 0.0, 1.0);
-	// float value = remap(float(step_counter), 0.0, float(MAX_STEPS / 3.0), 0.0, 1.0);
+#if SUPER_SAMPLING != 0
+
+// Static super sampling
+#include "static_supersampling.glsl"
 
+#else
 
-	fragColor = viridis(value);
+// Adaptive super sampling
+real evaluate(dvec2 pixelCoord) {
+	uint status;
+	return evaluate(pixelCoord, status); // status checks are useless here (see fragment_shader_double_pendulum.glsl)
+}
+#include "adaptive_supersampling.glsl"
+
+#endif
+
+
+#ifdef COST_INSTRUMENTATION
+#define main model_main // the heatmap replaces the output, see the end of the file
+#endif
+
+out vec4 fragColor;
+void main() {
+	#if SUPER_SAMPLING == 0
+	real result = evaluateWithAdaptiveSuperSampling(dvec2(gl_FragCoord.xy));
+
+	#else
+	real result = 0.0;
+	for (uint i = 0; i < NUM_SAMPLES; ++i) {
+		uint status;
+		result += evaluate(dvec2(gl_FragCoord.xy) + sample_offsets[i], status);
+		if (status == ERR_TOO_MANY_STEPS) {
+			fragColor = vec4(1.0, 0.7, 0.0, 1.0); // orange
+			return;
+		} else if (status == ERR_TOO_MANY_SAME_STEPS) { // did not reach end after MAX_STEPS
+			fragColor = vec4(1.0, 0.0, 0.7, 1.0); // purple
+			return;
+		} else if (status == ERR_TAU_TOO_SMALL) {
+			fragColor = vec4(1.0, 0.7, 0.7, 1.0); // light red
+			return;
+		}
+	}
+	result /= NUM_SAMPLES;
+	#endif
+
+	float value = remap(float(result), 0.0, distance_scale, 0.0, 1.0);
+	fragColor = texture(colormap, vec2(value, 0.5));
+}
+
+#ifdef COST_INSTRUMENTATION
+#undef main
+void main() {
+	model_main();
+	cost_record_totals();
+	fragColor = cost_record_pixel(cost_iterations);
 }
+#endif
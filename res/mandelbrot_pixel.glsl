@@ -0,0 +1,207 @@
+#ifndef MANDELBROT_PIXEL_INCLUDED
+#define MANDELBROT_PIXEL_INCLUDED
+
+// Iteration and super sampling of one pixel, shared by fragment_shader_mandelbrot.glsl and compute_shader_mandelbrot.glsl
+
+#include "complex.glsl"
+#include "zooming_and_tiling.glsl"
+#include "static_supersampling.glsl"
+#include "cost_instrumentation.glsl"
+
+uniform uint maxIterations = 400;
+
+// Iterated formula, same values as FractalFormula (src/fractal_formula.h), every formula (and power) is its own shader variant
+#define FORMULA_MANDELBROT 0
+#define FORMULA_MULTIBROT 1
+#define FORMULA_BURNING_SHIP 2
+#define FORMULA_TRICORN 3
+#define FORMULA_JULIA 4
+#ifndef FORMULA
+#define FORMULA FORMULA_MANDELBROT
+#endif
+#if FORMULA != FORMULA_MULTIBROT
+#undef FORMULA_POWER
+#define FORMULA_POWER 2
+#endif
+
+#if FORMULA == FORMULA_JULIA
+uniform dvec2 juliaConstant = dvec2(-0.8, 0.156); // k, the pixel is the start value
+#ifdef USE_DOUBLE_FLOAT
+uniform vec4 juliaConstantSplit = vec4(-0.8, 0.0, 0.156, 0.0); // juliaConstant as hi/lo float pairs
+#endif
+#endif
+
+// z -> formula(z) + c
+complex formulaStep(complex z, complex c) {
+	#if FORMULA == FORMULA_MULTIBROT
+	complex power = z;
+	for (int i = 1; i < FORMULA_POWER; i++) { // constant trip count, unrolled by the compiler
+		power = cmul(power, z);
+	}
+	return power + c;
+	#else
+	#if FORMULA == FORMULA_BURNING_SHIP
+	z = abs(z);
+	#elif FORMULA == FORMULA_TRICORN
+	z.y = -z.y;
+	#endif
+	return cmul(z, z) + c;
+	#endif
+}
+
+// log_d(x) with d = FORMULA_POWER, for the smoothing
+float formulaLog(float x) {
+	#if FORMULA_POWER == 2
+	return log2(x);
+	#else
+	return log(x) / log(float(FORMULA_POWER));
+	#endif
+}
+
+// True if `condition` holds for all lanes that run together, so that they can leave a loop together
+// compute_shader_mandelbrot.glsl defines it with a subgroup vote, otherwise every lane decides for itself
+#ifndef ALL_LANES
+#define ALL_LANES(condition) (condition)
+#endif
+
+// The orbit is compared with a saved value, which is replaced at iterations 1, 2, 4, 8, ... (Brent's cycle detection)
+// An exact repetition means that the orbit is periodic and never escapes, so the start is inside (the result is the same as without the check)
+uint calcFractal(complex start, out complex escape) {
+	#if FORMULA == FORMULA_JULIA
+	complex c = complex(juliaConstant);
+	#else
+	complex c = start;
+	#endif
+	complex current = start;
+	complex saved = start;
+	uint savedAt = 1u;
+	uint count = 0u;
+	bool done = false;
+	uint n = 1u;
+	for (; n < maxIterations + 1u; n++) {
+		if (!done) {
+			if (dot(current, current) > 65536.0) { // Divergence check // 4.0 would be enough, but higher values improve the smoothing
+				count = n;
+				done = true;
+			} else {
+				current = formulaStep(current, c);
+				if (current == saved) {
+					done = true;
+				} else if (n == savedAt) {
+					saved = current;
+					savedAt *= 2u;
+				}
+			}
+		}
+		if (ALL_LANES(done)) {
+			break;
+		}
+	}
+
+	escape = current;
+	COST_COUNT(cost_iterations, min(n, maxIterations));
+	return count;
+}
+
+#ifdef USE_DOUBLE_FLOAT
+// Same as formulaStep in double-float arithmetic
+dfcomplex dfcFormulaStep(dfcomplex z, dfcomplex c) {
+	#if FORMULA == FORMULA_MULTIBROT
+	dfcomplex power = z;
+	for (int i = 1; i < FORMULA_POWER; i++) {
+		power = dfc_mul(power, z);
+	}
+	return dfc_add(power, c);
+	#else
+	#if FORMULA == FORMULA_BURNING_SHIP
+	z = dfcomplex(z.x < 0.0 ? -z.xy : z.xy, z.z < 0.0 ? -z.zw : z.zw); // the sign of hi is the sign of the number
+	#elif FORMULA == FORMULA_TRICORN
+	z.zw = -z.zw;
+	#endif
+	return dfc_add(dfc_sqr(z), c);
+	#endif
+}
+
+// Same iteration in double-float arithmetic (see double_float.glsl)
+uint calcFractal(dfcomplex start, out complex escape) {
+	#if FORMULA == FORMULA_JULIA
+	dfcomplex c = juliaConstantSplit;
+	#else
+	dfcomplex c = start;
+	#endif
+	dfcomplex current = start;
+	dfcomplex saved = start;
+	uint savedAt = 1u;
+	uint count = 0u;
+	bool done = false;
+	uint n = 1u;
+	escape = dfc_to_complex(current);
+	for (; n < maxIterations + 1u; n++) {
+		if (!done) {
+			escape = dfc_to_complex(current);
+			if (dot(escape, escape) > 65536.0) {
+				count = n;
+				done = true;
+			} else {
+				current = dfcFormulaStep(current, c);
+				if (current == saved) {
+					done = true;
+				} else if (n == savedAt) {
+					saved = current;
+					savedAt *= 2u;
+				}
+			}
+		}
+		if (ALL_LANES(done)) {
+			break;
+		}
+	}
+
+	if (count == 0u) {
+		escape = dfc_to_complex(current);
+	}
+	COST_COUNT(cost_iterations, min(n, maxIterations));
+	return count;
+}
+#endif
+
+// (smoothCount, 1.0) of a sample outside the set, (0.0, 0.0) inside, `pixelCoord` in window coordinates like gl_FragCoord
+vec2 mandelbrotSample(dvec2 pixelCoord) {
+	#ifdef USE_DOUBLE_FLOAT
+	dfcomplex start = pixelCoordToPlaneCoordDF(vec2(pixelCoord));
+	#else
+	complex start = complex(pixelCoordToPlaneCoord(pixelCoord));
+	#endif
+	complex escape;
+	uint count = calcFractal(start, escape);
+
+	#ifdef USE_SMOOTHING
+		float smoothCount = float(count) + 1.0 - formulaLog(log(float(max(length(escape), 2.0)))); // |z| grows like |z|^d per iteration
+	#else
+		float smoothCount = float(count);
+	#endif
+	return count > 0u ? vec2(smoothCount, 1.0) : vec2(0.0);
+}
+
+// (avgSmoothCount, outsideRatio) of the pixel with center `fragCoord` (like gl_FragCoord, the lower left is (0.5, 0.5))
+vec2 mandelbrotPixel(vec2 fragCoord) {
+	dvec2 pixelCoord = dvec2(fragCoord);
+
+	uint numInside = 0;
+	float avgSmoothCount = 0.0;
+	for (uint i = 0; i < NUM_SAMPLES; ++i) {
+		vec2 sampleValue = mandelbrotSample(pixelCoord + sample_offsets[i]);
+		if (sampleValue.y > 0.0) { // not inside the mandelbrot
+			avgSmoothCount += sampleValue.x;
+		} else {
+			numInside += 1;
+		}
+	}
+	if (numInside < NUM_SAMPLES) {
+		avgSmoothCount /= float(NUM_SAMPLES - numInside); // Average of samples outside the mandelbrot
+	}
+	float outsideRatio = float(NUM_SAMPLES - numInside) / float(NUM_SAMPLES);
+	return vec2(avgSmoothCount, outsideRatio);
+}
+
+#endif
@@ -1,8 +1,13 @@
 #ifndef N_BODY_PROBLEM_INCLUDED
 #define N_BODY_PROBLEM_INCLUDED
 
+// N and D are set by NBodyModel (one of its variants, every variant is a separately compiled shader)
+#ifndef N
 #define N 3 // Number of bodies
+#endif
+#ifndef D
 #define D 3 // Dimension of space
+#endif
 #define M 2*N // M is number of array elements should rk45_arr works with
 #include "real.glsl"
 
@@ -13,14 +18,18 @@ const real length_scale = 1e7;          // We use length_scale * m as length uni
 
 // N-Body Problem Parameters
 // uniform real g; // Gravitational constant
-const real g = mass_scale / (pow(length_scale, 3.0)) * pow(time_scale, 2.0) * 6.67384e-11; // unit [(length_scale*m)^3 / (mass_scale*kg * (time_scale*s)^2)]
-uniform real m[N]; // Start masses of all N bodies
-// uniform rvecd q0[N]; // Start positions of all N bodies
-// uniform rvecd p0[N]; // Start momenta of all N bodies
+const real g = mass_scale / (length_scale*length_scale*length_scale) * (time_scale*time_scale) * 6.67384e-11; // unit [(length_scale*m)^3 / (mass_scale*kg * (time_scale*s)^2)]
+uniform float m[N]; // Masses of all N bodies
 const real t0 = 0.0;
 uniform float t_end;
 
-
+// Pair force between body i and body j (pointing from i to j), the force on j is the negative
+// g * m[i] * m[j] * diff / |diff|^3 with one inversesqrt instead of length and pow
+rvecd pair_force(rvecd q_i, rvecd q_j, real m_i_m_j) {
+    rvecd diff = q_j - q_i;
+    real inv_length = inversesqrt(dot(diff, diff));
+    return diff * (g * m_i_m_j * inv_length*inv_length*inv_length);
+}
 
 real H(rvecd q[N], rvecd p[N]) {
     real h = 0.0;
@@ -60,46 +69,36 @@ void dT(rvecd p[N], out rvecd dT_out[N]) {
 
 // Negative derivative of U
 void dnU(rvecd q[N], out rvecd dnU_out[N]) {
-    // Set dnU_out to zero
     for (int i = 0; i < N; ++i) {
         dnU_out[i] = rvecd(0.0);
     }
 
+    // Every pair once, the force acts on both bodies (in opposite directions)
     for (int i = 0; i < N; ++i) {
         for (int j = 0; j < i; ++j) {
-            // Calculate force between m[i] and m[j] (pointing to m[j])
-            rvecd diff = q[j] - q[i];
-            rvecd force = diff * g * m[i] * m[j] / pow(length(diff), 3.0);
-
-            // Add forces
+            rvecd force = pair_force(q[i], q[j], m[i] * m[j]);
             dnU_out[i] += force;
-            dnU_out[j] -= force; // in opposite direction
+            dnU_out[j] -= force;
         }
     }
 }
 
-void rhs_arr(rvecd y[2*N], out rvecd rhs_out[2*N]) {
+// y = (q[0], ..., q[N-1], p[0], ..., p[N-1])
+void rhs_arr(rvecd y[M], out rvecd rhs_out[M]) {
     // dT in first N components
     for (int i = 0; i < N; ++i) {
         rhs_out[i] = y[N+i] / m[i]; // p[i] = y[N+i]
-    }
-
-    // dnU in last N components
-    for (int i = 0; i < N; ++i) {
         rhs_out[N+i] = rvecd(0.0);
     }
 
+    // dnU in last N components, every pair once
     for (int i = 0; i < N; ++i) {
         for (int j = 0; j < i; ++j) {
-            // Calculate force between m[i] and m[j] (pointing to m[j])
-            rvecd diff = y[j] - y[i];
-            rvecd force = diff * g * m[i] * m[j] / pow(length(diff), 3);
-
-            // Add forces
+            rvecd force = pair_force(y[i], y[j], m[i] * m[j]);
             rhs_out[N+i] += force;
             rhs_out[N+j] -= force; // in opposite direction
         }
     }
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -2,6 +2,7 @@
 #define RK45_INCLUDED
 
 #include "real.glsl"
+#include "cost_instrumentation.glsl"
 
 // A Problem definition must be included before this and must contain the following
 //  #define D ... (defining dimension of vectors rvecd)
@@ -10,6 +11,24 @@
 // - void rhs_arr(rvecd y0[M], out rvecd y1[M]) { ... } (only when using rk45_arr, otherwise use #define RK45_DISABLE_ARR_METHODS)
 
 
+// Integration method of the vector methods (the _arr methods always use RK-Fehlberg), selected with #define RK_METHOD
+#define RK_FEHLBERG 0 // RK-Fehlberg 4(5), 6 rhs evaluations per step
+#define RK_DOPRI5 1   // Dormand-Prince 5(4), 6 rhs evaluations per step (the last one is the first of the next step)
+#define RK_DOP853 2   // Dormand-Prince 8(5,3), 12 rhs evaluations per step, needs far fewer steps for tight tolerances
+#define RK_VERLET 3   // fixed step symplectic methods, see symplectic.glsl (then there are no vector methods here)
+#define RK_YOSHIDA4 4
+#ifndef RK_METHOD
+#define RK_METHOD RK_FEHLBERG
+#endif
+#if RK_METHOD == RK_DOP853
+#define RK_STAGES 12u // rhs evaluations per step (for COST_INSTRUMENTATION)
+#else
+#define RK_STAGES 6u
+#endif
+#if RK_METHOD == RK_VERLET || RK_METHOD == RK_YOSHIDA4
+#define RK45_DISABLE_VEC_METHODS
+#endif
+
 // I trust the glsl compilation to optimize const float operations away
 // https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta%E2%80%93Fehlberg_method, Formula 1
 const real a21 = 2.0/9.0;
@@ -49,9 +68,18 @@ real scaled_norm(rvecd vector, rvecd scale_vec) {
     return sqrt(1.0 / D) * length(temp); // length is 2-norm 
 }
 
-rvecd rk45_step(rvecd y0, inout real tau, out bool isAccepted) {
+// Step size control, the same for all methods
+real rk45_new_tau(real tau, real err, real error_exponent) {
+    return tau * min(tau_fac_max, max(tau_fac_min, tau_fac*rpow(1.0 / max(err, 1e-10), error_exponent))); // max(err, 1e-10) to prevent division by zero
+}
+
+// One step of the selected method, `z0` must be rhs(y0) and is updated to rhs of the returned y (reused by the next step)
+// tau is always updated to the new step size. On success y1 is returned, otherwise y0
+#if RK_METHOD == RK_FEHLBERG
+
+rvecd rk45_step(rvecd y0, inout rvecd z0, inout real tau, out bool isAccepted) {
     rvecd Y1 = y0;
-    rvecd Z1 = rhs(Y1);
+    rvecd Z1 = z0;
 
     rvecd Y2 = y0 + tau*(a21*Z1);
     rvecd Z2 = rhs(Y2);
@@ -75,7 +103,7 @@ rvecd rk45_step(rvecd y0, inout real tau, out bool isAccepted) {
     // Error estimation and Calculation of optimal tau
     rvecd scale_vec = rvecd(atol) + max(abs(y0), abs(y1))*rvecd(rtol);
     real err = scaled_norm(err_vec, scale_vec);
-    tau = tau * min(tau_fac_max, max(tau_fac_min, tau_fac*pow(1.0 / max(err, 1e-10), 1.0/5.0))); // max(err, 1e-10) to prevent division by zero // 5.0 = order of rk5
+    tau = rk45_new_tau(tau, err, 1.0/5.0); // 5.0 = order of rk5
 
     if (err >= 1.0) {
         isAccepted = false;
@@ -83,53 +111,173 @@ rvecd rk45_step(rvecd y0, inout real tau, out bool isAccepted) {
     }
 
     isAccepted = true;
+    z0 = rhs(y1);
     return y1;
 }
 
-rvecd rk45(rvecd y0, real t0, real t_end, out uint error_code, out uint step_counter, out uint same_step_counter) {
-    // Guess initial step size (according to ChatGPT)
-    rvecd z0 = rhs(y0);
+#elif RK_METHOD == RK_DOPRI5
+
+// https://en.wikipedia.org/wiki/Dormand%E2%80%93Prince_method
+const real dp_a21 = 1.0/5.0;
+const real dp_a31 = 3.0/40.0;       const real dp_a32 = 9.0/40.0;
+const real dp_a41 = 44.0/45.0;      const real dp_a42 = -56.0/15.0;      const real dp_a43 = 32.0/9.0;
+const real dp_a51 = 19372.0/6561.0; const real dp_a52 = -25360.0/2187.0; const real dp_a53 = 64448.0/6561.0; const real dp_a54 = -212.0/729.0;
+const real dp_a61 = 9017.0/3168.0;  const real dp_a62 = -355.0/33.0;     const real dp_a63 = 46732.0/5247.0; const real dp_a64 = 49.0/176.0;  const real dp_a65 = -5103.0/18656.0;
+const real dp_a71 = 35.0/384.0;     const real dp_a73 = 500.0/1113.0;    const real dp_a74 = 125.0/192.0;    const real dp_a75 = -2187.0/6784.0; const real dp_a76 = 11.0/84.0; // = b (first same as last)
+
+const real dp_e1 = 71.0/57600.0; const real dp_e3 = -71.0/16695.0; const real dp_e4 = 71.0/1920.0; const real dp_e5 = -17253.0/339200.0; const real dp_e6 = 22.0/525.0; const real dp_e7 = -1.0/40.0; // b - b_
+
+rvecd rk45_step(rvecd y0, inout rvecd z0, inout real tau, out bool isAccepted) {
+    rvecd Z1 = z0;
+    rvecd Z2 = rhs(y0 + tau*(dp_a21*Z1));
+    rvecd Z3 = rhs(y0 + tau*(dp_a31*Z1 + dp_a32*Z2));
+    rvecd Z4 = rhs(y0 + tau*(dp_a41*Z1 + dp_a42*Z2 + dp_a43*Z3));
+    rvecd Z5 = rhs(y0 + tau*(dp_a51*Z1 + dp_a52*Z2 + dp_a53*Z3 + dp_a54*Z4));
+    rvecd Z6 = rhs(y0 + tau*(dp_a61*Z1 + dp_a62*Z2 + dp_a63*Z3 + dp_a64*Z4 + dp_a65*Z5));
+    rvecd y1 = y0 + tau*(dp_a71*Z1 + dp_a73*Z3 + dp_a74*Z4 + dp_a75*Z5 + dp_a76*Z6);
+    rvecd Z7 = rhs(y1);
+
+    rvecd err_vec = tau*(dp_e1*Z1 + dp_e3*Z3 + dp_e4*Z4 + dp_e5*Z5 + dp_e6*Z6 + dp_e7*Z7);
+    rvecd scale_vec = rvecd(atol) + max(abs(y0), abs(y1))*rvecd(rtol);
+    real err = scaled_norm(err_vec, scale_vec);
+    tau = rk45_new_tau(tau, err, 1.0/5.0); // 5.0 = order of the error estimator + 1
+
+    if (err >= 1.0) {
+        isAccepted = false;
+        return y0;
+    }
+
+    isAccepted = true;
+    z0 = Z7;
+    return y1;
+}
+
+#elif RK_METHOD == RK_DOP853
+
+// https://www.unige.ch/~hairer/prog/nonstiff/dop853.f (same coefficients as scipy)
+const real d8_a2_1 = 5.26001519587677318785587544488e-2;
+const real d8_a3_1 = 1.97250569845378994544595329183e-2; const real d8_a3_2 = 5.91751709536136983633785987549e-2;
+const real d8_a4_1 = 2.95875854768068491816892993775e-2; const real d8_a4_3 = 8.87627564304205475450678981324e-2;
+const real d8_a5_1 = 2.41365134159266685502369798665e-1; const real d8_a5_3 = -8.84549479328286085344864962717e-1; const real d8_a5_4 = 9.24834003261792003115737966543e-1;
+const real d8_a6_1 = 3.7037037037037037037037037037e-2; const real d8_a6_4 = 1.70828608729473871279604482173e-1; const real d8_a6_5 = 1.25467687566822425016691814123e-1;
+const real d8_a7_1 = 3.7109375e-2; const real d8_a7_4 = 1.70252211019544039314978060272e-1; const real d8_a7_5 = 6.02165389804559606850219397283e-2; const real d8_a7_6 = -1.7578125e-2;
+const real d8_a8_1 = 3.70920001185047927108779319836e-2; const real d8_a8_4 = 1.70383925712239993810214054705e-1; const real d8_a8_5 = 1.07262030446373284651809199168e-1; const real d8_a8_6 = -1.53194377486244017527936158236e-2; const real d8_a8_7 = 8.27378916381402288758473766002e-3;
+const real d8_a9_1 = 6.24110958716075717114429577812e-1; const real d8_a9_4 = -3.36089262944694129406857109825; const real d8_a9_5 = -8.68219346841726006818189891453e-1; const real d8_a9_6 = 2.75920996994467083049415600797e1; const real d8_a9_7 = 2.01540675504778934086186788979e1; const real d8_a9_8 = -4.34898841810699588477366255144e1;
+const real d8_a10_1 = 4.77662536438264365890433908527e-1; const real d8_a10_4 = -2.48811461997166764192642586468; const real d8_a10_5 = -5.90290826836842996371446475743e-1; const real d8_a10_6 = 2.12300514481811942347288949897e1; const real d8_a10_7 = 1.52792336328824235832596922938e1; const real d8_a10_8 = -3.32882109689848629194453265587e1; const real d8_a10_9 = -2.03312017085086261358222928593e-2;
+const real d8_a11_1 = -9.3714243008598732571704021658e-1; const real d8_a11_4 = 5.18637242884406370830023853209; const real d8_a11_5 = 1.09143734899672957818500254654; const real d8_a11_6 = -8.14978701074692612513997267357; const real d8_a11_7 = -1.85200656599969598641566180701e1; const real d8_a11_8 = 2.27394870993505042818970056734e1; const real d8_a11_9 = 2.49360555267965238987089396762; const real d8_a11_10 = -3.0467644718982195003823669022;
+const real d8_a12_1 = 2.27331014751653820792359768449; const real d8_a12_4 = -1.05344954667372501984066689879e1; const real d8_a12_5 = -2.00087205822486249909675718444; const real d8_a12_6 = -1.79589318631187989172765950534e1; const real d8_a12_7 = 2.79488845294199600508499808837e1; const real d8_a12_8 = -2.85899827713502369474065508674; const real d8_a12_9 = -8.87285693353062954433549289258; const real d8_a12_10 = 1.23605671757943030647266201528e1; const real d8_a12_11 = 6.43392746015763530355970484046e-1;
+const real d8_b1 = 5.42937341165687622380535766363e-2; const real d8_b6 = 4.45031289275240888144113950566; const real d8_b7 = 1.89151789931450038304281599044; const real d8_b8 = -5.8012039600105847814672114227; const real d8_b9 = 3.1116436695781989440891606237e-1; const real d8_b10 = -1.52160949662516078556178806805e-1; const real d8_b11 = 2.01365400804030348374776537501e-1; const real d8_b12 = 4.47106157277725905176885569043e-2;
+const real d8_e5_1 = 0.1312004499419488073250102996e-1; const real d8_e5_6 = -0.1225156446376204440720569753e+1; const real d8_e5_7 = -0.4957589496572501915214079952; const real d8_e5_8 = 0.1664377182454986536961530415e+1; const real d8_e5_9 = -0.3503288487499736816886487290; const real d8_e5_10 = 0.3341791187130174790297318841; const real d8_e5_11 = 0.8192320648511571246570742613e-1; const real d8_e5_12 = -0.2235530786388629525884427845e-1;
+const real d8_e3_1 = 5.42937341165687622380535766363e-2 - 0.244094488188976377952755905512; const real d8_e3_6 = 4.45031289275240888144113950566; const real d8_e3_7 = 1.89151789931450038304281599044; const real d8_e3_8 = -5.8012039600105847814672114227; const real d8_e3_9 = 3.1116436695781989440891606237e-1 - 0.733846688281611857341361741547; const real d8_e3_10 = -1.52160949662516078556178806805e-1; const real d8_e3_11 = 2.01365400804030348374776537501e-1; const real d8_e3_12 = 4.47106157277725905176885569043e-2 - 0.220588235294117647058823529412e-1;
+
+rvecd rk45_step(rvecd y0, inout rvecd z0, inout real tau, out bool isAccepted) {
+    rvecd Z1 = z0;
+    rvecd Z2 = rhs(y0 + tau*(d8_a2_1*Z1));
+    rvecd Z3 = rhs(y0 + tau*(d8_a3_1*Z1 + d8_a3_2*Z2));
+    rvecd Z4 = rhs(y0 + tau*(d8_a4_1*Z1 + d8_a4_3*Z3));
+    rvecd Z5 = rhs(y0 + tau*(d8_a5_1*Z1 + d8_a5_3*Z3 + d8_a5_4*Z4));
+    rvecd Z6 = rhs(y0 + tau*(d8_a6_1*Z1 + d8_a6_4*Z4 + d8_a6_5*Z5));
+    rvecd Z7 = rhs(y0 + tau*(d8_a7_1*Z1 + d8_a7_4*Z4 + d8_a7_5*Z5 + d8_a7_6*Z6));
+    rvecd Z8 = rhs(y0 + tau*(d8_a8_1*Z1 + d8_a8_4*Z4 + d8_a8_5*Z5 + d8_a8_6*Z6 + d8_a8_7*Z7));
+    rvecd Z9 = rhs(y0 + tau*(d8_a9_1*Z1 + d8_a9_4*Z4 + d8_a9_5*Z5 + d8_a9_6*Z6 + d8_a9_7*Z7 + d8_a9_8*Z8));
+    rvecd Z10 = rhs(y0 + tau*(d8_a10_1*Z1 + d8_a10_4*Z4 + d8_a10_5*Z5 + d8_a10_6*Z6 + d8_a10_7*Z7 + d8_a10_8*Z8 + d8_a10_9*Z9));
+    rvecd Z11 = rhs(y0 + tau*(d8_a11_1*Z1 + d8_a11_4*Z4 + d8_a11_5*Z5 + d8_a11_6*Z6 + d8_a11_7*Z7 + d8_a11_8*Z8 + d8_a11_9*Z9 + d8_a11_10*Z10));
+    rvecd Z12 = rhs(y0 + tau*(d8_a12_1*Z1 + d8_a12_4*Z4 + d8_a12_5*Z5 + d8_a12_6*Z6 + d8_a12_7*Z7 + d8_a12_8*Z8 + d8_a12_9*Z9 + d8_a12_10*Z10 + d8_a12_11*Z11));
+    rvecd y1 = y0 + tau*(d8_b1*Z1 + d8_b6*Z6 + d8_b7*Z7 + d8_b8*Z8 + d8_b9*Z9 + d8_b10*Z10 + d8_b11*Z11 + d8_b12*Z12);
+
+    // Error estimation with the 5th and 3rd order estimators combined like in dop853.f
+    rvecd err5_vec = d8_e5_1*Z1 + d8_e5_6*Z6 + d8_e5_7*Z7 + d8_e5_8*Z8 + d8_e5_9*Z9 + d8_e5_10*Z10 + d8_e5_11*Z11 + d8_e5_12*Z12;
+    rvecd err3_vec = d8_e3_1*Z1 + d8_e3_6*Z6 + d8_e3_7*Z7 + d8_e3_8*Z8 + d8_e3_9*Z9 + d8_e3_10*Z10 + d8_e3_11*Z11 + d8_e3_12*Z12;
+    rvecd scale_vec = rvecd(atol) + max(abs(y0), abs(y1))*rvecd(rtol);
+    rvecd err5_scaled = err5_vec / scale_vec;
+    rvecd err3_scaled = err3_vec / scale_vec;
+    real err5_squared = dot(err5_scaled, err5_scaled);
+    real err3_squared = dot(err3_scaled, err3_scaled);
+    real denominator = err5_squared + 0.01*err3_squared;
+    real err = denominator > 0.0 ? abs(tau) * err5_squared / sqrt(denominator * D) : 0.0;
+    tau = rk45_new_tau(tau, err, 1.0/8.0); // 8.0 = order of the error estimator + 1
+
+    if (err >= 1.0) {
+        isAccepted = false;
+        return y0;
+    }
+
+    isAccepted = true;
+    z0 = rhs(y1);
+    return y1;
+}
+
+#endif
+
+// Guess initial step size (according to ChatGPT), z0 = rhs(y0)
+real rk45_initial_tau(rvecd y0, rvecd z0) {
     real y0_norm = scaled_norm(y0, rvecd(atol) + abs(y0)*rvecd(rtol));
     real z0_norm = scaled_norm(z0, rvecd(atol) + abs(z0)*rvecd(rtol));
     real tau = 0.01 * y0_norm / max(z0_norm, 1e-10); // prevent divide by 0.0
-    tau = min(1.0, max(1e-8, tau)); // clamp to range [1e-8, 1.0]
+    return min(1.0, max(1e-8, tau)); // clamp to range [1e-8, 1.0]
+}
 
-    step_counter = 0;
-    same_step_counter = 0;
-    real t = t0;
-    rvecd y = y0;
-    while(t < t_end - 1e-9) { // small tolerance to rounding errors
-        if (step_counter >= MAX_STEPS) {
-            error_code = ERR_TOO_MANY_STEPS;
-            return rvecd(0.0);
-        }
-        if (same_step_counter >= MAX_SAME_STEPS) {
-            error_code = ERR_TOO_MANY_SAME_STEPS;
-            return rvecd(0.0);
-        }
-        if (tau < MIN_TAU && t + tau < t_end - 1e-9) { // tau too small and not close to end
-            error_code = ERR_TAU_TOO_SMALL;
-            return rvecd(0.0);
-        }
+// Stop conditions of the integration loop, returns true when the integration at time t with the next step size tau is finished
+bool rk45_is_finished(real t, real tau, real t_end, uint step_counter, uint same_step_counter, out uint error_code) {
+    error_code = SUCCESS;
+    if (t >= t_end - 1e-9) { // small tolerance to rounding errors
+        return true;
+    }
+    if (step_counter >= MAX_STEPS) {
+        error_code = ERR_TOO_MANY_STEPS;
+    } else if (same_step_counter >= MAX_SAME_STEPS) {
+        error_code = ERR_TOO_MANY_SAME_STEPS;
+    } else if (tau < MIN_TAU && t + tau < t_end - 1e-9) { // tau too small and not close to end
+        error_code = ERR_TAU_TOO_SMALL;
+    }
+    return error_code != SUCCESS;
+}
 
-        bool isAccepted;
-        tau = min(tau, t_end - t); // make sure not to overshoot t_end
-        real used_tau = tau;
-        y = rk45_step(y, tau, isAccepted); // tau is always updated to new step size. On success next y is returned, otherwise the initial y
+// One step of the integration loop (tau is clipped to not overshoot t_end), y, z = rhs(y), t, tau and the counters are updated
+void rk45_advance(inout rvecd y, inout rvecd z, inout real t, inout real tau, real t_end, inout uint step_counter, inout uint same_step_counter) {
+    bool isAccepted;
+    tau = min(tau, t_end - t); // make sure not to overshoot t_end
+    real used_tau = tau;
+    y = rk45_step(y, z, tau, isAccepted); // tau is always updated to new step size. On success next y is returned, otherwise the initial y
+
+    if (isAccepted) {
+        same_step_counter = 0;
+        t += used_tau;
+    } else {
+        same_step_counter += 1;
+        COST_COUNT(cost_rejected_steps, 1u);
+    }
 
-        if (isAccepted) {
-            same_step_counter = 0;
-            t += used_tau;
-        } else {
-            same_step_counter += 1;
-        }
+    step_counter += 1;
+    COST_COUNT(cost_iterations, 1u);
+    COST_COUNT(cost_rhs_evaluations, RK_STAGES);
+}
 
-        step_counter += 1;
+// Continues an integration at y(t) with step size tau (tau <= 0.0 guesses an initial step size) until t_end or one of the stop conditions
+// t and tau are updated, so that a later call can continue (e.g. after ERR_TOO_MANY_STEPS or with a larger t_end). Returns the last y
+rvecd rk45_continue(rvecd y0, inout real t, inout real tau, real t_end, out uint error_code, out uint step_counter, out uint same_step_counter) {
+    rvecd y = y0;
+    rvecd z = rhs(y0); // rhs(y)
+    COST_COUNT(cost_rhs_evaluations, 1u);
+    if (tau <= 0.0) {
+        tau = rk45_initial_tau(y0, z);
     }
 
-    error_code = SUCCESS;
+    step_counter = 0;
+    same_step_counter = 0;
+    while (!rk45_is_finished(t, tau, t_end, step_counter, same_step_counter, error_code)) {
+        rk45_advance(y, z, t, tau, t_end, step_counter, same_step_counter);
+    }
+    COST_COUNT_STATUS(error_code);
     return y;
 }
+
+rvecd rk45(rvecd y0, real t0, real t_end, out uint error_code, out uint step_counter, out uint same_step_counter) {
+    real t = t0;
+    real tau = 0.0;
+    rvecd y = rk45_continue(y0, t, tau, t_end, error_code, step_counter, same_step_counter);
+    return error_code == SUCCESS ? y : rvecd(0.0);
+}
 #endif //  #ifndef RK45_DISABLE_VEC_METHODS
 
 
@@ -147,76 +295,64 @@ real scaled_norm_arr(rvecd vector[M], rvecd scale_vec[M]) {
     return sqrt(sum_of_squares / (M*D)); // 2-norm
 }
 
+// Only the stage derivatives Z1 to Z6 and one stage value Y are kept (the arrays are M vectors each, e.g. 6 vec3 for 3 bodies in 3D),
+// the error is summed up directly instead of keeping error and scale arrays
 void rk45_step_arr(rvecd y0[M], inout real tau, out bool isAccepted, out rvecd y1[M]) {
-    rvecd Y1[M];
+    rvecd Y[M];
     rvecd Z1[M];
-    rvecd Y2[M];
     rvecd Z2[M];
-    rvecd Y3[M];
     rvecd Z3[M];
-    rvecd Y4[M];
     rvecd Z4[M];
-    rvecd Y5[M];
     rvecd Z5[M];
-    rvecd Y6[M];
     rvecd Z6[M];
-    rvecd err_vec[M];
 
-    for (int i = 0; i < M; ++i) {
-        Y1[i] = y0[i];
-    }
-    rhs_arr(Y1, Z1); // set Z1
+    rhs_arr(y0, Z1); // set Z1
 
     for (int i = 0; i < M; ++i) {
-        Y2[i] = y0[i] + tau*(a21*Z1[i]);
+        Y[i] = y0[i] + tau*(a21*Z1[i]);
     }
-    rhs_arr(Y2, Z2); // set Z2
+    rhs_arr(Y, Z2); // set Z2
 
     for (int i = 0; i < M; ++i) {
-        Y3[i] = y0[i] + tau*(a31*Z1[i] + a32*Z2[i]);
+        Y[i] = y0[i] + tau*(a31*Z1[i] + a32*Z2[i]);
     }
-    rhs_arr(Y3, Z3); // set Z3
+    rhs_arr(Y, Z3); // set Z3
 
     for (int i = 0; i < M; ++i) {
-        Y4[i] = y0[i] + tau*(a41*Z1[i] + a42*Z2[i] + a43*Z3[i]);
+        Y[i] = y0[i] + tau*(a41*Z1[i] + a42*Z2[i] + a43*Z3[i]);
     }
-    rhs_arr(Y4, Z4); // set Z4
+    rhs_arr(Y, Z4); // set Z4
 
     for (int i = 0; i < M; ++i) {
-        Y5[i] = y0[i] + tau*(a51*Z1[i] + a52*Z2[i] + a53*Z3[i] + a54*Z4[i]);
-        
+        Y[i] = y0[i] + tau*(a51*Z1[i] + a52*Z2[i] + a53*Z3[i] + a54*Z4[i]);
     }
-    rhs_arr(Y5, Z5); // set Z5
+    rhs_arr(Y, Z5); // set Z5
 
     for (int i = 0; i < M; ++i) {
-        Y6[i] = y0[i] + tau*(a61*Z1[i] + a62*Z2[i] + a63*Z3[i] + a64*Z4[i] + a65*Z5[i]);
+        Y[i] = y0[i] + tau*(a61*Z1[i] + a62*Z2[i] + a63*Z3[i] + a64*Z4[i] + a65*Z5[i]);
     }
-    rhs_arr(Y6, Z6); // set Z6
+    rhs_arr(Y, Z6); // set Z6
 
+    // Next y and error estimation (b2 = b2_ = 0, so Z2 is not needed)
+    real sum_of_squares = 0.0;
     for (int i = 0; i < M; ++i) {
-        y1[i] = y0[i] + tau*(b1*Z1[i] + b2*Z2[i] + b3*Z3[i] + b4*Z4[i] + b5*Z5[i] + b6*Z6[i]);
-        err_vec[i] = tau*((b1 - b1_)*Z1[i] + (b2 - b2_)*Z2[i] + (b3 - b3_)*Z3[i] + (b4 - b4_)*Z4[i] + (b5 - b5_)*Z5[i] + (b6 - b6_)*Z6[i]);
+        y1[i] = y0[i] + tau*(b1*Z1[i] + b3*Z3[i] + b4*Z4[i] + b5*Z5[i] + b6*Z6[i]);
+        rvecd err_vec = tau*((b1 - b1_)*Z1[i] + (b3 - b3_)*Z3[i] + (b4 - b4_)*Z4[i] + (b5 - b5_)*Z5[i] + (b6 - b6_)*Z6[i]);
+        rvecd scale_vec = rvecd(atol) + max(abs(y0[i]), abs(y1[i]))*rvecd(rtol);
+        rvecd temp = err_vec / scale_vec;
+        sum_of_squares += dot(temp, temp);
     }
+    real err = sqrt(sum_of_squares / (M*D)); // same as scaled_norm_arr
 
+    // Calculation of optimal tau
+    tau = tau * min(tau_fac_max, max(tau_fac_min, tau_fac*rpow(1.0 / max(err, 1e-10), 1.0/5.0))); // max(err, 1e-10) to prevent division by zero // 5.0 = order of rk5
 
-    // Error estimation and Calculation of optimal tau
-    rvecd scale_vec[M];
-    for (int i = 0; i < M; ++i) {
-        scale_vec[i] = rvecd(atol) + max(abs(y0[i]), abs(y1[i]))*rvecd(rtol);
-    }
-    real err = scaled_norm_arr(err_vec, scale_vec);
-    tau = tau * min(tau_fac_max, max(tau_fac_min, tau_fac*pow(1.0 / max(err, 1e-10), 1.0/5.0))); // max(err, 1e-10) to prevent division by zero // 5.0 = order of rk5
-
-    if (err >= 1.0) {
-        isAccepted = false;
+    isAccepted = err < 1.0;
+    if (!isAccepted) {
         for (int i = 0; i < M; ++i) {
             y1[i] = y0[i]; // output y0
-            return;
         }
     }
-
-    isAccepted = true;
-    // y1 is already set
 }
 
 void rk45_arr(rvecd y0[M], real t0, real t_end, out uint error_code, out uint step_counter, out uint same_step_counter, out rvecd y[M]) {
@@ -226,6 +362,7 @@ void rk45_arr(rvecd y0[M], real t0, real t_end, out uint error_code, out uint st
     rvecd scale_vec_z0[M];
 
     rhs_arr(y0, z0); // set z0
+    COST_COUNT(cost_rhs_evaluations, 1u);
     for (int i = 0; i < M; ++i) {
         scale_vec_y0[i] = rvecd(atol) + abs(y0[i])*rvecd(rtol);
         scale_vec_z0[i] = rvecd(atol) + abs(z0[i])*rvecd(rtol);
@@ -244,6 +381,7 @@ void rk45_arr(rvecd y0[M], real t0, real t_end, out uint error_code, out uint st
     while(t < t_end - 1e-9) { // small tolerance to rounding errors
         if (step_counter >= MAX_STEPS) {
             error_code = ERR_TOO_MANY_STEPS;
+            COST_COUNT_STATUS(error_code);
             for (int i = 0; i < M; ++i) {
                 y[i] = rvecd(0.0);
             }
@@ -251,6 +389,7 @@ void rk45_arr(rvecd y0[M], real t0, real t_end, out uint error_code, out uint st
         }
         if (same_step_counter >= MAX_SAME_STEPS) {
             error_code = ERR_TOO_MANY_SAME_STEPS;
+            COST_COUNT_STATUS(error_code);
             for (int i = 0; i < M; ++i) {
                 y[i] = rvecd(0.0);
             }
@@ -258,6 +397,7 @@ void rk45_arr(rvecd y0[M], real t0, real t_end, out uint error_code, out uint st
         }
         if (tau < MIN_TAU && t + tau < t_end - 1e-9) { // tau too small and not close to end
             error_code = ERR_TAU_TOO_SMALL;
+            COST_COUNT_STATUS(error_code);
             for (int i = 0; i < M; ++i) {
                 y[i] = rvecd(0.0);
             }
@@ -274,12 +414,16 @@ void rk45_arr(rvecd y0[M], real t0, real t_end, out uint error_code, out uint st
             t += used_tau;
         } else {
             same_step_counter += 1;
+            COST_COUNT(cost_rejected_steps, 1u);
         }
 
         step_counter += 1;
+        COST_COUNT(cost_iterations, 1u);
+        COST_COUNT(cost_rhs_evaluations, 6u); // always RK-Fehlberg
     }
 
     error_code = SUCCESS;
+    COST_COUNT_STATUS(error_code);
     // y is already set
 }
 #endif //  #ifndef RK45_DISABLE_ARR_METHODS
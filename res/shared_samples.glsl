@@ -0,0 +1,37 @@
+#ifndef SHARED_SAMPLES_INCLUDED
+#define SHARED_SAMPLES_INCLUDED
+
+// Sub-pixel sample lattice shared by neighboring pixels (SHARED_SAMPLES, only with COMPUTE_SAMPLES)
+// Every pixel has LATTICE_SIZE x LATTICE_SIZE samples on a regular grid, a pixel is the tent filtered average of all samples closer than one
+// pixel (in x and y), so every sample is integrated once but counts for up to 4 pixels, e.g. 16 integrations per pixel instead of 32 with
+// 32 (pmj). The tent filter is wider than the box of a pixel, so the result is softer than with independent samples (fewer integrations for
+// some sharpness), below 16 samples there would be nothing to save. Failed samples of neighbors are skipped, so only the own ones color a pixel
+// Needs static_supersampling.glsl, the lattice size depends on NUM_SAMPLES (same as getSharedLatticeSize in model_double_pendulum.cpp)
+
+#if defined(SHARED_SAMPLES) && NUM_SAMPLES >= 16
+#define USE_SHARED_SAMPLES
+
+#if NUM_SAMPLES >= 32
+	#define LATTICE_SIZE 4u
+#else
+	#define LATTICE_SIZE 3u
+#endif
+#define LATTICE_SAMPLES (LATTICE_SIZE*LATTICE_SIZE)
+
+// The state has an apron of one pixel around the image (texel = pixel + LATTICE_APRON), since the border pixels need the samples outside
+const int LATTICE_APRON = 1;
+
+// Offset of sample i from the pixel center
+vec2 lattice_offset(uint i) {
+	return (vec2(i % LATTICE_SIZE, i / LATTICE_SIZE) + 0.5) / float(LATTICE_SIZE) - 0.5;
+}
+
+// Weight of a sample at offset d from the pixel center
+float lattice_weight(vec2 d) {
+	vec2 tent = max(1.0 - abs(d), 0.0);
+	return tent.x * tent.y;
+}
+
+#endif
+
+#endif
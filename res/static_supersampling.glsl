@@ -1,7 +1,14 @@
 #ifndef STATIC_SUPER_SAMPLING_INCLUDED
 #define STATIC_SUPER_SAMPLING_INCLUDED
 
-#if !defined(SUPER_SAMPLING) || SUPER_SAMPLING == 1
+#if defined(SAMPLE_OFFSETS_BUFFER) // offsets uploaded by the model (SuperSamplingModel::bindSampleOffsets), any number without recompiling
+    layout(std430, binding = 2) readonly buffer SampleOffsets {
+        vec2 sample_offsets[];
+    };
+    uniform uint num_samples = 1u;
+    #define NUM_SAMPLES num_samples
+
+#elif !defined(SUPER_SAMPLING) || SUPER_SAMPLING == 1 || SUPER_SAMPLING == 0 // 0 (adaptive) is the center sample of the first pass of compute_shader_mandelbrot.glsl
     #define NUM_SAMPLES 1
     const vec2 sample_offsets[NUM_SAMPLES] = vec2[](
         vec2(0.0, 0.0)
@@ -0,0 +1,116 @@
+#ifndef SYMPLECTIC_INCLUDED
+#define SYMPLECTIC_INCLUDED
+
+#include "real.glsl"
+
+// Fixed step symplectic integrators for hamiltonian systems with 2 degrees of freedom, selected with #define RK_METHOD (see rk45.glsl)
+// rk45.glsl must be included before this (for RK_METHOD, MAX_STEPS and the error codes)
+// A Problem definition must be included before this and must contain the following
+// - void dH(rvec2 q, rvec2 p, out rvec2 dH_dq, out rvec2 dH_dp) { ... } (gradients of the hamiltonian H(q, p), dH_dp are the velocities)
+// - rvec2 momentum(rvec2 q, rvec2 v) { ... }                            (conjugated momentums from the velocities)
+
+#if RK_METHOD == RK_VERLET || RK_METHOD == RK_YOSHIDA4
+
+uniform float symplectic_tau; // step size, made slightly smaller so that the steps end exactly at t_end
+
+// The hamiltonian is not separable (see DoublePendulum.md), so Stormer-Verlet is implicit
+// The implicit equations are solved with a fixed number of fixed point iterations, so every pixel costs the same
+const uint SYMPLECTIC_ITERATIONS = 6u; // fewer iterations noticeably break the energy conservation of Yoshida 4
+
+// Yoshida's triple jump, w1 = 1 / (2 - 2^(1/3)) and w0 = 1 - 2*w1
+const real yoshida_w1 = 1.3512071919596578;
+const real yoshida_w0 = -1.7024143839193153;
+
+// Generalized Stormer-Verlet, https://www.unige.ch/~hairer/poly_geoint/week2.pdf (order 2, symmetric)
+void verlet_step(inout rvec2 q, inout rvec2 p, real tau) {
+    rvec2 dH_dq;
+    rvec2 dH_dp;
+
+    // p_half = p - tau/2 * dH_dq(q, p_half)
+    rvec2 p_half = p;
+    for (uint i = 0u; i < SYMPLECTIC_ITERATIONS; ++i) {
+        dH(q, p_half, dH_dq, dH_dp);
+        p_half = p - 0.5*tau*dH_dq;
+    }
+
+    // q_next = q + tau/2 * (dH_dp(q, p_half) + dH_dp(q_next, p_half))
+    dH(q, p_half, dH_dq, dH_dp);
+    rvec2 v_start = dH_dp;
+    rvec2 q_next = q + tau*v_start;
+    for (uint i = 0u; i < SYMPLECTIC_ITERATIONS; ++i) {
+        dH(q_next, p_half, dH_dq, dH_dp);
+        q_next = q + 0.5*tau*(v_start + dH_dp);
+    }
+
+    // p_next = p_half - tau/2 * dH_dq(q_next, p_half)
+    dH(q_next, p_half, dH_dq, dH_dp);
+    q = q_next;
+    p = p_half - 0.5*tau*dH_dq;
+}
+
+// One step of the selected method
+void symplectic_step(inout rvec2 q, inout rvec2 p, real tau) {
+    #if RK_METHOD == RK_VERLET
+    verlet_step(q, p, tau);
+    COST_COUNT(cost_rhs_evaluations, 2u*SYMPLECTIC_ITERATIONS + 2u);
+    #else
+    verlet_step(q, p, yoshida_w1*tau);
+    verlet_step(q, p, yoshida_w0*tau);
+    verlet_step(q, p, yoshida_w1*tau);
+    COST_COUNT(cost_rhs_evaluations, 3u*(2u*SYMPLECTIC_ITERATIONS + 2u));
+    #endif
+    COST_COUNT(cost_iterations, 1u);
+}
+
+// Number of steps of size at most symplectic_tau from t to t_end
+uint symplectic_step_count(real t, real t_end) {
+    return uint(max(ceil(float(t_end - t) / symplectic_tau - 1e-3), 0.0)); // small tolerance to rounding errors
+}
+
+// Same interface as rk45_continue, y = (q1, q2, v1, v2). tau is set to the used step size
+// Stops with ERR_TOO_MANY_STEPS after MAX_STEPS steps, a later call continues with the same step size
+rvec4 symplectic_continue(rvec4 y0, inout real t, inout real tau, real t_end, out uint error_code, out uint step_counter, out uint same_step_counter) {
+    same_step_counter = 0u;
+    uint num_steps = symplectic_step_count(t, t_end);
+    step_counter = min(num_steps, MAX_STEPS);
+    if (num_steps == 0u) {
+        error_code = SUCCESS;
+        COST_COUNT_STATUS(error_code);
+        return y0;
+    }
+
+    tau = (t_end - t) / real(num_steps);
+    rvec2 q = y0.xy;
+    rvec2 p = momentum(q, y0.zw);
+    for (uint i = 0u; i < step_counter; ++i) {
+        symplectic_step(q, p, tau);
+    }
+    t = step_counter == num_steps ? t_end : t + real(step_counter)*tau;
+
+    rvec2 dH_dq;
+    rvec2 dH_dp;
+    dH(q, p, dH_dq, dH_dp);
+    error_code = step_counter == num_steps ? SUCCESS : ERR_TOO_MANY_STEPS;
+    COST_COUNT(cost_rhs_evaluations, 1u);
+    COST_COUNT_STATUS(error_code);
+    return rvec4(q, dH_dp);
+}
+
+// Same interface as rk45. There are no rejected steps, so same_step_counter is always 0
+rvec4 symplectic(rvec4 y0, real t0, real t_end, out uint error_code, out uint step_counter, out uint same_step_counter) {
+    if (symplectic_step_count(t0, t_end) > MAX_STEPS) { // fail before integrating
+        same_step_counter = 0u;
+        step_counter = 0u;
+        error_code = ERR_TOO_MANY_STEPS;
+        COST_COUNT_STATUS(error_code);
+        return rvec4(0.0);
+    }
+
+    real t = t0;
+    real tau = 0.0;
+    return symplectic_continue(y0, t, tau, t_end, error_code, step_counter, same_step_counter);
+}
+
+#endif
+
+#endif
@@ -8,3 +8,19 @@ double windowSizeMeasure = double(min(windowSize.x, windowSize.y));
 dvec2 pixelCoordToPlaneCoord(dvec2 pixelCoord) {
     return (zoomScale / windowSizeMeasure) * (pixelCoord + dvec2(tileOffset) - dvec2(windowSize) / 2.0) + center;
 }
+
+#ifdef USE_DOUBLE_FLOAT
+#include "double_float.glsl"
+
+// zoomScale and center as hi/lo float pairs, center is vec4(x hi, x lo, y hi, y lo)
+uniform vec2 zoomScaleSplit;
+uniform vec4 centerSplit;
+
+// Same as pixelCoordToPlaneCoord without fp64, returns vec4(re hi, re lo, im hi, im lo)
+// The pixel offset is a float, its rounding (at most 2^-10 pixels for 16k wide images) only shifts the sample
+vec4 pixelCoordToPlaneCoordDF(vec2 pixelCoord) {
+    vec2 pixelSize = df_div_f(zoomScaleSplit, float(min(windowSize.x, windowSize.y)));
+    vec2 offset = pixelCoord + vec2(tileOffset) - vec2(windowSize) / 2.0;
+    return vec4(df_add(df_mul_f(pixelSize, offset.x), centerSplit.xy), df_add(df_mul_f(pixelSize, offset.y), centerSplit.zw));
+}
+#endif
@@ -5,13 +5,18 @@
 #include <string>
 #include <fstream>
 #include <sstream>
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+#include "fixed_point.h"
 
 /**
  * Type representing a complex number
  * `first` is the real part
  * `second` is the imaginary part
  */
-using ComplexNum = std::pair<long double, long double>;
+using ComplexNum = std::pair<FixedPoint, FixedPoint>;
 
 /**
  * Copies a string to a buffer
@@ -46,6 +51,33 @@ bool replaceAll(std::string& string, const std::string& search, const std::strin
  */
 std::string readFileToString(const char* filePath);
 
+/**
+ * Splits [0, count) into contiguous blocks and calls `function(begin, end)` for each block on its own thread
+ * Returns after all threads have finished
+ *
+ * @param numThreads 0 means one thread per hardware thread
+ */
+template <typename Function>
+void parallelFor(size_t count, Function&& function, unsigned int numThreads = 0) {
+    if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    const size_t numBlocks = std::min<size_t>(numThreads, count);
+    if (numBlocks <= 1) {
+        function(size_t(0), count);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(numBlocks);
+    for (size_t t = 0; t < numBlocks; ++t) {
+        threads.emplace_back(function, count * t / numBlocks, count * (t + 1) / numBlocks);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
 /** 
  * @param filePath e.g. "res/shader.glsl"
  * @return std::string e.g. "res/"
@@ -1,6 +1,7 @@
 #include "colormaps.h"
 
 #include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <vector>
 #include <string>
@@ -38,4 +39,40 @@ void loadColormaps(const std::string& filepath) {
 
         groupIt->second.push_back({name, std::move(colors)});
     }
-}
\ No newline at end of file
+}
+
+const std::vector<float>* findColormap(const std::string& group, const std::string& name) {
+    for (const auto& g : colormaps) {
+        if (g.first != group) continue;
+        for (const auto& m : g.second) {
+            if (m.first == name) {
+                return &m.second;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void sampleColormap(const std::vector<float>& colormap, float value, bool cyclic, float rgb[3]) {
+    constexpr int size = 256;
+    if (!std::isfinite(value)) value = 0.0f;
+    value = cyclic ? value - std::floor(value) : std::clamp(value, 0.0f, 1.0f); // keeps the texel index in range
+
+    // GL_LINEAR: texel centers are at (i + 0.5) / size
+    const float texel = value * static_cast<float>(size) - 0.5f;
+    const float texelFloor = std::floor(texel);
+    const float weight = texel - texelFloor;
+    int i0 = static_cast<int>(texelFloor);
+    int i1 = i0 + 1;
+    if (cyclic) {
+        i0 = ((i0 % size) + size) % size;
+        i1 = ((i1 % size) + size) % size;
+    } else {
+        i0 = std::clamp(i0, 0, size - 1);
+        i1 = std::clamp(i1, 0, size - 1);
+    }
+
+    for (int c = 0; c < 3; ++c) {
+        rgb[c] = (1.0f - weight) * colormap[static_cast<size_t>(3 * i0 + c)] + weight * colormap[static_cast<size_t>(3 * i1 + c)];
+    }
+}
@@ -11,4 +11,24 @@ inline ColormapDictionary colormaps;
 
 void loadColormaps(const std::string& filepath);
 
+/**
+ * Looks up a colormap in `colormaps`
+ *
+ * @return Returns the 256 RGB colors (768 floats) of the colormap or `nullptr` if there is no such colormap
+ */
+const std::vector<float>* findColormap(const std::string& group, const std::string& name);
+
+/** Colormaps of this group repeat (GL_REPEAT), all others are clamped to the edge */
+inline bool isCyclicColormapGroup(const std::string& group) { return group == "Cyclic"; }
+
+/**
+ * Samples a colormap on the CPU like the shaders do with `texture(colormap, vec2(value, 0.5))` (GL_LINEAR filtering)
+ *
+ * @param colormap 256 RGB colors (768 floats)
+ * @param value Texture coordinate, the colormap covers [0, 1]
+ * @param cyclic Repeat the colormap if `true`, clamp to the edge otherwise
+ * @param rgb Output color
+ */
+void sampleColormap(const std::vector<float>& colormap, float value, bool cyclic, float rgb[3]);
+
 #endif
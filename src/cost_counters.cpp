@@ -0,0 +1,49 @@
+#include "cost_counters.h"
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+
+void printCostCounters(std::ostream& stream, const CostCounters& counters) {
+    const double pixels = counters.pixels > 0u ? static_cast<double>(counters.pixels) : 1.0;
+    stream << "Pixels: " << counters.pixels << "\n"
+           << "Iterations: " << counters.totalIterations << " (" << static_cast<double>(counters.totalIterations) / pixels
+           << " per pixel, max " << counters.maxPixelIterations << ")\n"
+           << "RHS evaluations: " << counters.totalRhsEvaluations << "\n"
+           << "Rejected steps: " << counters.totalRejectedSteps << "\n"
+           << "Status:";
+    for (size_t i = 0; i < 4; ++i) {
+        stream << " " << CostCounters::STATUS_NAMES[i] << " " << counters.statusCounts[i];
+    }
+    stream << "\n";
+}
+
+bool appendCostCountersCsv(const std::string& filename, const std::string& label, const CostCounters& counters) {
+    std::error_code ec;
+    const bool writeHeader = !std::filesystem::exists(filename, ec) || std::filesystem::file_size(filename, ec) == 0;
+
+    std::ofstream file(filename, std::ios::app);
+    if (!file) {
+        std::cerr << "Error: Could not open " << filename << " for writing" << std::endl;
+        return false;
+    }
+    if (writeHeader) {
+        file << "label,pixels,iterations,max_pixel_iterations,rhs_evaluations,rejected_steps";
+        for (const char* status : CostCounters::STATUS_NAMES) {
+            file << "," << status;
+        }
+        file << "\n";
+    }
+    file << label << "," << counters.pixels << "," << counters.totalIterations << "," << counters.maxPixelIterations << ","
+         << counters.totalRhsEvaluations << "," << counters.totalRejectedSteps;
+    for (uint32_t count : counters.statusCounts) {
+        file << "," << count;
+    }
+    file << "\n";
+
+    if (!file) {
+        std::cerr << "Error: Could not write " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
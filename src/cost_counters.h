@@ -0,0 +1,34 @@
+#pragma once
+#ifndef MANDELBROT_COSTCOUNTERS_INCLUDED
+#define MANDELBROT_COSTCOUNTERS_INCLUDED
+
+#include <cstdint>
+#include <string>
+#include <ostream>
+
+/**
+ * Totals of the GPU cost instrumentation (see res/cost_instrumentation.glsl and `Model::setCostInstrumentation`).
+ * Iterations are Mandelbrot iterations or integration steps, depending on the model.
+ */
+struct CostCounters {
+    uint32_t pixels = 0u;
+    uint32_t maxPixelIterations = 0u;
+    uint64_t totalIterations = 0u;
+    uint64_t totalRhsEvaluations = 0u;
+    uint64_t totalRejectedSteps = 0u;
+    uint32_t statusCounts[4] = { 0u, 0u, 0u, 0u }; // integrations per status of rk45 (success, too many steps, too many same steps, tau too small)
+
+    static constexpr const char* STATUS_NAMES[4] = { "success", "too_many_steps", "too_many_same_steps", "tau_too_small" };
+};
+
+/** Prints the totals in a few human readable lines */
+void printCostCounters(std::ostream& stream, const CostCounters& counters);
+
+/**
+ * Appends the totals as one row to a CSV file, writes the header row first if the file is new or empty.
+ * `label` is the first column, e.g. the model name.
+ * @return Returns `false` if the file could not be written (error is printed)
+ */
+bool appendCostCountersCsv(const std::string& filename, const std::string& label, const CostCounters& counters);
+
+#endif
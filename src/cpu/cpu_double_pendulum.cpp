@@ -0,0 +1,167 @@
+#include "cpu_double_pendulum.h"
+
+#include <cmath>
+#include <limits>
+
+#include "rk45_batch.h"
+#include "double_pendulum_rhs.h"
+#include "vectorizable_math.h"
+#include "../colormaps.h"
+
+// Number of integrations that run side by side (covers 8 floats or 2x4 doubles of AVX registers)
+constexpr size_t BATCH_WIDTH = 8;
+
+// map interval (a, b) to (c, d)
+static float remap(float x, float a, float b, float c, float d) {
+    return c + (x - a) * (d - c) / (b - a);
+}
+
+const std::vector<SampleOffset>& DoublePendulumCpuRenderer::getSampleOffsets() const {
+    static const std::vector<SampleOffset> center = { { 0.0f, 0.0f } };
+    return this->parameters.scalarFieldOutput == 2 ? center : this->parameters.sampleOffsets;
+}
+
+template <typename Real>
+void DoublePendulumCpuRenderer::colorPixel(const std::array<Real, 4>* y, const rk45::Status* status, float rgba[4]) const {
+    const DoublePendulumCpuParameters& p = this->parameters;
+
+    if (p.scalarFieldOutput == 2) {
+        // Raw full state at the pixel center, NaN marks failed integrations
+        for (size_t i = 0; i < 4; ++i) {
+            rgba[i] = status[0] == rk45::SUCCESS ? static_cast<float>(y[0][i]) : std::numeric_limits<float>::quiet_NaN();
+        }
+        return;
+    }
+
+    const size_t numSamples = p.sampleOffsets.size();
+    Real result = Real(0.0);
+    for (size_t sample = 0; sample < numSamples; ++sample) {
+        if (status[sample] != rk45::SUCCESS) {
+            if (p.scalarFieldOutput == 1) { // error colors are chosen when recoloring
+                rgba[0] = 0.0f; rgba[1] = static_cast<float>(status[sample]); rgba[2] = 0.0f; rgba[3] = 0.0f;
+            } else if (status[sample] == rk45::ERR_TOO_MANY_STEPS) { // orange
+                rgba[0] = 1.0f; rgba[1] = 0.7f; rgba[2] = 0.0f; rgba[3] = 1.0f;
+            } else if (status[sample] == rk45::ERR_TOO_MANY_SAME_STEPS) { // purple
+                rgba[0] = 1.0f; rgba[1] = 0.0f; rgba[2] = 0.7f; rgba[3] = 1.0f;
+            } else { // light red (ERR_TAU_TOO_SMALL)
+                rgba[0] = 1.0f; rgba[1] = 0.7f; rgba[2] = 0.7f; rgba[3] = 1.0f;
+            }
+            return;
+        }
+
+        const Real y1 = static_cast<Real>(p.l1) * -std::cos(y[sample][0]);
+        const Real y2 = y1 + static_cast<Real>(p.l2) * -std::cos(y[sample][1]);
+        result += y2;
+    }
+    result /= static_cast<Real>(numSamples);
+
+    if (p.scalarFieldOutput == 1) { // raw y2 and status SUCCESS
+        rgba[0] = static_cast<float>(result); rgba[1] = 0.0f; rgba[2] = 0.0f; rgba[3] = 0.0f;
+        return;
+    }
+
+    sampleColormap(p.colormap, remap(static_cast<float>(result), -(p.l1 + p.l2), p.l1 + p.l2, 0.0f, 1.0f), p.cyclicColormap, rgba);
+    rgba[3] = 1.0f;
+}
+
+template <typename Real>
+void DoublePendulumCpuRenderer::integrateSymplectic(const std::array<Real, 4>* yStart, size_t count, std::array<Real, 4>* y, rk45::Status* status) const {
+    const DoublePendulumCpuParameters& p = this->parameters;
+    const DoublePendulumHamiltonian<Real> hamiltonian = {
+        static_cast<Real>(p.g), static_cast<Real>(p.l1), static_cast<Real>(p.l2), static_cast<Real>(p.m1), static_cast<Real>(p.m2)
+    };
+    const unsigned int numSteps = symplectic::stepCount(0.0f, p.tEnd, p.symplecticStepSize);
+    for (size_t i = 0; i < count; ++i) {
+        y[i] = symplectic::integrate(hamiltonian, static_cast<symplectic::Method>(p.method), yStart[i], Real(0.0), static_cast<Real>(p.tEnd),
+            numSteps, p.maxSteps, status[i]);
+    }
+}
+
+template <typename Real>
+void DoublePendulumCpuRenderer::renderHelper(size_t captureWidth, size_t captureHeight, const TileRect& rect, float* rgba) const {
+    const DoublePendulumCpuParameters& p = this->parameters;
+    const PlaneMapping mapping(captureWidth, captureHeight, this->zoomScale, this->centerX, this->centerY);
+    const std::vector<SampleOffset>& offsets = this->getSampleOffsets();
+
+    // Initial values of all samples of all pixels (pixel by pixel, rows from bottom to top)
+    const size_t numPixels = static_cast<size_t>(rect.width) * rect.height;
+    std::vector<std::array<Real, 4>> yStart;
+    yStart.reserve(numPixels * offsets.size());
+    for (uint32_t row = 0; row < rect.height; ++row) {
+        const double pixelY = static_cast<double>(rect.y + row) + 0.5; // pixel centers, like gl_FragCoord
+        for (uint32_t column = 0; column < rect.width; ++column) {
+            const double pixelX = static_cast<double>(rect.x + column) + 0.5;
+            for (const SampleOffset& offset : offsets) {
+                yStart.push_back({
+                    static_cast<Real>(mapping.toPlaneX(pixelX + static_cast<double>(offset.x))), // q1_start
+                    static_cast<Real>(mapping.toPlaneY(pixelY + static_cast<double>(offset.y))), // q2_start
+                    static_cast<Real>(p.v1Start),
+                    static_cast<Real>(p.v2Start)
+                });
+            }
+        }
+    }
+
+    const DoublePendulumRhs<Real, VectorizableMath> rhs = {
+        static_cast<Real>(p.g), static_cast<Real>(p.l1), static_cast<Real>(p.l2), static_cast<Real>(p.m1), static_cast<Real>(p.m2)
+    };
+    const rk45::Settings<Real> settings = {
+        static_cast<Real>(p.atol), static_cast<Real>(p.rtol), p.maxSteps, p.maxSameSteps, static_cast<Real>(p.minStepSize), static_cast<rk45::Method>(p.method)
+    };
+    std::vector<std::array<Real, 4>> y(yStart.size());
+    std::vector<rk45::Status> status(yStart.size());
+    if (symplectic::isSymplectic(p.method)) {
+        this->integrateSymplectic(yStart.data(), yStart.size(), y.data(), status.data());
+    } else {
+        rk45::integrateBatch<BATCH_WIDTH>(rhs, yStart.data(), yStart.size(), Real(0.0), static_cast<Real>(p.tEnd), settings, y.data(), status.data());
+    }
+
+    for (size_t pixel = 0; pixel < numPixels; ++pixel) {
+        this->colorPixel(y.data() + pixel * offsets.size(), status.data() + pixel * offsets.size(), rgba + pixel * 4u);
+    }
+}
+
+template <typename Real>
+void DoublePendulumCpuRenderer::shadeHelper(const PlaneMapping& mapping, double pixelX, double pixelY, float rgba[4]) const {
+    const DoublePendulumCpuParameters& p = this->parameters;
+    const std::vector<SampleOffset>& offsets = this->getSampleOffsets();
+    const DoublePendulumRhs<Real, VectorizableMath> rhs = { // same math as renderHelper, so that both give the same pixels
+        static_cast<Real>(p.g), static_cast<Real>(p.l1), static_cast<Real>(p.l2), static_cast<Real>(p.m1), static_cast<Real>(p.m2)
+    };
+    const rk45::Settings<Real> settings = {
+        static_cast<Real>(p.atol), static_cast<Real>(p.rtol), p.maxSteps, p.maxSameSteps, static_cast<Real>(p.minStepSize), static_cast<rk45::Method>(p.method)
+    };
+
+    std::vector<std::array<Real, 4>> y(offsets.size());
+    std::vector<rk45::Status> status(offsets.size());
+    for (size_t sample = 0; sample < offsets.size(); ++sample) {
+        const std::array<Real, 4> yStart = {
+            static_cast<Real>(mapping.toPlaneX(pixelX + static_cast<double>(offsets[sample].x))), // q1_start
+            static_cast<Real>(mapping.toPlaneY(pixelY + static_cast<double>(offsets[sample].y))), // q2_start
+            static_cast<Real>(p.v1Start),
+            static_cast<Real>(p.v2Start)
+        };
+        if (symplectic::isSymplectic(p.method)) {
+            this->integrateSymplectic(&yStart, 1, &y[sample], &status[sample]);
+        } else {
+            y[sample] = rk45::integrate(rhs, yStart, Real(0.0), static_cast<Real>(p.tEnd), settings, status[sample]);
+        }
+    }
+    this->colorPixel(y.data(), status.data(), rgba);
+}
+
+void DoublePendulumCpuRenderer::render(size_t captureWidth, size_t captureHeight, const TileRect& rect, float* rgba) const {
+    if (this->parameters.useDoublePrecision) {
+        this->renderHelper<double>(captureWidth, captureHeight, rect, rgba);
+    } else {
+        this->renderHelper<float>(captureWidth, captureHeight, rect, rgba);
+    }
+}
+
+void DoublePendulumCpuRenderer::shade(const PlaneMapping& mapping, double pixelX, double pixelY, float rgba[4]) const {
+    if (this->parameters.useDoublePrecision) {
+        this->shadeHelper<double>(mapping, pixelX, pixelY, rgba);
+    } else {
+        this->shadeHelper<float>(mapping, pixelX, pixelY, rgba);
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+#ifndef MANDELBROT_CPUDOUBLEPENDULUM_INCLUDED
+#define MANDELBROT_CPUDOUBLEPENDULUM_INCLUDED
+
+#include <array>
+#include <vector>
+
+#include "cpu_renderer.h"
+#include "rk45.h"
+#include "symplectic.h"
+
+struct DoublePendulumCpuParameters {
+    float tEnd = 3.0f;
+    float v1Start = 0.0f;
+    float v2Start = 0.0f;
+    float g = 9.81f;
+    float l1 = 1.0f;
+    float l2 = 1.0f;
+    float m1 = 1.0f;
+    float m2 = 1.0f;
+
+    // RK45
+    unsigned int maxSteps = 10'000;
+    unsigned int maxSameSteps = 30;
+    float minStepSize = 1e-12f;
+    float atol = 1e-5f;
+    float rtol = 1e-5f;
+    int method = rk45::FEHLBERG; // RK_METHOD, a rk45::Method or a symplectic::Method
+    float symplecticStepSize = 0.01f;
+
+    bool useDoublePrecision = false; // the GPU equivalent is USE_DOUBLE (gpuDoublePrecision of the model)
+
+    int scalarFieldOutput = 0; // SCALAR_FIELD_OUTPUT: 0 colors, 1 (y2, status), 2 (q1, q2, v1, v2) at the pixel center
+    std::vector<SampleOffset> sampleOffsets;
+    std::vector<float> colormap;
+    bool cyclicColormap = false;
+};
+
+/**
+ * Port of fragment_shader_double_pendulum.glsl (static super sampling only), integrates in float like the shader or in double
+ * `render` integrates all samples of a rect with the batched (SIMD) RK45, `shade` is the scalar version for single pixels
+ * (the symplectic methods are always scalar)
+ */
+class DoublePendulumCpuRenderer : public CpuRenderer {
+public:
+    DoublePendulumCpuRenderer(const DoublePendulumCpuParameters& _parameters, double _zoomScale, double _centerX, double _centerY)
+        : CpuRenderer(_zoomScale, _centerX, _centerY), parameters(_parameters) { }
+
+    virtual void render(size_t captureWidth, size_t captureHeight, const TileRect& rect, float* rgba) const override;
+    virtual bool isExclusive() const override { return this->parameters.useDoublePrecision; }
+
+protected:
+    virtual void shade(const PlaneMapping& mapping, double pixelX, double pixelY, float rgba[4]) const override;
+
+private:
+    template <typename Real>
+    void renderHelper(size_t captureWidth, size_t captureHeight, const TileRect& rect, float* rgba) const;
+
+    template <typename Real>
+    void shadeHelper(const PlaneMapping& mapping, double pixelX, double pixelY, float rgba[4]) const;
+
+    /** Integrates `count` initial values with the symplectic method */
+    template <typename Real>
+    void integrateSymplectic(const std::array<Real, 4>* yStart, size_t count, std::array<Real, 4>* y, rk45::Status* status) const;
+
+    /** Output of a pixel from the integration results of its samples (same order as `getSampleOffsets`) */
+    template <typename Real>
+    void colorPixel(const std::array<Real, 4>* y, const rk45::Status* status, float rgba[4]) const;
+
+    /** Offsets of the integrated samples of a pixel (only the center for the full state output) */
+    const std::vector<SampleOffset>& getSampleOffsets() const;
+
+    DoublePendulumCpuParameters parameters;
+};
+
+#endif
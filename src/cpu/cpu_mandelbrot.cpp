@@ -0,0 +1,241 @@
+#include "cpu_mandelbrot.h"
+
+#include <array>
+#include <limits>
+#include <cmath>
+#include <algorithm> // for std::equal, std::max
+#include <type_traits>
+
+#include "escape_time.h"
+#include "double_double.h"
+#include "../colormaps.h"
+
+#ifdef __SIZEOF_FLOAT128__
+__extension__ typedef __float128 Float128;
+#endif
+
+static constexpr double BAILOUT = 65536.0; // same as the shader
+
+// Relative rounding error of each CpuPrecision
+static constexpr std::array<double, 5> PRECISION_EPSILON = {
+    0x1p-24, 0x1p-53, static_cast<double>(std::numeric_limits<long double>::epsilon() / 2.0L), 0x1p-104, 0x1p-113
+};
+
+bool MandelbrotCpuRenderer::isAvailable(CpuPrecision precision) {
+    switch (precision) {
+    case CpuPrecision::LongDouble:
+        return std::numeric_limits<long double>::digits > std::numeric_limits<double>::digits;
+    case CpuPrecision::Float128:
+#ifdef __SIZEOF_FLOAT128__
+        return true;
+#else
+        return false;
+#endif
+    default:
+        return true;
+    }
+}
+
+CpuPrecision MandelbrotCpuRenderer::choosePrecision(double pixelSize, double magnitude, CpuPrecision minimum) {
+    CpuPrecision mostPrecise = minimum;
+    for (size_t p = static_cast<size_t>(minimum); p < PRECISION_EPSILON.size(); ++p) {
+        const CpuPrecision precision = static_cast<CpuPrecision>(p);
+        if (!isAvailable(precision)) {
+            continue;
+        }
+        if (pixelSize >= PRECISION_RESOLUTION_MARGIN * PRECISION_EPSILON[p] * magnitude) {
+            return precision;
+        }
+        mostPrecise = precision;
+    }
+    return mostPrecise; // deeper than any precision resolves
+}
+
+template <typename Real, typename Policy>
+void MandelbrotCpuRenderer::shadeHelper(const PlaneMapping& mapping, double pixelX, double pixelY, float rgba[4]) const {
+    const MandelbrotCpuParameters& p = this->parameters;
+
+    unsigned int numInside = 0;
+    float avgSmoothCount = 0.0f;
+    for (const SampleOffset& offset : p.sampleOffsets) {
+        Real startReal;
+        Real startImag;
+        if constexpr (std::is_same_v<Real, float> || std::is_same_v<Real, double>) { // rounded like the shader
+            startReal = static_cast<Real>(mapping.toPlaneX(pixelX + static_cast<double>(offset.x)));
+            startImag = static_cast<Real>(mapping.toPlaneY(pixelY + static_cast<double>(offset.y)));
+        } else { // the center in full precision, the offset from it is small enough for double
+            startReal = (Real(mapping.centerX) + Real(p.centerLowX)) + Real(mapping.toOffsetX(pixelX + static_cast<double>(offset.x)));
+            startImag = (Real(mapping.centerY) + Real(p.centerLowY)) + Real(mapping.toOffsetY(pixelY + static_cast<double>(offset.y)));
+        }
+        const EscapeTimeResult result = escapeTime<Real, Policy>(startReal, startImag, p.maxIterations, Real(p.juliaReal), Real(p.juliaImag));
+
+        if (result.count > 0) { // not inside the mandelbrot
+            avgSmoothCount += result.smoothCount;
+        } else {
+            numInside += 1;
+        }
+    }
+    const unsigned int numSamples = static_cast<unsigned int>(p.sampleOffsets.size());
+    if (numInside < numSamples) {
+        avgSmoothCount /= static_cast<float>(numSamples - numInside); // Average of samples outside the mandelbrot
+    }
+    const float outsideRatio = static_cast<float>(numSamples - numInside) / static_cast<float>(numSamples);
+
+    if (p.scalarFieldOutput) {
+        rgba[0] = avgSmoothCount;
+        rgba[1] = outsideRatio;
+        rgba[2] = 0.0f;
+        rgba[3] = 0.0f;
+        return;
+    }
+    sampleColormap(p.colormap, avgSmoothCount / p.colorScale, p.cyclicColormap, rgba);
+    for (int c = 0; c < 3; ++c) rgba[c] *= outsideRatio; // interpolate between outside color and implicit black
+    rgba[3] = 1.0f;
+}
+
+template <typename Policy>
+void MandelbrotCpuRenderer::shadePolicyHelper(const PlaneMapping& mapping, double pixelX, double pixelY, float rgba[4]) const {
+    switch (this->parameters.precision) {
+    case CpuPrecision::Float:
+        this->shadeHelper<float, Policy>(mapping, pixelX, pixelY, rgba);
+        break;
+    case CpuPrecision::Double:
+        this->shadeHelper<double, Policy>(mapping, pixelX, pixelY, rgba);
+        break;
+    case CpuPrecision::LongDouble:
+        this->shadeHelper<long double, Policy>(mapping, pixelX, pixelY, rgba);
+        break;
+    case CpuPrecision::DoubleDouble:
+        this->shadeHelper<DoubleDouble, Policy>(mapping, pixelX, pixelY, rgba);
+        break;
+    case CpuPrecision::Float128:
+#ifdef __SIZEOF_FLOAT128__
+        this->shadeHelper<Float128, Policy>(mapping, pixelX, pixelY, rgba);
+#else
+        this->shadeHelper<DoubleDouble, Policy>(mapping, pixelX, pixelY, rgba);
+#endif
+        break;
+    }
+}
+
+template <bool Smoothing, int Power>
+void MandelbrotCpuRenderer::shadeMultibrotHelper(const PlaneMapping& mapping, double pixelX, double pixelY, float rgba[4]) const {
+    if constexpr (Power < MAX_MULTIBROT_POWER) {
+        if (this->parameters.power != Power) {
+            this->shadeMultibrotHelper<Smoothing, Power + 1>(mapping, pixelX, pixelY, rgba);
+            return;
+        }
+    }
+    this->shadePolicyHelper<EscapeTimePolicy<BAILOUT, Smoothing, FractalFormula::Multibrot, Power>>(mapping, pixelX, pixelY, rgba);
+}
+
+template <bool Smoothing>
+void MandelbrotCpuRenderer::shadeFormulaHelper(const PlaneMapping& mapping, double pixelX, double pixelY, float rgba[4]) const {
+    switch (this->parameters.formula) {
+    case FractalFormula::Mandelbrot:
+        this->shadePolicyHelper<EscapeTimePolicy<BAILOUT, Smoothing, FractalFormula::Mandelbrot>>(mapping, pixelX, pixelY, rgba);
+        break;
+    case FractalFormula::Multibrot:
+        this->shadeMultibrotHelper<Smoothing, MIN_MULTIBROT_POWER>(mapping, pixelX, pixelY, rgba);
+        break;
+    case FractalFormula::BurningShip:
+        this->shadePolicyHelper<EscapeTimePolicy<BAILOUT, Smoothing, FractalFormula::BurningShip>>(mapping, pixelX, pixelY, rgba);
+        break;
+    case FractalFormula::Tricorn:
+        this->shadePolicyHelper<EscapeTimePolicy<BAILOUT, Smoothing, FractalFormula::Tricorn>>(mapping, pixelX, pixelY, rgba);
+        break;
+    case FractalFormula::Julia:
+        this->shadePolicyHelper<EscapeTimePolicy<BAILOUT, Smoothing, FractalFormula::Julia>>(mapping, pixelX, pixelY, rgba);
+        break;
+    }
+}
+
+void MandelbrotCpuRenderer::shade(const PlaneMapping& mapping, double pixelX, double pixelY, float rgba[4]) const {
+    if (this->parameters.useSmoothing) {
+        this->shadeFormulaHelper<true>(mapping, pixelX, pixelY, rgba);
+    } else {
+        this->shadeFormulaHelper<false>(mapping, pixelX, pixelY, rgba);
+    }
+}
+
+bool MandelbrotCpuRenderer::agrees(const float gpu[4], const float cpu[4], float tolerance) const {
+    // After thousands of iterations the smoothed counts of two float implementations (or float and double) diverge on the chaotic boundary,
+    // so only the escape mask is compared (black pixels, or an outside ratio of 0) and the outside ratio up to one sample
+    if (this->parameters.scalarFieldOutput) {
+        const float sampleStep = 1.0f / static_cast<float>(std::max<size_t>(this->parameters.sampleOffsets.size(), 1u));
+        return (gpu[1] == 0.0f) == (cpu[1] == 0.0f) && std::abs(gpu[1] - cpu[1]) <= sampleStep + tolerance;
+    }
+    const bool gpuInside = std::max({ gpu[0], gpu[1], gpu[2] }) <= tolerance;
+    const bool cpuInside = std::max({ cpu[0], cpu[1], cpu[2] }) <= tolerance;
+    return gpuInside == cpuInside;
+}
+
+void MandelbrotCpuRenderer::renderBlock(const PlaneMapping& mapping, const TileRect& rect, uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1,
+    std::vector<bool>& done, float* rgba) const {
+    auto pixel = [&](uint32_t x, uint32_t y) { return rgba + (static_cast<size_t>(y) * rect.width + x) * 4u; };
+    auto compute = [&](uint32_t x, uint32_t y) {
+        const size_t index = static_cast<size_t>(y) * rect.width + x;
+        if (!done[index]) {
+            this->shade(mapping, static_cast<double>(rect.x + x) + 0.5, static_cast<double>(rect.y + y) + 0.5, pixel(x, y));
+            done[index] = true;
+        }
+    };
+
+    // Border
+    for (uint32_t x = x0; x <= x1; ++x) {
+        compute(x, y0);
+        compute(x, y1);
+    }
+    for (uint32_t y = y0 + 1; y < y1; ++y) {
+        compute(x0, y);
+        compute(x1, y);
+    }
+
+    const float* first = pixel(x0, y0);
+    bool uniform = true;
+    for (uint32_t x = x0; x <= x1 && uniform; ++x) {
+        uniform = std::equal(first, first + 4, pixel(x, y0)) && std::equal(first, first + 4, pixel(x, y1));
+    }
+    for (uint32_t y = y0 + 1; y < y1 && uniform; ++y) {
+        uniform = std::equal(first, first + 4, pixel(x0, y)) && std::equal(first, first + 4, pixel(x1, y));
+    }
+
+    if (uniform) {
+        for (uint32_t y = y0 + 1; y < y1; ++y) {
+            for (uint32_t x = x0 + 1; x < x1; ++x) {
+                std::copy(first, first + 4, pixel(x, y));
+                done[static_cast<size_t>(y) * rect.width + x] = true;
+            }
+        }
+    } else if (x1 - x0 + 1u > MARIANI_SILVER_MIN_BLOCK_SIZE && y1 - y0 + 1u > MARIANI_SILVER_MIN_BLOCK_SIZE) {
+        const uint32_t xMid = (x0 + x1) / 2u;
+        const uint32_t yMid = (y0 + y1) / 2u;
+        this->renderBlock(mapping, rect, x0, y0, xMid, yMid, done, rgba);
+        this->renderBlock(mapping, rect, xMid, y0, x1, yMid, done, rgba);
+        this->renderBlock(mapping, rect, x0, yMid, xMid, y1, done, rgba);
+        this->renderBlock(mapping, rect, xMid, yMid, x1, y1, done, rgba);
+    } else {
+        for (uint32_t y = y0 + 1; y < y1; ++y) {
+            for (uint32_t x = x0 + 1; x < x1; ++x) {
+                compute(x, y);
+            }
+        }
+    }
+}
+
+void MandelbrotCpuRenderer::render(size_t captureWidth, size_t captureHeight, const TileRect& rect, float* rgba) const {
+    if (!this->parameters.marianiSilver || rect.width == 0 || rect.height == 0) {
+        this->CpuRenderer::render(captureWidth, captureHeight, rect, rgba);
+        return;
+    }
+
+    // Same grid of first blocks as on the GPU, but within `rect`
+    const PlaneMapping mapping(captureWidth, captureHeight, this->zoomScale, this->centerX, this->centerY);
+    std::vector<bool> done(static_cast<size_t>(rect.width) * rect.height, false);
+    for (uint32_t y0 = 0; y0 == 0 || y0 < rect.height - 1u; y0 += MARIANI_SILVER_BLOCK_SIZE) {
+        const uint32_t y1 = std::min(y0 + MARIANI_SILVER_BLOCK_SIZE, rect.height - 1u);
+        for (uint32_t x0 = 0; x0 == 0 || x0 < rect.width - 1u; x0 += MARIANI_SILVER_BLOCK_SIZE) {
+            this->renderBlock(mapping, rect, x0, y0, std::min(x0 + MARIANI_SILVER_BLOCK_SIZE, rect.width - 1u), y1, done, rgba);
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+#ifndef MANDELBROT_CPUMANDELBROT_INCLUDED
+#define MANDELBROT_CPUMANDELBROT_INCLUDED
+
+#include <vector>
+
+#include "cpu_renderer.h"
+#include "../fractal_formula.h"
+
+/** Number types of the escape-time kernel, ordered by cost (and precision) */
+enum class CpuPrecision {
+    Float = 0,
+    Double = 1,
+    LongDouble = 2, // x87 extended precision (64 bits) on x86, the same as double on e.g. MSVC
+    DoubleDouble = 3, // about 106 bits (double_double.h)
+    Float128 = 4 // quad precision in software, only where the compiler has __float128
+};
+
+struct MandelbrotCpuParameters {
+    unsigned int maxIterations = 400;
+    float colorScale = 50.0f;
+    CpuPrecision precision = CpuPrecision::Double; // of the kernel, see `MandelbrotCpuRenderer::choosePrecision`
+    CpuPrecision gpuPrecision = CpuPrecision::Double; // closest one to the shader, the CPU renders alone if `precision` is higher
+    FractalFormula formula = FractalFormula::Mandelbrot;
+    int power = 2; // of FractalFormula::Multibrot, MIN_MULTIBROT_POWER to MAX_MULTIBROT_POWER
+    double juliaReal = -0.8; // constant of FractalFormula::Julia
+    double juliaImag = 0.156;
+    bool useSmoothing = true;
+    bool marianiSilver = false; // only iterate the borders of blocks, same as compute_shader_mandelbrot.glsl
+    bool scalarFieldOutput = false; // SCALAR_FIELD_OUTPUT, (avgSmoothCount, outsideRatio) instead of colors
+    double centerLowX = 0.0; // rest of the center after rounding to double, only used beyond double precision
+    double centerLowY = 0.0;
+    std::vector<SampleOffset> sampleOffsets;
+    std::vector<float> colormap;
+    bool cyclicColormap = true;
+};
+
+/** Port of fragment_shader_mandelbrot.glsl */
+class MandelbrotCpuRenderer : public CpuRenderer {
+public:
+    constexpr static double PRECISION_RESOLUTION_MARGIN = 256.0; // same as MandelbrotModel
+    constexpr static uint32_t MARIANI_SILVER_BLOCK_SIZE = 64; // same as MandelbrotModel::MARIANI_SILVER_BLOCK_SIZE
+    constexpr static uint32_t MARIANI_SILVER_MIN_BLOCK_SIZE = 8; // same as the compute shader
+
+    MandelbrotCpuRenderer(const MandelbrotCpuParameters& _parameters, double _zoomScale, double _centerX, double _centerY)
+        : CpuRenderer(_zoomScale, _centerX, _centerY), parameters(_parameters) { }
+
+    virtual void render(size_t captureWidth, size_t captureHeight, const TileRect& rect, float* rgba) const override;
+    virtual bool isExclusive() const override { return this->parameters.precision > this->parameters.gpuPrecision; }
+    virtual uint32_t getMinBandHeight() const override { return this->parameters.marianiSilver ? MARIANI_SILVER_BLOCK_SIZE : 1u; }
+    virtual bool agrees(const float gpu[4], const float cpu[4], float tolerance) const override;
+
+    /** Cheapest precision (at least `minimum`) that still resolves pixels of `pixelSize` at coordinates up to `magnitude` */
+    static CpuPrecision choosePrecision(double pixelSize, double magnitude, CpuPrecision minimum);
+
+    static bool isAvailable(CpuPrecision precision);
+
+protected:
+    virtual void shade(const PlaneMapping& mapping, double pixelX, double pixelY, float rgba[4]) const override;
+
+private:
+    template <typename Real, typename Policy>
+    void shadeHelper(const PlaneMapping& mapping, double pixelX, double pixelY, float rgba[4]) const;
+
+    template <typename Policy>
+    void shadePolicyHelper(const PlaneMapping& mapping, double pixelX, double pixelY, float rgba[4]) const;
+
+    template <bool Smoothing>
+    void shadeFormulaHelper(const PlaneMapping& mapping, double pixelX, double pixelY, float rgba[4]) const;
+
+    template <bool Smoothing, int Power>
+    void shadeMultibrotHelper(const PlaneMapping& mapping, double pixelX, double pixelY, float rgba[4]) const;
+
+    /** Mariani-Silver subdivision of the block from (`x0`, `y0`) to (`x1`, `y1`) (inclusive, relative to `rect`), `done` marks the computed pixels */
+    void renderBlock(const PlaneMapping& mapping, const TileRect& rect, uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1,
+        std::vector<bool>& done, float* rgba) const;
+
+    MandelbrotCpuParameters parameters;
+};
+
+#endif
@@ -0,0 +1,181 @@
+#include "cpu_renderer.h"
+
+#include <cmath>
+
+#include "../model/model_super_sampling.h"
+
+const std::vector<SampleOffset>& getStaticSampleOffsets(int superSamplingMode) {
+    // Copied from static_supersampling.glsl (as floats, like the vec2 there)
+    switch (superSamplingMode) {
+    case SuperSamplingModel::OFF: {
+        static const std::vector<SampleOffset> offsets = {
+            { 0.0f, 0.0f }
+        };
+        return offsets;
+    }
+    case SuperSamplingModel::_2: {
+        static const std::vector<SampleOffset> offsets = {
+            { -0.25f, -0.25f },
+            { 0.25f, 0.25f }
+        };
+        return offsets;
+    }
+    case SuperSamplingModel::_4: {
+        static const std::vector<SampleOffset> offsets = {
+            { -0.25f, -0.25f },
+            { 0.25f, -0.25f },
+            { -0.25f, 0.25f },
+            { 0.25f, 0.25f }
+        };
+        return offsets;
+    }
+    case SuperSamplingModel::_6: {
+        static const std::vector<SampleOffset> offsets = {
+            { -0.33f, -0.25f },
+            { 0.0f, -0.25f },
+            { 0.33f, -0.25f },
+            { -0.33f, 0.25f },
+            { 0.0f, 0.25f },
+            { 0.33f, 0.25f }
+        };
+        return offsets;
+    }
+    case SuperSamplingModel::_8: {
+        static const std::vector<SampleOffset> offsets = {
+            { 0.35f, 0.0f },
+            { -0.35f, 0.0f },
+            { 0.0f, 0.35f },
+            { 0.0f, -0.35f },
+            { 0.2474873734152916f, 0.2474873734152916f },
+            { -0.2474873734152916f, 0.2474873734152916f },
+            { 0.2474873734152916f, -0.2474873734152916f },
+            { -0.2474873734152916f, -0.2474873734152916f }
+        };
+        return offsets;
+    }
+    case SuperSamplingModel::_12: {
+        static const std::vector<SampleOffset> offsets = {
+            { -0.25f, -0.375f },
+            { 0.0f, -0.375f },
+            { 0.25f, -0.375f },
+            { -0.25f, -0.125f },
+            { 0.0f, -0.125f },
+            { 0.25f, -0.125f },
+            { -0.25f, 0.125f },
+            { 0.0f, 0.125f },
+            { 0.25f, 0.125f },
+            { -0.25f, 0.375f },
+            { 0.0f, 0.375f },
+            { 0.25f, 0.375f }
+        };
+        return offsets;
+    }
+    case SuperSamplingModel::_16: {
+        static const std::vector<SampleOffset> offsets = {
+            { -0.375f, -0.375f },
+            { 0.375f, 0.375f },
+            { -0.375f, 0.125f },
+            { -0.125f, 0.375f },
+            { 0.125f, -0.375f },
+            { 0.375f, -0.125f },
+            { -0.125f, -0.125f },
+            { 0.125f, 0.125f },
+            { -0.5f, 0.0f },
+            { 0.5f, 0.0f },
+            { 0.0f, -0.5f },
+            { 0.0f, 0.5f },
+            { -0.25f, 0.25f },
+            { 0.25f, -0.25f },
+            { -0.25f, -0.25f },
+            { 0.25f, 0.25f }
+        };
+        return offsets;
+    }
+    case SuperSamplingModel::_16_PMJ: {
+        static const std::vector<SampleOffset> offsets = {
+            { -0.026716370187168492f, -0.004929086373079206f },
+            { 0.4484750221428714f, 0.4956808432839589f },
+            { -0.13006748618511488f, 0.28351616863133655f },
+            { 0.36038210492843936f, -0.211598426880599f },
+            { -0.2727249773071365f, -0.2730566294647252f },
+            { 0.24270376568844954f, 0.21479654945808768f },
+            { -0.11750484798082572f, 0.1268997253162244f },
+            { 0.4249501577365884f, -0.3510844866084426f },
+            { -0.43578090240216727f, -0.12889371382781623f },
+            { 0.07586719938445674f, 0.3731150628855976f },
+            { -0.3197436297238845f, 0.43049516646016384f },
+            { 0.18642756070396505f, -0.06874105769335287f },
+            { -0.1888918962307623f, -0.44509281923105454f },
+            { 0.3086305612034951f, 0.05419428038956031f },
+            { -0.3117787331141107f, 0.23123407093109194f },
+            { 0.19021486592645764f, -0.28258149109763075f }
+        };
+        return offsets;
+    }
+    case SuperSamplingModel::_32_PMJ: {
+        static const std::vector<SampleOffset> offsets = {
+            { -0.026716370187168492f, -0.004929086373079206f },
+            { 0.4484750221428714f, 0.4956808432839589f },
+            { -0.13006748618511488f, 0.28351616863133655f },
+            { 0.36038210492843936f, -0.211598426880599f },
+            { -0.2727249773071365f, -0.2730566294647252f },
+            { 0.24270376568844954f, 0.21479654945808768f },
+            { -0.11750484798082572f, 0.1268997253162244f },
+            { 0.4249501577365884f, -0.3510844866084426f },
+            { -0.43578090240216727f, -0.12889371382781623f },
+            { 0.07586719938445674f, 0.3731150628855976f },
+            { -0.3197436297238845f, 0.43049516646016384f },
+            { 0.18642756070396505f, -0.06874105769335287f },
+            { -0.1888918962307623f, -0.44509281923105454f },
+            { 0.3086305612034951f, 0.05419428038956031f },
+            { -0.3117787331141107f, 0.23123407093109194f },
+            { 0.19021486592645764f, -0.28258149109763075f },
+            { -0.15809740236546804f, -0.22002085815928946f },
+            { 0.34311654153186455f, 0.28073262534571863f },
+            { -0.055887816801843404f, 0.46497030351619995f },
+            { 0.47172529509549843f, -0.0329591914670071f },
+            { -0.4702819835134301f, -0.41130995665641806f },
+            { 0.029054026419489176f, 0.09264033463652688f },
+            { -0.24895948160751946f, 0.0012394400159095875f },
+            { 0.2504900612143476f, -0.48072733079290914f },
+            { -0.34389523071133477f, -0.0957268877603979f },
+            { 0.1539052104518367f, 0.40457937885312f },
+            { -0.4034900596151533f, 0.3241683467196622f },
+            { 0.09437732355411821f, -0.1763629223755282f },
+            { -0.0836884067861996f, -0.3433563848828414f },
+            { 0.406106644941877f, 0.15966373412494317f },
+            { -0.35946050000052227f, 0.03209545229743016f },
+            { 0.14001959735680558f, -0.46828723214448686f }
+        };
+        return offsets;
+    }
+    default: {
+        static const std::vector<SampleOffset> none; // adaptive super sampling
+        return none;
+    }
+    }
+}
+
+void CpuRenderer::render(size_t captureWidth, size_t captureHeight, const TileRect& rect, float* rgba) const {
+    const PlaneMapping mapping(captureWidth, captureHeight, this->zoomScale, this->centerX, this->centerY);
+    for (uint32_t row = 0; row < rect.height; ++row) {
+        const double pixelY = static_cast<double>(rect.y + row) + 0.5; // pixel centers, like gl_FragCoord
+        for (uint32_t column = 0; column < rect.width; ++column) {
+            const double pixelX = static_cast<double>(rect.x + column) + 0.5;
+            this->shade(mapping, pixelX, pixelY, rgba + (static_cast<size_t>(row) * rect.width + column) * 4u);
+        }
+    }
+}
+
+bool CpuRenderer::agrees(const float gpu[4], const float cpu[4], float tolerance) const {
+    for (size_t c = 0; c < 4u; ++c) {
+        if (std::isnan(gpu[c]) || std::isnan(cpu[c])) {
+            if (std::isnan(gpu[c]) != std::isnan(cpu[c])) {
+                return false;
+            }
+        } else if (std::abs(gpu[c] - cpu[c]) > tolerance * std::max(1.0f, std::abs(gpu[c]))) {
+            return false;
+        }
+    }
+    return true;
+}
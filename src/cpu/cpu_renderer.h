@@ -0,0 +1,73 @@
+#pragma once
+#ifndef MANDELBROT_CPURENDERER_INCLUDED
+#define MANDELBROT_CPURENDERER_INCLUDED
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm> // for std::min
+
+#include "../screenshot.h" // for TileRect
+
+/** Maps pixel coordinates of the whole image to plane coordinates, same as `pixelCoordToPlaneCoord` in zooming_and_tiling.glsl */
+struct PlaneMapping {
+    PlaneMapping(size_t width, size_t height, double zoomScale, double _centerX, double _centerY)
+        : scale(zoomScale / static_cast<double>(std::min(width, height))),
+          halfWidth(static_cast<double>(width) / 2.0), halfHeight(static_cast<double>(height) / 2.0),
+          centerX(_centerX), centerY(_centerY)
+        { }
+
+    double toOffsetX(double pixelX) const { return this->scale * (pixelX - this->halfWidth); }
+    double toOffsetY(double pixelY) const { return this->scale * (pixelY - this->halfHeight); }
+    double toPlaneX(double pixelX) const { return this->toOffsetX(pixelX) + this->centerX; }
+    double toPlaneY(double pixelY) const { return this->toOffsetY(pixelY) + this->centerY; }
+
+    double scale;
+    double halfWidth;
+    double halfHeight;
+    double centerX;
+    double centerY;
+};
+
+struct SampleOffset {
+    float x;
+    float y;
+};
+
+/** Sub-pixel offsets of a static super sampling mode (see static_supersampling.glsl), empty for adaptive super sampling */
+const std::vector<SampleOffset>& getStaticSampleOffsets(int superSamplingMode);
+
+/**
+ * C++ port of the fragment shader of a model, renders parts of a screenshot on CPU threads while the GPU renders the rest
+ * Created by `Model::makeCpuRenderer` with the parameters and view of the model at that time, must be thread safe
+ */
+class CpuRenderer {
+public:
+    CpuRenderer(double _zoomScale, double _centerX, double _centerY) : zoomScale(_zoomScale), centerX(_centerX), centerY(_centerY) { }
+    virtual ~CpuRenderer() = default;
+
+    /** Renders `rect` of the whole image as RGBA floats, i.e. the raw fragment shader output (rows from bottom to top like glReadPixels) */
+    virtual void render(size_t captureWidth, size_t captureHeight, const TileRect& rect, float* rgba) const;
+
+    /** `true` if the GPU can't render the same image (e.g. higher precision), then the CPU threads render the whole screenshot */
+    virtual bool isExclusive() const { return false; }
+
+    /** Rows that `render` should get at least, e.g. for renderers that subdivide the rect */
+    virtual uint32_t getMinBandHeight() const { return 1u; }
+
+    /**
+     * Whether a pixel of the shader (`gpu`, 8 bit outputs as floats in [0, 1]) and of `render` (`cpu`) agree in the consistency check before hybrid screenshots
+     * By default all channels must be within `tolerance` (relative for values beyond 1)
+     */
+    virtual bool agrees(const float gpu[4], const float cpu[4], float tolerance) const;
+
+protected:
+    /** Fragment shader output for the pixel with center (`pixelX`, `pixelY`) in image coordinates (gl_FragCoord + tileOffset) */
+    virtual void shade(const PlaneMapping& mapping, double pixelX, double pixelY, float rgba[4]) const = 0;
+
+    double zoomScale;
+    double centerX;
+    double centerY;
+};
+
+#endif
@@ -0,0 +1,64 @@
+#pragma once
+#ifndef MANDELBROT_CPU_DOUBLEDOUBLE_INCLUDED
+#define MANDELBROT_CPU_DOUBLEDOUBLE_INCLUDED
+
+// Double-double arithmetic: a number is the unevaluated sum hi + lo of two doubles, which gives about 106 bits of mantissa
+// Same algorithms as res/double_float.glsl (error-free transformations of the QD library), only with double instead of float
+// Must not be compiled with -ffast-math, which may reassociate the sums and lose the low parts
+
+struct DoubleDouble {
+    double hi = 0.0;
+    double lo = 0.0;
+
+    constexpr DoubleDouble() = default;
+    constexpr DoubleDouble(double value) : hi(value), lo(0.0) { }
+    constexpr DoubleDouble(double _hi, double _lo) : hi(_hi), lo(_lo) { }
+
+    explicit constexpr operator double() const { return this->hi + this->lo; }
+
+    // a + b = s + e exactly
+    static constexpr DoubleDouble twoSum(double a, double b) {
+        const double s = a + b;
+        const double bb = s - a;
+        return { s, (a - (s - bb)) + (b - bb) };
+    }
+
+    // Same as twoSum for |a| >= |b|
+    static constexpr DoubleDouble quickTwoSum(double a, double b) {
+        const double s = a + b;
+        return { s, b - (s - a) };
+    }
+
+    // a * b = p + e exactly, with Dekker's split (std::fma is a slow library call without FMA instructions)
+    static constexpr DoubleDouble twoProd(double a, double b) {
+        constexpr double SPLIT = 134217729.0; // 2^27 + 1
+        const double ta = SPLIT * a;
+        const double aHi = ta - (ta - a);
+        const double aLo = a - aHi;
+        const double tb = SPLIT * b;
+        const double bHi = tb - (tb - b);
+        const double bLo = b - bHi;
+        const double p = a * b;
+        return { p, ((aHi*bHi - p) + aHi*bLo + aLo*bHi) + aLo*bLo };
+    }
+
+    friend constexpr DoubleDouble operator-(const DoubleDouble& a) { return { -a.hi, -a.lo }; }
+
+    friend constexpr DoubleDouble operator+(const DoubleDouble& a, const DoubleDouble& b) {
+        DoubleDouble s = twoSum(a.hi, b.hi);
+        const DoubleDouble t = twoSum(a.lo, b.lo);
+        s = quickTwoSum(s.hi, s.lo + t.hi);
+        return quickTwoSum(s.hi, s.lo + t.lo);
+    }
+
+    friend constexpr DoubleDouble operator-(const DoubleDouble& a, const DoubleDouble& b) { return a + -b; }
+
+    friend constexpr DoubleDouble operator*(const DoubleDouble& a, const DoubleDouble& b) {
+        const DoubleDouble p = twoProd(a.hi, b.hi);
+        return quickTwoSum(p.hi, p.lo + (a.hi*b.lo + a.lo*b.hi));
+    }
+
+    friend constexpr bool operator>(const DoubleDouble& a, const DoubleDouble& b) { return a.hi > b.hi || (a.hi == b.hi && a.lo > b.lo); }
+};
+
+#endif
@@ -0,0 +1,105 @@
+#pragma once
+#ifndef MANDELBROT_CPU_DOUBLEPENDULUMRHS_INCLUDED
+#define MANDELBROT_CPU_DOUBLEPENDULUMRHS_INCLUDED
+
+#include <array>
+#include <cmath>
+
+/** Math policy that uses the standard library (see `VectorizableMath` in vectorizable_math.h) */
+struct StdMath {
+    template <typename Real>
+    static Real sin(Real x) { return std::sin(x); }
+
+    template <typename Real>
+    static Real cos(Real x) { return std::cos(x); }
+};
+
+/** Port of `rhs` in double_pendulum_rhs.glsl, y = (q1, q2, v1, v2) */
+template <typename Real, typename Math = StdMath>
+struct DoublePendulumRhs {
+    Real g;
+    Real l1;
+    Real l2;
+    Real m1;
+    Real m2;
+
+    std::array<Real, 4> operator()(const std::array<Real, 4>& y) const {
+        const Real q1 = y[0];
+        const Real q2 = y[1];
+        const Real v1 = y[2];
+        const Real v2 = y[3];
+
+        const Real sinDiff = Math::sin(q1 - q2);
+        const Real cosDiff = Math::cos(q1 - q2);
+        const Real cosDiffSquared = cosDiff * cosDiff;
+        const Real a = -g*l1*(m1 + m2)*Math::sin(q1) - l1*l2*m2*(v2*v2)*sinDiff;
+        const Real b = -g*l2*m2*Math::sin(q2) + l1*l2*m2*(v1*v1)*sinDiff;
+        const Real mixedDenominator = l1*l2*m1 - l1*l2*m2*cosDiffSquared + l1*l2*m2;
+
+        return {
+            v1,
+            v2,
+            a/((l1*l1)*m1 - (l1*l1)*m2*cosDiffSquared + (l1*l1)*m2) - b*cosDiff/mixedDenominator,
+            (m1 + m2)*b/((l2*l2)*m1*m2 - (l2*l2)*(m2*m2)*cosDiffSquared + (l2*l2)*(m2*m2)) - a*cosDiff/mixedDenominator
+        };
+    }
+
+    /** Total energy (kinetic + potential) of y = (q1, q2, v1, v2), conserved by the exact solution */
+    Real energy(const std::array<Real, 4>& y) const {
+        const Real q1 = y[0];
+        const Real q2 = y[1];
+        const Real v1 = y[2];
+        const Real v2 = y[3];
+
+        const Real kinetic = Real(1.0/2.0)*(m1 + m2)*(l1*l1)*(v1*v1) + Real(1.0/2.0)*m2*(l2*l2)*(v2*v2) + m2*l1*l2*v1*v2*Math::cos(q1 - q2);
+        const Real potential = -g*l1*(m1 + m2)*Math::cos(q1) - g*l2*m2*Math::cos(q2);
+        return kinetic + potential;
+    }
+};
+
+/** Port of `dH` and `momentum` in double_pendulum_rhs.glsl, the hamiltonian form with angles q and conjugated momentums p */
+template <typename Real, typename Math = StdMath>
+struct DoublePendulumHamiltonian {
+    using Vec2 = std::array<Real, 2>;
+
+    Real g;
+    Real l1;
+    Real l2;
+    Real m1;
+    Real m2;
+
+    /** Gradients of the hamiltonian H(q, p), `dHdp` are the velocities */
+    void gradients(const Vec2& q, const Vec2& p, Vec2& dHdq, Vec2& dHdp) const {
+        const Real sinDiff = Math::sin(q[0] - q[1]);
+        const Real cosDiff = Math::cos(q[0] - q[1]);
+        const Real cosDiffSquared = cosDiff * cosDiff;
+        const Real denominator1 = (l1*l1)*m1 - (l1*l1)*m2*cosDiffSquared + (l1*l1)*m2;
+        const Real mixedDenominator = l1*l2*m1 - l1*l2*m2*cosDiffSquared + l1*l2*m2;
+        const Real denominator2 = (l2*l2)*m1*m2 - (l2*l2)*(m2*m2)*cosDiffSquared + (l2*l2)*(m2*m2);
+
+        // Part of dH/dq1 that comes from the kinetic energy, dH/dq2 has the same with opposite sign (it only depends on q1 - q2)
+        const Real kinetic =
+            p[0]*(-(l1*l1)*m2*p[0]*sinDiff*cosDiff/(denominator1*denominator1) + l1*l2*m2*p[1]*sinDiff*cosDiffSquared/(mixedDenominator*mixedDenominator) + Real(1.0/2.0)*p[1]*sinDiff/mixedDenominator)
+            + p[1]*(l1*l2*m2*p[0]*sinDiff*cosDiffSquared/(mixedDenominator*mixedDenominator) - (l2*l2)*(m2*m2)*p[1]*(m1 + m2)*sinDiff*cosDiff/(denominator2*denominator2) + Real(1.0/2.0)*p[0]*sinDiff/mixedDenominator);
+
+        dHdq = {
+            -g*l1*(-m1 - m2)*Math::sin(q[0]) + kinetic,
+            g*l2*m2*Math::sin(q[1]) - kinetic
+        };
+        dHdp = {
+            p[0]/denominator1 - p[1]*cosDiff/mixedDenominator,
+            -p[0]*cosDiff/mixedDenominator + p[1]*(m1 + m2)/denominator2
+        };
+    }
+
+    /** Conjugated momentums p = M(q) v */
+    Vec2 momentum(const Vec2& q, const Vec2& v) const {
+        const Real cosDiff = Math::cos(q[0] - q[1]);
+        return {
+            (m1 + m2)*(l1*l1)*v[0] + l1*l2*m2*cosDiff*v[1],
+            l1*l2*m2*cosDiff*v[0] + (l2*l2)*m2*v[1]
+        };
+    }
+};
+
+#endif
@@ -0,0 +1,110 @@
+#pragma once
+#ifndef MANDELBROT_CPU_ESCAPETIME_INCLUDED
+#define MANDELBROT_CPU_ESCAPETIME_INCLUDED
+
+#include <cmath>
+#include <concepts>
+#include <algorithm> // for std::max
+
+#include "../fractal_formula.h"
+
+/** Number type the escape-time kernel can iterate in, e.g. float, double, long double, __float128 or `DoubleDouble` */
+template <typename T>
+concept EscapeTimeReal = std::copyable<T> && requires(T a, T b, double d) {
+    T(d);
+    { a + b } -> std::convertible_to<T>;
+    { a - b } -> std::convertible_to<T>;
+    { a * b } -> std::convertible_to<T>;
+    { -a } -> std::convertible_to<T>;
+    { a > b } -> std::convertible_to<bool>;
+    static_cast<double>(a);
+};
+
+/** Compile time settings of `escapeTime`, so that the inner loop of every instantiation has no runtime switches */
+template <double Bailout, bool Smoothing, FractalFormula Formula = FractalFormula::Mandelbrot, int Power = 2>
+struct EscapeTimePolicy {
+    static constexpr double BAILOUT = Bailout; // squared escape radius
+    static constexpr bool SMOOTHING = Smoothing;
+    static constexpr FractalFormula FORMULA = Formula;
+    static constexpr int POWER = Formula == FractalFormula::Multibrot ? Power : 2; // d of z^d
+};
+
+struct EscapeTimeResult {
+    unsigned int count; // iteration at which the orbit escaped, 0 if it didn't within maxIterations
+    float smoothCount; // `count` with the fractional part of the smoothing (if enabled)
+};
+
+/** z -> formula(z) + c, same as `formulaStep` in mandelbrot_pixel.glsl */
+template <EscapeTimeReal Real, typename Policy>
+inline void formulaStep(Real& real, Real& imag, const Real& realSquared, const Real& imagSquared, const Real& cReal, const Real& cImag) {
+    if constexpr (Policy::FORMULA == FractalFormula::Multibrot) {
+        Real powerReal = real;
+        Real powerImag = imag;
+        for (int i = 1; i < Policy::POWER; ++i) { // same order of operations as cmul
+            const Real nextReal = powerReal * real - powerImag * imag;
+            powerImag = powerReal * imag + powerImag * real;
+            powerReal = nextReal;
+        }
+        real = powerReal + cReal;
+        imag = powerImag + cImag;
+    } else {
+        if constexpr (Policy::FORMULA == FractalFormula::BurningShip) {
+            real = real > Real(0.0) ? real : -real;
+            imag = imag > Real(0.0) ? imag : -imag;
+        } else if constexpr (Policy::FORMULA == FractalFormula::Tricorn) {
+            imag = -imag;
+        }
+        imag = real * imag + imag * real + cImag; // the squares are the same for |z| and conj(z)
+        real = realSquared - imagSquared + cReal;
+    }
+}
+
+/**
+ * Port of `calcFractal` in mandelbrot_pixel.glsl
+ * @param juliaReal The constant of FractalFormula::Julia, the start is c otherwise
+ */
+template <EscapeTimeReal Real, typename Policy>
+EscapeTimeResult escapeTime(Real startReal, Real startImag, unsigned int maxIterations, Real juliaReal = Real(0.0), Real juliaImag = Real(0.0)) {
+    const Real bailout = Real(Policy::BAILOUT);
+    const Real cReal = Policy::FORMULA == FractalFormula::Julia ? juliaReal : startReal;
+    const Real cImag = Policy::FORMULA == FractalFormula::Julia ? juliaImag : startImag;
+    Real real = startReal;
+    Real imag = startImag;
+    Real realSquared = real * real;
+    Real imagSquared = imag * imag;
+
+    // Single exit, the squares of the divergence check are reused for the next iteration
+    // An exact repetition of the saved value (replaced at iterations 1, 2, 4, ...) means a periodic orbit, which never escapes
+    Real savedReal = real;
+    Real savedImag = imag;
+    unsigned int savedAt = 1u;
+    unsigned int n = 0u;
+    while (n < maxIterations && !(realSquared + imagSquared > bailout)) {
+        formulaStep<Real, Policy>(real, imag, realSquared, imagSquared, cReal, cImag);
+        realSquared = real * real;
+        imagSquared = imag * imag;
+        ++n;
+        if (!(real > savedReal) && !(savedReal > real) && !(imag > savedImag) && !(savedImag > imag)) {
+            n = maxIterations;
+        } else if (n == savedAt) {
+            savedReal = real;
+            savedImag = imag;
+            savedAt *= 2u;
+        }
+    }
+
+    EscapeTimeResult result = { n < maxIterations ? n + 1u : 0u, 0.0f };
+    result.smoothCount = static_cast<float>(result.count);
+    if constexpr (Policy::SMOOTHING) {
+        // |z| is at least the escape radius here, so double is plenty for every Real
+        const float escapeLength = static_cast<float>(std::max(std::sqrt(static_cast<double>(realSquared + imagSquared)), 2.0));
+        if constexpr (Policy::POWER == 2) {
+            result.smoothCount += 1.0f - std::log2(std::log(escapeLength));
+        } else {
+            result.smoothCount += 1.0f - std::log(std::log(escapeLength)) / std::log(static_cast<float>(Policy::POWER));
+        }
+    }
+    return result;
+}
+
+#endif
@@ -0,0 +1,303 @@
+#pragma once
+#ifndef MANDELBROT_CPU_RK45_INCLUDED
+#define MANDELBROT_CPU_RK45_INCLUDED
+
+#include <array>
+#include <cmath>
+#include <algorithm> // for std::min, std::max
+
+// Port of the vector methods of rk45.glsl (same methods, coefficients, step size control and error codes)
+
+namespace rk45 {
+
+enum Status : unsigned int {
+    SUCCESS = 0u,
+    ERR_TOO_MANY_STEPS = 1u,
+    ERR_TOO_MANY_SAME_STEPS = 2u,
+    ERR_TAU_TOO_SMALL = 3u
+};
+
+/** Integration method, same values as RK_METHOD in rk45.glsl */
+enum Method : int {
+    FEHLBERG = 0,
+    DOPRI5 = 1,
+    DOP853 = 2
+};
+
+template <typename Real>
+struct Settings {
+    Real atol; // must be non-zero
+    Real rtol;
+    unsigned int maxSteps;
+    unsigned int maxSameSteps;
+    Real minTau;
+    Method method = FEHLBERG;
+};
+
+// Butcher tableaus of the methods. Only the strictly lower triangle of A is used, zero coefficients are skipped.
+// E are the coefficients of the error estimate, the last one belongs to rhs(y1) (only non-zero for DOPRI5, which then evaluates
+// rhs(y1) before the error estimation, the value is reused as first stage of the next step either way)
+template <Method M>
+struct Tableau;
+
+template <>
+struct Tableau<FEHLBERG> { // https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta%E2%80%93Fehlberg_method, Formula 1
+    static constexpr size_t STAGES = 6;
+    static constexpr std::array<std::array<double, STAGES>, STAGES> A = {{
+        {},
+        {2.0/9.0},
+        {1.0/12.0, 1.0/4.0},
+        {69.0/128.0, -243.0/128.0, 135.0/64.0},
+        {-17.0/12.0, 27.0/4.0, -27.0/5.0, 16.0/15.0},
+        {65.0/432.0, -5.0/16.0, 13.0/16.0, 4.0/27.0, 5.0/144.0}
+    }};
+    static constexpr std::array<double, STAGES> B = {47.0/450.0, 0.0, 12.0/25.0, 32.0/225.0, 1.0/30.0, 6.0/25.0};
+    static constexpr std::array<double, STAGES + 1> E = { // b - b_
+        47.0/450.0 - 1.0/9.0, 0.0, 12.0/25.0 - 9.0/20.0, 32.0/225.0 - 16.0/45.0, 1.0/30.0 - 1.0/12.0, 6.0/25.0, 0.0
+    };
+    static constexpr double ERROR_EXPONENT = 1.0/5.0; // 5.0 = order of rk5
+};
+
+template <>
+struct Tableau<DOPRI5> { // https://en.wikipedia.org/wiki/Dormand%E2%80%93Prince_method
+    static constexpr size_t STAGES = 6;
+    static constexpr std::array<std::array<double, STAGES>, STAGES> A = {{
+        {},
+        {1.0/5.0},
+        {3.0/40.0, 9.0/40.0},
+        {44.0/45.0, -56.0/15.0, 32.0/9.0},
+        {19372.0/6561.0, -25360.0/2187.0, 64448.0/6561.0, -212.0/729.0},
+        {9017.0/3168.0, -355.0/33.0, 46732.0/5247.0, 49.0/176.0, -5103.0/18656.0}
+    }};
+    static constexpr std::array<double, STAGES> B = {35.0/384.0, 0.0, 500.0/1113.0, 125.0/192.0, -2187.0/6784.0, 11.0/84.0};
+    static constexpr std::array<double, STAGES + 1> E = { // b - b_
+        71.0/57600.0, 0.0, -71.0/16695.0, 71.0/1920.0, -17253.0/339200.0, 22.0/525.0, -1.0/40.0
+    };
+    static constexpr double ERROR_EXPONENT = 1.0/5.0; // 5.0 = order of the error estimator + 1
+};
+
+template <>
+struct Tableau<DOP853> { // https://www.unige.ch/~hairer/prog/nonstiff/dop853.f (same coefficients as scipy)
+    static constexpr size_t STAGES = 12;
+    static constexpr std::array<std::array<double, STAGES>, STAGES> A = {{
+        {},
+        {5.26001519587677318785587544488e-2},
+        {1.97250569845378994544595329183e-2, 5.91751709536136983633785987549e-2},
+        {2.95875854768068491816892993775e-2, 0.0, 8.87627564304205475450678981324e-2},
+        {2.41365134159266685502369798665e-1, 0.0, -8.84549479328286085344864962717e-1, 9.24834003261792003115737966543e-1},
+        {3.7037037037037037037037037037e-2, 0.0, 0.0, 1.70828608729473871279604482173e-1, 1.25467687566822425016691814123e-1},
+        {3.7109375e-2, 0.0, 0.0, 1.70252211019544039314978060272e-1, 6.02165389804559606850219397283e-2, -1.7578125e-2},
+        {3.70920001185047927108779319836e-2, 0.0, 0.0, 1.70383925712239993810214054705e-1, 1.07262030446373284651809199168e-1,
+            -1.53194377486244017527936158236e-2, 8.27378916381402288758473766002e-3},
+        {6.24110958716075717114429577812e-1, 0.0, 0.0, -3.36089262944694129406857109825, -8.68219346841726006818189891453e-1,
+            2.75920996994467083049415600797e1, 2.01540675504778934086186788979e1, -4.34898841810699588477366255144e1},
+        {4.77662536438264365890433908527e-1, 0.0, 0.0, -2.48811461997166764192642586468, -5.90290826836842996371446475743e-1,
+            2.12300514481811942347288949897e1, 1.52792336328824235832596922938e1, -3.32882109689848629194453265587e1, -2.03312017085086261358222928593e-2},
+        {-9.3714243008598732571704021658e-1, 0.0, 0.0, 5.18637242884406370830023853209, 1.09143734899672957818500254654,
+            -8.14978701074692612513997267357, -1.85200656599969598641566180701e1, 2.27394870993505042818970056734e1, 2.49360555267965238987089396762,
+            -3.0467644718982195003823669022},
+        {2.27331014751653820792359768449, 0.0, 0.0, -1.05344954667372501984066689879e1, -2.00087205822486249909675718444,
+            -1.79589318631187989172765950534e1, 2.79488845294199600508499808837e1, -2.85899827713502369474065508674, -8.87285693353062954433549289258,
+            1.23605671757943030647266201528e1, 6.43392746015763530355970484046e-1}
+    }};
+    static constexpr std::array<double, STAGES> B = {
+        5.42937341165687622380535766363e-2, 0.0, 0.0, 0.0, 0.0, 4.45031289275240888144113950566, 1.89151789931450038304281599044,
+        -5.8012039600105847814672114227, 3.1116436695781989440891606237e-1, -1.52160949662516078556178806805e-1, 2.01365400804030348374776537501e-1,
+        4.47106157277725905176885569043e-2
+    };
+    static constexpr std::array<double, STAGES + 1> E = { // 5th order estimator
+        0.1312004499419488073250102996e-1, 0.0, 0.0, 0.0, 0.0, -0.1225156446376204440720569753e+1, -0.4957589496572501915214079952,
+        0.1664377182454986536961530415e+1, -0.3503288487499736816886487290, 0.3341791187130174790297318841, 0.8192320648511571246570742613e-1,
+        -0.2235530786388629525884427845e-1, 0.0
+    };
+    static constexpr std::array<double, STAGES + 1> E3 = { // 3rd order estimator, only used to correct the 5th order one
+        5.42937341165687622380535766363e-2 - 0.244094488188976377952755905512, 0.0, 0.0, 0.0, 0.0, 4.45031289275240888144113950566,
+        1.89151789931450038304281599044, -5.8012039600105847814672114227, 3.1116436695781989440891606237e-1 - 0.733846688281611857341361741547,
+        -1.52160949662516078556178806805e-1, 2.01365400804030348374776537501e-1, 4.47106157277725905176885569043e-2 - 0.220588235294117647058823529412e-1, 0.0
+    };
+    static constexpr double ERROR_EXPONENT = 1.0/8.0; // 8.0 = order of the error estimator + 1
+};
+
+// Step size control, the same for all methods
+constexpr double TAU_FAC_MIN = 1.0/3.0;
+constexpr double TAU_FAC_MAX = 2.0;
+constexpr double TAU_FAC = 0.9;
+
+template <typename Real, size_t D>
+using Vec = std::array<Real, D>;
+
+template <typename Real, size_t D>
+Real scaledNorm(const Vec<Real, D>& vector, const Vec<Real, D>& scale) {
+    Real sumOfSquares = Real(0.0);
+    for (size_t i = 0; i < D; ++i) {
+        const Real temp = vector[i] / scale[i];
+        sumOfSquares += temp * temp;
+    }
+    return std::sqrt(Real(1.0) / Real(D)) * std::sqrt(sumOfSquares);
+}
+
+/** Error of a DOP853 step from the sums of squares of the scaled 5th and 3rd order error estimates (without the factor tau) */
+template <typename Real>
+Real dop853Error(Real tau, Real err5SumOfSquares, Real err3SumOfSquares, size_t dimension) {
+    const Real denominator = err5SumOfSquares + Real(0.01)*err3SumOfSquares;
+    return denominator > Real(0.0) ? std::abs(tau) * err5SumOfSquares / std::sqrt(denominator * Real(dimension)) : Real(0.0);
+}
+
+/** New step size from the error of the last step */
+template <Method M, typename Real>
+Real newStepSize(Real tau, Real err) {
+    return tau * std::min(Real(TAU_FAC_MAX), std::max(Real(TAU_FAC_MIN), Real(TAU_FAC)*std::pow(Real(1.0) / std::max(err, Real(1e-10)), Real(Tableau<M>::ERROR_EXPONENT))));
+}
+
+/**
+ * One embedded step, `tau` is always updated to the new step size. Returns `true` and sets `y1` if the step is accepted.
+ * `z0` must be rhs(`y0`) and is set to rhs(`y1`) if the step is accepted
+ */
+template <Method M, typename Real, size_t D, typename Rhs>
+bool step(const Rhs& rhs, const Vec<Real, D>& y0, Vec<Real, D>& z0, Real& tau, const Settings<Real>& settings, Vec<Real, D>& y1) {
+    using T = Tableau<M>;
+    std::array<Vec<Real, D>, T::STAGES> K;
+    K[0] = z0;
+    for (size_t stage = 1; stage < T::STAGES; ++stage) {
+        Vec<Real, D> Y;
+        for (size_t i = 0; i < D; ++i) {
+            Real sum = Real(0.0);
+            for (size_t j = 0; j < stage; ++j) {
+                if (T::A[stage][j] != 0.0) sum += Real(T::A[stage][j])*K[j][i];
+            }
+            Y[i] = y0[i] + tau*sum;
+        }
+        K[stage] = rhs(Y);
+    }
+
+    Vec<Real, D> scale;
+    for (size_t i = 0; i < D; ++i) {
+        Real sum = Real(0.0);
+        for (size_t j = 0; j < T::STAGES; ++j) {
+            if (T::B[j] != 0.0) sum += Real(T::B[j])*K[j][i];
+        }
+        y1[i] = y0[i] + tau*sum;
+        scale[i] = settings.atol + std::max(std::abs(y0[i]), std::abs(y1[i]))*settings.rtol;
+    }
+
+    constexpr bool FSAL = T::E[T::STAGES] != 0.0; // error estimate needs rhs(y1)
+    Vec<Real, D> z1{};
+    if constexpr (FSAL) {
+        z1 = rhs(y1);
+    }
+
+    // Error estimation and calculation of optimal tau
+    Vec<Real, D> errVec;
+    for (size_t i = 0; i < D; ++i) {
+        Real sum = FSAL ? Real(T::E[T::STAGES])*z1[i] : Real(0.0);
+        for (size_t j = 0; j < T::STAGES; ++j) {
+            if (T::E[j] != 0.0) sum += Real(T::E[j])*K[j][i];
+        }
+        errVec[i] = sum;
+    }
+    Real err;
+    if constexpr (M == DOP853) {
+        Real err5SumOfSquares = Real(0.0);
+        Real err3SumOfSquares = Real(0.0);
+        for (size_t i = 0; i < D; ++i) {
+            Real sum = Real(0.0);
+            for (size_t j = 0; j < T::STAGES; ++j) {
+                if (T::E3[j] != 0.0) sum += Real(T::E3[j])*K[j][i];
+            }
+            const Real err5 = errVec[i] / scale[i];
+            const Real err3 = sum / scale[i];
+            err5SumOfSquares += err5 * err5;
+            err3SumOfSquares += err3 * err3;
+        }
+        err = dop853Error(tau, err5SumOfSquares, err3SumOfSquares, D);
+    } else {
+        for (size_t i = 0; i < D; ++i) errVec[i] *= tau;
+        err = scaledNorm(errVec, scale);
+    }
+    tau = newStepSize<M>(tau, err);
+    if (!(err < Real(1.0))) {
+        return false;
+    }
+
+    if constexpr (FSAL) {
+        z0 = z1;
+    } else {
+        z0 = rhs(y1);
+    }
+    return true;
+}
+
+/** Initial step size guess of `rk45`, `z0` must be rhs(`y0`) */
+template <typename Real, size_t D>
+Real initialStepSize(const Vec<Real, D>& y0, const Vec<Real, D>& z0, const Settings<Real>& settings) {
+    Vec<Real, D> scaleY;
+    Vec<Real, D> scaleZ;
+    for (size_t i = 0; i < D; ++i) {
+        scaleY[i] = settings.atol + std::abs(y0[i])*settings.rtol;
+        scaleZ[i] = settings.atol + std::abs(z0[i])*settings.rtol;
+    }
+    const Real tau = Real(0.01) * scaledNorm(y0, scaleY) / std::max(scaledNorm(z0, scaleZ), Real(1e-10)); // prevent divide by 0.0
+    return std::min(Real(1.0), std::max(Real(1e-8), tau)); // clamp to range [1e-8, 1.0]
+}
+
+/** Stop conditions checked before every step of `rk45`, returns `true` and sets `status` if the integration is over */
+template <typename Real>
+bool isFinished(Real t, Real tEnd, Real tau, unsigned int stepCounter, unsigned int sameStepCounter, const Settings<Real>& settings, Status& status) {
+    if (!(t < tEnd - Real(1e-9))) { // small tolerance to rounding errors
+        status = SUCCESS;
+        return true;
+    }
+    if (stepCounter >= settings.maxSteps) {
+        status = ERR_TOO_MANY_STEPS;
+        return true;
+    }
+    if (sameStepCounter >= settings.maxSameSteps) {
+        status = ERR_TOO_MANY_SAME_STEPS;
+        return true;
+    }
+    if (tau < settings.minTau && t + tau < tEnd - Real(1e-9)) { // tau too small and not close to end
+        status = ERR_TAU_TOO_SMALL;
+        return true;
+    }
+    return false;
+}
+
+/** `integrate` with a fixed method */
+template <Method M, typename Real, size_t D, typename Rhs>
+Vec<Real, D> integrateWith(const Rhs& rhs, const Vec<Real, D>& y0, Real t0, Real tEnd, const Settings<Real>& settings, Status& status) {
+    Vec<Real, D> z = rhs(y0); // rhs(y), reused from the end of the last step
+    Real tau = initialStepSize(y0, z, settings);
+    unsigned int stepCounter = 0;
+    unsigned int sameStepCounter = 0;
+    Real t = t0;
+    Vec<Real, D> y = y0;
+    Vec<Real, D> y1;
+    while (!isFinished(t, tEnd, tau, stepCounter, sameStepCounter, settings, status)) {
+        tau = std::min(tau, tEnd - t); // make sure not to overshoot tEnd
+        const Real usedTau = tau;
+        if (step<M>(rhs, y, z, tau, settings, y1)) {
+            y = y1;
+            sameStepCounter = 0;
+            t += usedTau;
+        } else {
+            sameStepCounter += 1;
+        }
+        stepCounter += 1;
+    }
+
+    return status == SUCCESS ? y : Vec<Real, D>{};
+}
+
+/** Integrates from `t0` to `tEnd` with `settings.method`, returns the state at `tEnd` (zero on failure) */
+template <typename Real, size_t D, typename Rhs>
+Vec<Real, D> integrate(const Rhs& rhs, const Vec<Real, D>& y0, Real t0, Real tEnd, const Settings<Real>& settings, Status& status) {
+    switch (settings.method) {
+    case DOPRI5: return integrateWith<DOPRI5>(rhs, y0, t0, tEnd, settings, status);
+    case DOP853: return integrateWith<DOP853>(rhs, y0, t0, tEnd, settings, status);
+    default: return integrateWith<FEHLBERG>(rhs, y0, t0, tEnd, settings, status);
+    }
+}
+
+} // namespace rk45
+
+#endif
@@ -0,0 +1,197 @@
+#pragma once
+#ifndef MANDELBROT_CPU_RK45BATCH_INCLUDED
+#define MANDELBROT_CPU_RK45BATCH_INCLUDED
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <algorithm> // for std::min, std::max
+
+#include "rk45.h"
+
+// Batched version of rk45::integrate for many initial values at once. The state of W integrations is stored as structure of arrays
+// (component i of lane l is [i][l]), so the stages of a step are loops over the lanes that the compiler vectorizes (one SIMD lane
+// per integration, the right-hand side must be inlinable and branch-free, see VectorizableMath). Every lane has its own step size,
+// time and step counters, a rejected step only repeats that lane. A finished lane is refilled with the next initial value.
+// The result of every integration is the same as of rk45::integrate with the same right-hand side (up to FMA contraction, which the
+// compiler may do differently in vectorized code, e.g. with MANDELBROT_NATIVE_ARCH)
+
+namespace rk45 {
+
+template <typename Real, size_t W>
+using Lanes = std::array<Real, W>;
+
+template <typename Real, size_t D, size_t W>
+using LaneVec = std::array<Lanes<Real, W>, D>;
+
+/** z = rhs(y) for all lanes (flatten inlines the right-hand side, otherwise the loop is not vectorized) */
+template <typename Real, size_t D, size_t W, typename Rhs>
+[[gnu::flatten]] void evaluateLanes(const Rhs& rhs, const LaneVec<Real, D, W>& y, LaneVec<Real, D, W>& z) {
+    for (size_t l = 0; l < W; ++l) {
+        Vec<Real, D> yLane;
+        for (size_t i = 0; i < D; ++i) yLane[i] = y[i][l];
+        const Vec<Real, D> zLane = rhs(yLane);
+        for (size_t i = 0; i < D; ++i) z[i][l] = zLane[i];
+    }
+}
+
+/** `step` for all lanes, `tau` is updated to the new step sizes, `accepted` is set per lane and `z1` is rhs(`y1`) */
+template <Method M, typename Real, size_t D, size_t W, typename Rhs>
+void stepLanes(const Rhs& rhs, const LaneVec<Real, D, W>& y0, const LaneVec<Real, D, W>& z0, Lanes<Real, W>& tau, const Settings<Real>& settings,
+    LaneVec<Real, D, W>& y1, LaneVec<Real, D, W>& z1, Lanes<bool, W>& accepted) {
+    using T = Tableau<M>;
+    std::array<LaneVec<Real, D, W>, T::STAGES> K;
+    LaneVec<Real, D, W> Y;
+    K[0] = z0;
+    for (size_t stage = 1; stage < T::STAGES; ++stage) {
+        for (size_t i = 0; i < D; ++i) {
+            Lanes<Real, W> sum{};
+            for (size_t j = 0; j < stage; ++j) {
+                if (T::A[stage][j] == 0.0) continue;
+                for (size_t l = 0; l < W; ++l) sum[l] += Real(T::A[stage][j])*K[j][i][l];
+            }
+            for (size_t l = 0; l < W; ++l) Y[i][l] = y0[i][l] + tau[l]*sum[l];
+        }
+        evaluateLanes(rhs, Y, K[stage]);
+    }
+
+    for (size_t i = 0; i < D; ++i) {
+        Lanes<Real, W> sum{};
+        for (size_t j = 0; j < T::STAGES; ++j) {
+            if (T::B[j] == 0.0) continue;
+            for (size_t l = 0; l < W; ++l) sum[l] += Real(T::B[j])*K[j][i][l];
+        }
+        for (size_t l = 0; l < W; ++l) y1[i][l] = y0[i][l] + tau[l]*sum[l];
+    }
+    evaluateLanes(rhs, y1, z1); // rhs(y1) of rejected lanes is not needed, but the lanes are not evaluated separately
+
+    // Error estimation, same as scaledNorm (or dop853Error)
+    Lanes<Real, W> sumOfSquares{};
+    Lanes<Real, W> err3SumOfSquares{};
+    for (size_t i = 0; i < D; ++i) {
+        Lanes<Real, W> sum{};
+        for (size_t l = 0; l < W; ++l) sum[l] = T::E[T::STAGES] != 0.0 ? Real(T::E[T::STAGES])*z1[i][l] : Real(0.0);
+        for (size_t j = 0; j < T::STAGES; ++j) {
+            if (T::E[j] == 0.0) continue;
+            for (size_t l = 0; l < W; ++l) sum[l] += Real(T::E[j])*K[j][i][l];
+        }
+
+        Lanes<Real, W> sum3{};
+        if constexpr (M == DOP853) {
+            for (size_t j = 0; j < T::STAGES; ++j) {
+                if (T::E3[j] == 0.0) continue;
+                for (size_t l = 0; l < W; ++l) sum3[l] += Real(T::E3[j])*K[j][i][l];
+            }
+        }
+
+        for (size_t l = 0; l < W; ++l) {
+            const Real scale = settings.atol + std::max(std::abs(y0[i][l]), std::abs(y1[i][l]))*settings.rtol;
+            const Real temp = (M == DOP853 ? sum[l] : tau[l]*sum[l]) / scale;
+            sumOfSquares[l] += temp * temp;
+            if constexpr (M == DOP853) {
+                const Real temp3 = sum3[l] / scale;
+                err3SumOfSquares[l] += temp3 * temp3;
+            }
+        }
+    }
+
+    // Calculation of optimal tau (std::pow is not vectorized, but it is only called once per step)
+    for (size_t l = 0; l < W; ++l) {
+        Real err;
+        if constexpr (M == DOP853) {
+            err = dop853Error(tau[l], sumOfSquares[l], err3SumOfSquares[l], D);
+        } else {
+            err = std::sqrt(Real(1.0) / Real(D)) * std::sqrt(sumOfSquares[l]);
+        }
+        tau[l] = newStepSize<M>(tau[l], err);
+        accepted[l] = err < Real(1.0);
+    }
+}
+
+/** `integrateBatch` with a fixed method */
+template <Method M, size_t W, typename Real, size_t D, typename Rhs>
+void integrateBatchWith(const Rhs& rhs, const Vec<Real, D>* y0, size_t count, Real t0, Real tEnd, const Settings<Real>& settings, Vec<Real, D>* y, Status* status) {
+    LaneVec<Real, D, W> yLanes{};
+    LaneVec<Real, D, W> zLanes{}; // rhs(y), reused from the end of the last step
+    LaneVec<Real, D, W> y1Lanes{};
+    LaneVec<Real, D, W> z1Lanes{};
+    Lanes<Real, W> t{};
+    Lanes<Real, W> tau{};
+    Lanes<Real, W> usedTau{};
+    Lanes<bool, W> accepted{};
+    std::array<unsigned int, W> stepCounter{};
+    std::array<unsigned int, W> sameStepCounter{};
+    std::array<size_t, W> job{};
+    Lanes<bool, W> active{};
+    size_t nextJob = 0;
+    size_t numActive = 0;
+
+    // Takes the next initial value (if any) into lane l
+    auto refill = [&](size_t l) {
+        active[l] = nextJob < count;
+        if (!active[l]) {
+            return;
+        }
+        job[l] = nextJob++;
+        const Vec<Real, D> z0 = rhs(y0[job[l]]);
+        for (size_t i = 0; i < D; ++i) yLanes[i][l] = y0[job[l]][i];
+        for (size_t i = 0; i < D; ++i) zLanes[i][l] = z0[i];
+        t[l] = t0;
+        tau[l] = initialStepSize(y0[job[l]], z0, settings);
+        stepCounter[l] = 0;
+        sameStepCounter[l] = 0;
+    };
+
+    for (size_t l = 0; l < W; ++l) {
+        refill(l);
+        numActive += active[l] ? 1u : 0u;
+    }
+
+    while (numActive > 0) {
+        // Stop conditions, finished lanes are refilled (a new integration may be finished right away, e.g. for tEnd = t0)
+        for (size_t l = 0; l < W; ++l) {
+            Status laneStatus;
+            while (active[l] && isFinished(t[l], tEnd, tau[l], stepCounter[l], sameStepCounter[l], settings, laneStatus)) {
+                for (size_t i = 0; i < D; ++i) y[job[l]][i] = laneStatus == SUCCESS ? yLanes[i][l] : Real(0.0);
+                status[job[l]] = laneStatus;
+                refill(l);
+                numActive -= active[l] ? 0u : 1u;
+            }
+        }
+        if (numActive == 0) {
+            break;
+        }
+
+        for (size_t l = 0; l < W; ++l) {
+            tau[l] = std::min(tau[l], tEnd - t[l]); // make sure not to overshoot tEnd
+            usedTau[l] = tau[l];
+        }
+
+        stepLanes<M>(rhs, yLanes, zLanes, tau, settings, y1Lanes, z1Lanes, accepted); // inactive lanes step on stale values, their results are ignored
+
+        for (size_t l = 0; l < W; ++l) {
+            for (size_t i = 0; i < D; ++i) yLanes[i][l] = accepted[l] ? y1Lanes[i][l] : yLanes[i][l];
+            for (size_t i = 0; i < D; ++i) zLanes[i][l] = accepted[l] ? z1Lanes[i][l] : zLanes[i][l];
+            t[l] = accepted[l] ? t[l] + usedTau[l] : t[l];
+            sameStepCounter[l] = accepted[l] ? 0u : sameStepCounter[l] + 1u;
+            stepCounter[l] += 1u;
+        }
+    }
+}
+
+/**
+ * Integrates all `count` initial values `y0` from `t0` to `tEnd` with `settings.method` on W lanes, writes the states at `tEnd`
+ * (zero on failure) to `y` and the results to `status`
+ */
+template <size_t W, typename Real, size_t D, typename Rhs>
+void integrateBatch(const Rhs& rhs, const Vec<Real, D>* y0, size_t count, Real t0, Real tEnd, const Settings<Real>& settings, Vec<Real, D>* y, Status* status) {
+    switch (settings.method) {
+    case DOPRI5: integrateBatchWith<DOPRI5, W>(rhs, y0, count, t0, tEnd, settings, y, status); break;
+    case DOP853: integrateBatchWith<DOP853, W>(rhs, y0, count, t0, tEnd, settings, y, status); break;
+    default: integrateBatchWith<FEHLBERG, W>(rhs, y0, count, t0, tEnd, settings, y, status); break;
+    }
+}
+
+} // namespace rk45
+
+#endif
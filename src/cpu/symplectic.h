@@ -0,0 +1,105 @@
+#pragma once
+#ifndef MANDELBROT_CPU_SYMPLECTIC_INCLUDED
+#define MANDELBROT_CPU_SYMPLECTIC_INCLUDED
+
+#include <array>
+#include <cmath>
+#include <algorithm> // for std::max
+
+#include "rk45.h" // for rk45::Status
+
+// Port of symplectic.glsl (same methods, number of fixed point iterations and step count)
+
+namespace symplectic {
+
+/** Fixed step methods, same values as RK_METHOD in rk45.glsl (they follow rk45::Method) */
+enum Method : int {
+    VERLET = 3,
+    YOSHIDA4 = 4
+};
+
+constexpr unsigned int ITERATIONS = 6; // fixed point iterations of the implicit Stormer-Verlet equations
+
+// Yoshida's triple jump, w1 = 1 / (2 - 2^(1/3)) and w0 = 1 - 2*w1
+constexpr double YOSHIDA_W1 = 1.3512071919596578;
+constexpr double YOSHIDA_W0 = -1.7024143839193153;
+
+inline bool isSymplectic(int method) {
+    return method == VERLET || method == YOSHIDA4;
+}
+
+template <typename Real>
+using Vec2 = std::array<Real, 2>;
+
+/** Generalized Stormer-Verlet step of `q` and `p`, `hamiltonian` provides `gradients(q, p, dHdq, dHdp)` */
+template <typename Real, typename Hamiltonian>
+void verletStep(const Hamiltonian& hamiltonian, Vec2<Real>& q, Vec2<Real>& p, Real tau) {
+    Vec2<Real> dHdq;
+    Vec2<Real> dHdp;
+    const Real halfTau = Real(0.5)*tau;
+
+    // pHalf = p - tau/2 * dHdq(q, pHalf)
+    Vec2<Real> pHalf = p;
+    for (unsigned int i = 0; i < ITERATIONS; ++i) {
+        hamiltonian.gradients(q, pHalf, dHdq, dHdp);
+        pHalf = { p[0] - halfTau*dHdq[0], p[1] - halfTau*dHdq[1] };
+    }
+
+    // qNext = q + tau/2 * (dHdp(q, pHalf) + dHdp(qNext, pHalf))
+    hamiltonian.gradients(q, pHalf, dHdq, dHdp);
+    const Vec2<Real> vStart = dHdp;
+    Vec2<Real> qNext = { q[0] + tau*vStart[0], q[1] + tau*vStart[1] };
+    for (unsigned int i = 0; i < ITERATIONS; ++i) {
+        hamiltonian.gradients(qNext, pHalf, dHdq, dHdp);
+        qNext = { q[0] + halfTau*(vStart[0] + dHdp[0]), q[1] + halfTau*(vStart[1] + dHdp[1]) };
+    }
+
+    // pNext = pHalf - tau/2 * dHdq(qNext, pHalf)
+    hamiltonian.gradients(qNext, pHalf, dHdq, dHdp);
+    q = qNext;
+    p = { pHalf[0] - halfTau*dHdq[0], pHalf[1] - halfTau*dHdq[1] };
+}
+
+/** Number of steps of size at most `tau` from `t0` to `tEnd` (computed in float like the shader) */
+inline unsigned int stepCount(float t0, float tEnd, float tau) {
+    return static_cast<unsigned int>(std::max(std::ceil((tEnd - t0) / tau - 1e-3f), 0.0f)); // small tolerance to rounding errors
+}
+
+/**
+ * Integrates y = (q1, q2, v1, v2) from `t0` to `tEnd` in `numSteps` equal steps, returns the state at `tEnd` (zero on failure).
+ * Fails only with ERR_TOO_MANY_STEPS (more than `maxSteps`)
+ */
+template <typename Real, typename Hamiltonian>
+std::array<Real, 4> integrate(const Hamiltonian& hamiltonian, Method method, const std::array<Real, 4>& y0, Real t0, Real tEnd,
+    unsigned int numSteps, unsigned int maxSteps, rk45::Status& status) {
+    if (numSteps > maxSteps) {
+        status = rk45::ERR_TOO_MANY_STEPS;
+        return {};
+    }
+    status = rk45::SUCCESS;
+    if (numSteps == 0) {
+        return y0;
+    }
+
+    const Real tau = (tEnd - t0) / static_cast<Real>(numSteps);
+    Vec2<Real> q = { y0[0], y0[1] };
+    Vec2<Real> p = hamiltonian.momentum(q, { y0[2], y0[3] });
+    for (unsigned int i = 0; i < numSteps; ++i) {
+        if (method == VERLET) {
+            verletStep(hamiltonian, q, p, tau);
+        } else {
+            verletStep(hamiltonian, q, p, Real(YOSHIDA_W1)*tau);
+            verletStep(hamiltonian, q, p, Real(YOSHIDA_W0)*tau);
+            verletStep(hamiltonian, q, p, Real(YOSHIDA_W1)*tau);
+        }
+    }
+
+    Vec2<Real> dHdq;
+    Vec2<Real> dHdp;
+    hamiltonian.gradients(q, p, dHdq, dHdp);
+    return { q[0], q[1], dHdp[0], dHdp[1] };
+}
+
+} // namespace symplectic
+
+#endif
@@ -0,0 +1,368 @@
+#include "distributed_render.h"
+
+#include <iostream>
+#include <deque>
+#include <cstring> // for std::memcpy
+#include <cstdint>
+#include <algorithm> // for std::min
+
+#if defined(__unix__) || defined(__APPLE__)
+    #define MANDELBROT_DISTRIBUTED_SUPPORTED
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <poll.h>
+    #include <signal.h>
+    #include <spawn.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+    extern char** environ;
+#endif
+
+#ifdef MANDELBROT_DISTRIBUTED_SUPPORTED
+namespace {
+
+// Protocol (native byte order, both sides run the same binary):
+//   worker -> coordinator: WorkerHello once, then for every request the TileRect followed by its pixels (rows from bottom to top)
+//   coordinator -> worker: TileRect of the requested tile, closing the pipe ends the worker
+
+constexpr char HELLO_MAGIC[4] = { 'M', 'T', 'W', '1' };
+constexpr size_t PIPELINE_DEPTH = 2; // tiles in flight per worker
+constexpr unsigned int MAX_TILE_ATTEMPTS = 3; // a tile that killed this many workers is not retried
+
+struct WorkerHello {
+    char magic[4];
+    uint32_t bytesPerPixel;
+    uint32_t maxTileSize; // after clamping to GL_MAX_TEXTURE_SIZE of the worker
+    uint32_t reserved;
+    ScalarFieldHeader header;
+};
+
+bool writeAll(int fd, const void* data, size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        const ssize_t written = ::write(fd, bytes, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+/** Returns `false` on error or end of file */
+bool readAll(int fd, void* data, size_t size) {
+    char* bytes = static_cast<char*>(data);
+    while (size > 0) {
+        const ssize_t received = ::read(fd, bytes, size);
+        if (received < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (received == 0) {
+            return false;
+        }
+        bytes += received;
+        size -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+struct Worker {
+    pid_t pid = -1;
+    int requestFd = -1; // stdin of the worker
+    int resultFd = -1;  // stdout of the worker
+    bool ready = false; // hello received
+    std::deque<size_t> inFlight; // tile indices in request order
+    std::vector<unsigned char> buffer; // received bytes of incomplete messages
+};
+
+bool spawnWorker(const std::vector<std::string>& command, Worker& worker) {
+    int requestPipe[2];
+    int resultPipe[2];
+    if (pipe(requestPipe) != 0) {
+        return false;
+    }
+    if (pipe(resultPipe) != 0) {
+        close(requestPipe[0]);
+        close(requestPipe[1]);
+        return false;
+    }
+    // no other worker may inherit these (otherwise a dead worker's pipe is never closed), dup2 clears the flag in the child
+    for (int fd : { requestPipe[0], requestPipe[1], resultPipe[0], resultPipe[1] }) {
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, requestPipe[0], STDIN_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, resultPipe[1], STDOUT_FILENO);
+
+    std::vector<char*> argv;
+    for (const std::string& arg : command) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    const int error = posix_spawnp(&worker.pid, argv[0], &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(requestPipe[0]);
+    close(resultPipe[1]);
+
+    if (error != 0) {
+        std::cerr << "    Error: failed to start worker '" << command[0] << "' (" << std::strerror(error) << ")\n";
+        close(requestPipe[1]);
+        close(resultPipe[0]);
+        worker.pid = -1;
+        return false;
+    }
+    worker.requestFd = requestPipe[1];
+    worker.resultFd = resultPipe[0];
+    return true;
+}
+
+/** Closes the pipes and waits for the worker, `kill` terminates it first (otherwise it exits because its stdin is closed) */
+void stopWorker(Worker& worker, bool kill) {
+    if (worker.pid < 0) {
+        return;
+    }
+    if (kill) {
+        ::kill(worker.pid, SIGKILL);
+    }
+    close(worker.requestFd);
+    close(worker.resultFd);
+    waitpid(worker.pid, nullptr, 0);
+    worker.pid = -1;
+    worker.requestFd = -1;
+    worker.resultFd = -1;
+}
+
+} // namespace
+#endif
+
+
+bool renderTilesDistributed(
+    const std::vector<std::vector<std::string>>& workerCommands,
+    size_t captureWidth,
+    size_t captureHeight,
+    size_t maxTileSize,
+    TileRenderer::Format format,
+    unsigned char* pixels,
+    ScalarFieldHeader& header
+) {
+#ifdef MANDELBROT_DISTRIBUTED_SUPPORTED
+    if (workerCommands.empty() || captureWidth == 0 || captureHeight == 0 || maxTileSize == 0) {
+        std::cerr << "    Error: nothing to render (no workers or empty image)\n";
+        return false;
+    }
+    const size_t bytesPerPixel = TileRenderer::getBytesPerPixel(format);
+
+    // A dead worker must not kill the coordinator
+    struct sigaction ignorePipe{};
+    struct sigaction previousPipe{};
+    ignorePipe.sa_handler = SIG_IGN;
+    sigaction(SIGPIPE, &ignorePipe, &previousPipe);
+
+    std::vector<Worker> workers(workerCommands.size());
+    size_t aliveWorkers = 0;
+    for (size_t i = 0; i < workers.size(); ++i) {
+        if (!workerCommands[i].empty() && spawnWorker(workerCommands[i], workers[i])) {
+            ++aliveWorkers;
+        }
+    }
+
+    // The tile grid is made when the first worker is ready (its texture size limit might be smaller than `maxTileSize`)
+    std::vector<TileRect> tiles;
+    std::vector<unsigned int> attempts;
+    std::deque<size_t> queue;
+    size_t gridTileSize = 0;
+    size_t finishedTiles = 0;
+    bool success = true;
+
+    auto abandonWorker = [&](Worker& worker, bool kill) {
+        stopWorker(worker, kill);
+        --aliveWorkers;
+        for (auto it = worker.inFlight.rbegin(); it != worker.inFlight.rend(); ++it) { // keep the order of the tiles
+            if (++attempts[*it] >= MAX_TILE_ATTEMPTS) {
+                std::cerr << "\n    Error: tile (" << tiles[*it].x << "," << tiles[*it].y << ") failed " << MAX_TILE_ATTEMPTS << " times\n";
+                success = false;
+            }
+            queue.push_front(*it);
+        }
+        worker.inFlight.clear();
+        worker.buffer.clear();
+    };
+
+    /** Handles the complete messages in the buffer of a worker, returns `false` if the worker sent garbage */
+    auto processMessages = [&](Worker& worker) -> bool {
+        size_t consumed = 0;
+        while (true) {
+            const unsigned char* message = worker.buffer.data() + consumed;
+            const size_t available = worker.buffer.size() - consumed;
+
+            if (!worker.ready) {
+                WorkerHello hello;
+                if (available < sizeof(hello)) break;
+                std::memcpy(&hello, message, sizeof(hello));
+                if (std::memcmp(hello.magic, HELLO_MAGIC, sizeof(HELLO_MAGIC)) != 0 || hello.bytesPerPixel != bytesPerPixel || hello.maxTileSize == 0) {
+                    std::cerr << "\n    Error: worker " << worker.pid << " does not speak the tile protocol or renders another format\n";
+                    return false;
+                }
+                if (tiles.empty()) {
+                    gridTileSize = std::min(maxTileSize, static_cast<size_t>(hello.maxTileSize));
+                    tiles = makeTileGrid(captureWidth, captureHeight, gridTileSize);
+                    attempts.assign(tiles.size(), 0u);
+                    for (size_t i = 0; i < tiles.size(); ++i) queue.push_back(i);
+                    header = hello.header;
+                } else if (hello.maxTileSize < gridTileSize) {
+                    std::cerr << "\n    Error: worker " << worker.pid << " only supports tiles up to " << hello.maxTileSize << " pixels\n";
+                    return false;
+                }
+                worker.ready = true;
+                consumed += sizeof(hello);
+                continue;
+            }
+
+            TileRect tile;
+            if (available < sizeof(tile)) break;
+            std::memcpy(&tile, message, sizeof(tile));
+            if (worker.inFlight.empty()) {
+                std::cerr << "\n    Error: worker " << worker.pid << " sent a tile that was not requested\n";
+                return false;
+            }
+            const TileRect& expected = tiles[worker.inFlight.front()];
+            if (tile.x != expected.x || tile.y != expected.y || tile.width != expected.width || tile.height != expected.height) {
+                std::cerr << "\n    Error: worker " << worker.pid << " sent a tile that was not requested\n";
+                return false;
+            }
+            const size_t tileBytes = static_cast<size_t>(tile.width) * tile.height * bytesPerPixel;
+            if (available < sizeof(tile) + tileBytes) break;
+
+            copyTileToImage(tile, message + sizeof(tile), captureWidth, captureHeight, bytesPerPixel, pixels);
+            worker.inFlight.pop_front();
+            ++finishedTiles;
+            consumed += sizeof(tile) + tileBytes;
+            std::cout << "\r    Processed " << finishedTiles << "/" << tiles.size() << " tiles (" << aliveWorkers << " workers)" << std::flush;
+        }
+        worker.buffer.erase(worker.buffer.begin(), worker.buffer.begin() + static_cast<std::ptrdiff_t>(consumed));
+        return true;
+    };
+
+    std::vector<unsigned char> readBuffer(1u << 20);
+    std::vector<pollfd> pollFds;
+    std::vector<size_t> pollWorkers;
+    while (success && (tiles.empty() || finishedTiles < tiles.size())) {
+        if (aliveWorkers == 0) {
+            std::cerr << "\n    Error: all workers died\n";
+            success = false;
+            break;
+        }
+
+        // Keep every ready worker busy
+        for (Worker& worker : workers) {
+            while (worker.pid >= 0 && worker.ready && worker.inFlight.size() < PIPELINE_DEPTH && !queue.empty()) {
+                const size_t index = queue.front();
+                if (!writeAll(worker.requestFd, &tiles[index], sizeof(TileRect))) {
+                    abandonWorker(worker, true);
+                    break;
+                }
+                queue.pop_front();
+                worker.inFlight.push_back(index);
+            }
+        }
+
+        // Wait for results
+        pollFds.clear();
+        pollWorkers.clear();
+        for (size_t i = 0; i < workers.size(); ++i) {
+            if (workers[i].pid >= 0) {
+                pollFds.push_back({ workers[i].resultFd, POLLIN, 0 });
+                pollWorkers.push_back(i);
+            }
+        }
+        if (pollFds.empty()) {
+            continue; // all workers died while sending requests
+        }
+        if (poll(pollFds.data(), pollFds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "\n    Error: poll failed (" << std::strerror(errno) << ")\n";
+            success = false;
+            break;
+        }
+
+        for (size_t p = 0; p < pollFds.size(); ++p) {
+            if (pollFds[p].revents == 0) continue;
+            Worker& worker = workers[pollWorkers[p]];
+            const ssize_t received = ::read(worker.resultFd, readBuffer.data(), readBuffer.size());
+            if (received < 0 && errno == EINTR) continue;
+            if (received <= 0) { // worker died (its error is on stderr), hand its tiles to the others
+                std::cerr << "\n    Worker " << worker.pid << " stopped, reassigning " << worker.inFlight.size() << " tiles\n";
+                abandonWorker(worker, false);
+                continue;
+            }
+            worker.buffer.insert(worker.buffer.end(), readBuffer.begin(), readBuffer.begin() + received);
+            if (!processMessages(worker)) {
+                abandonWorker(worker, true);
+            }
+        }
+    }
+    std::cout << "\n";
+
+    for (Worker& worker : workers) {
+        stopWorker(worker, !success);
+    }
+    sigaction(SIGPIPE, &previousPipe, nullptr);
+    return success;
+#else
+    (void)workerCommands; (void)captureWidth; (void)captureHeight; (void)maxTileSize; (void)format; (void)pixels; (void)header;
+    std::cerr << "    Error: distributed rendering is not supported on this platform\n";
+    return false;
+#endif
+}
+
+bool runTileWorker(
+    Model& model,
+    unsigned int vertexArray,
+    size_t captureWidth,
+    size_t captureHeight,
+    size_t maxTileSize,
+    TileRenderer::Format format,
+    const ScalarFieldHeader& header,
+    int inFd,
+    int outFd
+) {
+#ifdef MANDELBROT_DISTRIBUTED_SUPPORTED
+    TileRenderer renderer;
+    if (!renderer.create(maxTileSize, format)) {
+        return false;
+    }
+    const size_t bytesPerPixel = renderer.getBytesPerPixel();
+
+    WorkerHello hello{};
+    std::memcpy(hello.magic, HELLO_MAGIC, sizeof(HELLO_MAGIC));
+    hello.bytesPerPixel = static_cast<uint32_t>(bytesPerPixel);
+    hello.maxTileSize = static_cast<uint32_t>(renderer.getMaxTileSize());
+    hello.header = header;
+    if (!writeAll(outFd, &hello, sizeof(hello))) {
+        return false;
+    }
+
+    std::vector<unsigned char> tilePixels(renderer.getMaxTileSize() * renderer.getMaxTileSize() * bytesPerPixel);
+    TileRect tile;
+    while (readAll(inFd, &tile, sizeof(tile))) { // ends when the coordinator closes the pipe
+        if (tile.x >= captureWidth || tile.y >= captureHeight || !renderer.render(model, vertexArray, captureWidth, captureHeight, tile, tilePixels.data())) {
+            return false;
+        }
+        const size_t tileBytes = static_cast<size_t>(tile.width) * tile.height * bytesPerPixel;
+        if (!writeAll(outFd, &tile, sizeof(tile)) || !writeAll(outFd, tilePixels.data(), tileBytes)) {
+            return false;
+        }
+    }
+    return true;
+#else
+    (void)model; (void)vertexArray; (void)captureWidth; (void)captureHeight; (void)maxTileSize; (void)format; (void)header; (void)inFd; (void)outFd;
+    std::cerr << "Error: distributed rendering is not supported on this platform" << std::endl;
+    return false;
+#endif
+}
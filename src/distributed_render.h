@@ -0,0 +1,52 @@
+#pragma once
+#ifndef MANDELBROT_DISTRIBUTEDRENDER_INCLUDED
+#define MANDELBROT_DISTRIBUTEDRENDER_INCLUDED
+
+#include <string>
+#include <vector>
+
+#include "model/model.h"
+#include "scalar_field.h"
+#include "screenshot.h"
+
+/**
+ * Renders an image by handing its tiles to worker processes (see `runTileWorker`) and assembles the result
+ *
+ * Every worker is started with one of `workerCommands` (argv, looked up in PATH) and talks to the coordinator over its stdin and stdout.
+ * All workers must render the same image. Each worker has at most two tiles in flight, so it never waits for the coordinator.
+ * Tiles of a worker that dies are handed to the remaining workers.
+ * Only supported on POSIX systems
+ *
+ * @param pixels Receives the image (rows from top to bottom), must hold `captureWidth * captureHeight * TileRenderer::getBytesPerPixel(format)` bytes
+ * @param header Receives the scalar field header reported by the workers (only meaningful for `TileRenderer::RGBA32F`)
+ */
+bool renderTilesDistributed(
+    const std::vector<std::vector<std::string>>& workerCommands,
+    size_t captureWidth,
+    size_t captureHeight,
+    size_t maxTileSize,
+    TileRenderer::Format format,
+    unsigned char* pixels,
+    ScalarFieldHeader& header
+);
+
+/**
+ * Worker side of `renderTilesDistributed`: renders the tiles requested on `inFd` and sends their pixels to `outFd`
+ * Returns when the coordinator closes `inFd`
+ * The uniforms of the model (view and parameters) must be applied already
+ *
+ * @param header Scalar field header of the model (with view), is sent to the coordinator
+ */
+bool runTileWorker(
+    Model& model,
+    unsigned int vertexArray,
+    size_t captureWidth,
+    size_t captureHeight,
+    size_t maxTileSize,
+    TileRenderer::Format format,
+    const ScalarFieldHeader& header,
+    int inFd,
+    int outFd
+);
+
+#endif
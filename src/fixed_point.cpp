@@ -0,0 +1,279 @@
+#include "fixed_point.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <charconv> // for std::from_chars
+#include <algorithm>
+#include <stdexcept>
+
+static constexpr size_t GUARD_LIMBS = 2; // extra fraction limbs while parsing, so that only the final rounding matters
+
+FixedPoint::FixedPoint(long double value) {
+    if (!std::isfinite(value)) {
+        return; // 0
+    }
+
+    long double magnitude = std::fabs(value);
+    for (size_t i = LIMBS; i-- > 0;) {
+        const long double scale = std::ldexp(1.0L, 32 * (static_cast<int>(i) - static_cast<int>(FRACTION_LIMBS)));
+        const long double limb = std::floor(magnitude / scale);
+        this->limbs[i] = static_cast<uint32_t>(std::fmod(limb, 4294967296.0L));
+        magnitude -= limb * scale; // exact, since scale is a power of 2
+    }
+    if (value < 0.0L) {
+        *this = -*this;
+    }
+}
+
+FixedPoint FixedPoint::fromString(const std::string& text) {
+    // Sign, digits with an optional point, optional exponent
+    size_t pos = 0;
+    bool negative = false;
+    if (pos < text.size() && (text[pos] == '-' || text[pos] == '+')) {
+        negative = text[pos] == '-';
+        ++pos;
+    }
+    std::string digits;
+    long pointPosition = -1; // number of digits before the point
+    for (; pos < text.size(); ++pos) {
+        const char c = text[pos];
+        if (c >= '0' && c <= '9') {
+            digits += c;
+        } else if (c == '.' && pointPosition < 0) {
+            pointPosition = static_cast<long>(digits.size());
+        } else {
+            break;
+        }
+    }
+    if (digits.empty()) {
+        throw std::invalid_argument("not a number: \"" + text + "\"");
+    }
+    if (pointPosition < 0) {
+        pointPosition = static_cast<long>(digits.size());
+    }
+    if (pos < text.size() && (text[pos] == 'e' || text[pos] == 'E')) {
+        // The exponent is the whole rest, std::from_chars neither skips whitespace nor takes '+'
+        const char* first = text.data() + pos + 1;
+        const char* const last = text.data() + text.size();
+        if (first != last && *first == '+' && last - first > 1 && first[1] != '-') {
+            ++first;
+        }
+        long exponent = 0;
+        const auto [end, error] = std::from_chars(first, last, exponent);
+        if (error != std::errc() || end != last) {
+            throw std::invalid_argument("not a number: \"" + text + "\"");
+        }
+        if (exponent > std::numeric_limits<long>::max() - pointPosition) {
+            throw std::invalid_argument("number too large: \"" + text + "\"");
+        }
+        pointPosition = std::max(pointPosition + exponent, std::numeric_limits<long>::min() / 2); // far below the resolution anyway
+        pos = text.size();
+    }
+    if (pos != text.size()) {
+        throw std::invalid_argument("not a number: \"" + text + "\"");
+    }
+
+    // Drop leading zeros, the value is 0.digits * 10^pointPosition then
+    const size_t firstNonZero = digits.find_first_not_of('0');
+    if (firstNonZero == std::string::npos || pointPosition - static_cast<long>(firstNonZero) < -2 * ROUND_TRIP_DIGITS) {
+        return FixedPoint(); // 0 or below the resolution
+    }
+    pointPosition -= static_cast<long>(firstNonZero);
+    digits.erase(0, firstNonZero);
+    if (pointPosition > 19) { // 19 digits fit into uint64_t, the range is checked after rounding
+        throw std::invalid_argument("number too large: \"" + text + "\"");
+    }
+
+    // Integer part
+    uint64_t integer = 0;
+    for (long i = 0; i < pointPosition; ++i) {
+        integer = 10u * integer + static_cast<uint64_t>(static_cast<size_t>(i) < digits.size() ? digits[static_cast<size_t>(i)] - '0' : 0);
+    }
+
+    // Fraction by Horner's method from the last digit, f = (digit + f) / 10
+    std::array<uint32_t, FRACTION_LIMBS + GUARD_LIMBS> fraction{};
+    const long numFractionDigits = static_cast<long>(digits.size()) - pointPosition;
+    for (long i = numFractionDigits - 1; i >= 0; --i) {
+        const long index = pointPosition + i; // may be negative for leading zeros of the fraction
+        uint64_t remainder = index >= 0 ? static_cast<uint64_t>(digits[static_cast<size_t>(index)] - '0') : 0u;
+        for (size_t j = fraction.size(); j-- > 0;) {
+            const uint64_t current = (remainder << 32) | fraction[j];
+            fraction[j] = static_cast<uint32_t>(current / 10u);
+            remainder = current % 10u;
+        }
+    }
+
+    FixedPoint result;
+    for (size_t i = 0; i < FRACTION_LIMBS; ++i) {
+        result.limbs[i] = fraction[i + GUARD_LIMBS];
+    }
+    result.limbs[FRACTION_LIMBS] = static_cast<uint32_t>(integer);
+    result.limbs[FRACTION_LIMBS + 1] = static_cast<uint32_t>(integer >> 32);
+    if ((fraction[GUARD_LIMBS - 1] & 0x80000000u) != 0u) { // round to nearest
+        FixedPoint ulp;
+        ulp.limbs[0] = 1u;
+        result += ulp;
+    }
+    if (result.isNegative() && !(negative && -result == result)) { // 2^63 or more, only -2^63 fits (it is its own negation)
+        throw std::invalid_argument("number too large: \"" + text + "\"");
+    }
+    return negative ? -result : result;
+}
+
+std::string FixedPoint::toString(int maxFractionDigits) const {
+    const FixedPoint magnitude = this->abs();
+    const uint64_t integer = (static_cast<uint64_t>(magnitude.limbs[FRACTION_LIMBS + 1]) << 32) | magnitude.limbs[FRACTION_LIMBS];
+
+    // Exact digits of the fraction (one more than needed for rounding), by multiplying with 10
+    const int numDigits = maxFractionDigits < 0 ? ROUND_TRIP_DIGITS : maxFractionDigits;
+    std::array<uint32_t, FRACTION_LIMBS> fraction;
+    std::copy(magnitude.limbs.begin(), magnitude.limbs.begin() + FRACTION_LIMBS, fraction.begin());
+    std::vector<char> exactDigits(static_cast<size_t>(numDigits) + 1u);
+    for (char& digit : exactDigits) {
+        uint64_t carry = 0;
+        for (uint32_t& limb : fraction) {
+            const uint64_t current = 10u * static_cast<uint64_t>(limb) + carry;
+            limb = static_cast<uint32_t>(current);
+            carry = current >> 32;
+        }
+        digit = static_cast<char>(carry);
+    }
+
+    auto format = [&](int digitCount) {
+        std::vector<char> rounded(exactDigits.begin(), exactDigits.begin() + digitCount);
+        uint64_t roundedInteger = integer;
+        if (exactDigits[static_cast<size_t>(digitCount)] >= 5) { // round half up
+            size_t i = rounded.size();
+            while (i > 0 && rounded[i - 1] == 9) {
+                rounded[--i] = 0;
+            }
+            if (i > 0) {
+                ++rounded[i - 1];
+            } else {
+                ++roundedInteger;
+            }
+        }
+        while (!rounded.empty() && rounded.back() == 0) {
+            rounded.pop_back();
+        }
+
+        std::string result = (this->isNegative() && (roundedInteger != 0u || !rounded.empty()) ? "-" : "") + std::to_string(roundedInteger);
+        if (!rounded.empty()) {
+            result += '.';
+            for (char digit : rounded) {
+                result += static_cast<char>('0' + digit);
+            }
+        }
+        return result;
+    };
+
+    if (maxFractionDigits >= 0) {
+        return format(maxFractionDigits);
+    }
+    for (int digitCount = 0; digitCount < ROUND_TRIP_DIGITS; ++digitCount) { // shortest
+        std::string candidate = format(digitCount);
+        try {
+            if (FixedPoint::fromString(candidate) == *this) {
+                return candidate;
+            }
+        } catch (const std::invalid_argument&) {
+            // rounded up beyond the range, e.g. 9223372036854775807.9 to 9223372036854775808
+        }
+    }
+    return format(ROUND_TRIP_DIGITS);
+}
+
+long double FixedPoint::toLongDouble() const {
+    const FixedPoint magnitude = this->abs();
+    long double result = 0.0L;
+    for (size_t i = LIMBS; i-- > 0;) { // largest first, so that the small ones round correctly
+        result += std::ldexp(static_cast<long double>(magnitude.limbs[i]), 32 * (static_cast<int>(i) - static_cast<int>(FRACTION_LIMBS)));
+    }
+    return this->isNegative() ? -result : result;
+}
+
+bool FixedPoint::isNegative() const {
+    return (this->limbs[LIMBS - 1] & 0x80000000u) != 0u;
+}
+
+FixedPoint FixedPoint::abs() const {
+    return this->isNegative() ? -*this : *this;
+}
+
+FixedPoint FixedPoint::dividedBy(uint32_t divisor) const {
+    FixedPoint result = this->abs();
+    uint64_t remainder = 0;
+    for (size_t i = LIMBS; i-- > 0;) {
+        const uint64_t current = (remainder << 32) | result.limbs[i];
+        result.limbs[i] = static_cast<uint32_t>(current / divisor);
+        remainder = current % divisor;
+    }
+    return this->isNegative() ? -result : result;
+}
+
+FixedPoint FixedPoint::operator-() const {
+    FixedPoint result;
+    uint64_t carry = 1; // two's complement: invert and add 1
+    for (size_t i = 0; i < LIMBS; ++i) {
+        const uint64_t current = static_cast<uint64_t>(~this->limbs[i]) + carry;
+        result.limbs[i] = static_cast<uint32_t>(current);
+        carry = current >> 32;
+    }
+    return result;
+}
+
+FixedPoint& FixedPoint::operator+=(const FixedPoint& other) {
+    uint64_t carry = 0;
+    for (size_t i = 0; i < LIMBS; ++i) {
+        const uint64_t current = static_cast<uint64_t>(this->limbs[i]) + other.limbs[i] + carry;
+        this->limbs[i] = static_cast<uint32_t>(current);
+        carry = current >> 32;
+    }
+    return *this;
+}
+
+FixedPoint& FixedPoint::operator-=(const FixedPoint& other) {
+    return *this += -other;
+}
+
+FixedPoint& FixedPoint::operator*=(const FixedPoint& other) {
+    const bool negative = this->isNegative() != other.isNegative();
+    const FixedPoint a = this->abs();
+    const FixedPoint b = other.abs();
+
+    // Schoolbook multiplication of the magnitudes, the product has 2 * FRACTION_LIMBS fraction limbs
+    std::array<uint32_t, 2 * LIMBS> product{};
+    for (size_t i = 0; i < LIMBS; ++i) {
+        uint64_t carry = 0;
+        for (size_t j = 0; j < LIMBS; ++j) {
+            const uint64_t current = product[i + j] + static_cast<uint64_t>(a.limbs[i]) * b.limbs[j] + carry;
+            product[i + j] = static_cast<uint32_t>(current);
+            carry = current >> 32;
+        }
+        product[i + LIMBS] = static_cast<uint32_t>(carry);
+    }
+
+    uint64_t carry = (product[FRACTION_LIMBS - 1] & 0x80000000u) != 0u ? 1u : 0u; // round to nearest
+    for (size_t i = 0; i < LIMBS; ++i) {
+        const uint64_t current = static_cast<uint64_t>(product[i + FRACTION_LIMBS]) + carry;
+        this->limbs[i] = static_cast<uint32_t>(current);
+        carry = current >> 32;
+    }
+    if (negative) {
+        *this = -*this;
+    }
+    return *this;
+}
+
+std::strong_ordering FixedPoint::operator<=>(const FixedPoint& other) const {
+    if (this->isNegative() != other.isNegative()) {
+        return this->isNegative() ? std::strong_ordering::less : std::strong_ordering::greater;
+    }
+    for (size_t i = LIMBS; i-- > 0;) { // same sign, so two's complement compares like unsigned
+        if (this->limbs[i] != other.limbs[i]) {
+            return this->limbs[i] < other.limbs[i] ? std::strong_ordering::less : std::strong_ordering::greater;
+        }
+    }
+    return std::strong_ordering::equal;
+}
@@ -0,0 +1,75 @@
+#pragma once
+#ifndef MANDELBROT_FIXEDPOINT_INCLUDED
+#define MANDELBROT_FIXEDPOINT_INCLUDED
+
+#include <array>
+#include <string>
+#include <utility>
+#include <compare>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Signed fixed-point number with 64 integer bits and 256 fraction bits (about 77 decimal digits)
+ * Used for the view (center and zoom scale), which needs more digits than long double (about 19) at deep zooms
+ * Two's complement in 32 bit limbs, overflow of the integer part wraps around
+ */
+class FixedPoint {
+public:
+    static constexpr size_t FRACTION_LIMBS = 8;
+    static constexpr size_t INTEGER_LIMBS = 2;
+    static constexpr size_t LIMBS = FRACTION_LIMBS + INTEGER_LIMBS;
+    static constexpr int FRACTION_BITS = 32 * static_cast<int>(FRACTION_LIMBS);
+    static constexpr int ROUND_TRIP_DIGITS = 78; // fraction digits that always parse back to the same number (10^-78 < 2^-256)
+
+public:
+    FixedPoint() = default;
+
+    /** Exact for |value| < 2^63, bits below 2^-256 are cut off */
+    FixedPoint(long double value);
+
+    /**
+     * Parses a decimal number, e.g. "-0.743643887037158704752191506114774" or "1.7e-10", rounded to the nearest representable number
+     * @throws std::invalid_argument if `text` is not a number or outside of [-2^63, 2^63)
+     */
+    static FixedPoint fromString(const std::string& text);
+
+    /**
+     * @param maxFractionDigits Rounds to at most this many digits after the point, -1 gives the shortest string that parses to the same number
+     * @return Decimal string without exponent and trailing zeros, e.g. "-0.7436"
+     */
+    std::string toString(int maxFractionDigits = -1) const;
+
+    long double toLongDouble() const;
+    inline double toDouble() const { return static_cast<double>(this->toLongDouble()); }
+
+    /** Splits into hi + lo (nearest T and nearest T of the rest), e.g. the hi/lo float pairs of double_float.glsl */
+    template <typename T>
+    std::pair<T, T> split() const {
+        const T hi = static_cast<T>(this->toLongDouble());
+        return { hi, static_cast<T>((*this - FixedPoint(static_cast<long double>(hi))).toLongDouble()) };
+    }
+
+    bool isNegative() const;
+    FixedPoint abs() const;
+
+    /** Rounded toward zero */
+    FixedPoint dividedBy(uint32_t divisor) const;
+
+    FixedPoint operator-() const;
+    FixedPoint& operator+=(const FixedPoint& other);
+    FixedPoint& operator-=(const FixedPoint& other);
+    FixedPoint& operator*=(const FixedPoint& other); // rounded to nearest
+
+    friend FixedPoint operator+(FixedPoint a, const FixedPoint& b) { return a += b; }
+    friend FixedPoint operator-(FixedPoint a, const FixedPoint& b) { return a -= b; }
+    friend FixedPoint operator*(FixedPoint a, const FixedPoint& b) { return a *= b; }
+
+    bool operator==(const FixedPoint& other) const = default;
+    std::strong_ordering operator<=>(const FixedPoint& other) const;
+
+protected:
+    std::array<uint32_t, LIMBS> limbs{}; // least significant first, limbs[FRACTION_LIMBS] is the lowest limb of the integer part
+};
+
+#endif
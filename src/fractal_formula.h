@@ -0,0 +1,56 @@
+#pragma once
+#ifndef MANDELBROT_FRACTALFORMULA_INCLUDED
+#define MANDELBROT_FRACTALFORMULA_INCLUDED
+
+#include <array>
+#include <string>
+#include <cstddef>
+
+/**
+ * Iterated formulas of MandelbrotModel, the value is the FORMULA define of mandelbrot_pixel.glsl
+ * Every formula is its own shader variant and its own instantiation of the CPU kernel (escape_time.h), so the iteration has no runtime switch
+ */
+enum class FractalFormula {
+    Mandelbrot = 0, // z^2 + c
+    Multibrot = 1, // z^d + c, d = FORMULA_POWER
+    BurningShip = 2, // (|Re z| + i |Im z|)^2 + c
+    Tricorn = 3, // conj(z)^2 + c
+    Julia = 4 // z^2 + k with a fixed k, the pixel is the start value
+};
+
+struct FractalFormulaInfo {
+    FractalFormula formula;
+    const char* name; // value of the parameter "formula"
+    const char* label; // in the UI
+    bool usesPower; // FORMULA_POWER
+    bool usesJuliaConstant;
+};
+
+constexpr std::array<FractalFormulaInfo, 5> FRACTAL_FORMULAS = {{
+    { FractalFormula::Mandelbrot, "mandelbrot", "Mandelbrot z^2 + c", false, false },
+    { FractalFormula::Multibrot, "multibrot", "Multibrot z^d + c", true, false },
+    { FractalFormula::BurningShip, "burning-ship", "Burning Ship", false, false },
+    { FractalFormula::Tricorn, "tricorn", "Tricorn conj(z)^2 + c", false, false },
+    { FractalFormula::Julia, "julia", "Julia z^2 + k", false, true },
+}};
+
+// Powers of Multibrot, each is instantiated in the CPU kernel
+constexpr int MIN_MULTIBROT_POWER = 3;
+constexpr int MAX_MULTIBROT_POWER = 8;
+
+inline const FractalFormulaInfo& getFractalFormulaInfo(FractalFormula formula) {
+    return FRACTAL_FORMULAS[static_cast<size_t>(formula)];
+}
+
+/** @return false if there is no formula called `name` */
+inline bool findFractalFormula(const std::string& name, FractalFormula& formula) {
+    for (const FractalFormulaInfo& info : FRACTAL_FORMULAS) {
+        if (name == info.name) {
+            formula = info.formula;
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif
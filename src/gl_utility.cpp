@@ -0,0 +1,80 @@
+#include "gl_utility.h"
+
+#include <glad/glad.h>
+
+unsigned int createFullscreenQuad() {
+    float vertices[] = {
+        -1.0f, -1.0f,    // bottom left
+         1.0f, -1.0f,    // bottom right
+         1.0f,  1.0f,    // top right
+        -1.0f,  1.0f,    // top left
+    };
+    unsigned int indices[] = {
+        0, 1, 2,    // first triangle
+        0, 2, 3,    // second triangle
+    };
+
+    // vertex buffer
+    unsigned int vertexBuffer;
+    glGenBuffers(1, &vertexBuffer);
+
+    // element buffer
+    unsigned int elementBuffer;
+    glGenBuffers(1, &elementBuffer);
+
+    // vertex array object
+    unsigned int vertexArray;
+    glGenVertexArrays(1, &vertexArray);
+
+    // init vertex array, vertex buffer and element buffer together
+    glBindVertexArray(vertexArray);
+
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, elementBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    // unbind vertex buffer and vertex array (not necessary)
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    return vertexArray;
+}
+
+void deleteFullscreenQuad(unsigned int vertexArray) {
+    // the buffers are only referenced by the vertex array
+    glBindVertexArray(vertexArray);
+    int vertexBuffer = 0;
+    int elementBuffer = 0;
+    glGetVertexAttribiv(0, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &vertexBuffer);
+    glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &elementBuffer);
+    glBindVertexArray(0);
+
+    const unsigned int buffers[] = { static_cast<unsigned int>(vertexBuffer), static_cast<unsigned int>(elementBuffer) };
+    glDeleteVertexArrays(1, &vertexArray);
+    glDeleteBuffers(2, buffers);
+}
+
+void setViewPositionUniforms(Shader& shader, const FixedPoint& zoomScale, const FixedPoint& centerX, const FixedPoint& centerY) {
+    const auto [centerXDouble, centerXLow] = centerX.split<double>();
+    const auto [centerYDouble, centerYLow] = centerY.split<double>();
+    shader.setDouble("zoomScale", zoomScale.toDouble());
+    shader.setVec2Double("center", { centerXDouble, centerYDouble });
+    shader.setVec2Double("centerLow", { centerXLow, centerYLow }); // not in the shaders, for the CPU ports beyond double (see MandelbrotCpuRenderer)
+
+    const auto [zoomScaleHi, zoomScaleLo] = zoomScale.split<float>();
+    const auto [centerXHi, centerXLo] = centerX.split<float>();
+    const auto [centerYHi, centerYLo] = centerY.split<float>();
+    shader.setVec2("zoomScaleSplit", { zoomScaleHi, zoomScaleLo });
+    shader.setVec4("centerSplit", { centerXHi, centerXLo, centerYHi, centerYLo });
+}
+
+void applyViewUniforms(Model& model, unsigned int width, unsigned int height, const FixedPoint& zoomScale, const FixedPoint& centerX, const FixedPoint& centerY) {
+    model.shader.setVec2UInt("windowSize", { width, height });
+    setViewPositionUniforms(model.shader, zoomScale, centerX, centerY);
+    model.shader.setVec2UInt("tileOffset", { 0u, 0u }); // only needed for tiled screenshot rendering
+}
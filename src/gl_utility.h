@@ -0,0 +1,31 @@
+#pragma once
+#ifndef MANDELBROT_GLUTILITY_INCLUDED
+#define MANDELBROT_GLUTILITY_INCLUDED
+
+#include "model/model.h"
+
+/**
+ * Creates the vertex array of a quad covering the whole viewport (two triangles, draw with 6 indices)
+ * Needs a current OpenGL context with loaded function pointers
+ *
+ * @return Id of the vertex array object
+ */
+unsigned int createFullscreenQuad();
+
+/** Deletes a vertex array created by createFullscreenQuad together with its buffers */
+void deleteFullscreenQuad(unsigned int vertexArray);
+
+/**
+ * Sets zoomScale and center, as doubles and as hi/lo float pairs for USE_DOUBLE_FLOAT shaders (see zooming_and_tiling.glsl)
+ * Needs the shader to be in use
+ */
+void setViewPositionUniforms(Shader& shader, const FixedPoint& zoomScale, const FixedPoint& centerX, const FixedPoint& centerY);
+
+/**
+ * Sets the uniforms that map pixels to the plane (see zooming_and_tiling.glsl)
+ *
+ * @param zoomScale Size of the shorter side of the view in plane units
+ */
+void applyViewUniforms(Model& model, unsigned int width, unsigned int height, const FixedPoint& zoomScale, const FixedPoint& centerX, const FixedPoint& centerY);
+
+#endif
@@ -0,0 +1,96 @@
+#include "headless_context.h"
+
+#include <iostream>
+#include <cstring> // for std::strstr
+
+#include <glad/glad.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+static bool hasExtension(const char* extensions, const char* name) {
+    return extensions != nullptr && std::strstr(extensions, name) != nullptr;
+}
+
+HeadlessContext::~HeadlessContext() {
+    this->destroy();
+}
+
+bool HeadlessContext::create(int majorVersion, int minorVersion) {
+    this->destroy();
+
+    // Prefer the surfaceless platform (no X11/Wayland needed)
+    EGLDisplay eglDisplay = EGL_NO_DISPLAY;
+    const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (hasExtension(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+        auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (getPlatformDisplay != nullptr) {
+            eglDisplay = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        }
+    }
+    if (eglDisplay == EGL_NO_DISPLAY) {
+        eglDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+
+    EGLint major = 0, minor = 0;
+    if (eglDisplay == EGL_NO_DISPLAY || !eglInitialize(eglDisplay, &major, &minor)) {
+        std::cerr << "Error: failed to initialize EGL (0x" << std::hex << eglGetError() << std::dec << ")" << std::endl;
+        return false;
+    }
+    this->display = eglDisplay;
+
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        std::cerr << "Error: EGL does not support desktop OpenGL" << std::endl;
+        return false;
+    }
+
+    // No surface is needed, but a config is still required by some drivers
+    const EGLint configAttributes[] = { EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+    EGLConfig config = nullptr;
+    EGLint numConfigs = 0;
+    eglChooseConfig(eglDisplay, configAttributes, &config, 1, &numConfigs);
+    if (numConfigs == 0 && !hasExtension(eglQueryString(eglDisplay, EGL_EXTENSIONS), "EGL_KHR_no_config_context")) {
+        std::cerr << "Error: no suitable EGL config" << std::endl;
+        return false;
+    }
+
+    const EGLint contextAttributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION, majorVersion,
+        EGL_CONTEXT_MINOR_VERSION, minorVersion,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    EGLContext eglContext = eglCreateContext(eglDisplay, numConfigs > 0 ? config : EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, contextAttributes);
+    if (eglContext == EGL_NO_CONTEXT) {
+        std::cerr << "Error: failed to create an OpenGL " << majorVersion << "." << minorVersion << " context (0x"
+            << std::hex << eglGetError() << std::dec << ")" << std::endl;
+        return false;
+    }
+    this->context = eglContext;
+
+    if (!eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, eglContext)) {
+        std::cerr << "Error: failed to make the EGL context current" << std::endl;
+        return false;
+    }
+
+    if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(eglGetProcAddress))) {
+        std::cerr << "Failed to initialize GLAD" << std::endl;
+        return false;
+    }
+
+    std::cout << glGetString(GL_VERSION) << std::endl
+        << glGetString(GL_VENDOR) << ", " << glGetString(GL_RENDERER) << std::endl;
+    return true;
+}
+
+void HeadlessContext::destroy() {
+    if (this->display == nullptr) {
+        return;
+    }
+    eglMakeCurrent(this->display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (this->context != nullptr) {
+        eglDestroyContext(this->display, this->context);
+    }
+    eglTerminate(this->display);
+    this->display = nullptr;
+    this->context = nullptr;
+}
@@ -0,0 +1,30 @@
+#pragma once
+#ifndef MANDELBROT_HEADLESSCONTEXT_INCLUDED
+#define MANDELBROT_HEADLESSCONTEXT_INCLUDED
+
+/**
+ * OpenGL context without a window (EGL), e.g. for rendering on servers without a display
+ * Tries the surfaceless Mesa platform first (also works with llvmpipe, i.e. without a GPU), then the default display
+ * Rendering always goes to framebuffer objects, since there is no default framebuffer
+ */
+class HeadlessContext {
+public:
+    HeadlessContext() = default;
+    HeadlessContext(const HeadlessContext& other) = delete;
+    HeadlessContext& operator=(const HeadlessContext& other) = delete;
+    ~HeadlessContext();
+
+    /**
+     * Creates a core profile context, makes it current and loads the OpenGL functions (glad)
+     *
+     * @return Returns `false` on failure (error is printed)
+     */
+    bool create(int majorVersion = 4, int minorVersion = 3);
+    void destroy();
+
+private:
+    void* display = nullptr; // EGLDisplay
+    void* context = nullptr; // EGLContext
+};
+
+#endif
@@ -0,0 +1,3 @@
+// stb_image_write implementation, shared by the app and the command line tools
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb_image_write.h"
@@ -16,19 +16,25 @@
 
 #include "app_utility.h"
 #include "shader.h"
+#include "gl_utility.h"
 #include "saved_view.h"
 #include "screenshot.h"
+#include "zoom_video.h"
+#include "tolerance_tuning.h"
+#include "cost_counters.h"
+#include "precision_benchmark.h"
 #include "model/model_double_pendulum.h"
 #include "model/model_mandelbrot.h"
+#include "model/model_n_body.h"
 
 static GLFWwindow* window;
 //static Shader shader;
 
 static int windowWidth = 1080;
 static int windowHeight = 720;
-static long double zoomScale = 3.5L; //1.7e-10;
-static long double centerX = -2.5L; //-0.04144230656908739;
-static long double centerY = -1.75L; //1.48014290228390966;
+static FixedPoint zoomScale = 3.5L; //1.7e-10;
+static FixedPoint centerX = -2.5L; //-0.04144230656908739;
+static FixedPoint centerY = -1.75L; //1.48014290228390966;
 static unsigned int vertexArray = 0; // VAO 
 static bool zoomingIn = false; // e.g. if Ctrl + Plus is pressed, this is true
 static bool zoomingOut = false;
@@ -44,17 +50,11 @@ static std::array<float, 10> lastFrameDeltas;
 static std::size_t lastFrameArrayIndex = 0;
 static bool autoMaxIterations = false;
 
-static std::unique_ptr<Model> model; // = std::make_unique<DoublePendulumModel>(); // or MandelbrotModel
+static std::unique_ptr<Model> model; // = std::make_unique<DoublePendulumModel>(); // or MandelbrotModel, NBodyModel
 static std::unique_ptr<Model> screenshotModel; // Initialized in main (always kept in a state, where at least the vertex shader is compiled)
-static const char* availableModels[] = { "DoublePendulumModel", "MandelbrotModel" };
+static const char* availableModels[] = { "DoublePendulumModel", "MandelbrotModel", "NBodyModel" };
 static int currentSelectedModel = 1; // defined which model is used
 
-// N-Body Problem Parameters
-// constexpr const uint N = 3u;
-// constexpr const uint D = 3u;
-// static float simulationEndTime = 0.0f;
-// static float masses[N] = { 1.0f, 0.9f, 1.2f };
-
 static bool ImGuiEnabled = true;
 
 // * HELPER FUNCTIONS
@@ -95,10 +95,15 @@ static inline long double getWindowSize() {
 	return std::min(windowWidth, windowHeight);
 }
 
+/** Size of a pixel in plane units (zoomScale / getWindowSize() without rounding to long double) */
+static FixedPoint getPixelSize() {
+	return zoomScale.dividedBy(static_cast<uint32_t>(std::max(getWindowSize(), 1.0L)));
+}
+
 static ComplexNum getNumberAtPos(double x, double y) {
-	long double windowSize = getWindowSize();
-	long double real = (zoomScale / windowSize) * (x + 0.5L - windowWidth / 2.0L) + centerX;
-    long double imag = (zoomScale / windowSize) * (y + 0.5L - windowHeight / 2.0L) + centerY;
+	const FixedPoint pixelSize = getPixelSize();
+	FixedPoint real = pixelSize * (x + 0.5L - windowWidth / 2.0L) + centerX;
+	FixedPoint imag = pixelSize * (y + 0.5L - windowHeight / 2.0L) + centerY;
 	return {real, imag};
 }
 
@@ -124,13 +129,12 @@ static void zoom(long double factor) {
 		zoomFocusY = static_cast<long double>(mouseY);
 	}
 	
-	auto windowSize = getWindowSize();
-	centerX += ((1.0L - factor) * zoomScale / windowSize) * (zoomFocusX + 0.5L - windowWidth / 2.0L);
-	centerY += ((1.0L - factor) * zoomScale / windowSize) * (zoomFocusY + 0.5L - windowHeight / 2.0);
+	const FixedPoint shift = getPixelSize() * (1.0L - factor);
+	centerX += shift * (zoomFocusX + 0.5L - windowWidth / 2.0L);
+	centerY += shift * (zoomFocusY + 0.5L - windowHeight / 2.0L);
 	zoomScale *= factor;
 
-	model->shader.setDouble("zoomScale", static_cast<double>(zoomScale));
-	model->shader.setVec2Double("center", { centerX, centerY });
+	setViewPositionUniforms(model->shader, zoomScale, centerX, centerY);
 }
 
 static void jumpToView(const SavedView& savedView) {
@@ -138,8 +142,7 @@ static void jumpToView(const SavedView& savedView) {
 	centerX = savedView.getCenter().first;
 	centerY = savedView.getCenter().second;
 
-	model->shader.setDouble("zoomScale", static_cast<double>(zoomScale));
-	model->shader.setVec2Double("center", { centerX, centerY });
+	setViewPositionUniforms(model->shader, zoomScale, centerX, centerY);
 }
 
 static void applyModelSelection() {
@@ -154,6 +157,11 @@ static void applyModelSelection() {
 			model = std::make_unique<MandelbrotModel>();
 			modelChanged = true;
 		}
+	} else if (currentSelectedModel == 2) {
+		if (dynamic_cast<const NBodyModel*>(model.get()) == nullptr) {
+			model = std::make_unique<NBodyModel>();
+			modelChanged = true;
+		}
 	}
 
 	if (modelChanged) {
@@ -198,26 +206,42 @@ static void ImGuiFrame(bool& showImGuiWindow) {
 
 				model->imGuiFrame();
 
-				// ImGui::Text("N-Body Problem Controls: ");
-				// if (ImGui::SliderFloat("End-Time", &simulationEndTime, 0.0f, 0.1f)) {
-				// 	shader.setFloat("t_end", simulationEndTime);
-				// }
-				// if (ImGui::SliderFloat("mass1", &masses[0], 0.0f, +5.0f)) {
-				// 	shader.setFloatArray("m", masses, N);
-				// }
-				// if (ImGui::SliderFloat("mass2", &masses[1], 0.0f, +5.0f)) {
-				// 	shader.setFloatArray("m", masses, N);
-				// }
-				// if (ImGui::SliderFloat("mass3", &masses[2], 0.0f, +5.0f)) {
-				// 	shader.setFloatArray("m", masses, N);
-				// }
-
 				// Status info
 				if (ImGui::CollapsingHeader("Info")) {
-					ImGui::Text("Zoom: %.1Le", zoomScale);
+					ImGui::Text("Zoom: %.1Le", zoomScale.toLongDouble());
 					auto [real, imag] = getNumberAtCursor();
-					ImGui::Text("Cursor: %.10Lf + %.10Lf i", real, imag);
-					ImGui::Text("Center: %.10Lf + %.10LF i", centerX, centerY);
+					ImGui::Text("Cursor: %s + %s i", real.toString(10).c_str(), imag.toString(10).c_str());
+					ImGui::Text("Center: %s + %s i", centerX.toString(10).c_str(), centerY.toString(10).c_str());
+					if (ImGui::Button("Copy center")) { // all digits
+						ImGui::SetClipboardText((centerX.toString() + "," + centerY.toString()).c_str());
+					}
+				}
+
+				// GPU cost instrumentation (heatmap of the work per pixel and totals of the last frame)
+				if (ImGui::CollapsingHeader("Cost")) {
+					bool costInstrumentation = model->getCostInstrumentation();
+					if (ImGui::Checkbox("Heatmap and counters", &costInstrumentation)) {
+						model->setCostInstrumentation(costInstrumentation);
+						model->shader.recompile();
+					}
+					if (costInstrumentation) {
+						const CostCounters& counters = model->getCostCounters();
+						const double pixels = counters.pixels > 0u ? static_cast<double>(counters.pixels) : 1.0;
+						ImGui::Text("Pixels: %u", counters.pixels);
+						ImGui::Text("Iterations: %llu (%.1f per pixel, max %u)", static_cast<unsigned long long>(counters.totalIterations),
+							static_cast<double>(counters.totalIterations) / pixels, counters.maxPixelIterations);
+						ImGui::Text("RHS evaluations: %llu", static_cast<unsigned long long>(counters.totalRhsEvaluations));
+						ImGui::Text("Rejected steps: %llu", static_cast<unsigned long long>(counters.totalRejectedSteps));
+						for (size_t i = 0; i < 4; ++i) {
+							ImGui::Text("Status %s: %u", CostCounters::STATUS_NAMES[i], counters.statusCounts[i]);
+						}
+
+						static char costCsvFilename[128] = "cost.csv";
+						ImGui::InputText("CSV File", costCsvFilename, sizeof(costCsvFilename));
+						if (ImGui::Button("Export CSV")) {
+							appendCostCountersCsv(costCsvFilename, model->name, counters);
+						}
+					}
 				}
 				ImGui::EndTabItem();
 			}
@@ -271,11 +295,15 @@ static void ImGuiFrame(bool& showImGuiWindow) {
 				static int captureWidth  = 1920;
 				static int captureHeight = 1080;
 				static int maxTileSize = 2048;
+				static int numCpuThreads = 0;
 
 				ImGui::InputText("Filename", screenshotFilename, sizeof(screenshotFilename));
 				ImGui::InputInt("Width", &captureWidth);
 				ImGui::InputInt("Height", &captureHeight);
 				ImGui::InputInt("Max Tile Size", &maxTileSize);
+				ImGui::InputInt("CPU Threads", &numCpuThreads); // render parts of the screenshot on the CPU while the GPU renders the rest (0 = GPU only)
+				HybridRenderSettings hybrid;
+				hybrid.numCpuThreads = static_cast<unsigned int>(std::max(numCpuThreads, 0));
 
 				ImGui::Separator();
 
@@ -305,8 +333,125 @@ static void ImGuiFrame(bool& showImGuiWindow) {
 						static_cast<size_t>(std::max(captureHeight, 0)),
 						*screenshotModel,
 						vertexArray,
-						static_cast<size_t>(maxTileSize)
+						static_cast<size_t>(maxTileSize),
+						hybrid
 					);
+					if (screenshotModel->readCostCounters()) { // totals of all tiles (the CPU threads are not counted)
+						printCostCounters(std::cout, screenshotModel->getCostCounters());
+						screenshotModel->resetCostCounters();
+					}
+				}
+				ImGui::SameLine();
+				if (ImGui::Button("Tune Tolerances")) {
+					// Loosest RK45 tolerances of the screenshot model whose output looks the same as with very tight ones
+					screenshotModel->updateWithLiveModel(*model);
+					screenshotModel->shader.recompile();
+					applyGlobalUniformVariables(*screenshotModel);
+					screenshotModel->applyUniformVariables();
+
+					if (tuneTolerances(*screenshotModel, static_cast<size_t>(std::max(captureWidth, 1)), static_cast<size_t>(std::max(captureHeight, 1)), vertexArray)) {
+						screenshotModel->shader.recompile(); // AUTO may have switched the method
+					}
+					model->shader.use(); // the probes used their own shaders
+				}
+				if (ImGui::IsItemHovered()) {
+					ImGui::SetTooltip("Renders a small probe with very tight tolerances, then loosens them until the image or the energy differs");
+				}
+
+				ImGui::Separator();
+
+				// Raw scalar field (values before the colormap is applied), can be recolored with MandelbrotRecolor
+				static char scalarFieldFilename[128] = "scalar_field.msf";
+				ImGui::InputText("Scalar Field Filename", scalarFieldFilename, sizeof(scalarFieldFilename));
+				if (ImGui::Button("Export Scalar Field")) {
+					screenshotModel->updateWithLiveModel(*model);
+
+					// Use a separate copy, since the scalar field output changes the defines of the shader
+					std::unique_ptr<Model> scalarFieldModel = screenshotModel->clone();
+					ScalarFieldHeader header;
+					if (scalarFieldModel->makeScalarFieldModel(header)) {
+						scalarFieldModel->shader.compileVertexShader();
+						scalarFieldModel->shader.recompile();
+
+						applyGlobalUniformVariables(*scalarFieldModel);
+						scalarFieldModel->applyUniformVariables();
+
+						takeScalarFieldScreenshot(
+							scalarFieldFilename,
+							static_cast<size_t>(std::max(captureWidth, 0)),
+							static_cast<size_t>(std::max(captureHeight, 0)),
+							*scalarFieldModel,
+							header,
+							vertexArray,
+							static_cast<size_t>(maxTileSize),
+							hybrid
+						);
+					} else {
+						std::cout << "The model \"" << scalarFieldModel->name << "\" has no scalar field output" << std::endl;
+					}
+				}
+
+				ImGui::Separator();
+
+				// Zoom video between two saved views (uses the screenshot model and the width/height above)
+				if (ImGui::CollapsingHeader("Zoom Video")) {
+					static char videoFilename[128] = "zoom/frame.png";
+					static int videoStartView = 0;
+					static int videoEndView = 1;
+					static int videoNumFrames = 300;
+					static int videoFPS = 30;
+					static int videoFormat = ZoomVideoSettings::PNG_SEQUENCE;
+
+					auto savedViewCombo = [](const char* label, int* index) {
+						const int numViews = static_cast<int>(SavedView::allViews.size());
+						const char* preview = (*index >= 0 && *index < numViews) ? SavedView::allViews[static_cast<size_t>(*index)].getName().c_str() : "";
+						if (ImGui::BeginCombo(label, preview)) {
+							for (int v = 0; v < numViews; ++v) {
+								ImGui::PushID(v);
+								if (ImGui::Selectable(SavedView::allViews[static_cast<size_t>(v)].getName().c_str(), *index == v)) {
+									*index = v;
+								}
+								ImGui::PopID();
+							}
+							ImGui::EndCombo();
+						}
+					};
+					savedViewCombo("Start View", &videoStartView);
+					savedViewCombo("End View", &videoEndView);
+					ImGui::InputInt("Frames", &videoNumFrames);
+					ImGui::InputInt("FPS", &videoFPS);
+					ImGui::RadioButton("PNG Sequence", &videoFormat, ZoomVideoSettings::PNG_SEQUENCE);
+					ImGui::SameLine();
+					ImGui::RadioButton("Y4M", &videoFormat, ZoomVideoSettings::Y4M);
+					ImGui::InputText("Video Filename", videoFilename, sizeof(videoFilename));
+
+					const int numViews = static_cast<int>(SavedView::allViews.size());
+					if (ImGui::Button("Render Zoom Video")) {
+						if (videoStartView < 0 || videoStartView >= numViews || videoEndView < 0 || videoEndView >= numViews) {
+							std::cout << "Select a start and an end view first" << std::endl;
+						} else {
+							screenshotModel->updateWithLiveModel(*model);
+							screenshotModel->shader.recompile();
+							applyGlobalUniformVariables(*screenshotModel);
+							screenshotModel->applyUniformVariables();
+
+							ZoomVideoSettings settings;
+							settings.width = static_cast<size_t>(std::max(captureWidth, 1));
+							settings.height = static_cast<size_t>(std::max(captureHeight, 1));
+							settings.numFrames = static_cast<size_t>(std::max(videoNumFrames, 1));
+							settings.fps = static_cast<unsigned int>(std::max(videoFPS, 1));
+							settings.format = static_cast<ZoomVideoSettings::Format>(videoFormat);
+							settings.maxTileSize = static_cast<size_t>(maxTileSize);
+							renderZoomVideo(
+								videoFilename,
+								SavedView::allViews[static_cast<size_t>(videoStartView)],
+								SavedView::allViews[static_cast<size_t>(videoEndView)],
+								*screenshotModel,
+								vertexArray,
+								settings
+							);
+						}
+					}
 				}
 
 				ImGui::EndTabItem();
@@ -476,7 +621,7 @@ static void mouseButtonCallbackGLFW(GLFWwindow* _window, int button, int action,
 		const auto num = getNumberAtCursor();
         centerX = num.first;
 		centerY = num.second;
-		model->shader.setVec2Double("center", { centerX, centerY });
+		setViewPositionUniforms(model->shader, zoomScale, centerX, centerY);
 	}
 }
 
@@ -572,15 +717,7 @@ static void initImGui() {
 
 static void applyGlobalUniformVariables(Model& usedModel) {
 	// Coordinate Mapping
-	usedModel.shader.setVec2UInt("windowSize", { windowWidth, windowHeight });
-	usedModel.shader.setDouble("zoomScale", static_cast<double>(zoomScale));
-	usedModel.shader.setVec2Double("center", { centerX, centerY });
-	usedModel.shader.setVec2UInt("tileOffset", { 0u, 0u }); // only needed for tiled screenshot rendering
-
-	// N Body Problem
-	// shader.setFloat("t_end", simulationEndTime);
-	// // shader.setFloat("g", gravitationalConstant);
-	// shader.setFloatArray("m", masses, N);
+	applyViewUniforms(usedModel, static_cast<unsigned int>(windowWidth), static_cast<unsigned int>(windowHeight), zoomScale, centerX, centerY);
 }
 
 
@@ -599,44 +736,8 @@ int main()
 	// Initialize model and screenshotModel
 	applyModelSelection(); // initializes the model
 
-	float vertices[] = {
-		-1.0f, -1.0f,	// bottom left
-		 1.0f, -1.0f,	// bottom right
-		 1.0f,  1.0f,	// top right
-		-1.0f,  1.0f,	// top left
-	};
-	unsigned int indices[] = {
-		0, 1, 2,	// first triangle
-		0, 2, 3,	// second triangle
-	};
-
-	// vertex buffer
-	unsigned int vertexBuffer;
-	glGenBuffers(1, &vertexBuffer);
-
-	// element buffer
-	unsigned int elementBuffer;
-	glGenBuffers(1, &elementBuffer);
-
-	// vertex array object
-	// unsigned int vertexArray;
-	glGenVertexArrays(1, &vertexArray);
-
-	// init vertex array, vertex buffer and element buffer together
-	glBindVertexArray(vertexArray);
-
-	glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, elementBuffer);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-
-	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
-	glEnableVertexAttribArray(0);
-
-	// unbind vertex buffer and vertex array (not necessary)
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
+	vertexArray = createFullscreenQuad();
+	printPrecisionBenchmark(std::cout, getPrecisionBenchmark()); // used by the automatic precision of MandelbrotModel
 
 	applyGlobalUniformVariables(*model);
 	model->applyUniformVariables();
@@ -665,6 +766,9 @@ int main()
 		glBindVertexArray(vertexArray);
 		model->drawCall();
 		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, (void*)0);
+		if (model->readCostCounters()) { // only with cost instrumentation
+			model->resetCostCounters();
+		}
 
 		if (ImGuiEnabled)
 			ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
@@ -700,9 +804,7 @@ int main()
 	}
 
 	// delete all resources (not necessary)
-	glDeleteVertexArrays(1, &vertexArray);
-	glDeleteBuffers(1, &vertexBuffer);
-	glDeleteBuffers(1, &elementBuffer);
+	deleteFullscreenQuad(vertexArray);
 	model->shader.destroy(); // destroy before destroying the OpenGLs context
 
 	ImGui_ImplOpenGL3_Shutdown();
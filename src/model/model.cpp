@@ -1,5 +1,14 @@
 #include "model.h"
 
+#include "../cpu/cpu_renderer.h"
+
+#include <string> // for std::stoi, std::stof
+#include <stdexcept> // for std::invalid_argument
+
+namespace {
+constexpr size_t COST_COUNTER_BUFFER_SIZE = 12; // uints of the CostCounters block in cost_instrumentation.glsl
+}
+
 void Model::applyUniformVariables() { }
 void Model::imGuiFrame() { }
 void Model::imGuiScreenshotFrame() { }
@@ -8,6 +17,104 @@ std::unique_ptr<Model> Model::clone() const {
 }
 void Model::makeScreenshotModel() { }
 void Model::makeScreenshotModel(const Model& otherScreenshotModel) { (void)otherScreenshotModel; }
-void Model::updateWithLiveModel(const Model& liveModel) { (void)liveModel; }
-void Model::drawCall() { }
+void Model::updateWithLiveModel(const Model& liveModel) {
+    if (this->costInstrumentation != liveModel.costInstrumentation) {
+        this->setCostInstrumentation(liveModel.costInstrumentation);
+    }
+    this->costHeatmapMax = liveModel.costHeatmapMax;
+    this->costCounters = liveModel.costCounters; // scale of the heatmap
+}
+bool Model::makeScalarFieldModel(ScalarFieldHeader& header) { (void)header; return false; }
+bool Model::setParameter(const std::string& parameter, const std::string& value) {
+    if (parameter == "costInstrumentation") {
+        this->setCostInstrumentation(std::stoi(value) != 0);
+        return true;
+    }
+    if (parameter == "costHeatmapMax") {
+        const float heatmapMax = std::stof(value);
+        if (heatmapMax < 0.0f) {
+            throw std::invalid_argument("costHeatmapMax must not be negative");
+        }
+        this->costHeatmapMax = heatmapMax;
+        return true;
+    }
+    return false;
+}
+std::unique_ptr<CpuRenderer> Model::makeCpuRenderer() { return nullptr; }
+
+void Model::drawCall() {
+    if (!this->costInstrumentation) {
+        return;
+    }
+
+    if (!this->costCounterBuffer) {
+        this->costCounterBuffer = std::shared_ptr<GLuint>(new GLuint(0), [](GLuint* ptr) {
+            glDeleteBuffers(1, ptr);
+            delete ptr;
+        });
+        glGenBuffers(1, this->costCounterBuffer.get());
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, *this->costCounterBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, COST_COUNTER_BUFFER_SIZE * sizeof(GLuint), nullptr, GL_DYNAMIC_READ);
+        glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    }
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, *this->costCounterBuffer); // binding of CostCounters in cost_instrumentation.glsl
+
+    float heatmapMax = this->costHeatmapMax;
+    if (heatmapMax <= 0.0f) { // maximum of the last frame, or a fixed scale for the first one (e.g. a single screenshot)
+        heatmapMax = this->costCounters.maxPixelIterations > 0u ? static_cast<float>(this->costCounters.maxPixelIterations) : 100'000.0f;
+    }
+    this->shader.setFloat("cost_heatmap_max", heatmapMax);
+}
+
+void Model::setCostInstrumentation(bool enabled) {
+    this->costInstrumentation = enabled;
+    if (enabled) {
+        this->shader.define("COST_INSTRUMENTATION", "");
+    } else {
+        this->shader.undefine("COST_INSTRUMENTATION");
+        this->costCounterBuffer.reset();
+    }
+}
+
+bool Model::getCostInstrumentation() const {
+    return this->costInstrumentation;
+}
+
+bool Model::readCostCounters() {
+    if (!this->costCounterBuffer) {
+        return false;
+    }
+
+    GLuint data[COST_COUNTER_BUFFER_SIZE];
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT); // the atomics of the shaders must be visible
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, *this->costCounterBuffer);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(data), data);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    auto total = [&data](size_t i) { return static_cast<uint64_t>(data[2 + 2*i]) | (static_cast<uint64_t>(data[3 + 2*i]) << 32); };
+    this->costCounters.pixels = data[0];
+    this->costCounters.maxPixelIterations = data[1];
+    this->costCounters.totalIterations = total(0);
+    this->costCounters.totalRhsEvaluations = total(1);
+    this->costCounters.totalRejectedSteps = total(2);
+    for (size_t i = 0; i < 4; ++i) {
+        this->costCounters.statusCounts[i] = data[8 + i];
+    }
+    return true;
+}
+
+void Model::resetCostCounters() {
+    if (!this->costCounterBuffer) {
+        return;
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, *this->costCounterBuffer);
+    glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+const CostCounters& Model::getCostCounters() const {
+    return this->costCounters;
+}
+
 Model::~Model() { }
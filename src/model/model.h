@@ -5,11 +5,21 @@
 #include <memory> // for std::unique_ptr
 
 #include "../shader.h"
+#include "../scalar_field.h"
+#include "../cost_counters.h"
+
+class CpuRenderer;
 
 class Model {
 public:
     Model(const std::string& _name, Shader&& _shader) : name(_name), shader(std::move(_shader)) { }
-    Model(const Model& other) : name(other.name), shader(other.shader) { }
+    Model(const Model& other)
+        : name(other.name)
+        , shader(other.shader)
+        , costInstrumentation(other.costInstrumentation)
+        , costHeatmapMax(other.costHeatmapMax)
+        , costCounters(other.costCounters)
+    { }
     Model(Model&& other) = delete;
 
     Model& operator=(const Model& other) = delete;
@@ -38,14 +48,45 @@ public:
         (usually the same ones that `makeScreenshotModel` touches) */
     virtual void updateWithLiveModel(const Model& liveModel);
 
+    /** Modify this model (usually a copy of the screenshot model) to output its raw scalar field into a float texture instead of colors.
+        Fills in the model specific parts of the header (kind, channels, params).
+        Returns `false` if the model has no scalar field output */
+    virtual bool makeScalarFieldModel(ScalarFieldHeader& header);
+
+    /** Set a parameter by name from a string, e.g. from the command line ("maxIterations", "400").
+        Defines are changed, but the shader is neither recompiled nor are the uniforms applied.
+        Returns `false` if the model has no parameter of that name, may throw `std::invalid_argument` or `std::out_of_range` for bad values */
+    virtual bool setParameter(const std::string& parameter, const std::string& value);
+
+    /** C++ port of the current shader (parameters, defines and view uniforms), which renders screenshot tiles on CPU threads.
+        Returns `nullptr` if the model or its current settings (e.g. adaptive super sampling) have no CPU port */
+    virtual std::unique_ptr<CpuRenderer> makeCpuRenderer();
+
     /** Gets called right before glDrawElements, e.g. for binding a texture */
     virtual void drawCall();
 
+    /** Diagnostic output (see cost_instrumentation.glsl): the shader outputs a heatmap of the work per pixel and sums up the totals.
+        Changes a define, the shader needs to be recompiled */
+    void setCostInstrumentation(bool enabled);
+    bool getCostInstrumentation() const;
+
+    /** Reads the totals of all draw calls since the last `resetCostCounters` (waits for the GPU), see `getCostCounters`.
+        Returns `false` if nothing was drawn with cost instrumentation yet */
+    bool readCostCounters();
+    void resetCostCounters();
+    const CostCounters& getCostCounters() const;
+
     virtual ~Model();
 
 public:
     std::string name;
     Shader shader;
+
+protected:
+    bool costInstrumentation = false;
+    float costHeatmapMax = 0.0f; // iterations of a pixel at the end of the heatmap, 0 means the maximum of the last read counters (see `drawCall`)
+    CostCounters costCounters; // last read totals
+    std::shared_ptr<GLuint> costCounterBuffer; // SSBO of the counters, created by the first draw call, not shared by copies
 };
 
 #endif
@@ -5,6 +5,7 @@
 #include <utility> // for std::pair
 #include <array> // for std::array
 #include <string> // for stoi
+#include <stdexcept> // for std::invalid_argument
 
 #include <ImGui/imgui.h>
 
@@ -121,6 +122,8 @@ void ColormapModel::makeScreenshotModel(const Model& otherScreenshotModel) {
 }
 
 void ColormapModel::drawCall() {
+    this->Model::drawCall();
+
     // bind colormap for render
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, *(this->colormapTexture));
@@ -131,6 +134,19 @@ void ColormapModel::drawCall() {
 }
 
 
+bool ColormapModel::setParameter(const std::string& parameter, const std::string& value) {
+    if (parameter == "colormap") { // "<group>/<name>", e.g. "Cyclic/cet_colorwheel"
+        const size_t slash = value.find('/');
+        if (slash == std::string::npos || findColormap(value.substr(0, slash), value.substr(slash + 1)) == nullptr) {
+            throw std::invalid_argument("unknown colormap " + value);
+        }
+        this->selectColormap(value.substr(0, slash), value.substr(slash + 1));
+        return true;
+    }
+    return this->Model::setParameter(parameter, value);
+}
+
+
 void ColormapModel::initializeColormapTexture(const std::string& defaultGroup, const std::string& defaultName) {
     this->selectedColormapGroup = defaultGroup;
     this->selectedColormapName = defaultName;
@@ -144,25 +160,15 @@ void ColormapModel::initializeColormapTexture(const std::string& defaultGroup, c
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-    const float* data = nullptr;
-    for (const auto& group : colormaps) {
-        if (group.first == defaultGroup) {
-            for (const auto& map : group.second) {
-                if (map.first == defaultName) {
-                    data = map.second.data();
-                    break;
-                }
-            }
-        }
-    }
-
+    const std::vector<float>* colormap = findColormap(defaultGroup, defaultName);
+    const float* data = colormap ? colormap->data() : nullptr;
 
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB32F, 256, 1, 0, GL_RGB, GL_FLOAT, data);
 }
 
 void ColormapModel::applyWrapMode(const std::string& group) {
     // If the group is "cyclic", set OpenGL to repeat the texture
-    if (group == "Cyclic") {
+    if (isCyclicColormapGroup(group)) {
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
     } 
@@ -173,27 +179,17 @@ void ColormapModel::applyWrapMode(const std::string& group) {
     }
 }
 
-void ColormapModel::selectColormap(const std::string& group, const std::string& name) {
-    const float* data = nullptr;
-    for (const auto& g : colormaps) {
-        if (g.first == group) {
-            for (const auto& m : g.second) {
-                if (m.first == name) {
-                    data = m.second.data();
-                    break;
-                }
-            }
-        }
-    }
-    if (!data) return;
+void ColormapModel::selectColormap(const std::string& _group, const std::string& _name) {
+    const std::vector<float>* colormap = findColormap(_group, _name);
+    if (!colormap) return;
 
-    this->selectedColormapGroup = group;
-    this->selectedColormapName = name;
+    this->selectedColormapGroup = _group;
+    this->selectedColormapName = _name;
     
     glBindTexture(GL_TEXTURE_2D, *(this->colormapTexture));
     
     // Update the wrap mode dynamically for the new colormap
-    applyWrapMode(group);
+    applyWrapMode(_group);
 
-    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 256, 1, GL_RGB, GL_FLOAT, data);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 256, 1, GL_RGB, GL_FLOAT, colormap->data());
 }
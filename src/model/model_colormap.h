@@ -6,7 +6,6 @@
 
 #include <memory>
 #include <glad/glad.h>
-#include <GLFW/glfw3.h>
 
 #include "../colormaps.h"
 
@@ -22,8 +21,9 @@ public:
     virtual void makeScreenshotModel() override;
     virtual void makeScreenshotModel(const Model& otherScreenshotModel) override;
     virtual void drawCall() override;
+    virtual bool setParameter(const std::string& parameter, const std::string& value) override;
     
-    void selectColormap(const std::string& group, const std::string& name);
+    void selectColormap(const std::string& _group, const std::string& _name);
 
 protected:
     void setDefaultScreenshotParameters();
@@ -1,25 +1,38 @@
 #include "model_double_pendulum.h"
 
+#include <cmath> // for std::pow
+#include <numeric> // for std::iota
+#include <algorithm> // for std::stable_sort, std::min
+
 #include <ImGui/imgui.h>
 
 #include "../app_utility.h"
+#include "../cpu/cpu_double_pendulum.h"
+#include "../cpu/double_pendulum_rhs.h"
+
+/** Samples per row and column of the lattice of SHARED_SAMPLES, 0 for no lattice (same as shared_samples.glsl) */
+static int getSharedLatticeSize(int numSamples) {
+    if (numSamples >= 32) return 4;
+    if (numSamples >= 16) return 3;
+    return 0; // fewer samples wouldn't save integrations, only blur
+}
 
 DoublePendulumModel::DoublePendulumModel() :
     Model(
         "Double Pendulum",
-        Shader("../res/vertex_shader.glsl", "../res/fragment_shader_double_pendulum.glsl") // Don't compile and link shader (not responsibility of the model)
+        Shader("../res/vertex_shader.glsl", "../res/fragment_shader_double_pendulum.glsl", "../res/compute_shader_double_pendulum.glsl") // Don't compile and link shader (not responsibility of the model)
     ),
     SuperSamplingModel(
         "Double Pendulum",
-        Shader("../res/vertex_shader.glsl", "../res/fragment_shader_double_pendulum.glsl") // Don't compile and link shader (not responsibility of the model)
+        Shader("../res/vertex_shader.glsl", "../res/fragment_shader_double_pendulum.glsl", "../res/compute_shader_double_pendulum.glsl") // Don't compile and link shader (not responsibility of the model)
     ),
     RK45Model(
         "Double Pendulum",
-        Shader("../res/vertex_shader.glsl", "../res/fragment_shader_double_pendulum.glsl") // Don't compile and link shader (not responsibility of the model)
+        Shader("../res/vertex_shader.glsl", "../res/fragment_shader_double_pendulum.glsl", "../res/compute_shader_double_pendulum.glsl") // Don't compile and link shader (not responsibility of the model)
     ),
     ColormapModel(
         "Double Pendulum",
-        Shader("../res/vertex_shader.glsl", "../res/fragment_shader_double_pendulum.glsl") // Don't compile and link shader (not responsibility of the model)
+        Shader("../res/vertex_shader.glsl", "../res/fragment_shader_double_pendulum.glsl", "../res/compute_shader_double_pendulum.glsl") // Don't compile and link shader (not responsibility of the model)
     )
     { }
 
@@ -35,8 +48,14 @@ DoublePendulumModel::DoublePendulumModel(const DoublePendulumModel& other)
       length1(other.length1),
       length2(other.length2),
       mass1(other.mass1),
-      mass2(other.mass2)
-    { }
+      mass2(other.mass2),
+      exportFullState(other.exportFullState),
+      cpuDoublePrecision(other.cpuDoublePrecision),
+      gpuDoublePrecision(other.gpuDoublePrecision),
+      incrementalIntegration(other.incrementalIntegration),
+      computeShaderIntegration(other.computeShaderIntegration),
+      sharedSamples(other.sharedSamples)
+    { } // the state textures and work queue are not copied, the copy starts from t0 again
 
 void DoublePendulumModel::applyUniformVariables() {
     this->SuperSamplingModel::applyUniformVariables();
@@ -84,6 +103,51 @@ void DoublePendulumModel::imGuiFrame() {
         if (ImGui::SliderFloat("m2", &this->mass2, -2.0, 8.0)) {
             this->shader.setFloat("m2", this->mass2);
         }
+
+        bool gpuDouble = this->gpuDoublePrecision;
+        if (ImGui::Checkbox("Double precision", &gpuDouble)) {
+            this->setGpuDoublePrecision(gpuDouble);
+            this->shader.recompile(); // needed, because USE_DOUBLE is a #define
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Integrates in double precision on the GPU (including sin and cos).\n"
+                "Much slower on most consumer GPUs, but tight tolerances don't drift like in single precision.\n"
+                "Turns off incremental and compute shader integration, their state textures only hold single precision.");
+        }
+
+        bool incremental = this->incrementalIntegration;
+        if (ImGui::Checkbox("Incremental (continue from last End-Time)", &incremental)) {
+            this->setIncrementalIntegration(incremental);
+            this->shader.recompile(); // needed, because INCREMENTAL and COMPUTE_SAMPLES are #defines
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Keeps the state of every sample between frames, so increasing the End-Time only integrates the difference.\n"
+                "Samples that need more than the maximum steps continue in the next frames. Not used with adaptive super sampling.\n"
+                "Single precision only (the state is stored in float textures), turns off double precision.");
+        }
+
+        bool compute = this->computeShaderIntegration;
+        if (ImGui::Checkbox("Compute shader (work queue)", &compute)) {
+            this->setComputeShaderIntegration(compute);
+            this->shader.recompile(); // needed, because COMPUTE_SAMPLES and INCREMENTAL are #defines
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Integrates in a compute shader, where every thread takes the next sample as soon as it is done with one,\n"
+                "instead of waiting for the slowest pixel of its group. Faster in chaotic regions. Not used with adaptive super sampling.\n"
+                "Single precision only (the state is stored in float textures), turns off double precision.");
+        }
+        if (this->computeShaderIntegration) {
+            bool shared = this->sharedSamples;
+            if (ImGui::Checkbox("Share samples between pixels", &shared)) {
+                this->setSharedSamples(shared);
+                this->shader.recompile(); // needed, because SHARED_SAMPLES is a #define
+            }
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("Integrates a regular grid of samples, every sample counts for all pixels closer than one pixel (tent filter).\n"
+                    "E.g. 32 (pmj) integrates 16 samples per pixel instead of 32. The wider filter makes the image softer than\n"
+                    "independent samples, so this trades sharpness for speed. Only used with at least 16 samples.");
+            }
+        }
     }
 }
 
@@ -92,6 +156,9 @@ void DoublePendulumModel::imGuiScreenshotFrame() {
     this->SuperSamplingModel::imGuiScreenshotFrame();
     this->RK45Model::imGuiScreenshotFrame();
     this->ColormapModel::imGuiScreenshotFrame();
+
+    ImGui::Checkbox("Export full state (q1, q2, v1, v2) as scalar field", &this->exportFullState);
+    ImGui::Checkbox("Double precision (needs CPU threads, renders on the CPU only)", &this->cpuDoublePrecision);
 }
 
 std::unique_ptr<Model> DoublePendulumModel::clone() const {
@@ -102,6 +169,8 @@ void DoublePendulumModel::makeScreenshotModel() {
     this->SuperSamplingModel::makeScreenshotModel();
     this->RK45Model::makeScreenshotModel();
     this->ColormapModel::makeScreenshotModel();
+
+    this->setIncrementalIntegration(false); // screenshots are rendered in tiles, which don't fit the state textures
 }
 
 void DoublePendulumModel::makeScreenshotModel(const Model& otherScreenshotModel) {
@@ -109,8 +178,19 @@ void DoublePendulumModel::makeScreenshotModel(const Model& otherScreenshotModel)
     this->RK45Model::makeScreenshotModel(otherScreenshotModel);
     this->ColormapModel::makeScreenshotModel(otherScreenshotModel);
 
-    // No need to copy assign any attributes from the otherScreenshotModel,
-    // since all attributes are only relevant to the live model
+    this->setIncrementalIntegration(false);
+
+    const DoublePendulumModel* otherScreenshotDoublePendulumModel = dynamic_cast<const DoublePendulumModel*>(&otherScreenshotModel);
+    if (otherScreenshotDoublePendulumModel == nullptr) {
+        return;
+    }
+
+    // All other attributes are only relevant to the live model
+    this->exportFullState = otherScreenshotDoublePendulumModel->exportFullState;
+    this->cpuDoublePrecision = otherScreenshotDoublePendulumModel->cpuDoublePrecision;
+    this->setGpuDoublePrecision(otherScreenshotDoublePendulumModel->gpuDoublePrecision);
+    this->setComputeShaderIntegration(otherScreenshotDoublePendulumModel->computeShaderIntegration);
+    this->setSharedSamples(otherScreenshotDoublePendulumModel->sharedSamples);
 }
 
 void DoublePendulumModel::updateWithLiveModel(const Model& liveModel) {
@@ -132,3 +212,307 @@ void DoublePendulumModel::updateWithLiveModel(const Model& liveModel) {
     this->mass1 = liveDoublePendulumModel->mass1;
     this->mass2 = liveDoublePendulumModel->mass2;
 }
+
+bool DoublePendulumModel::makeScalarFieldModel(ScalarFieldHeader& header) {
+    this->setIncrementalIntegration(false);
+    if (this->exportFullState) {
+        this->shader.define("SCALAR_FIELD_OUTPUT", "2");
+        header.kind = ScalarFieldKind::DOUBLE_PENDULUM_STATE;
+        header.channels = 4u; // (q1, q2, v1, v2)
+    } else {
+        this->shader.define("SCALAR_FIELD_OUTPUT", "1");
+        header.kind = ScalarFieldKind::DOUBLE_PENDULUM_Y2;
+        header.channels = 2u; // (y2, status)
+    }
+
+    header.params[0] = this->length1;
+    header.params[1] = this->length2;
+    return true;
+}
+
+bool DoublePendulumModel::makeEnergyFieldModel(ScalarFieldHeader& header, bool startState) {
+    this->exportFullState = true;
+    if (startState) {
+        this->simulationEndTime = 0.0f; // t0
+    }
+    return this->makeScalarFieldModel(header);
+}
+
+double DoublePendulumModel::getEnergy(const float* state) const {
+    const DoublePendulumRhs<double> rhs = { this->weightConstant, this->length1, this->length2, this->mass1, this->mass2 };
+    return rhs.energy({ state[0], state[1], state[2], state[3] });
+}
+
+bool DoublePendulumModel::setParameter(const std::string& parameter, const std::string& value) {
+    if (this->SuperSamplingModel::setParameter(parameter, value) || this->RK45Model::setParameter(parameter, value) || this->ColormapModel::setParameter(parameter, value)) {
+        return true;
+    }
+
+    // Same names as the uniforms
+    if (parameter == "t_end") { this->simulationEndTime = std::stof(value); return true; }
+    if (parameter == "v1_start") { this->v1Start = std::stof(value); return true; }
+    if (parameter == "v2_start") { this->v2Start = std::stof(value); return true; }
+    if (parameter == "g") { this->weightConstant = std::stof(value); return true; }
+    if (parameter == "l1") { this->length1 = std::stof(value); return true; }
+    if (parameter == "l2") { this->length2 = std::stof(value); return true; }
+    if (parameter == "m1") { this->mass1 = std::stof(value); return true; }
+    if (parameter == "m2") { this->mass2 = std::stof(value); return true; }
+    if (parameter == "exportFullState") { this->exportFullState = std::stoi(value) != 0; return true; }
+    if (parameter == "cpuDoublePrecision") { this->cpuDoublePrecision = std::stoi(value) != 0; return true; }
+    if (parameter == "gpuDoublePrecision") { this->setGpuDoublePrecision(std::stoi(value) != 0); return true; }
+    if (parameter == "incremental") { this->setIncrementalIntegration(std::stoi(value) != 0); return true; }
+    if (parameter == "computeShader") { this->setComputeShaderIntegration(std::stoi(value) != 0); return true; }
+    if (parameter == "sharedSamples") { this->setSharedSamples(std::stoi(value) != 0); return true; }
+    return false;
+}
+
+void DoublePendulumModel::drawCall() {
+    this->ColormapModel::drawCall();
+
+    const int numSamples = static_cast<int>(getStaticSampleOffsets(this->getSSMode()).size());
+    const bool fullStateOutput = this->shader.isDefined("SCALAR_FIELD_OUTPUT") && this->shader.getDefine("SCALAR_FIELD_OUTPUT") == "2";
+    if ((!this->incrementalIntegration && !this->computeShaderIntegration) || numSamples == 0 || fullStateOutput) { // adaptive super sampling always integrates in the fragment shader
+        return;
+    }
+
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    const int width = viewport[0] + viewport[2]; // the shaders index the state with gl_FragCoord
+    const int height = viewport[1] + viewport[3];
+    if (this->computeShaderIntegration) {
+        const int latticeSize = this->sharedSamples ? getSharedLatticeSize(numSamples) : 0;
+        if (latticeSize > 0) {
+            this->allocateStateTextures(width + 2, height + 2, latticeSize * latticeSize); // apron of one pixel, see shared_samples.glsl
+        } else {
+            this->allocateStateTextures(width, height, numSamples);
+        }
+        this->dispatchComputeShader(this->stateWidth, this->stateHeight);
+        glBindImageTexture(0, (*this->stateTextures)[0], 0, GL_TRUE, 0, GL_READ_ONLY, GL_RGBA32F);
+        glBindImageTexture(1, (*this->stateTextures)[1], 0, GL_TRUE, 0, GL_READ_ONLY, GL_RGBA32F);
+        return;
+    }
+
+    bool reset = this->allocateStateTextures(width, height, numSamples);
+
+    // Anything but a larger End-Time invalidates the state
+    std::unordered_map<std::string, Shader::uniform_t> uniforms = this->shader.uniforms;
+    uniforms.erase("t_end");
+    uniforms.erase("reset_state");
+    if (reset || this->simulationEndTime < this->stateEndTime || uniforms != this->stateUniforms || this->shader.defines != this->stateDefines) {
+        reset = true;
+        this->stateUniforms = std::move(uniforms);
+        this->stateDefines = this->shader.defines;
+    }
+    this->stateEndTime = this->simulationEndTime;
+
+    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT); // the stores of the last frame must be visible
+    glBindImageTexture(0, (*this->stateTextures)[0], 0, GL_TRUE, 0, GL_READ_WRITE, GL_RGBA32F);
+    glBindImageTexture(1, (*this->stateTextures)[1], 0, GL_TRUE, 0, GL_READ_WRITE, GL_RGBA32F);
+    this->shader.setInt("reset_state", reset ? 1 : 0);
+}
+
+bool DoublePendulumModel::allocateStateTextures(int width, int height, int layers) {
+    if (this->stateTextures && width == this->stateWidth && height == this->stateHeight && layers == this->stateLayers) {
+        return false;
+    }
+
+    this->stateTextures = std::shared_ptr<std::array<GLuint, 2>>(new std::array<GLuint, 2>{0, 0}, [](std::array<GLuint, 2>* ptr) {
+        glDeleteTextures(2, ptr->data());
+        delete ptr;
+    });
+    glGenTextures(2, this->stateTextures->data());
+    for (GLuint texture : *this->stateTextures) {
+        glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+        glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_RGBA32F, width, height, layers);
+    }
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    this->stateWidth = width;
+    this->stateHeight = height;
+    this->stateLayers = layers;
+    return true;
+}
+
+void DoublePendulumModel::dispatchComputeShader(int width, int height) {
+    constexpr int TILE_SIZE = 8; // same as in the compute shader
+    constexpr GLuint LOCAL_SIZE = 64;
+    constexpr GLuint PERSISTENT_WORK_GROUPS = 1024; // enough to fill large GPUs, same as in the compute shader
+    constexpr GLuint STEPS_PER_DISPATCH = 1u << 26; // of all lanes together, so that a dispatch stays well below the watchdog of the OS
+    constexpr size_t DISPATCHES_PER_CHECK = 16; // between the reads of the remaining work, every read waits for the GPU
+    const int numTiles = ((width + TILE_SIZE - 1) / TILE_SIZE) * ((height + TILE_SIZE - 1) / TILE_SIZE);
+    const GLsizeiptr numItems = static_cast<GLsizeiptr>(numTiles) * TILE_SIZE * TILE_SIZE * this->stateLayers;
+    // If every work item gets a lane right away, the order doesn't matter
+    const bool orderTiles = numItems > static_cast<GLsizeiptr>(PERSISTENT_WORK_GROUPS * LOCAL_SIZE);
+
+    // Tile order: expensive tiles of the last frame first (the view changes little from frame to frame), otherwise row by row
+    std::vector<GLuint> queue(2 + static_cast<size_t>(numTiles)); // next continued item, next queued item and tile order
+    std::iota(queue.begin() + 2, queue.end(), 0u);
+    queue[0] = queue[1] = 0u;
+    if (this->workQueueBuffers && this->numWorkQueueTiles == numTiles && this->numWorkQueueLayers == this->stateLayers) {
+        if (orderTiles && this->tileCosts.size() == static_cast<size_t>(numTiles)) {
+            const std::vector<GLuint>& cost = this->tileCosts;
+            std::stable_sort(queue.begin() + 2, queue.end(), [&cost](GLuint a, GLuint b) { return cost[a] > cost[b]; });
+        }
+    } else {
+        this->workQueueBuffers = std::shared_ptr<std::array<GLuint, 4>>(new std::array<GLuint, 4>{0, 0, 0, 0}, [](std::array<GLuint, 4>* ptr) {
+            glDeleteBuffers(4, ptr->data());
+            delete ptr;
+        });
+        glGenBuffers(4, this->workQueueBuffers->data());
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, (*this->workQueueBuffers)[0]);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(queue.size() * sizeof(GLuint)), nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, (*this->workQueueBuffers)[1]);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(numTiles) * static_cast<GLsizeiptr>(sizeof(GLuint)), nullptr, GL_DYNAMIC_READ);
+        for (size_t i = 2; i < 4; ++i) { // header (glDispatchComputeIndirect arguments and count), then the items
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, (*this->workQueueBuffers)[i]);
+            glBufferData(GL_SHADER_STORAGE_BUFFER, (4 + numItems) * static_cast<GLsizeiptr>(sizeof(GLuint)), nullptr, GL_DYNAMIC_COPY);
+        }
+        this->numWorkQueueTiles = numTiles;
+        this->numWorkQueueLayers = this->stateLayers;
+        this->tileCosts.clear();
+    }
+    const GLuint emptyHeader[4] = { 0u, 1u, 1u, 0u }; // no work groups and items
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, (*this->workQueueBuffers)[0]);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, static_cast<GLsizeiptr>(queue.size() * sizeof(GLuint)), queue.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, (*this->workQueueBuffers)[2]);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(emptyHeader), emptyHeader); // nothing to continue in the first dispatch
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, (*this->workQueueBuffers)[1]);
+    glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr); // costs are summed up by the compute shader
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, (*this->workQueueBuffers)[0]);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, (*this->workQueueBuffers)[1]);
+
+    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT); // the last draw call must be done reading the state
+    glBindImageTexture(0, (*this->stateTextures)[0], 0, GL_TRUE, 0, GL_READ_WRITE, GL_RGBA32F);
+    glBindImageTexture(1, (*this->stateTextures)[1], 0, GL_TRUE, 0, GL_READ_WRITE, GL_RGBA32F);
+
+    // Every dispatch stops after STEPS_PER_DISPATCH steps, the next one continues the unfinished samples and the rest of the queue
+    // The compute shader writes the work groups of the next dispatch, so only every DISPATCHES_PER_CHECK-th dispatch waits for the GPU
+    // (the ones after the work is done have no work groups)
+    this->shader.setUInt("max_steps_per_dispatch", STEPS_PER_DISPATCH);
+    this->shader.useCompute();
+    for (size_t dispatch = 0; ; ++dispatch) {
+        const GLuint zero = 0;
+        const GLuint continuedItems = (*this->workQueueBuffers)[2 + dispatch % 2];
+        const GLuint unfinishedItems = (*this->workQueueBuffers)[2 + (dispatch + 1) % 2];
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, (*this->workQueueBuffers)[0]);
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(GLuint), &zero); // next continued item
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, unfinishedItems);
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(emptyHeader), emptyHeader);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, continuedItems);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, unfinishedItems);
+
+        if (dispatch == 0) {
+            glDispatchCompute(static_cast<GLuint>(std::min<GLsizeiptr>(PERSISTENT_WORK_GROUPS, (numItems + LOCAL_SIZE - 1) / LOCAL_SIZE)), 1, 1);
+        } else {
+            glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, continuedItems);
+            glDispatchComputeIndirect(0);
+        }
+        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+
+        if ((dispatch + 1) % DISPATCHES_PER_CHECK == 0) {
+            GLuint nextWorkGroups = 0;
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, unfinishedItems);
+            glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(GLuint), &nextWorkGroups);
+            if (nextWorkGroups == 0) {
+                break;
+            }
+        }
+    }
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, 0);
+
+    if (orderTiles) { // the GPU is done already (the last check waited for it)
+        this->tileCosts.resize(static_cast<size_t>(numTiles));
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, (*this->workQueueBuffers)[1]);
+        glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, static_cast<GLsizeiptr>(this->tileCosts.size() * sizeof(GLuint)), this->tileCosts.data());
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    this->shader.use();
+}
+
+void DoublePendulumModel::setSharedSamples(bool enabled) {
+    this->sharedSamples = enabled;
+    if (enabled) {
+        this->shader.define("SHARED_SAMPLES", "");
+    } else {
+        this->shader.undefine("SHARED_SAMPLES");
+    }
+}
+
+void DoublePendulumModel::setGpuDoublePrecision(bool enabled) {
+    this->gpuDoublePrecision = enabled;
+    if (enabled) {
+        // the state textures are RGBA32F, the state would drop to single precision between frames or dispatches
+        this->setIncrementalIntegration(false);
+        this->setComputeShaderIntegration(false);
+        this->shader.define("USE_DOUBLE", "");
+    } else {
+        this->shader.undefine("USE_DOUBLE");
+    }
+}
+
+void DoublePendulumModel::setIncrementalIntegration(bool enabled) {
+    this->incrementalIntegration = enabled;
+    if (enabled) {
+        this->setComputeShaderIntegration(false);
+        this->setGpuDoublePrecision(false);
+        this->shader.define("INCREMENTAL", "");
+    } else {
+        this->shader.undefine("INCREMENTAL");
+        this->stateUniforms.clear(); // starts at t0 next time
+        if (!this->computeShaderIntegration) {
+            this->stateTextures.reset();
+        }
+    }
+}
+
+void DoublePendulumModel::setComputeShaderIntegration(bool enabled) {
+    this->computeShaderIntegration = enabled;
+    if (enabled) {
+        this->setIncrementalIntegration(false);
+        this->setGpuDoublePrecision(false);
+        this->shader.define("COMPUTE_SAMPLES", "");
+    } else {
+        this->shader.undefine("COMPUTE_SAMPLES");
+        this->workQueueBuffers.reset();
+        if (!this->incrementalIntegration) {
+            this->stateTextures.reset();
+        }
+    }
+}
+
+std::unique_ptr<CpuRenderer> DoublePendulumModel::makeCpuRenderer() {
+    DoublePendulumCpuParameters parameters;
+    parameters.tEnd = this->simulationEndTime;
+    parameters.v1Start = this->v1Start;
+    parameters.v2Start = this->v2Start;
+    parameters.g = this->weightConstant;
+    parameters.l1 = this->length1;
+    parameters.l2 = this->length2;
+    parameters.m1 = this->mass1;
+    parameters.m2 = this->mass2;
+
+    parameters.maxSteps = static_cast<unsigned int>(this->maxSteps);
+    parameters.maxSameSteps = static_cast<unsigned int>(this->maxSameSteps);
+    parameters.minStepSize = this->minStepSize;
+    parameters.atol = std::pow(10.0f, this->atolExponent);
+    parameters.rtol = std::pow(10.0f, this->rtolExponent);
+    parameters.method = std::stoi(this->shader.getDefine("RK_METHOD"));
+    parameters.symplecticStepSize = this->symplecticStepSize;
+    parameters.useDoublePrecision = this->cpuDoublePrecision;
+
+    parameters.scalarFieldOutput = this->shader.isDefined("SCALAR_FIELD_OUTPUT") ? std::stoi(this->shader.getDefine("SCALAR_FIELD_OUTPUT")) : 0;
+    parameters.sampleOffsets = getStaticSampleOffsets(this->getSSMode());
+    if (parameters.sampleOffsets.empty() && parameters.scalarFieldOutput != 2) {
+        return nullptr; // adaptive super sampling has no CPU port
+    }
+    if (parameters.scalarFieldOutput == 0) {
+        const std::vector<float>* colormap = findColormap(this->selectedColormapGroup, this->selectedColormapName);
+        if (!colormap) {
+            return nullptr;
+        }
+        parameters.colormap = *colormap;
+        parameters.cyclicColormap = isCyclicColormapGroup(this->selectedColormapGroup);
+    }
+
+    return std::make_unique<DoublePendulumCpuRenderer>(parameters,
+        this->shader.getDouble("zoomScale"), vec::getX(this->shader.getVec2Double("center")), vec::getY(this->shader.getVec2Double("center")));
+}
@@ -6,6 +6,12 @@
 #include "model_super_sampling.h"
 #include "model_colormap.h"
 
+#include <array>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <glad/glad.h>
+
 class DoublePendulumModel : public virtual SuperSamplingModel, public virtual RK45Model, public virtual ColormapModel {
 protected:
     // Double Pendulum Parameters
@@ -22,6 +28,43 @@ protected:
     float simulationEndTimeMin = 0.0f;
     float simulationEndTimeMax = 10.0f;
 
+    // Scalar field export
+    bool exportFullState = false; // export (q1, q2, v1, v2) instead of y2
+
+    // Screenshots in double precision on the CPU threads
+    bool cpuDoublePrecision = false;
+    // Double precision in the shaders (USE_DOUBLE, sin and cos of double_math.glsl), fp64 is much slower on most consumer GPUs
+    bool gpuDoublePrecision = false;
+
+    // State of every sample (q1, q2, v1, v2, t, tau, status) in two RGBA32F array textures (one layer per sample), not shared by copies
+    std::shared_ptr<std::array<GLuint, 2>> stateTextures; // (q1, q2, v1, v2) and (t, tau, status, unused)
+    int stateWidth = 0;
+    int stateHeight = 0;
+    int stateLayers = 0;
+
+    // Incremental integration (live model only): the state is kept between frames, so that a larger End-Time only integrates from the last End-Time on
+    bool incrementalIntegration = false;
+    float stateEndTime = 0.0f;
+    std::unordered_map<std::string, Shader::uniform_t> stateUniforms; // all uniforms except t_end and reset_state, when the state was computed
+    std::unordered_map<std::string, std::string> stateDefines;
+
+    // Integration in a compute shader with persistent work groups and a work queue, the fragment shader only colors the state
+    bool computeShaderIntegration = false;
+    // Work queue (next item, tile order), cost per tile and two lists of unfinished samples (one dispatch reads, the next writes), not shared by copies
+    std::shared_ptr<std::array<GLuint, 4>> workQueueBuffers;
+    std::vector<GLuint> tileCosts; // of the last frame, only read back when the tile order matters
+    int numWorkQueueTiles = 0;
+    int numWorkQueueLayers = 0;
+    bool sharedSamples = false; // the compute shader integrates a sub-pixel lattice shared by neighboring pixels (see shared_samples.glsl)
+
+    void setIncrementalIntegration(bool enabled);
+    void setComputeShaderIntegration(bool enabled);
+    void setSharedSamples(bool enabled);
+    void setGpuDoublePrecision(bool enabled);
+    /** (Re)allocates the state textures if the size changed, returns true if it did */
+    bool allocateStateTextures(int width, int height, int layers);
+    void dispatchComputeShader(int width, int height);
+
 public:
     DoublePendulumModel();
     DoublePendulumModel(const DoublePendulumModel& other);
@@ -36,6 +79,12 @@ public:
     virtual void makeScreenshotModel() override;
     virtual void makeScreenshotModel(const Model& otherScreenshotModel) override;
     virtual void updateWithLiveModel(const Model& liveModel) override;
+    virtual bool makeScalarFieldModel(ScalarFieldHeader& header) override;
+    virtual bool makeEnergyFieldModel(ScalarFieldHeader& header, bool startState) override;
+    virtual double getEnergy(const float* state) const override;
+    virtual void drawCall() override;
+    virtual bool setParameter(const std::string& parameter, const std::string& value) override;
+    virtual std::unique_ptr<CpuRenderer> makeCpuRenderer() override;
 };
 
 #endif
@@ -1,19 +1,30 @@
 #include "model_mandelbrot.h"
 
 #include <string> // for stoi
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+#include <sstream>
+#include <tuple> // for tie
+#include <vector>
 
 #include <ImGui/imgui.h>
 
+#include "../cpu/cpu_mandelbrot.h"
+#include "../precision_benchmark.h"
+#include "../sample_sequence.h"
+
+// Unit roundoff by Precision (float, double, double-float)
+static constexpr std::array<double, 3> PRECISION_EPSILON = { 0x1p-24, 0x1p-53, 0x1p-48 };
+
 MandelbrotModel::MandelbrotModel()
-    : Model("MandelbrotModel", Shader("../res/vertex_shader.glsl", "../res/fragment_shader_mandelbrot.glsl")),
-    SuperSamplingModel("MandelbrotModel", Shader("../res/vertex_shader.glsl", "../res/fragment_shader_mandelbrot.glsl"), true), // disable adaptive supersampling mode
-      ColormapModel("MandelbrotModel", Shader("../res/vertex_shader.glsl", "../res/fragment_shader_mandelbrot.glsl"))
+    : Model("MandelbrotModel", Shader("../res/vertex_shader.glsl", "../res/fragment_shader_mandelbrot.glsl", "../res/compute_shader_mandelbrot.glsl")),
+    SuperSamplingModel("MandelbrotModel", Shader("../res/vertex_shader.glsl", "../res/fragment_shader_mandelbrot.glsl", "../res/compute_shader_mandelbrot.glsl"), false, false, true),
+      ColormapModel("MandelbrotModel", Shader("../res/vertex_shader.glsl", "../res/fragment_shader_mandelbrot.glsl", "../res/compute_shader_mandelbrot.glsl"))
 {
     this->selectColormap("Cyclic", "cet_colorwheel"); // Cyclic colormap as default
 
-    if (this->useDoublePrecision) {
-        this->shader.define("USE_DOUBLE", "");
-    }
+    this->setPrecision(this->precision);
     if (this->useSmoothing) {
         this->shader.define("USE_SMOOTHING", "");
     }
@@ -27,16 +38,19 @@ MandelbrotModel::MandelbrotModel(const MandelbrotModel& other)
       ColormapModel(other),
       maxIterations(other.maxIterations),
       colorScale(other.colorScale),
-      useDoublePrecision(other.useDoublePrecision),
+      precision(other.precision),
+      autoPrecision(other.autoPrecision),
       useSmoothing(other.useSmoothing),
+      formula(other.formula),
+      power(other.power),
+      juliaReal(other.juliaReal),
+      juliaImag(other.juliaImag),
+      marianiSilver(other.marianiSilver),
+      computeShader(other.computeShader),
+      progressive(other.progressive),
       sliceValue(other.sliceValue),
       sliceFactor(other.sliceFactor)
 {
-    // strncpy(this->codeDivergenceCriterion, other.codeDivergenceCriterion, 1000); // copy at most 1000 characters
-    // this->codeDivergenceCriterion[1000 - 1] = '\0'; // ensure null termination
-
-    // strncpy(this->codeCalculateNextSequenceTerm, other.codeCalculateNextSequenceTerm, 2000); // copy at most 2000 characters
-    // this->codeCalculateNextSequenceTerm[2000 - 1] = '\0'; // ensure null termination
 }
 
 void MandelbrotModel::applyUniformVariables() {
@@ -45,6 +59,224 @@ void MandelbrotModel::applyUniformVariables() {
 
     this->shader.setUInt("maxIterations", static_cast<uint>(this->maxIterations));
     this->shader.setFloat("colorScale", this->colorScale);
+    if (this->formula == FractalFormula::Julia) { // the uniforms only exist in this variant
+        this->shader.setVec2Double("juliaConstant", { this->juliaReal, this->juliaImag });
+        const float juliaRealHi = static_cast<float>(this->juliaReal);
+        const float juliaImagHi = static_cast<float>(this->juliaImag);
+        this->shader.setVec4("juliaConstantSplit", {
+            juliaRealHi, static_cast<float>(this->juliaReal - static_cast<double>(juliaRealHi)),
+            juliaImagHi, static_cast<float>(this->juliaImag - static_cast<double>(juliaImagHi))
+        });
+    }
+}
+
+void MandelbrotModel::drawCall() {
+    this->updateAutoPrecision();
+
+    const bool adaptive = this->getSSMode() == SuperSamplingModel::ADAPTIVE;
+    const bool dispatch = (this->progressive || adaptive || this->marianiSilver || this->computeShader) && !this->getCostInstrumentation(); // the heatmap needs the iterations of the fragment shader
+    if (dispatch && this->progressive) {
+        this->bindSampleOffsets(getPmj02Samples(PROGRESSIVE_MAX_SAMPLES));
+    } else if (adaptive && !dispatch) { // the heatmap of adaptive super sampling is the one of its first pass
+        this->bindSampleOffsets(getStaticSampleOffsets(SuperSamplingModel::OFF));
+    } else {
+        this->bindSampleOffsets(this->getSampleOffsets());
+    }
+
+    if (dispatch) {
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        if (this->progressive) { // takes precedence in the compute shader, super sampling is replaced by the accumulated samples
+            this->dispatchProgressive(viewport[0] + viewport[2], viewport[1] + viewport[3]);
+        } else if (adaptive) { // takes precedence over Mariani-Silver
+            this->dispatchAdaptiveSuperSampling(viewport[0] + viewport[2], viewport[1] + viewport[3]);
+        } else if (this->marianiSilver) { // the compute shader is compiled with MARIANI_SILVER then
+            this->dispatchMarianiSilver(viewport[0] + viewport[2], viewport[1] + viewport[3]); // the fragment shader reads the values at gl_FragCoord
+        } else {
+            this->dispatchComputePixels(viewport[0] + viewport[2], viewport[1] + viewport[3]);
+        }
+        glBindImageTexture(0, (*this->computeObjects)[0], 0, GL_FALSE, 0, GL_READ_ONLY, GL_RGBA32F);
+    }
+
+    this->ColormapModel::drawCall(); // after the dispatch, which binds its texture to the same unit as the colormap
+}
+
+bool MandelbrotModel::allocateComputeObjects(int width, int height, bool blockLists, bool centerValues) {
+    if (this->computeObjects && width == this->computeWidth && height == this->computeHeight
+        && (!blockLists || (*this->computeObjects)[1] != 0) && (!centerValues || (*this->computeObjects)[3] != 0)) {
+        return false;
+    }
+
+    this->computeObjects = std::shared_ptr<std::array<GLuint, 4>>(new std::array<GLuint, 4>{0, 0, 0, 0}, [](std::array<GLuint, 4>* ptr) {
+        glDeleteTextures(1, &(*ptr)[0]);
+        glDeleteBuffers(2, &(*ptr)[1]); // ignore 0
+        glDeleteTextures(1, &(*ptr)[3]);
+        delete ptr;
+    });
+    glGenTextures(1, &(*this->computeObjects)[0]);
+    glBindTexture(GL_TEXTURE_2D, (*this->computeObjects)[0]);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA32F, width, height);
+    if (centerValues) {
+        glGenTextures(1, &(*this->computeObjects)[3]);
+        glBindTexture(GL_TEXTURE_2D, (*this->computeObjects)[3]);
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_RG32F, width, height);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    if (blockLists) {
+        const GLuint numColumns = static_cast<GLuint>(std::max(width - 2, 0)) / MARIANI_SILVER_BLOCK_SIZE + 1u;
+        const GLuint numRows = static_cast<GLuint>(std::max(height - 2, 0)) / MARIANI_SILVER_BLOCK_SIZE + 1u;
+        const GLsizeiptr maxBlocks = static_cast<GLsizeiptr>(numColumns) * numRows << (2 * (MARIANI_SILVER_PASSES - 1)); // every block can split into 4 per pass
+        glGenBuffers(2, &(*this->computeObjects)[1]);
+        for (size_t i = 1; i < 3; ++i) {
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, (*this->computeObjects)[i]);
+            glBufferData(GL_SHADER_STORAGE_BUFFER, (1 + maxBlocks) * 4 * static_cast<GLsizeiptr>(sizeof(GLuint)), nullptr, GL_DYNAMIC_COPY);
+        }
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    }
+    this->computeWidth = width;
+    this->computeHeight = height;
+    return true;
+}
+
+void MandelbrotModel::dispatchMarianiSilver(int width, int height) {
+    const GLuint numColumns = static_cast<GLuint>(std::max(width - 2, 0)) / MARIANI_SILVER_BLOCK_SIZE + 1u;
+    const GLuint numRows = static_cast<GLuint>(std::max(height - 2, 0)) / MARIANI_SILVER_BLOCK_SIZE + 1u;
+    this->allocateComputeObjects(width, height, true, false);
+
+    // First blocks: a grid over the viewport (header, then (min x, min y, max x, max y) per block)
+    std::vector<GLuint> firstBlocks = { std::min(numColumns * numRows, MAX_WORK_GROUPS), 1u, 1u, numColumns * numRows };
+    for (GLuint row = 0; row < numRows; ++row) {
+        for (GLuint column = 0; column < numColumns; ++column) {
+            firstBlocks.insert(firstBlocks.end(), {
+                column * MARIANI_SILVER_BLOCK_SIZE, row * MARIANI_SILVER_BLOCK_SIZE,
+                std::min((column + 1u) * MARIANI_SILVER_BLOCK_SIZE, static_cast<GLuint>(width - 1)),
+                std::min((row + 1u) * MARIANI_SILVER_BLOCK_SIZE, static_cast<GLuint>(height - 1))
+            });
+        }
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, (*this->computeObjects)[1]);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, static_cast<GLsizeiptr>(firstBlocks.size() * sizeof(GLuint)), firstBlocks.data());
+
+    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT); // the last draw call must be done reading the values
+    glClearTexImage((*this->computeObjects)[0], 0, GL_RGBA, GL_FLOAT, nullptr); // nothing computed
+    glBindImageTexture(0, (*this->computeObjects)[0], 0, GL_FALSE, 0, GL_READ_WRITE, GL_RGBA32F);
+
+    for (size_t pass = 0; pass < MARIANI_SILVER_PASSES; ++pass) {
+        const GLuint blocks = (*this->computeObjects)[1 + pass % 2];
+        const GLuint nextBlocks = (*this->computeObjects)[1 + (pass + 1) % 2];
+        const GLuint emptyHeader[4] = { 0u, 1u, 1u, 0u };
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, nextBlocks);
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(emptyHeader), emptyHeader);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, blocks);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, nextBlocks);
+
+        this->shader.setInt("final_pass", pass == MARIANI_SILVER_PASSES - 1 ? 1 : 0);
+        this->shader.useCompute();
+        glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, blocks);
+        glDispatchComputeIndirect(0);
+        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+    }
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, 0);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    this->shader.use();
+}
+
+// One work group per tile of 8x8 pixels, the shader numbers them linearly (and swizzles), so the 2D grid only avoids the limit per dimension
+static void dispatchTiles(int width, int height) {
+    const GLuint numTiles = static_cast<GLuint>((width + 7) / 8) * static_cast<GLuint>((height + 7) / 8);
+    const GLuint numGroupsX = std::min(numTiles, MandelbrotModel::MAX_WORK_GROUPS);
+    glDispatchCompute(numGroupsX, (numTiles + numGroupsX - 1u) / numGroupsX, 1u);
+}
+
+void MandelbrotModel::dispatchComputePixels(int width, int height) {
+    this->allocateComputeObjects(width, height, false, false);
+
+    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT); // the last draw call must be done reading the values
+    glBindImageTexture(0, (*this->computeObjects)[0], 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA32F);
+    this->shader.useCompute();
+    dispatchTiles(width, height);
+    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+    this->shader.use();
+}
+
+void MandelbrotModel::dispatchAdaptiveSuperSampling(int width, int height) {
+    this->allocateComputeObjects(width, height, false, true);
+
+    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT); // the last draw call must be done reading the values
+    glBindImageTexture(0, (*this->computeObjects)[0], 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA32F);
+    glBindImageTexture(1, (*this->computeObjects)[3], 0, GL_FALSE, 0, GL_READ_WRITE, GL_RG32F);
+    for (int pass = 0; pass < 2; ++pass) { // center samples, then the pixels that differ from their neighbors
+        this->shader.setInt("adaptive_first_pass", pass == 0 ? 1 : 0);
+        this->shader.useCompute();
+        dispatchTiles(width, height);
+        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+    }
+    this->shader.use();
+}
+
+void MandelbrotModel::dispatchProgressive(int width, int height) {
+    bool restart = this->allocateComputeObjects(width, height, false, false);
+
+    // Anything but the sample and the colors (applied to the pixel values by the fragment shader) invalidates the accumulated samples
+    std::unordered_map<std::string, Shader::uniform_t> uniforms = this->shader.uniforms;
+    uniforms.erase("progressive_samples");
+    uniforms.erase("colorScale");
+    uniforms.erase("sliceValue");
+    uniforms.erase("sliceFactor");
+    if (restart || uniforms != this->progressiveUniforms || this->shader.defines != this->progressiveDefines) {
+        this->progressiveSamples = 0;
+        this->progressiveUniforms = std::move(uniforms);
+        this->progressiveDefines = this->shader.defines;
+    }
+    if (this->progressiveSamples >= PROGRESSIVE_MAX_SAMPLES) {
+        return; // converged, the pixel values stay
+    }
+
+    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT); // the last draw call must be done reading the values
+    glBindImageTexture(0, (*this->computeObjects)[0], 0, GL_FALSE, 0, GL_READ_WRITE, GL_RGBA32F);
+    this->shader.setUInt("progressive_samples", this->progressiveSamples);
+    this->shader.useCompute();
+    dispatchTiles(width, height);
+    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+    this->shader.use();
+    this->progressiveSamples += 1;
+}
+
+void MandelbrotModel::setMarianiSilver(bool enabled) {
+    this->marianiSilver = enabled;
+    if (enabled) {
+        this->shader.define("MARIANI_SILVER", "");
+    } else {
+        this->shader.undefine("MARIANI_SILVER");
+        if (!this->computeShader && !this->progressive) {
+            this->computeObjects.reset();
+        }
+    }
+}
+
+void MandelbrotModel::setComputeShader(bool enabled) {
+    this->computeShader = enabled;
+    if (enabled) {
+        this->shader.define("COMPUTE_PIXELS", "");
+    } else {
+        this->shader.undefine("COMPUTE_PIXELS");
+        if (!this->marianiSilver && !this->progressive) {
+            this->computeObjects.reset();
+        }
+    }
+}
+
+void MandelbrotModel::setProgressive(bool enabled) {
+    this->progressive = enabled;
+    if (enabled) {
+        this->shader.define("PROGRESSIVE", "");
+    } else {
+        this->shader.undefine("PROGRESSIVE");
+        this->progressiveUniforms.clear(); // starts again next time
+        if (!this->marianiSilver && !this->computeShader) {
+            this->computeObjects.reset();
+        }
+    }
 }
 
 void MandelbrotModel::imGuiFrame() {
@@ -74,20 +306,39 @@ void MandelbrotModel::imGuiFrame() {
 
     this->imGuiScreenshotFrameHelper();
 
-    // Sequence
-    // ImGui::Text("Sequence code (1. Divergence criterion, 2. Code to calculate next term in sequence)");
-    // ImGui::InputTextMultiline("1", codeDivergenceCriterion, IM_ARRAYSIZE(codeDivergenceCriterion),
-    // 	ImVec2(-FLT_MIN, ImGui::GetTextLineHeight() * 2.5f)
-    // );
-    // ImGui::InputTextMultiline("2", codeCalculateNextSequenceTerm, IM_ARRAYSIZE(codeCalculateNextSequenceTerm),
-    // 	ImVec2(-FLT_MIN, ImGui::GetTextLineHeight() * 3.5f)
-    // );
-    // if (ImGui::SmallButton("Apply")) {
-    // 	this->shader.define(CODE_DIVERGENCE_CRITERION, std::string(codeDivergenceCriterion));
-    // 	this->shader.define(CODE_CALCULATE_NEXT_SEQUENCE_TERM, std::string(codeCalculateNextSequenceTerm));
-    // 	this->shader.recompile();
-    // }
-    // ImGui::NewLine();
+    bool accumulate = this->progressive;
+    if (ImGui::Checkbox("Progressive accumulation", &accumulate)) {
+        this->setProgressive(accumulate);
+        this->shader.recompile(); // needed, because PROGRESSIVE is a #define
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("One sample per pixel while the view changes, every further frame of a static view adds another one (PMJ offsets)\n"
+            "and shows the mean, up to %u samples per pixel. Replaces super sampling in the live view, screenshots use super sampling.", PROGRESSIVE_MAX_SAMPLES);
+    }
+
+    // Formula
+    int formulaIndex = static_cast<int>(this->formula);
+    if (ImGui::Combo("Formula", &formulaIndex, [](void*, int index, const char** label) {
+            *label = FRACTAL_FORMULAS[static_cast<size_t>(index)].label;
+            return true;
+        }, nullptr, static_cast<int>(FRACTAL_FORMULAS.size()))) {
+        this->setFormula(static_cast<FractalFormula>(formulaIndex), this->power);
+        this->shader.recompile();
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Every formula is its own shader variant, so it iterates as fast as z^2 + c");
+    }
+    if (getFractalFormulaInfo(this->formula).usesPower && ImGui::SliderInt("Power d", &this->power, MIN_MULTIBROT_POWER, MAX_MULTIBROT_POWER)) {
+        this->setFormula(this->formula, this->power);
+        this->shader.recompile(); // needed, because FORMULA_POWER is a #define
+    }
+    if (getFractalFormulaInfo(this->formula).usesJuliaConstant) {
+        bool changed = ImGui::InputDouble("Julia Real", &this->juliaReal, 0.001, 0.01, "%.6f");
+        changed |= ImGui::InputDouble("Julia Imag", &this->juliaImag, 0.001, 0.01, "%.6f");
+        if (changed) {
+            this->applyUniformVariables();
+        }
+    }
 }
 
 void MandelbrotModel::imGuiScreenshotFrame() {
@@ -104,6 +355,7 @@ std::unique_ptr<Model> MandelbrotModel::clone() const {
 void MandelbrotModel::makeScreenshotModel() {
     this->SuperSamplingModel::makeScreenshotModel();
     this->ColormapModel::makeScreenshotModel();
+    this->setProgressive(false); // screenshots are rendered in tiles, and only once
 
     this->setDefaultScreenshotParameters();
 }
@@ -111,6 +363,7 @@ void MandelbrotModel::makeScreenshotModel() {
 void MandelbrotModel::makeScreenshotModel(const Model& otherScreenshotModel) {
     this->SuperSamplingModel::makeScreenshotModel(otherScreenshotModel);
     this->ColormapModel::makeScreenshotModel(otherScreenshotModel);
+    this->setProgressive(false); // screenshots are rendered in tiles, and only once
 
     const MandelbrotModel* otherScreenshotMandelbrotModel = dynamic_cast<const MandelbrotModel*>(&otherScreenshotModel);
     if (otherScreenshotMandelbrotModel == nullptr) {
@@ -133,6 +386,111 @@ void MandelbrotModel::updateWithLiveModel(const Model& liveModel) {
 
     this->colorScale = liveMandelbrotModel->colorScale;
     this->setColorMap(liveMandelbrotModel->getColorMap());
+    this->setFormula(liveMandelbrotModel->formula, liveMandelbrotModel->power);
+    this->juliaReal = liveMandelbrotModel->juliaReal;
+    this->juliaImag = liveMandelbrotModel->juliaImag;
+}
+
+bool MandelbrotModel::makeScalarFieldModel(ScalarFieldHeader& header) {
+    this->shader.define("SCALAR_FIELD_OUTPUT", "1");
+
+    header.kind = ScalarFieldKind::MANDELBROT;
+    header.channels = 2u; // (avgSmoothCount, outsideRatio)
+    return true;
+}
+
+bool MandelbrotModel::setParameter(const std::string& parameter, const std::string& value) {
+    if (this->SuperSamplingModel::setParameter(parameter, value) || this->ColormapModel::setParameter(parameter, value)) {
+        return true;
+    }
+
+    if (parameter == "maxIterations") { this->maxIterations = std::stoi(value); return true; }
+    if (parameter == "colorScale") { this->colorScale = std::stof(value); return true; }
+    if (parameter == "sliceValue") { this->sliceValue = std::stoi(value); return true; }
+    if (parameter == "sliceFactor") { this->sliceFactor = std::stof(value); return true; }
+    if (parameter == "useDoublePrecision") { // older name of precision
+        this->autoPrecision = false;
+        this->setPrecision(std::stoi(value) != 0 ? Double : Float);
+        return true;
+    }
+    if (parameter == "precision") {
+        this->autoPrecision = value == "auto";
+        if (this->autoPrecision) {
+            // chosen in the next drawCall
+        } else if (value == "float") {
+            this->setPrecision(Float);
+        } else if (value == "double") {
+            this->setPrecision(Double);
+        } else if (value == "double-float") {
+            this->setPrecision(DoubleFloat);
+        } else {
+            throw std::invalid_argument("precision must be auto, float, double or double-float");
+        }
+        return true;
+    }
+    if (parameter == "formula") {
+        FractalFormula newFormula;
+        if (!findFractalFormula(value, newFormula)) {
+            throw std::invalid_argument("formula must be mandelbrot, multibrot, burning-ship, tricorn or julia");
+        }
+        this->setFormula(newFormula, this->power);
+        return true;
+    }
+    if (parameter == "power") { this->setFormula(this->formula, std::stoi(value)); return true; }
+    if (parameter == "juliaReal") { this->juliaReal = std::stod(value); return true; }
+    if (parameter == "juliaImag") { this->juliaImag = std::stod(value); return true; }
+    if (parameter == "marianiSilver") { this->setMarianiSilver(std::stoi(value) != 0); return true; }
+    if (parameter == "computeShader") { this->setComputeShader(std::stoi(value) != 0); return true; }
+    if (parameter == "progressive") { this->setProgressive(std::stoi(value) != 0); return true; }
+    if (parameter == "useSmoothing") {
+        this->useSmoothing = std::stoi(value) != 0;
+        if (this->useSmoothing) {
+            this->shader.define("USE_SMOOTHING", "");
+        } else {
+            this->shader.undefine("USE_SMOOTHING");
+        }
+        return true;
+    }
+    return false;
+}
+
+std::unique_ptr<CpuRenderer> MandelbrotModel::makeCpuRenderer() {
+    this->updateAutoPrecision();
+
+    MandelbrotCpuParameters parameters;
+    parameters.maxIterations = static_cast<unsigned int>(this->maxIterations);
+    parameters.colorScale = this->colorScale;
+    parameters.gpuPrecision = this->precision == Float ? CpuPrecision::Float : CpuPrecision::Double; // double is the closest to double-float
+    parameters.formula = this->formula;
+    parameters.power = this->power;
+    parameters.juliaReal = this->juliaReal;
+    parameters.juliaImag = this->juliaImag;
+    parameters.useSmoothing = this->shader.isDefined("USE_SMOOTHING");
+    parameters.marianiSilver = this->marianiSilver;
+    parameters.scalarFieldOutput = this->shader.isDefined("SCALAR_FIELD_OUTPUT");
+    if (this->getSSMode() == SuperSamplingModel::ADAPTIVE) {
+        return nullptr; // no port of the compute passes
+    }
+    parameters.sampleOffsets = this->getSampleOffsets();
+    if (!parameters.scalarFieldOutput) {
+        const std::vector<float>* colormap = findColormap(this->selectedColormapGroup, this->selectedColormapName);
+        if (!colormap) {
+            return nullptr;
+        }
+        parameters.colormap = *colormap;
+        parameters.cyclicColormap = isCyclicColormapGroup(this->selectedColormapGroup);
+    }
+
+    // Deeper than the shader resolves, the CPU iterates in a more precise type (and renders alone)
+    const auto [centerX, centerY] = this->shader.getVec2Double("center");
+    const auto [width, height] = this->shader.getVec2UInt("windowSize");
+    const double pixelSize = this->shader.getDouble("zoomScale") / static_cast<double>(std::max(std::min(width, height), 1u));
+    parameters.precision = MandelbrotCpuRenderer::choosePrecision(pixelSize, std::max({ 2.0, std::abs(centerX), std::abs(centerY) }), parameters.gpuPrecision);
+    if (this->shader.uniforms.contains("centerLow")) {
+        std::tie(parameters.centerLowX, parameters.centerLowY) = this->shader.getVec2Double("centerLow");
+    }
+
+    return std::make_unique<MandelbrotCpuRenderer>(parameters, this->shader.getDouble("zoomScale"), centerX, centerY);
 }
 
 MandelbrotModel::ColorMap MandelbrotModel::getColorMap() const {
@@ -143,19 +501,139 @@ void MandelbrotModel::setColorMap(ColorMap colorMap) {
     this->shader.define(FLOW_COLOR_TYPE, std::to_string(colorMap));
 }
 
+MandelbrotModel::Precision MandelbrotModel::getPrecision() const {
+    return this->precision;
+}
+
+void MandelbrotModel::setPrecision(Precision _precision) {
+    this->precision = _precision;
+    if (this->precision == Double) {
+        this->shader.define("USE_DOUBLE", "");
+    } else {
+        this->shader.undefine("USE_DOUBLE");
+    }
+    if (this->precision == DoubleFloat) {
+        this->shader.define("USE_DOUBLE_FLOAT", "");
+    } else {
+        this->shader.undefine("USE_DOUBLE_FLOAT");
+    }
+}
+
+void MandelbrotModel::setFormula(FractalFormula _formula, int _power) {
+    this->formula = _formula;
+    this->power = std::clamp(_power, MIN_MULTIBROT_POWER, MAX_MULTIBROT_POWER);
+    this->shader.define("FORMULA", std::to_string(static_cast<int>(this->formula)));
+    if (getFractalFormulaInfo(this->formula).usesPower) {
+        this->shader.define("FORMULA_POWER", std::to_string(this->power));
+    } else {
+        this->shader.undefine("FORMULA_POWER"); // so that the other formulas have one variant each
+    }
+}
+
+
+MandelbrotModel::Precision MandelbrotModel::choosePrecision(double pixelSize, double magnitude, Precision current, const std::array<double, 3>& costs) {
+    constexpr size_t NONE = 3;
+    size_t best = NONE;
+    size_t mostPrecise = NONE;
+    for (size_t p = 0; p < 3; ++p) {
+        if (!std::isfinite(costs[p])) { // not supported
+            continue;
+        }
+        if (mostPrecise == NONE || PRECISION_EPSILON[p] < PRECISION_EPSILON[mostPrecise]) {
+            mostPrecise = p;
+        }
+
+        double requiredPixelSize = PRECISION_RESOLUTION_MARGIN * PRECISION_EPSILON[p] * magnitude;
+        if (PRECISION_EPSILON[p] > PRECISION_EPSILON[static_cast<size_t>(current)]) {
+            requiredPixelSize *= PRECISION_HYSTERESIS;
+        }
+        if (pixelSize >= requiredPixelSize && (best == NONE || costs[p] < costs[best])) {
+            best = p;
+        }
+    }
+
+    if (best == NONE) {
+        return mostPrecise == NONE ? Float : static_cast<Precision>(mostPrecise);
+    }
+    return static_cast<Precision>(best);
+}
+
+void MandelbrotModel::updateAutoPrecision() {
+    if (!this->autoPrecision || !this->shader.uniforms.contains("zoomScale") || !this->shader.uniforms.contains("center")
+        || !this->shader.uniforms.contains("windowSize")) {
+        return;
+    }
+
+    const auto [width, height] = this->shader.getVec2UInt("windowSize");
+    const auto [centerX, centerY] = this->shader.getVec2Double("center");
+    const double pixelSize = this->shader.getDouble("zoomScale") / static_cast<double>(std::max(std::min(width, height), 1u));
+    const double magnitude = std::max({ 2.0, std::abs(centerX), std::abs(centerY) });
+
+    const PrecisionBenchmark& benchmark = getPrecisionBenchmark();
+    const Precision current = this->precision;
+    const Precision chosen = choosePrecision(pixelSize, magnitude, current, benchmark.nanosecondsPerIteration);
+
+    // Compiles the other variants ahead while a threshold is close, so that the switch loads them from the program binary cache
+    bool nearThreshold = false;
+    for (size_t p = 0; p < 3; ++p) {
+        const double threshold = PRECISION_RESOLUTION_MARGIN * PRECISION_EPSILON[p] * magnitude;
+        nearThreshold |= pixelSize < PRECISION_PRECOMPILE_RANGE * threshold && pixelSize > threshold / PRECISION_PRECOMPILE_RANGE;
+    }
+    for (size_t p = 0; nearThreshold && p < 3; ++p) {
+        if (p != static_cast<size_t>(chosen) && std::isfinite(benchmark.nanosecondsPerIteration[p])) {
+            this->setPrecision(static_cast<Precision>(p));
+            this->shader.precompile();
+        }
+    }
+
+    this->setPrecision(chosen);
+    if (chosen != current) {
+        this->shader.recompile();
+    }
+}
 
 void MandelbrotModel::imGuiScreenshotFrameHelper() {
     if (ImGui::SliderInt("Max Iterations", &this->maxIterations, 0, 5'000)) {
         this->shader.setUInt("maxIterations", static_cast<uint>(this->maxIterations));
     }
 
-    if (ImGui::Checkbox("Use Double Precision", &this->useDoublePrecision)) {
-        if (this->useDoublePrecision) {
-            this->shader.define("USE_DOUBLE", ""); 
-        } else {
-            this->shader.undefine("USE_DOUBLE");
-        }
-        this->shader.recompile();
+    int precisionIndex = this->autoPrecision ? 3 : static_cast<int>(this->precision);
+    if (ImGui::Combo("Precision", &precisionIndex, "Float\0Double\0Double-Float\0Auto\0")) {
+        this->autoPrecision = precisionIndex == 3;
+        if (!this->autoPrecision) {
+            this->setPrecision(static_cast<Precision>(precisionIndex));
+            this->shader.recompile();
+        } // otherwise in the next drawCall
+    }
+    if (ImGui::IsItemHovered()) {
+        std::ostringstream benchmark;
+        printPrecisionBenchmark(benchmark, getPrecisionBenchmark());
+        ImGui::SetTooltip("Double-Float: two floats per number (about 48 bits), almost as deep as Double but without fp64\n"
+            "Auto: the cheapest precision that still resolves the pixels, by zoom depth\n%s", benchmark.str().c_str());
+    }
+    if (this->autoPrecision) {
+        ImGui::SameLine();
+        ImGui::TextDisabled("(%s)", PrecisionBenchmark::NAMES[static_cast<size_t>(this->precision)]);
+    }
+
+    bool subdivision = this->marianiSilver;
+    if (ImGui::Checkbox("Mariani-Silver subdivision", &subdivision)) {
+        this->setMarianiSilver(subdivision);
+        this->shader.recompile(); // needed, because MARIANI_SILVER is a #define
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Only iterates the borders of blocks of pixels, a block with the same value on the whole border is filled with it.\n"
+            "Much faster for views with large areas inside the set or (without smoothing) large bands. Also used by the CPU threads.");
+    }
+
+    bool compute = this->computeShader;
+    if (ImGui::Checkbox("Compute shader", &compute)) {
+        this->setComputeShader(compute);
+        this->shader.recompile(); // needed, because COMPUTE_PIXELS is a #define
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Iterates in a compute shader in tiles of 8x8 pixels. Lanes that run together stop together,\n"
+            "as soon as all of them escaped or repeat a value (subgroup vote, if the driver supports it).");
     }
 }
 
@@ -3,9 +3,14 @@
 #define MANDELBROT_MODEL_MANDELBROT_INCLUDED
 
 #include <string>
+#include <array>
+#include <memory>
+#include <unordered_map>
+#include <glad/glad.h>
 
 #include "model_super_sampling.h"
 #include "model_colormap.h"
+#include "../fractal_formula.h"
 
 class MandelbrotModel : virtual public SuperSamplingModel, virtual public ColormapModel {
 public:
@@ -16,38 +21,108 @@ public:
         RainbowSmooth = 3
     };
 
+    // Arithmetic of the iteration, DoubleFloat (USE_DOUBLE_FLOAT) is about as deep as Double but only uses fp32, which is much faster on most consumer GPUs
+    enum Precision {
+        Float = 0,
+        Double = 1,
+        DoubleFloat = 2
+    };
+
+    // Automatic precision: a precision is used while a pixel is at least this many units in the last place of the coordinates (relative to the iterated values)
+    constexpr static double PRECISION_RESOLUTION_MARGIN = 256.0;
+    constexpr static double PRECISION_HYSTERESIS = 2.0; // switching back to a less precise one needs this factor more
+    constexpr static double PRECISION_PRECOMPILE_RANGE = 16.0; // the variants are compiled ahead when the pixel size is this close to a threshold
+
+    // Compute shader (see compute_shader_mandelbrot.glsl)
+    constexpr static GLuint MARIANI_SILVER_BLOCK_SIZE = 64; // distance of the borders of the first blocks
+    constexpr static size_t MARIANI_SILVER_PASSES = 5; // 65 -> 33 -> 17 -> 9 -> 5 pixels per side, the last ones are below MIN_BLOCK_SIZE of the shader
+    constexpr static GLuint MAX_WORK_GROUPS = 65535; // minimum of GL_MAX_COMPUTE_WORK_GROUP_COUNT per dimension, same as in the shader
+    constexpr static unsigned int PROGRESSIVE_MAX_SAMPLES = 256; // per pixel (a prefix of the PMJ02 sequence), a static view stops accumulating then
+
 public:
     MandelbrotModel();
     MandelbrotModel(const MandelbrotModel& other);
 
     virtual void applyUniformVariables() override;
+    virtual void drawCall() override;
     virtual void imGuiFrame() override;
     virtual void imGuiScreenshotFrame() override;
     virtual std::unique_ptr<Model> clone() const override;
     virtual void makeScreenshotModel() override;
     virtual void makeScreenshotModel(const Model& otherScreenshotModel) override;
     virtual void updateWithLiveModel(const Model& liveModel) override;
+    virtual bool makeScalarFieldModel(ScalarFieldHeader& header) override;
+    virtual bool setParameter(const std::string& parameter, const std::string& value) override;
+    virtual std::unique_ptr<CpuRenderer> makeCpuRenderer() override;
 
     ColorMap getColorMap() const;
     void setColorMap(ColorMap colorMap);
+    Precision getPrecision() const;
+    void setPrecision(Precision _precision); // needs recompile
+    /** @param power Of FractalFormula::Multibrot, clamped to MIN_MULTIBROT_POWER to MAX_MULTIBROT_POWER */
+    void setFormula(FractalFormula _formula, int _power); // needs recompile
+
+    /**
+     * Chooses the cheapest precision (by measured costs, see precision_benchmark.h) that still resolves pixels of the given size
+     * Falls back to the most precise supported one if none does
+     *
+     * @param magnitude Magnitude of the iterated values (at least the escape radius 2)
+     * @param current Precision in use, the hysteresis is relative to it
+     */
+    static Precision choosePrecision(double pixelSize, double magnitude, Precision current, const std::array<double, 3>& costs);
 
 public:
     constexpr static const char* FLOW_COLOR_TYPE = "FLOW_COLOR_TYPE";
-    // constexpr static const char* CODE_DIVERGENCE_CRITERION = "CODE_DIVERGENCE_CRITERION";
-    // constexpr static const char* CODE_CALCULATE_NEXT_SEQUENCE_TERM = "CODE_CALCULATE_NEXT_SEQUENCE_TERM";
 
     int maxIterations = 400;
     float colorScale = 50.0f;
-    bool useDoublePrecision = true;
+    Precision precision = Double;
+    bool autoPrecision = true; // precision is chosen by zoom depth in `drawCall`
     bool useSmoothing = true;
+    FractalFormula formula = FractalFormula::Mandelbrot; // see fractal_formula.h
+    int power = MIN_MULTIBROT_POWER; // of FractalFormula::Multibrot
+    double juliaReal = -0.8; // constant of FractalFormula::Julia
+    double juliaImag = 0.156;
+    bool marianiSilver = false; // only iterate the borders of blocks, see compute_shader_mandelbrot.glsl
+    bool computeShader = false; // iterate in compute_shader_mandelbrot.glsl (with subgroup votes) instead of the fragment shader
+    bool progressive = false; // one more sample per pixel every frame while nothing changes (live model only), see compute_shader_mandelbrot.glsl
     int sliceValue = 0;
     float sliceFactor = 0.5f;
-    // char codeDivergenceCriterion[1000] = "real*real + imag*imag > 4";
-    // char codeCalculateNextSequenceTerm[2000] = "real = real*real - imag*imag + startReal;\nimag = 2 * realTemp * imag + startImag;";
 
 protected:
     void imGuiScreenshotFrameHelper();
     void setDefaultScreenshotParameters();
+
+    /** Switches to the automatic precision (if enabled) for the view of the shader uniforms, compiles variants ahead near thresholds */
+    void updateAutoPrecision();
+
+    void setMarianiSilver(bool enabled); // needs recompile
+    void setComputeShader(bool enabled); // needs recompile
+    void setProgressive(bool enabled); // needs recompile
+    /**
+     * Allocates the pixel values for a viewport of `width` x `height` (and the block lists and center values, if needed)
+     * @return true if the objects are new (their contents are undefined)
+     */
+    bool allocateComputeObjects(int width, int height, bool blockLists, bool centerValues);
+    /** Computes the pixel values of the viewport with the passes of compute_shader_mandelbrot.glsl */
+    void dispatchMarianiSilver(int width, int height);
+    /** Computes the pixel values of the viewport with compute_shader_mandelbrot.glsl, one invocation per pixel */
+    void dispatchComputePixels(int width, int height);
+    /** Computes the pixel values of the viewport with the two passes of adaptive super sampling of compute_shader_mandelbrot.glsl */
+    void dispatchAdaptiveSuperSampling(int width, int height);
+    /** Adds the next progressive sample to the pixel values, restarts if the view, a uniform or a define changed since the last one */
+    void dispatchProgressive(int width, int height);
+
+    // Pixel values (RGBA32F texture), two block lists (one pass reads, the next writes, 0 without Mariani-Silver)
+    // and the center values of adaptive super sampling (RG32F texture, 0 without), not shared by copies
+    std::shared_ptr<std::array<GLuint, 4>> computeObjects;
+    int computeWidth = 0;
+    int computeHeight = 0;
+
+    // Progressive accumulation: samples in the pixel values, the uniforms (except the ones of the sample) and defines they were computed with
+    unsigned int progressiveSamples = 0;
+    std::unordered_map<std::string, Shader::uniform_t> progressiveUniforms;
+    std::unordered_map<std::string, std::string> progressiveDefines;
 };
 
 #endif
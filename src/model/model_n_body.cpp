@@ -0,0 +1,209 @@
+#include "model_n_body.h"
+
+#include <string> // for std::to_string, std::stof
+#include <sstream> // for std::istringstream
+#include <stdexcept> // for std::invalid_argument
+
+#include <ImGui/imgui.h>
+
+#include "../app_utility.h"
+
+NBodyModel::NBodyModel() :
+    Model(
+        "N-Body Problem",
+        Shader("../res/vertex_shader.glsl", "../res/fragment_shader_n_body_problem.glsl") // Don't compile and link shader (not responsibility of the model)
+    ),
+    SuperSamplingModel(
+        "N-Body Problem",
+        Shader("../res/vertex_shader.glsl", "../res/fragment_shader_n_body_problem.glsl") // Don't compile and link shader (not responsibility of the model)
+    ),
+    RK45Model(
+        "N-Body Problem",
+        Shader("../res/vertex_shader.glsl", "../res/fragment_shader_n_body_problem.glsl") // Don't compile and link shader (not responsibility of the model)
+    ),
+    ColormapModel(
+        "N-Body Problem",
+        Shader("../res/vertex_shader.glsl", "../res/fragment_shader_n_body_problem.glsl") // Don't compile and link shader (not responsibility of the model)
+    )
+    {
+        this->setVariant(this->variantIndex);
+        this->method = FEHLBERG;
+        this->updateMethodDefine(); // the RK45Model constructor couldn't know that there is no method selection
+    }
+
+NBodyModel::NBodyModel(const NBodyModel& other)
+    : Model(other),
+      SuperSamplingModel(other),
+      RK45Model(other),
+      ColormapModel(other),
+      variantIndex(other.variantIndex),
+      simulationEndTime(other.simulationEndTime),
+      distanceScale(other.distanceScale),
+      masses(other.masses),
+      startPositions(other.startPositions),
+      startMomenta(other.startMomenta),
+      simulationEndTimeMin(other.simulationEndTimeMin),
+      simulationEndTimeMax(other.simulationEndTimeMax)
+    { }
+
+void NBodyModel::setVariant(size_t index) {
+    this->variantIndex = index;
+    this->shader.define("N", std::to_string(VARIANTS[index].bodies));
+    this->shader.define("D", std::to_string(VARIANTS[index].dimension));
+}
+
+void NBodyModel::applyBodyUniforms() {
+    const uint bodies = static_cast<uint>(VARIANTS[this->variantIndex].bodies);
+    std::array<Shader::vec3, MAX_BODIES> positions;
+    std::array<Shader::vec3, MAX_BODIES> momenta;
+    for (size_t i = 0; i < MAX_BODIES; ++i) {
+        positions[i] = { this->startPositions[i][0], this->startPositions[i][1], this->startPositions[i][2] };
+        momenta[i] = { this->startMomenta[i][0], this->startMomenta[i][1], this->startMomenta[i][2] };
+    }
+    this->shader.setFloatArray("m", this->masses.data(), bodies);
+    this->shader.setVec3Array("q_start", positions.data(), bodies);
+    this->shader.setVec3Array("p_start", momenta.data(), bodies);
+}
+
+void NBodyModel::applyUniformVariables() {
+    this->SuperSamplingModel::applyUniformVariables();
+    this->RK45Model::applyUniformVariables();
+    this->ColormapModel::applyUniformVariables();
+
+    // N-Body Problem
+    this->shader.setFloat("t_end", this->simulationEndTime);
+    this->shader.setFloat("distance_scale", this->distanceScale);
+    this->applyBodyUniforms();
+}
+
+void NBodyModel::imGuiFrame() {
+    this->SuperSamplingModel::imGuiFrame();
+    this->RK45Model::imGuiFrame();
+    this->ColormapModel::imGuiFrame();
+
+    if (ImGui::CollapsingHeader("N-Body Problem", ImGuiTreeNodeFlags_DefaultOpen)) {
+        if (ImGui::BeginCombo("Bodies", VARIANTS[this->variantIndex].label)) {
+            for (size_t i = 0; i < VARIANTS.size(); ++i) {
+                bool isSelected = i == this->variantIndex;
+                if (ImGui::Selectable(VARIANTS[i].label, isSelected)) {
+                    this->setVariant(i);
+                    this->shader.recompile(); // needed, because N and D are #defines (variants compiled before are cached)
+                    this->applyBodyUniforms(); // the arrays have a different length
+                }
+                if (isSelected) {
+                    ImGui::SetItemDefaultFocus();
+                }
+            }
+            ImGui::EndCombo();
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("The pixel sets the start position of the last body (first two dimensions),\n"
+                "the color is the distance of the first two bodies at the End-Time. Always integrated with RK-Fehlberg.");
+        }
+
+        if (ImGuiFlexibleSliderFloat("End-Time", &this->simulationEndTime, &this->simulationEndTimeMin, &this->simulationEndTimeMax, 1.0f, 1.3f)) {
+            this->shader.setFloat("t_end", this->simulationEndTime);
+        }
+        if (ImGui::SliderFloat("Distance scale", &this->distanceScale, 0.1f, 100.0f, "%.1f", ImGuiSliderFlags_Logarithmic)) {
+            this->shader.setFloat("distance_scale", this->distanceScale);
+        }
+
+        bool bodiesChanged = false;
+        for (int i = 0; i < VARIANTS[this->variantIndex].bodies; ++i) {
+            const size_t index = static_cast<size_t>(i);
+            ImGui::PushID(i);
+            ImGui::Text("Body %d", i);
+            bodiesChanged |= ImGui::SliderFloat("m", &this->masses[index], 0.0f, 10.0f);
+            bodiesChanged |= ImGui::DragFloat3("q", this->startPositions[index].data(), 0.01f);
+            bodiesChanged |= ImGui::DragFloat3("p", this->startMomenta[index].data(), 0.01f);
+            ImGui::PopID();
+        }
+        if (bodiesChanged) {
+            this->applyBodyUniforms();
+        }
+    }
+}
+
+void NBodyModel::imGuiScreenshotFrame() {
+    this->SuperSamplingModel::imGuiScreenshotFrame();
+    this->RK45Model::imGuiScreenshotFrame();
+    this->ColormapModel::imGuiScreenshotFrame();
+}
+
+std::unique_ptr<Model> NBodyModel::clone() const {
+    return std::make_unique<NBodyModel>(*this);
+}
+
+void NBodyModel::makeScreenshotModel() {
+    this->SuperSamplingModel::makeScreenshotModel();
+    this->RK45Model::makeScreenshotModel();
+    this->ColormapModel::makeScreenshotModel();
+}
+
+void NBodyModel::makeScreenshotModel(const Model& otherScreenshotModel) {
+    this->SuperSamplingModel::makeScreenshotModel(otherScreenshotModel);
+    this->RK45Model::makeScreenshotModel(otherScreenshotModel);
+    this->ColormapModel::makeScreenshotModel(otherScreenshotModel);
+}
+
+void NBodyModel::updateWithLiveModel(const Model& liveModel) {
+    this->SuperSamplingModel::updateWithLiveModel(liveModel);
+    this->RK45Model::updateWithLiveModel(liveModel);
+    this->ColormapModel::updateWithLiveModel(liveModel);
+
+    const NBodyModel* liveNBodyModel = dynamic_cast<const NBodyModel*>(&liveModel);
+    if (liveNBodyModel == nullptr) { // liveModel is not an NBodyModel
+        return;
+    }
+
+    this->setVariant(liveNBodyModel->variantIndex);
+    this->simulationEndTime = liveNBodyModel->simulationEndTime;
+    this->distanceScale = liveNBodyModel->distanceScale;
+    this->masses = liveNBodyModel->masses;
+    this->startPositions = liveNBodyModel->startPositions;
+    this->startMomenta = liveNBodyModel->startMomenta;
+}
+
+/** Parses "x,y,z" */
+static std::array<float, 3> parseVector(const std::string& value) {
+    std::array<float, 3> vector;
+    std::istringstream stream(value);
+    char separator1 = 0;
+    char separator2 = 0;
+    stream >> vector[0] >> separator1 >> vector[1] >> separator2 >> vector[2];
+    if (!stream || separator1 != ',' || separator2 != ',') {
+        throw std::invalid_argument("expected x,y,z but got " + value);
+    }
+    return vector;
+}
+
+bool NBodyModel::setParameter(const std::string& parameter, const std::string& value) {
+    if (this->SuperSamplingModel::setParameter(parameter, value) || this->RK45Model::setParameter(parameter, value) || this->ColormapModel::setParameter(parameter, value)) {
+        return true;
+    }
+
+    // Same names as the uniforms
+    if (parameter == "t_end") { this->simulationEndTime = std::stof(value); return true; }
+    if (parameter == "distance_scale") { this->distanceScale = std::stof(value); return true; }
+    if (parameter == "bodies" || parameter == "dimension") { // the variant with the other value unchanged
+        const int bodies = parameter == "bodies" ? std::stoi(value) : VARIANTS[this->variantIndex].bodies;
+        const int dimension = parameter == "dimension" ? std::stoi(value) : VARIANTS[this->variantIndex].dimension;
+        for (size_t i = 0; i < VARIANTS.size(); ++i) {
+            if (VARIANTS[i].bodies == bodies && VARIANTS[i].dimension == dimension) {
+                this->setVariant(i);
+                return true;
+            }
+        }
+        throw std::invalid_argument("no variant with " + std::to_string(bodies) + " bodies in " + std::to_string(dimension) + "D");
+    }
+
+    // Bodies, e.g. "m0", "q0" ("x,y,z") and "p0"
+    if (parameter.size() == 2 && (parameter[0] == 'm' || parameter[0] == 'q' || parameter[0] == 'p') && parameter[1] >= '0' && parameter[1] < '0' + MAX_BODIES) {
+        const size_t index = static_cast<size_t>(parameter[1] - '0');
+        if (parameter[0] == 'm') this->masses[index] = std::stof(value);
+        if (parameter[0] == 'q') this->startPositions[index] = parseVector(value);
+        if (parameter[0] == 'p') this->startMomenta[index] = parseVector(value);
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,79 @@
+#pragma once
+#ifndef MANDELBROT_MODEL_N_BODY_INCLUDED
+#define MANDELBROT_MODEL_N_BODY_INCLUDED
+
+#include "model_rk45.h"
+#include "model_super_sampling.h"
+#include "model_colormap.h"
+
+#include <array>
+
+/** Gravitational N-body problem (n_body_problem_rhs.glsl), a pixel sets the start position of the last body, the color is the distance of the first two bodies at the End-Time */
+class NBodyModel : public virtual SuperSamplingModel, public virtual RK45Model, public virtual ColormapModel {
+public:
+    /** Number of bodies N and dimension of space D, both are #defines, so every variant is a separately compiled shader with unrolled loops */
+    struct Variant {
+        int bodies;
+        int dimension;
+        const char* label;
+    };
+    static constexpr int MAX_BODIES = 5;
+    static constexpr std::array<Variant, 6> VARIANTS = {{
+        { 2, 2, "2 bodies, 2D" },
+        { 2, 3, "2 bodies, 3D" },
+        { 3, 2, "3 bodies, 2D" },
+        { 3, 3, "3 bodies, 3D" },
+        { 4, 3, "4 bodies, 3D" },
+        { 5, 3, "5 bodies, 3D" },
+    }};
+
+protected:
+    // N-Body Problem Parameters
+    size_t variantIndex = 3; // 3 bodies, 3D
+    float simulationEndTime = 5.0f;
+    float distanceScale = 30.0f;
+    std::array<float, MAX_BODIES> masses = { 1.0f, 1.0f, 1.0f, 1.0f, 1.0f };
+    std::array<std::array<float, 3>, MAX_BODIES> startPositions = {{ // only the first D components are used, the last body's first two come from the pixel
+        { 0.0f, 0.0f, 0.0f },
+        { 1.2f, 0.0f, 0.0f },
+        { 0.0f, 1.2f, 0.0f },
+        { -1.2f, 0.0f, 0.3f },
+        { 0.0f, -1.2f, -0.3f },
+    }};
+    std::array<std::array<float, 3>, MAX_BODIES> startMomenta = {{
+        { 0.0f, 1.2f, 0.0f },
+        { 0.0f, -1.2f, 0.0f },
+        { 0.0f, 0.0f, -0.6f },
+        { 0.0f, 0.6f, 0.0f },
+        { 0.6f, 0.0f, 0.0f },
+    }};
+
+    // UI Variables
+    float simulationEndTimeMin = 0.0f;
+    float simulationEndTimeMax = 20.0f;
+
+    /** Sets N and D in the shader, but doesn't recompile it */
+    void setVariant(size_t index);
+    void applyBodyUniforms();
+
+public:
+    NBodyModel();
+    NBodyModel(const NBodyModel& other);
+
+    NBodyModel& operator=(const NBodyModel& other) = delete;
+    NBodyModel& operator=(NBodyModel&& other) = delete;
+
+    virtual void applyUniformVariables() override;
+    virtual void imGuiFrame() override;
+    virtual void imGuiScreenshotFrame() override;
+    virtual std::unique_ptr<Model> clone() const override;
+    virtual void makeScreenshotModel() override;
+    virtual void makeScreenshotModel(const Model& otherScreenshotModel) override;
+    virtual void updateWithLiveModel(const Model& liveModel) override;
+    virtual bool setParameter(const std::string& parameter, const std::string& value) override;
+
+    /** `rk45_arr` (RK45_DISABLE_VEC_METHODS) only has RK-Fehlberg */
+    virtual bool supportsMethodSelection() const override { return false; }
+};
+
+#endif
@@ -2,11 +2,67 @@
 
 #include <format>
 #include <cmath>
+#include <array> // for std::array
+#include <utility> // for std::pair
+#include <algorithm> // for std::min
+#include <stdexcept> // for std::invalid_argument
 
 #include <ImGui/imgui.h>
 
 #include "../app_utility.h"
 
+static const std::array<std::pair<const char*, RK45Model::Method>, 6> methodOptions = {{
+    std::make_pair("Auto", RK45Model::AUTO),
+    std::make_pair("RK-Fehlberg 4(5)", RK45Model::FEHLBERG),
+    std::make_pair("Dormand-Prince 5(4)", RK45Model::DOPRI5),
+    std::make_pair("DOP853", RK45Model::DOP853),
+    std::make_pair("Stormer-Verlet (symplectic)", RK45Model::VERLET),
+    std::make_pair("Yoshida 4 (symplectic)", RK45Model::YOSHIDA4)
+}};
+
+// Tightest tolerance exponent from which AUTO uses DOP853, its higher order pays off the doubled stages per step
+constexpr float DOP853_TOLERANCE_EXPONENT = -9.0f;
+
+RK45Model::RK45Model(const std::string& _name, Shader&& _shader) : Model(_name, std::move(_shader)) {
+    this->updateMethodDefine();
+}
+
+RK45Model::Method RK45Model::getResolvedMethod() const {
+    if (!this->supportsMethodSelection()) {
+        return FEHLBERG;
+    }
+    if (this->method != AUTO) {
+        return this->method;
+    }
+    return std::min(this->atolExponent, this->rtolExponent) <= DOP853_TOLERANCE_EXPONENT ? DOP853 : DOPRI5;
+}
+
+void RK45Model::setToleranceExponents(float _atolExponent, float _rtolExponent) {
+    this->atolExponent = _atolExponent;
+    this->rtolExponent = _rtolExponent;
+    this->updateMethodDefine();
+}
+
+bool RK45Model::makeEnergyFieldModel(ScalarFieldHeader& header, bool startState) {
+    (void)header;
+    (void)startState;
+    return false;
+}
+
+double RK45Model::getEnergy(const float* state) const {
+    (void)state;
+    return 0.0;
+}
+
+bool RK45Model::updateMethodDefine() {
+    const std::string value = std::to_string(this->getResolvedMethod());
+    if (this->shader.isDefined("RK_METHOD") && this->shader.getDefine("RK_METHOD") == value) {
+        return false;
+    }
+    this->shader.define("RK_METHOD", value);
+    return true;
+}
+
 void RK45Model::applyUniformVariables() {
     this->Model::applyUniformVariables();
 
@@ -15,18 +71,59 @@ void RK45Model::applyUniformVariables() {
 	this->shader.setFloat("MIN_TAU", this->minStepSize);
 	this->shader.setFloat("atol", std::pow(10.0f, this->atolExponent));
 	this->shader.setFloat("rtol", std::pow(10.0f, this->rtolExponent));
+	this->shader.setFloat("symplectic_tau", this->symplecticStepSize);
 }
 
 void RK45Model::imGuiFrameHelper() {
     if (ImGui::CollapsingHeader("RK45", ImGuiTreeNodeFlags_DefaultOpen)) {
 
+        if (!this->supportsMethodSelection()) {
+            ImGui::Text("Method: %s", methodOptions[1].first); // RK-Fehlberg 4(5)
+        } else {
+            const char* currentLabel = methodOptions[0].first;
+            for (const auto& option : methodOptions) {
+                if (option.second == this->method) {
+                    currentLabel = option.first;
+                }
+            }
+            if (ImGui::BeginCombo("Method", currentLabel)) {
+                for (const auto& option : methodOptions) {
+                    bool isSelected = (this->method == option.second);
+                    if (ImGui::Selectable(option.first, isSelected)) {
+                        this->method = option.second;
+                        if (this->updateMethodDefine()) {
+                            this->shader.recompile(); // needed, because the method is a #define
+                        }
+                    }
+                    if (isSelected) {
+                        ImGui::SetItemDefaultFocus();
+                    }
+                }
+                ImGui::EndCombo();
+            }
+            if (this->method == AUTO) {
+                ImGui::SameLine();
+                ImGui::Text(this->getResolvedMethod() == DOP853 ? "(DOP853)" : "(Dormand-Prince 5(4))");
+            }
+        }
+
         if (ImGuiFlexibleSliderInt("Max Iterations", &this->maxSteps, &this->maxStepsMin, &this->maxStepsMax, 1.0f, 1.5f)) {
             this->shader.setUInt("MAX_STEPS", static_cast<uint>(this->maxSteps));
         }
 
+        if (this->isSymplectic()) { // fixed step size, no tolerances
+            if (ImGui::SliderFloat("Step Size", &this->symplecticStepSize, 1e-4f, 0.1f, "%.1e", ImGuiSliderFlags_Logarithmic)) {
+                this->shader.setFloat("symplectic_tau", this->symplecticStepSize);
+            }
+            return;
+        }
+
         ImGui::Text("Absolute Tolerance Exponent");
         if (ImGui::SliderFloat("##Absolute Tolerance Exponent (10^_)", &this->atolExponent, -14.0, 2.0)) {
             this->shader.setFloat("atol", std::pow(10.0f, this->atolExponent));
+            if (this->updateMethodDefine()) {
+                this->shader.recompile(); // AUTO switched the method
+            }
         }
         ImGui::SameLine();
         ImGui::Text(std::format("{:.1e}", std::pow(10.0f, this->atolExponent)).c_str());
@@ -34,6 +131,9 @@ void RK45Model::imGuiFrameHelper() {
         ImGui::Text("Relative Tolerance Exponent");
         if (ImGui::SliderFloat("##Relative Tolerance Exponent (10^_)", &this->rtolExponent, -14.0, 2.0)) {
             this->shader.setFloat("rtol", std::pow(10.0f, this->rtolExponent));
+            if (this->updateMethodDefine()) {
+                this->shader.recompile(); // AUTO switched the method
+            }
         }
         ImGui::SameLine();
         ImGui::Text(std::format("{:.1e}", std::pow(10.0f, this->rtolExponent)).c_str());
@@ -62,6 +162,8 @@ void RK45Model::setDefaultScreenshotParameters() {
     this->atolExponent = -11.0f;
     this->rtolExponent = -11.0f;
     this->minStepSize = 1e-25f;
+    this->symplecticStepSize = 1e-3f;
+    this->updateMethodDefine();
 }
 
 void RK45Model::makeScreenshotModel() {
@@ -84,4 +186,30 @@ void RK45Model::makeScreenshotModel(const Model& otherScreenshotModel) {
     this->atolExponent = otherScreenshotRK45Model->atolExponent;
     this->rtolExponent = otherScreenshotRK45Model->rtolExponent;
     this->minStepSize = otherScreenshotRK45Model->minStepSize;
-}
\ No newline at end of file
+    this->method = otherScreenshotRK45Model->method;
+    this->symplecticStepSize = otherScreenshotRK45Model->symplecticStepSize;
+    this->updateMethodDefine();
+}
+
+bool RK45Model::setParameter(const std::string& parameter, const std::string& value) {
+    if (parameter == "maxSteps") { this->maxSteps = std::stoi(value); return true; }
+    if (parameter == "maxSameSteps") { this->maxSameSteps = std::stoi(value); return true; }
+    if (parameter == "minStepSize") { this->minStepSize = std::stof(value); return true; }
+    if (parameter == "atolExponent") { this->atolExponent = std::stof(value); this->updateMethodDefine(); return true; }
+    if (parameter == "rtolExponent") { this->rtolExponent = std::stof(value); this->updateMethodDefine(); return true; }
+    if (parameter == "symplecticStepSize") { this->symplecticStepSize = std::stof(value); return true; }
+    if (parameter == "rkMethod") { // label of the UI (e.g. "Auto", "DOP853") or value of the define (-1 for auto)
+        for (const auto& option : methodOptions) {
+            if (value == option.first || value == std::to_string(option.second)) {
+                if (!this->supportsMethodSelection() && option.second != FEHLBERG) {
+                    throw std::invalid_argument(this->name + " always integrates with RK-Fehlberg, not " + value);
+                }
+                this->method = option.second;
+                this->updateMethodDefine();
+                return true;
+            }
+        }
+        throw std::invalid_argument("unknown RK45 method " + value);
+    }
+    return this->Model::setParameter(parameter, value);
+}
@@ -5,6 +5,16 @@
 #include "model.h"
 
 class RK45Model : public virtual Model {
+public:
+    enum Method : int { // values of RK_METHOD in rk45.glsl
+        AUTO = -1, // picked from the tolerances, see `getResolvedMethod`
+        FEHLBERG = 0,
+        DOPRI5 = 1,
+        DOP853 = 2,
+        VERLET = 3, // fixed step symplectic methods, only for hamiltonian problems (symplectic.glsl)
+        YOSHIDA4 = 4
+    };
+
 protected:
     // RK45 Parameters
     int maxSteps = 10'000;
@@ -12,17 +22,20 @@ protected:
     float minStepSize = 1e-12f;
     float atolExponent = -5.0f; // corresponds to 1e-5
     float rtolExponent = -5.0f; // corresponds to 1e-5
+    Method method = AUTO;
+    float symplecticStepSize = 0.01f; // step size of VERLET and YOSHIDA4 (instead of the tolerances)
 
     // UI Variables
     int maxStepsMin = 1;
     int maxStepsMax = 100'000;
 
 public:
-    RK45Model(const std::string& _name, Shader&& _shader) : Model(_name, std::move(_shader)) { }
+    RK45Model(const std::string& _name, Shader&& _shader);
     RK45Model(const RK45Model& other) :
         Model(other),
         maxSteps(other.maxSteps), maxSameSteps(other.maxSameSteps),
-        minStepSize(other.minStepSize), atolExponent(other.atolExponent), rtolExponent(other.rtolExponent),
+        minStepSize(other.minStepSize), atolExponent(other.atolExponent), rtolExponent(other.rtolExponent), method(other.method),
+        symplecticStepSize(other.symplecticStepSize),
         maxStepsMin(other.maxStepsMin), maxStepsMax(other.maxStepsMax)
         { }
 
@@ -35,6 +48,33 @@ public:
     virtual std::unique_ptr<Model> clone() const override;
     virtual void makeScreenshotModel() override;
     virtual void makeScreenshotModel(const Model& otherScreenshotModel);
+    virtual bool setParameter(const std::string& parameter, const std::string& value) override;
+
+    /** `false` for models whose shader always integrates with RK-Fehlberg (e.g. `rk45_arr`), then the method can't be chosen */
+    virtual bool supportsMethodSelection() const { return true; }
+
+    /** `true` for the fixed step symplectic methods */
+    bool isSymplectic() const { return this->getResolvedMethod() == VERLET || this->getResolvedMethod() == YOSHIDA4; }
+
+    /** `method` or for AUTO the cheapest method for the tolerances (DOP853 for tight tolerances, otherwise Dormand-Prince 5(4)), always FEHLBERG without method selection */
+    Method getResolvedMethod() const;
+
+    float getAtolExponent() const { return this->atolExponent; }
+    float getRtolExponent() const { return this->rtolExponent; }
+
+    /** Sets both tolerance exponents (and RK_METHOD for AUTO), but doesn't recompile the shader or apply the uniforms */
+    void setToleranceExponents(float _atolExponent, float _rtolExponent);
+
+    /** Modify this model (a copy) like `makeScalarFieldModel`, but to output the raw state at t_end (or at t0 for `startState`),
+        whose energy `getEnergy` computes. Used by `tuneTolerances` for the energy drift. Returns `false` if the model has no energy (hamiltonian) */
+    virtual bool makeEnergyFieldModel(ScalarFieldHeader& header, bool startState);
+
+    /** Energy of one pixel of the field `makeEnergyFieldModel` outputs */
+    virtual double getEnergy(const float* state) const;
+
+protected:
+    /** Sets RK_METHOD to the resolved method, returns `true` if it changed (then the shader needs to be recompiled) */
+    bool updateMethodDefine();
 
 private:
     void imGuiFrameHelper();
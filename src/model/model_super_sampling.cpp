@@ -3,24 +3,47 @@
 #include <algorithm> // for std::find_if
 #include <utility> // for std::pair
 #include <array> // for std::array
-#include <string> // for stoi
+#include <string> // for std::to_string
+#include <stdexcept> // for std::invalid_argument
 
 #include <ImGui/imgui.h>
 
-
-SuperSamplingModel::SuperSamplingModel(const std::string& _name, Shader&& _shader, bool disableAdaptive, bool disableStatic)
+#include "../sample_sequence.h"
+
+static const std::array<std::pair<const char*, SuperSamplingModel::Mode>, 10> ssModeOptions = {{
+    std::make_pair("Adaptive", SuperSamplingModel::ADAPTIVE),
+    std::make_pair("Off", SuperSamplingModel::OFF),
+    std::make_pair("2", SuperSamplingModel::_2),
+    std::make_pair("4", SuperSamplingModel::_4),
+    std::make_pair("6", SuperSamplingModel::_6),
+    std::make_pair("8", SuperSamplingModel::_8),
+    std::make_pair("12", SuperSamplingModel::_12),
+    std::make_pair("16", SuperSamplingModel::_16),
+    std::make_pair("16 (pmj)", SuperSamplingModel::_16_PMJ),
+    std::make_pair("32 (pmj)", SuperSamplingModel::_32_PMJ)
+}};
+
+SuperSamplingModel::SuperSamplingModel(const std::string& _name, Shader&& _shader, bool _disableAdaptive, bool _disableStatic, bool _sampleOffsetsBuffer)
     : Model(_name, std::move(_shader)),
-      disableAdaptive(disableAdaptive),
-      disableStatic(disableStatic)
+      disableAdaptive(_disableAdaptive),
+      disableStatic(_disableStatic),
+      sampleOffsetsBuffer(_sampleOffsetsBuffer)
 {
-    this->shader.define("SUPER_SAMPLING", std::to_string(SuperSamplingModel::_2));
+    if (this->sampleOffsetsBuffer) {
+        this->shader.define("SAMPLE_OFFSETS_BUFFER", "");
+    }
+    this->setSSMode(SuperSamplingModel::_2);
 }
 
 SuperSamplingModel::SuperSamplingModel(const SuperSamplingModel& other)
     : Model(other),
       ssMeanDiffTolerance(other.ssMeanDiffTolerance),
       ssAbsoluteStandardErrorTolerance(other.ssAbsoluteStandardErrorTolerance),
-      ssRelativeStandardErrorTolerance(other.ssRelativeStandardErrorTolerance)
+      ssRelativeStandardErrorTolerance(other.ssRelativeStandardErrorTolerance),
+      disableAdaptive(other.disableAdaptive),
+      disableStatic(other.disableStatic),
+      sampleOffsetsBuffer(other.sampleOffsetsBuffer),
+      ssMode(other.ssMode)
 { }
 
 void SuperSamplingModel::applyUniformVariables() {
@@ -32,20 +55,8 @@ void SuperSamplingModel::applyUniformVariables() {
 }
 
 void SuperSamplingModel::imGuiFrameHelper() {
-    static const std::array<std::pair<const char*, SuperSamplingModel::Mode>, 10> options = {{
-        std::make_pair("Adaptive", SuperSamplingModel::ADAPTIVE),
-        std::make_pair("Off", SuperSamplingModel::OFF),
-        std::make_pair("2", SuperSamplingModel::_2),
-        std::make_pair("4", SuperSamplingModel::_4),
-        std::make_pair("6", SuperSamplingModel::_6),
-        std::make_pair("8", SuperSamplingModel::_8),
-        std::make_pair("12", SuperSamplingModel::_12),
-        std::make_pair("16", SuperSamplingModel::_16),
-        std::make_pair("16 (pmj)", SuperSamplingModel::_16_PMJ),
-        std::make_pair("32 (pmj)", SuperSamplingModel::_32_PMJ)
-    }};
-
-    
+    const auto& options = ssModeOptions;
+
     if (ImGui::CollapsingHeader("Super Sampling (Anti-Aliasing)", ImGuiTreeNodeFlags_DefaultOpen)) {
         const auto currentSSMode = this->getSSMode();
         auto it = std::find_if(options.begin(), options.end(),
@@ -64,8 +75,11 @@ void SuperSamplingModel::imGuiFrameHelper() {
                 }
                 bool isSelected = (currentSSMode == option.second);
                 if (ImGui::Selectable(option.first, isSelected)) {
+                    const std::string define = this->shader.getDefine("SUPER_SAMPLING");
                     this->setSSMode(option.second);
-                    this->shader.recompile(); // needed, because super sampling mode is a #define
+                    if (this->shader.getDefine("SUPER_SAMPLING") != define) {
+                        this->shader.recompile(); // needed, because super sampling mode is a #define
+                    }
                 }
                 if (isSelected) {
                     ImGui::SetItemDefaultFocus();
@@ -134,10 +148,68 @@ void SuperSamplingModel::makeScreenshotModel(const Model& otherScreenshotModel)
 }
 
 
+bool SuperSamplingModel::setParameter(const std::string& parameter, const std::string& value) {
+    if (parameter == "superSampling") { // label of the UI (e.g. "Adaptive", "16 (pmj)") or value of the define (e.g. "1601")
+        for (const auto& option : ssModeOptions) {
+            if (value == option.first || value == std::to_string(option.second)) {
+                this->setSSMode(option.second);
+                return true;
+            }
+        }
+        throw std::invalid_argument("unknown super sampling mode " + value);
+    }
+    if (parameter == "ssMeanTol") { this->ssMeanDiffTolerance = std::stof(value); return true; }
+    if (parameter == "ssAbsSETol") { this->ssAbsoluteStandardErrorTolerance = std::stof(value); return true; }
+    if (parameter == "ssRelSETol") { this->ssRelativeStandardErrorTolerance = std::stof(value); return true; }
+    return this->Model::setParameter(parameter, value);
+}
+
+
 SuperSamplingModel::Mode SuperSamplingModel::getSSMode() const {
-    return static_cast<SuperSamplingModel::Mode>(stoi(this->shader.getDefine("SUPER_SAMPLING"))); // stoi = string to int
+    return this->ssMode;
 }
 
 void SuperSamplingModel::setSSMode(SuperSamplingModel::Mode mode) {
-    this->shader.define("SUPER_SAMPLING", std::to_string(mode));
+    this->ssMode = mode;
+    if (this->sampleOffsetsBuffer && mode != SuperSamplingModel::ADAPTIVE) {
+        this->shader.define("SUPER_SAMPLING", std::to_string(SuperSamplingModel::OFF)); // any static mode, the number of samples is a uniform
+    } else {
+        this->shader.define("SUPER_SAMPLING", std::to_string(mode));
+    }
+}
+
+const std::vector<SampleOffset>& SuperSamplingModel::getSampleOffsets() const {
+    if (this->sampleOffsetsBuffer) {
+        switch (this->ssMode) {
+        case SuperSamplingModel::ADAPTIVE:
+            return getPmj02Samples(ADAPTIVE_MAX_SAMPLES);
+        case SuperSamplingModel::_16_PMJ:
+            return getPmj02Samples(16);
+        case SuperSamplingModel::_32_PMJ:
+            return getPmj02Samples(32);
+        default:
+            break;
+        }
+    }
+    return getStaticSampleOffsets(this->ssMode);
+}
+
+void SuperSamplingModel::bindSampleOffsets(const std::vector<SampleOffset>& offsets) {
+    static_assert(sizeof(SampleOffset) == 2 * sizeof(float), "the buffer is an array of vec2 (std430)");
+    if (!this->sampleOffsetsObject) {
+        this->sampleOffsetsObject = std::shared_ptr<GLuint>(new GLuint(0), [](GLuint* ptr) {
+            glDeleteBuffers(1, ptr);
+            delete ptr;
+        });
+        glGenBuffers(1, this->sampleOffsetsObject.get());
+        this->uploadedSampleOffsets = nullptr;
+    }
+    if (&offsets != this->uploadedSampleOffsets) { // the offsets of a mode are static, so the address identifies them
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, *this->sampleOffsetsObject);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(offsets.size() * sizeof(SampleOffset)), offsets.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        this->uploadedSampleOffsets = &offsets;
+    }
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SAMPLE_OFFSETS_BINDING, *this->sampleOffsetsObject);
+    this->shader.setUInt("num_samples", static_cast<uint>(offsets.size()));
 }
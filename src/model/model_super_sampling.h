@@ -2,8 +2,12 @@
 #ifndef MANDELBROT_MODEL_SUPER_SAMPLING_INCLUDED
 #define MANDELBROT_MODEL_SUPER_SAMPLING_INCLUDED
 
+#include <vector>
+
 #include "model.h"
 
+struct SampleOffset;
+
 class SuperSamplingModel : public virtual Model {
 public:
     enum Mode {
@@ -19,8 +23,15 @@ public:
         _32_PMJ = 32,
     };
 
+    constexpr static GLuint SAMPLE_OFFSETS_BINDING = 2; // of the shader storage buffer of static_supersampling.glsl
+    constexpr static size_t ADAPTIVE_MAX_SAMPLES = 16; // with a sample offsets buffer
+
 public:
-    SuperSamplingModel(const std::string& _name, Shader&& _shader, bool disableAdaptive = false, bool disableStatic = false);
+    /**
+     * @param sampleOffsetsBuffer The shaders take the offsets from a buffer (SAMPLE_OFFSETS_BUFFER, see `bindSampleOffsets`) instead of the
+     *     constants of static_supersampling.glsl, so SUPER_SAMPLING only tells adaptive (0) from static (1), and changing the mode doesn't recompile
+     */
+    SuperSamplingModel(const std::string& _name, Shader&& _shader, bool _disableAdaptive = false, bool _disableStatic = false, bool _sampleOffsetsBuffer = false);
     SuperSamplingModel(const SuperSamplingModel& other);
 
     virtual void applyUniformVariables() override;
@@ -29,11 +40,18 @@ public:
     virtual std::unique_ptr<Model> clone() const override;
     virtual void makeScreenshotModel() override;
     virtual void makeScreenshotModel(const Model& otherScreenshotModel) override;
+    virtual bool setParameter(const std::string& parameter, const std::string& value) override;
     
     /** Set super sampling mode in the shader, but don't recompile it */
     void setSSMode(Mode newSSMode);
     Mode getSSMode() const;
 
+    /**
+     * Offsets of the samples of the mode, the PMJ modes (and ADAPTIVE_MAX_SAMPLES for adaptive) are the PMJ02 sequence of sample_sequence.h
+     * with a sample offsets buffer, otherwise the constants of static_supersampling.glsl (empty for adaptive)
+     */
+    const std::vector<SampleOffset>& getSampleOffsets() const;
+
 public:
     float ssMeanDiffTolerance = 0.003f;
     float ssAbsoluteStandardErrorTolerance = 0.004f;
@@ -42,9 +60,17 @@ public:
 protected:
     bool disableAdaptive;
     bool disableStatic;
+    bool sampleOffsetsBuffer;
+    Mode ssMode = _2;
     void imGuiFrameHelper();
     void setDefaultScreenshotParameters();
 
+    /** Uploads `offsets` (if they are not the ones of the last call) to the sample offsets buffer and binds it, NUM_SAMPLES is their number */
+    void bindSampleOffsets(const std::vector<SampleOffset>& offsets);
+
+    std::shared_ptr<GLuint> sampleOffsetsObject; // not shared by copies
+    const std::vector<SampleOffset>* uploadedSampleOffsets = nullptr;
+
 };
 
 
@@ -0,0 +1,75 @@
+#include "precision_benchmark.h"
+
+#include <iostream>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+
+#include <glad/glad.h>
+
+#include "shader.h"
+
+/** Nanoseconds per iteration in the given precision (defines of real.glsl), infinity if the shader does not compile */
+static double measureIterationCost(const char* define) {
+    constexpr GLuint LOCAL_SIZE = 64; // of the compute shader
+    constexpr GLuint INVOCATIONS = 1u << 16; // enough to fill a GPU
+    constexpr GLuint ITERATIONS = 128;
+    constexpr int REPEATS = 3; // the minimum is used
+
+    Shader shader("", "", "../res/compute_shader_precision_benchmark.glsl");
+    if (define != nullptr) {
+        shader.define(define, "");
+    }
+    shader.useCompute();
+    GLint linked = 0;
+    glGetProgramiv(shader.computeProgram, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        return std::numeric_limits<double>::infinity();
+    }
+    glUniform1ui(glGetUniformLocation(shader.computeProgram, "iterations"), ITERATIONS); // not setUInt, the shader has no fragment program
+
+    GLuint buffer;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(INVOCATIONS * sizeof(float)), nullptr, GL_DYNAMIC_DRAW);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, buffer);
+
+    double best = std::numeric_limits<double>::infinity();
+    for (int i = 0; i <= REPEATS; ++i) { // the first dispatch is a warm up
+        glFinish();
+        const auto start = std::chrono::steady_clock::now();
+        glDispatchCompute(INVOCATIONS / LOCAL_SIZE, 1, 1);
+        glFinish();
+        const auto end = std::chrono::steady_clock::now();
+        if (i > 0) {
+            best = std::min(best, static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+        }
+    }
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, 0);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    glDeleteBuffers(1, &buffer);
+    return best / static_cast<double>(INVOCATIONS * ITERATIONS);
+}
+
+const PrecisionBenchmark& getPrecisionBenchmark() {
+    static PrecisionBenchmark benchmark;
+    if (!benchmark.measured) {
+        GLint program = 0;
+        glGetIntegerv(GL_CURRENT_PROGRAM, &program); // useCompute changes the program
+
+        benchmark.nanosecondsPerIteration = { measureIterationCost(nullptr), measureIterationCost("USE_DOUBLE"), measureIterationCost("USE_DOUBLE_FLOAT") };
+        benchmark.measured = true;
+
+        glUseProgram(static_cast<GLuint>(program));
+    }
+    return benchmark;
+}
+
+void printPrecisionBenchmark(std::ostream& stream, const PrecisionBenchmark& benchmark) {
+    stream << "Nanoseconds per iteration:";
+    for (size_t i = 0; i < benchmark.nanosecondsPerIteration.size(); ++i) {
+        stream << " " << PrecisionBenchmark::NAMES[i] << " " << benchmark.nanosecondsPerIteration[i];
+    }
+    stream << "\n";
+}
@@ -0,0 +1,28 @@
+#pragma once
+#ifndef MANDELBROT_PRECISIONBENCHMARK_INCLUDED
+#define MANDELBROT_PRECISIONBENCHMARK_INCLUDED
+
+#include <array>
+#include <ostream>
+
+/**
+ * Measured cost of one Mandelbrot iteration per precision, by the values of MandelbrotModel::Precision (float, double, double-float).
+ * The automatic precision of MandelbrotModel uses the cheapest one that still resolves the pixels.
+ */
+struct PrecisionBenchmark {
+    static constexpr const char* NAMES[3] = { "float", "double", "double-float" };
+
+    std::array<double, 3> nanosecondsPerIteration = { 1.0, 32.0, 8.0 }; // infinity if not supported (e.g. no fp64), the defaults are a typical consumer GPU
+    bool measured = false;
+};
+
+/**
+ * Runs the benchmark (res/compute_shader_precision_benchmark.glsl) on the first call and returns the result of it on every call.
+ * Needs a current OpenGL context, takes a few hundred milliseconds on a software renderer.
+ */
+const PrecisionBenchmark& getPrecisionBenchmark();
+
+/** Prints the costs in one line */
+void printPrecisionBenchmark(std::ostream& stream, const PrecisionBenchmark& benchmark);
+
+#endif
@@ -0,0 +1,74 @@
+#include "sample_sequence.h"
+
+#include <map>
+#include <mutex>
+
+static constexpr uint64_t PMJ02_SEED = 0x4d616e64656c6272ull; // any constant, fixed so that renders are reproducible
+
+// splitmix64 finalizer
+static uint64_t mixBits(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+// First dimension of the Sobol sequence (van der Corput), the index with reversed bits
+static uint32_t sobolX(uint32_t index) {
+    uint32_t result = 0;
+    for (uint32_t v = 1u << 31; index != 0; index >>= 1, v >>= 1) {
+        if (index & 1u) {
+            result ^= v;
+        }
+    }
+    return result;
+}
+
+// Second dimension of the Sobol sequence, its generator matrix is the Pascal matrix mod 2
+static uint32_t sobolY(uint32_t index) {
+    uint32_t result = 0;
+    for (uint32_t v = 1u << 31; index != 0; index >>= 1, v ^= v >> 1) {
+        if (index & 1u) {
+            result ^= v;
+        }
+    }
+    return result;
+}
+
+// Nested uniform (Owen) scrambling: every bit is flipped or not depending on the seed, its position and all bits above it,
+// which permutes the elementary intervals of every size among themselves, so the sequence stays a (0,2) sequence
+static uint32_t owenScramble(uint32_t x, uint64_t seed) {
+    uint32_t result = x;
+    for (uint32_t bit = 0; bit < 32; ++bit) {
+        const uint64_t above = bit == 31 ? 0u : static_cast<uint64_t>(x >> (bit + 1));
+        if (mixBits(seed ^ (above << 5 | bit)) & 1u) {
+            result ^= 1u << bit;
+        }
+    }
+    return result;
+}
+
+std::vector<SampleOffset> generatePmj02Samples(size_t count, uint64_t seed) {
+    const uint64_t seedX = mixBits(seed);
+    const uint64_t seedY = mixBits(seedX);
+    std::vector<SampleOffset> samples(count);
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t x = owenScramble(sobolX(static_cast<uint32_t>(i)), seedX);
+        const uint32_t y = owenScramble(sobolY(static_cast<uint32_t>(i)), seedY);
+        samples[i] = { static_cast<float>(x >> 8) * 0x1p-24f - 0.5f, static_cast<float>(y >> 8) * 0x1p-24f - 0.5f }; // 24 bits are exact in float
+    }
+    return samples;
+}
+
+const std::vector<SampleOffset>& getPmj02Samples(size_t count) {
+    static std::mutex mutex;
+    static std::map<size_t, std::vector<SampleOffset>> sequences; // nodes are stable, the references stay valid
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = sequences.find(count);
+    if (it == sequences.end()) {
+        it = sequences.emplace(count, generatePmj02Samples(count, PMJ02_SEED)).first;
+    }
+    return it->second;
+}
@@ -0,0 +1,21 @@
+#pragma once
+#ifndef MANDELBROT_SAMPLESEQUENCE_INCLUDED
+#define MANDELBROT_SAMPLESEQUENCE_INCLUDED
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "cpu/cpu_renderer.h" // for SampleOffset
+
+/**
+ * The first `count` points of a progressive multi-jittered (0,2) sequence, as offsets from the pixel center in [-0.5, 0.5)^2
+ * Generated as Owen-scrambled Sobol points: every prefix of 2^k points has exactly one point in every elementary interval of area 2^-k
+ * (like the pmj02bn tables of static_supersampling.glsl), so every prefix is well distributed, not only the full sequence
+ */
+std::vector<SampleOffset> generatePmj02Samples(size_t count, uint64_t seed);
+
+/** `generatePmj02Samples` with the seed of all models (so that the CPU threads and the shaders agree), generated once per count */
+const std::vector<SampleOffset>& getPmj02Samples(size_t count);
+
+#endif
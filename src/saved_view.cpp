@@ -1,6 +1,9 @@
 #include "saved_view.h"
 
 #include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <algorithm> // for std::find
 
 // * static
 
@@ -17,11 +20,15 @@ IniFile<int> SavedView::iniFile{INI_FILE_PATH};
 void SavedView::initFromFile() {
 	for (const auto& pair : iniFile) {
 		//allViews.insert(std::cbegin(allViews), std::move(SavedView{pair.first, pair.second})); // Add to front
-		allViews.push_back(SavedView{pair.first, pair.second});
+		try {
+			allViews.push_back(SavedView{pair.first, pair.second});
+		} catch (const std::logic_error& error) { // std::invalid_argument and std::out_of_range of corrupt numbers
+			std::cerr << "Warning: skipping saved view " << pair.first << " of " << INI_FILE_PATH << ", " << error.what() << std::endl;
+		}
 	}
 }
 
-void SavedView::saveNew(long double zoomScale, const ComplexNum& center, const std::string& name) {
+void SavedView::saveNew(const FixedPoint& zoomScale, const ComplexNum& center, const std::string& name) {
 	allViews.push_back(SavedView{zoomScale, center, name});
 	const SavedView& currentElement = *(allViews.cend() - 1);
 	iniFile.set(currentElement.imGuiIDs[0], currentElement.viewDataToString());
@@ -65,7 +72,7 @@ int SavedView::createNewID() const {
 	return newID;
 }
 
-SavedView::SavedView(long double _zoomScale, const ComplexNum& _center, const std::string& _name)
+SavedView::SavedView(const FixedPoint& _zoomScale, const ComplexNum& _center, const std::string& _name)
     : zoomScale(_zoomScale), center(_center), name(_name)
 {
     if (_name.empty()) {
@@ -79,6 +86,7 @@ SavedView::SavedView(long double _zoomScale, const ComplexNum& _center, const st
 
 SavedView::SavedView(int firstID, const std::string& viewData) {
 	// Format: "name|zoomScale|center.first|center.second|imGuiIds[1]|...|imGuiIds['last']|"
+	// The numbers are decimal with all digits of FixedPoint (older files have long double, e.g. "1.7e-10", which parses too)
 	std::string value;
 	std::stringstream stream{viewData};
 
@@ -87,13 +95,13 @@ SavedView::SavedView(int firstID, const std::string& viewData) {
 	std::getline(stream, name, '|');
 
 	std::getline(stream, value, '|');
-	zoomScale = std::stold(value);
+	zoomScale = FixedPoint::fromString(value);
 
 	std::getline(stream, value, '|');
-	center.first = std::stold(value);
+	center.first = FixedPoint::fromString(value);
 
 	std::getline(stream, value, '|');
-	center.second = std::stold(value);
+	center.second = FixedPoint::fromString(value);
 
 	for (size_t i = 0; std::getline(stream, value, '|'); i++)
 		imGuiIDs[i + 1] = std::stoi(value);
@@ -102,15 +110,14 @@ SavedView::SavedView(int firstID, const std::string& viewData) {
 std::string SavedView::createGenericName() const {
     std::stringstream stream;
     stream.precision(5);
-    stream << center.first * zoomScale << " + " << center.second * zoomScale << " i (" << zoomScale << ")";
+    stream << (center.first * zoomScale).toLongDouble() << " + " << (center.second * zoomScale).toLongDouble() << " i (" << zoomScale.toLongDouble() << ")";
     return stream.str();
 }
 
 std::string SavedView::viewDataToString() const {
 	// Format: "name|zoomScale|center.first|center.second|imGuiIds[1]|...|imGuiIds['last']|"
 	std::stringstream stream;
-	stream.precision(std::numeric_limits<long double>::max_digits10);
-	stream << name << '|' << zoomScale << '|' << center.first << '|' << center.second << '|';
+	stream << name << '|' << zoomScale.toString() << '|' << center.first.toString() << '|' << center.second.toString() << '|';
 	for (size_t i = 1; i < imGuiIDs.size(); i++)
 		stream << imGuiIDs[i] << '|';
 	return stream.str();
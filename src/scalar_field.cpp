@@ -0,0 +1,210 @@
+#include "scalar_field.h"
+
+#include <iostream>
+#include <fstream>
+#include <cstring> // for std::memcmp
+#include <cmath>
+#include <algorithm> // for std::clamp
+
+#if defined(__unix__) || defined(__APPLE__)
+    #define MANDELBROT_SCALARFIELD_USE_MMAP
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "colormaps.h"
+#include "app_utility.h"
+
+bool writeScalarField(const std::string& filename, const ScalarFieldHeader& header, const float* data) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file) {
+        std::cerr << "    Error: failed to open '" << filename << "' for writing\n";
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    const size_t count = static_cast<size_t>(header.width) * header.height * header.channels;
+    file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(float)));
+
+    if (!file) {
+        std::cerr << "    Error: failed to write scalar field '" << filename << "'\n";
+        return false;
+    }
+    return true;
+}
+
+
+ScalarFieldFile::~ScalarFieldFile() {
+    this->close();
+}
+
+/** Channels of the pixels of `kind` (see `ScalarFieldKind`), 0 for unknown kinds */
+static uint32_t channelsOfKind(ScalarFieldKind kind) {
+    switch (kind) {
+    case ScalarFieldKind::MANDELBROT: return 2u;
+    case ScalarFieldKind::DOUBLE_PENDULUM_Y2: return 2u;
+    case ScalarFieldKind::DOUBLE_PENDULUM_STATE: return 4u;
+    }
+    return 0u;
+}
+
+bool ScalarFieldFile::open(const std::string& filename) {
+    this->close();
+
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file) {
+        std::cerr << "Error: failed to open scalar field '" << filename << "'" << std::endl;
+        return false;
+    }
+    const size_t fileSize = static_cast<size_t>(file.tellg());
+    file.seekg(0);
+
+    if (fileSize < sizeof(ScalarFieldHeader) || !file.read(reinterpret_cast<char*>(&this->header), sizeof(ScalarFieldHeader))) {
+        std::cerr << "Error: '" << filename << "' is too small to be a scalar field" << std::endl;
+        return false;
+    }
+    if (std::memcmp(this->header.magic, ScalarFieldHeader::MAGIC, sizeof(ScalarFieldHeader::MAGIC)) != 0) {
+        std::cerr << "Error: '" << filename << "' is not a scalar field file" << std::endl;
+        return false;
+    }
+    if (this->header.version != ScalarFieldHeader::VERSION || this->header.headerSize < sizeof(ScalarFieldHeader) || this->header.headerSize % sizeof(float) != 0) {
+        std::cerr << "Error: unsupported scalar field version " << this->header.version << " in '" << filename << "'" << std::endl;
+        return false;
+    }
+
+    if (channelsOfKind(this->header.kind) == 0u) {
+        std::cerr << "Error: unknown scalar field kind " << static_cast<uint32_t>(this->header.kind) << " in '" << filename << "'" << std::endl;
+        return false;
+    }
+    if (this->header.channels != channelsOfKind(this->header.kind)) { // recoloring reads the channels by kind
+        std::cerr << "Error: scalar field '" << filename << "' has " << this->header.channels << " channels, its kind needs "
+            << channelsOfKind(this->header.kind) << std::endl;
+        return false;
+    }
+
+    const size_t dataSize = static_cast<size_t>(this->header.width) * this->header.height * this->header.channels * sizeof(float);
+    if (dataSize == 0 || fileSize < this->header.headerSize + dataSize) {
+        std::cerr << "Error: scalar field '" << filename << "' is truncated" << std::endl;
+        return false;
+    }
+
+#ifdef MANDELBROT_SCALARFIELD_USE_MMAP
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        void* memory = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // the mapping stays valid
+        if (memory != MAP_FAILED) {
+            madvise(memory, fileSize, MADV_SEQUENTIAL);
+            this->mappedMemory = memory;
+            this->mappedSize = fileSize;
+            this->data = reinterpret_cast<const float*>(static_cast<const char*>(memory) + this->header.headerSize);
+            return true;
+        }
+    }
+#endif
+
+    // Fallback: read everything
+    this->fallbackBuffer.resize(dataSize / sizeof(float));
+    file.seekg(this->header.headerSize);
+    if (!file.read(reinterpret_cast<char*>(this->fallbackBuffer.data()), static_cast<std::streamsize>(dataSize))) {
+        std::cerr << "Error: failed to read scalar field '" << filename << "'" << std::endl;
+        this->fallbackBuffer.clear();
+        return false;
+    }
+    this->data = this->fallbackBuffer.data();
+    return true;
+}
+
+void ScalarFieldFile::close() {
+#ifdef MANDELBROT_SCALARFIELD_USE_MMAP
+    if (this->mappedMemory != nullptr) {
+        munmap(this->mappedMemory, this->mappedSize);
+    }
+#endif
+    this->mappedMemory = nullptr;
+    this->mappedSize = 0;
+    this->fallbackBuffer.clear();
+    this->fallbackBuffer.shrink_to_fit();
+    this->data = nullptr;
+}
+
+
+static unsigned char toByte(float x) {
+    return static_cast<unsigned char>(std::clamp(x, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+// map interval (a, b) to (c, d), same as in the shaders
+static float remap(float x, float a, float b, float c, float d) {
+    return c + (x - a) * (d - c) / (b - a);
+}
+
+/** Color of a single pixel, mirrors the end of the fragment shaders */
+static void recolorPixel(const ScalarFieldHeader& header, const float* values, const std::vector<float>& colormap, bool cyclic, const RecolorOptions& options, float rgb[3]) {
+    constexpr float PI = 3.14159265358979323846f;
+
+    switch (header.kind) {
+    case ScalarFieldKind::MANDELBROT: {
+        const float avgSmoothCount = values[0];
+        const float outsideRatio = values[1];
+        sampleColormap(colormap, avgSmoothCount / options.colorScale, cyclic, rgb);
+        for (int c = 0; c < 3; ++c) rgb[c] *= outsideRatio; // interpolate between outside color and implicit black
+        return;
+    }
+    case ScalarFieldKind::DOUBLE_PENDULUM_Y2: {
+        const uint32_t status = static_cast<uint32_t>(values[1]);
+        if (status == 1u) { rgb[0] = 1.0f; rgb[1] = 0.7f; rgb[2] = 0.0f; return; } // orange (ERR_TOO_MANY_STEPS)
+        if (status == 2u) { rgb[0] = 1.0f; rgb[1] = 0.0f; rgb[2] = 0.7f; return; } // purple (ERR_TOO_MANY_SAME_STEPS)
+        if (status == 3u) { rgb[0] = 1.0f; rgb[1] = 0.7f; rgb[2] = 0.7f; return; } // light red (ERR_TAU_TOO_SMALL)
+        const float l = header.params[0] + header.params[1];
+        sampleColormap(colormap, remap(values[0], -l, l, 0.0f, 1.0f), cyclic, rgb);
+        return;
+    }
+    case ScalarFieldKind::DOUBLE_PENDULUM_STATE: {
+        if (std::isnan(values[0])) { rgb[0] = 1.0f; rgb[1] = 0.7f; rgb[2] = 0.7f; return; } // light red (rk45 failed)
+        float value;
+        if (options.channel < 0) { // y2
+            const float l1 = header.params[0];
+            const float l2 = header.params[1];
+            const float y2 = -l1 * std::cos(values[0]) - l2 * std::cos(values[1]);
+            value = remap(y2, -(l1 + l2), l1 + l2, 0.0f, 1.0f);
+        } else if (options.channel < 2) { // angles, one turn covers the colormap (use a cyclic colormap)
+            value = values[options.channel] / (2.0f * PI);
+        } else { // velocities, [-colorScale, colorScale] covers the colormap
+            value = remap(values[options.channel], -options.colorScale, options.colorScale, 0.0f, 1.0f);
+        }
+        sampleColormap(colormap, value, cyclic, rgb);
+        return;
+    }
+    }
+    rgb[0] = rgb[1] = rgb[2] = 0.0f;
+}
+
+void recolorScalarField(
+    const ScalarFieldFile& field,
+    const std::vector<float>& colormap,
+    bool cyclic,
+    const RecolorOptions& options,
+    std::vector<unsigned char>& rgba
+) {
+    const ScalarFieldHeader& header = field.getHeader();
+    const size_t width = header.width;
+    const size_t height = header.height;
+    rgba.resize(width * height * 4u);
+
+    // Each thread colors a contiguous block of rows
+    parallelFor(height, [&](size_t rowBegin, size_t rowEnd) {
+        float rgb[3];
+        for (size_t y = rowBegin; y < rowEnd; ++y) {
+            for (size_t x = 0; x < width; ++x) {
+                recolorPixel(header, field.pixel(x, y), colormap, cyclic, options, rgb);
+                unsigned char* out = rgba.data() + (y * width + x) * 4u;
+                out[0] = toByte(rgb[0]);
+                out[1] = toByte(rgb[1]);
+                out[2] = toByte(rgb[2]);
+                out[3] = 255u;
+            }
+        }
+    }, options.numThreads);
+}
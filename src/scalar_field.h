@@ -0,0 +1,102 @@
+#pragma once
+#ifndef MANDELBROT_SCALARFIELD_INCLUDED
+#define MANDELBROT_SCALARFIELD_INCLUDED
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * Raw scalar field files (".msf") store the per-pixel values a model computes before they are mapped through a colormap.
+ * This allows recoloring (different colormap, color scale) without rendering again.
+ *
+ * Layout: a `ScalarFieldHeader` (64 bytes) followed by `width * height * channels` float32 values (native byte order),
+ * rows from top to bottom, channels interleaved per pixel. Since the data starts at `headerSize`, the file can be memory-mapped as is.
+ */
+enum class ScalarFieldKind : uint32_t {
+    MANDELBROT = 0,            // channels: (mean smooth iteration count of the outside samples, ratio of samples outside the set)
+    DOUBLE_PENDULUM_Y2 = 1,    // channels: (y2 = height of the outer pendulum at t_end, error status of rk45 (0 = success))
+    DOUBLE_PENDULUM_STATE = 2, // channels: (q1, q2, v1, v2) at t_end, all NaN if rk45 failed
+};
+
+struct ScalarFieldHeader {
+    static constexpr char MAGIC[8] = { 'M', 'B', 'S', 'F', 'I', 'E', 'L', 'D' };
+    static constexpr uint32_t VERSION = 1u;
+
+    char magic[8] = { 'M', 'B', 'S', 'F', 'I', 'E', 'L', 'D' };
+    uint32_t version = VERSION;
+    uint32_t headerSize = 64u; // offset of the float data in bytes
+    uint32_t width = 0u;
+    uint32_t height = 0u;
+    uint32_t channels = 0u;
+    ScalarFieldKind kind = ScalarFieldKind::MANDELBROT;
+    double zoomScale = 0.0; // view the field was rendered with (informational)
+    double centerX = 0.0;
+    double centerY = 0.0;
+    float params[2] = { 0.0f, 0.0f }; // model specific, double pendulum: (l1, l2)
+};
+static_assert(sizeof(ScalarFieldHeader) == 64, "ScalarFieldHeader must match the file layout");
+
+/**
+ * Writes a scalar field file
+ *
+ * @param data `header.width * header.height * header.channels` floats, rows from top to bottom
+ * @return Returns `false` on failure (error is printed)
+ */
+bool writeScalarField(const std::string& filename, const ScalarFieldHeader& header, const float* data);
+
+/**
+ * Read-only view of a scalar field file
+ * The file is memory-mapped where possible (otherwise it is read into memory)
+ */
+class ScalarFieldFile {
+public:
+    ScalarFieldFile() = default;
+    ScalarFieldFile(const ScalarFieldFile& other) = delete;
+    ScalarFieldFile& operator=(const ScalarFieldFile& other) = delete;
+    ~ScalarFieldFile();
+
+    /** @return Returns `false` if the file cannot be opened or is not a valid scalar field file (error is printed) */
+    bool open(const std::string& filename);
+    void close();
+
+    inline bool isOpen() const { return data != nullptr; }
+    inline const ScalarFieldHeader& getHeader() const { return header; }
+
+    /** Pointer to the first value of pixel (x, y), y = 0 is the top row */
+    inline const float* pixel(size_t x, size_t y) const {
+        return data + (y * header.width + x) * header.channels;
+    }
+
+private:
+    ScalarFieldHeader header;
+    const float* data = nullptr;
+
+    void* mappedMemory = nullptr;
+    size_t mappedSize = 0;
+    std::vector<float> fallbackBuffer; // used if memory-mapping is not available
+};
+
+struct RecolorOptions {
+    float colorScale = 50.0f; // Mandelbrot: smooth iteration count range covered by the colormap, double pendulum state: velocity range [-colorScale, colorScale]
+    int channel = -1;         // Only for `ScalarFieldKind::DOUBLE_PENDULUM_STATE`: -1 = y2 (like the app), 0 = q1, 1 = q2, 2 = v1, 3 = v2
+    unsigned int numThreads = 0; // 0 means one thread per hardware thread
+};
+
+/**
+ * Maps a scalar field through a colormap on the CPU (multithreaded), the same way the fragment shaders of the models do
+ *
+ * @param colormap 256 RGB colors, as in `colormaps`
+ * @param cyclic Whether the colormap repeats (see `isCyclicColormapGroup`) or is clamped
+ * @param rgba Output RGBA8 image, rows from top to bottom
+ */
+void recolorScalarField(
+    const ScalarFieldFile& field,
+    const std::vector<float>& colormap,
+    bool cyclic,
+    const RecolorOptions& options,
+    std::vector<unsigned char>& rgba
+);
+
+#endif
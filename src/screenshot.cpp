@@ -2,309 +2,628 @@
 #include "screenshot.h"
 
 #include <string>
-#include <cstring> // std::memcpyc
+#include <cstring> // std::memcpy
 #include <iostream>
 #include <vector>
 #include <cmath>
 #include <filesystem>
+#include <algorithm> // for std::min
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <memory>
 
 #include <glad/glad.h>
-#define STB_IMAGE_WRITE_IMPLEMENTATION
-#include "stb_image_write.h" // for writing a png file
+#include "stb_image_write.h" // for writing a png file (implementation in image_write.cpp)
 
+#include "cpu/cpu_renderer.h"
 
 
-// Probably good tiled ChatGPT implementation ------------------------------
-bool takeScreenshot(
-    std::string filename,
-    size_t captureWidth,
-    size_t captureHeight,
-    Model& model,
-    unsigned int vertexArray,
-    size_t maxTileSize /* = 2048 */
-) {
-    // Ensure unique filename: if file exists, append _1, _2, etc.
-    if (std::filesystem::exists(filename)) {
-        std::string base = filename;
-        std::string ext;
-        // split extension
-        size_t dot = filename.find_last_of('.');
-        if (dot != std::string::npos) {
-            base = filename.substr(0, dot);
-            ext = filename.substr(dot);
-        }
-        int counter = 1;
-        while (std::filesystem::exists(base + "_" + std::to_string(counter) + ext)) {
-            ++counter;
+
+// Ensure unique filename: if file exists, append _1, _2, etc.
+std::string makeUniqueFilename(const std::string& filename) {
+    if (!std::filesystem::exists(filename)) {
+        return filename;
+    }
+
+    std::string base = filename;
+    std::string ext;
+    // split extension
+    size_t dot = filename.find_last_of('.');
+    if (dot != std::string::npos) {
+        base = filename.substr(0, dot);
+        ext = filename.substr(dot);
+    }
+    int counter = 1;
+    while (std::filesystem::exists(base + "_" + std::to_string(counter) + ext)) {
+        ++counter;
+    }
+    return base + "_" + std::to_string(counter) + ext;
+}
+
+// Ensure parent directory exists
+bool createParentDirectories(const std::string& filename) {
+    std::filesystem::path outPath(filename);
+    if (outPath.has_parent_path()) {
+        std::error_code ec;
+        std::filesystem::create_directories(outPath.parent_path(), ec);
+        if (ec) {
+            std::cerr << "    Error: failed to create parent directories for "
+                        << filename << " (" << ec.message() << ")\n";
+            return false;
         }
-        filename = base + "_" + std::to_string(counter) + ext;
     }
+    return true;
+}
 
-    std::cout << "Taking Screenshot \"" << filename << "\" (" << captureWidth << "x" << captureHeight << ")" << std::endl;
 
-    // ---- basic validation -------------------------------------------------
-    if (captureWidth == 0 || captureHeight == 0) {
-        std::cerr << "    Error: invalid dimensions " << captureWidth << "x" << captureHeight << "\n";
-        return false;
+std::vector<TileRect> makeTileGrid(size_t captureWidth, size_t captureHeight, size_t maxTileSize) {
+    // compute number of tiles
+    // ceil(captureWidth / maxTileSize), ceil(captureHeight / maxTileSize)
+    const size_t tilesX = (captureWidth  + maxTileSize - 1) / maxTileSize;
+    const size_t tilesY = (captureHeight + maxTileSize - 1) / maxTileSize;
+
+    std::vector<TileRect> tiles;
+    tiles.reserve(tilesX * tilesY);
+    for (size_t ty = 0; ty < tilesY; ++ty) {
+        for (size_t tx = 0; tx < tilesX; ++tx) {
+            TileRect tile;
+            tile.x = static_cast<uint32_t>(tx * maxTileSize);
+            tile.y = static_cast<uint32_t>(ty * maxTileSize);
+            tile.width = static_cast<uint32_t>(std::min(maxTileSize, captureWidth - tile.x)); // last tile in a row might be smaller
+            tile.height = static_cast<uint32_t>(std::min(maxTileSize, captureHeight - tile.y));
+            tiles.push_back(tile);
+        }
     }
+    return tiles;
+}
 
-    // stbi_write_png takes ints — guard against absurd sizes early.
-    if (captureWidth > static_cast<size_t>(std::numeric_limits<int>::max()) ||
-        captureHeight > static_cast<size_t>(std::numeric_limits<int>::max()))
-    {
-        std::cerr << "    Error: requested image dimensions exceed int limits required by PNG writer\n";
-        return false;
+void copyTileToImage(
+    const TileRect& tile,
+    const unsigned char* tilePixels,
+    size_t captureWidth,
+    size_t captureHeight,
+    size_t bytesPerPixel,
+    unsigned char* imagePixels
+) {
+    const size_t rowBytes = tile.width * bytesPerPixel;
+    for (size_t row = 0; row < tile.height; ++row) {
+        // row in tile: 0 .. tileH-1 (0 = bottom row of the tile because glReadPixels origin is bottom-left)
+        const size_t globalY = tile.y + row; // counted from the bottom of the image
+        // our finalPixels we want top-to-bottom (row 0 = top), so flip
+        const size_t dstRowIndex = (captureHeight - 1 - globalY);
+        const size_t dstOffset = (dstRowIndex * captureWidth + tile.x) * bytesPerPixel;
+        std::memcpy(imagePixels + dstOffset, tilePixels + row * rowBytes, rowBytes);
     }
+}
 
-    // ---- GL limits and tile sizing ---------------------------------------
+
+TileRenderer::~TileRenderer() {
+    this->destroy();
+}
+
+bool TileRenderer::create(size_t requestedMaxTileSize, Format requestedFormat) {
+    this->destroy();
+
+    // Query maximum texture size supported by GL implementation
     GLint maxTexSizeInt = 0;
     glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTexSizeInt);
     if (maxTexSizeInt <= 0) {
         std::cerr << "    Error: failed to query GL_MAX_TEXTURE_SIZE or returned non-positive value\n";
         return false;
     }
-    const size_t maxTexSize = static_cast<size_t>(maxTexSizeInt);
 
-    // Ensure maxTileSize is within what the GL driver supports.
-    if (maxTileSize == 0) {
+    // Validate and clamp maxTileSize
+    if (requestedMaxTileSize == 0) {
         std::cerr << "    Error: maxTileSize must be > 0\n";
         return false;
     }
-    if (maxTileSize > maxTexSize) {
-        maxTileSize = maxTexSize;
-    }
+    this->maxTileSize = std::min(requestedMaxTileSize, static_cast<size_t>(maxTexSizeInt));
+    this->format = requestedFormat;
 
-    // We allow captureWidth/captureHeight > maxTexSize because we render tiled.
-    // Calculate how many tiles are required.
-    const size_t tilesX = (captureWidth  + maxTileSize - 1) / maxTileSize;
-    const size_t tilesY = (captureHeight + maxTileSize - 1) / maxTileSize;
+    // Save previous GL state we will change
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &this->prevFBO);
+    glGetIntegerv(GL_VIEWPORT, this->prevViewport);
+
+    // Create offscreen FBO and texture sized to the maximum tile size
+    glGenTextures(1, &this->texColor);
+    glBindTexture(GL_TEXTURE_2D, this->texColor);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-    // actual tile sizes (last tile may be smaller)
-    std::vector<size_t> tileWidths(tilesX);
-    std::vector<size_t> tileHeights(tilesY);
-    for (size_t tx = 0; tx < tilesX; ++tx) {
-        tileWidths[tx] = std::min(maxTileSize, captureWidth - tx * maxTileSize);
+    // allocate texture storage for maxTileSize x maxTileSize (we'll reuse for smaller tiles)
+    const int tileTexSize = static_cast<int>(this->maxTileSize);
+    const bool isFloat = this->format == RGBA32F;
+    glTexImage2D(GL_TEXTURE_2D, 0, isFloat ? GL_RGBA32F : GL_RGBA8, tileTexSize, tileTexSize, 0, GL_RGBA, isFloat ? GL_FLOAT : GL_UNSIGNED_BYTE, nullptr);
+
+    // Create depth renderbuffer (optional; useful if shader uses depth)
+    glGenRenderbuffers(1, &this->rboDepth);
+    glBindRenderbuffer(GL_RENDERBUFFER, this->rboDepth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, tileTexSize, tileTexSize);
+
+    // Create FBO and attach
+    glGenFramebuffers(1, &this->fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, this->fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, this->texColor, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, this->rboDepth);
+
+    // Check for GL errors / framebuffer completeness
+    GLenum e = glGetError();
+    if (e != GL_NO_ERROR) {
+        std::cerr << "    Error: GL error 0x" << std::hex << e << std::dec
+                  << " after allocating tile texture/renderbuffer\n";
+        this->destroy();
+        return false;
     }
-    for (size_t ty = 0; ty < tilesY; ++ty) {
-        tileHeights[ty] = std::min(maxTileSize, captureHeight - ty * maxTileSize);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "    Error: framebuffer incomplete (0x" << std::hex << status << std::dec << ")\n";
+        this->destroy();
+        return false;
     }
+    return true;
+}
 
-    // ---- final image buffer (RGBA) --------------------------------------
-    const size_t bytesPerPixel = 4u;
-    const size_t finalSize = captureWidth * captureHeight * bytesPerPixel;
-    std::vector<unsigned char> finalPixels;
-    try {
-        finalPixels.assign(finalSize, 0u);
-    } catch (const std::bad_alloc&) {
-        std::cerr << "    Error: not enough memory to allocate final image buffer (" << finalSize << " bytes)\n";
+void TileRenderer::destroy() {
+    if (this->fbo == 0u && this->texColor == 0u && this->rboDepth == 0u) {
+        return;
+    }
+
+    // restore previous GL state and free resources
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(this->prevFBO));
+    glViewport(this->prevViewport[0], this->prevViewport[1], this->prevViewport[2], this->prevViewport[3]);
+    if (this->fbo) { glDeleteFramebuffers(1, &this->fbo); this->fbo = 0u; }
+    if (this->texColor) { glDeleteTextures(1, &this->texColor); this->texColor = 0u; }
+    if (this->rboDepth) { glDeleteRenderbuffers(1, &this->rboDepth); this->rboDepth = 0u; }
+}
+
+bool TileRenderer::render(Model& model, unsigned int vertexArray, size_t captureWidth, size_t captureHeight, const TileRect& tile, unsigned char* tilePixels) {
+    if (this->fbo == 0u || tile.width > this->maxTileSize || tile.height > this->maxTileSize) {
+        std::cerr << "    Error: tile (" << tile.x << "," << tile.y << ") does not fit the tile renderer\n";
         return false;
     }
 
-    // ---- save & preserve GL state ----------------------------------------
-    GLint prevFBO = 0;
-    GLint prevViewport[4] = {0,0,0,0};
-    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFBO);
-    glGetIntegerv(GL_VIEWPORT, prevViewport);
+    // Bind FBO and set viewport to tile size
+    glBindFramebuffer(GL_FRAMEBUFFER, this->fbo);
+    glViewport(0, 0, static_cast<int>(tile.width), static_cast<int>(tile.height));
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+    // Render the tile. The shader maps gl_FragCoord (0..tileSize) + tileOffset to the full image
+    model.shader.use();
+    model.shader.setVec2UInt("windowSize", { static_cast<unsigned int>(captureWidth), static_cast<unsigned int>(captureHeight) });
+    model.shader.setVec2UInt("tileOffset", { tile.x, tile.y });
+
+    model.drawCall();
+    glBindVertexArray(vertexArray);
+    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+    glFinish();
+
+    GLenum err = glGetError();
+    if (err != GL_NO_ERROR) {
+        std::cerr << "    Error: GL error 0x" << std::hex << err << std::dec
+                  << " while drawing tile (" << tile.x << "," << tile.y << ")\n";
+        return false;
+    }
 
-    // ---- allocate a single texture + rbo sized to the maximum tile size ----
-    GLuint texColor = 0u;
-    GLuint rboDepth = 0u;
-    GLuint fbo = 0u;
+    // Read pixels from the FBO (origin bottom-left)
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glReadPixels(0, 0, static_cast<int>(tile.width), static_cast<int>(tile.height), GL_RGBA, this->format == RGBA32F ? GL_FLOAT : GL_UNSIGNED_BYTE, tilePixels);
 
-    glGenTextures(1, &texColor);
-    glBindTexture(GL_TEXTURE_2D, texColor);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    err = glGetError();
+    if (err != GL_NO_ERROR) {
+        std::cerr << "    Error: GL error 0x" << std::hex << err << std::dec
+                  << " after glReadPixels for tile (" << tile.x << "," << tile.y << ")\n";
+        return false;
+    }
+    return true;
+}
 
-    // allocate storage once for the maximum tile dimensions (safe: <= GL_MAX_TEXTURE_SIZE)
-    const int tileTexW = static_cast<int>(maxTileSize);
-    const int tileTexH = static_cast<int>(maxTileSize);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, tileTexW, tileTexH, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
 
-    // renderbuffer (depth+stencil) sized the same
-    glGenRenderbuffers(1, &rboDepth);
-    glBindRenderbuffer(GL_RENDERBUFFER, rboDepth);
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, tileTexW, tileTexH);
+namespace {
 
-    // framebuffer
-    glGenFramebuffers(1, &fbo);
-    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texColor, 0);
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, rboDepth);
+/** Rows per work unit of a CPU thread (small, so the CPU threads never hold up the end of a screenshot), see `CpuRenderer::getMinBandHeight` */
+constexpr uint32_t CPU_BAND_HEIGHT = 8u;
 
-    // immediate checks
-    {
-        GLenum e = glGetError();
-        if (e != GL_NO_ERROR) {
-            std::cerr << "    Error: GL error 0x" << std::hex << e << std::dec
-                      << " after allocating tile texture/renderbuffer\n";
-            // cleanup before returning
-            if (fbo) { glBindFramebuffer(GL_FRAMEBUFFER, 0); glDeleteFramebuffers(1, &fbo); fbo = 0; }
-            if (texColor) { glDeleteTextures(1, &texColor); texColor = 0; }
-            if (rboDepth) { glDeleteRenderbuffers(1, &rboDepth); rboDepth = 0; }
-            // restore viewport/binding
-            glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(prevFBO));
-            glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
-            return false;
+/**
+ * Work queue shared by the GPU (takes whole tiles from the front) and the CPU threads (take bands of rows of the tiles from the back)
+ * When they meet, the GPU takes the rows of the last tile that are not claimed yet
+ */
+class HybridTileQueue {
+public:
+    explicit HybridTileQueue(const std::vector<TileRect>& _tiles) : tiles(_tiles), back(_tiles.size()) { }
+
+    bool nextGpuRect(TileRect& rect) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (this->front < this->back) {
+            rect = this->tiles[this->front++];
+            return true;
         }
-        GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
-        if (status != GL_FRAMEBUFFER_COMPLETE) {
-            std::cerr << "    Error: framebuffer incomplete (0x" << std::hex << status << std::dec << ")\n";
-            // cleanup
-            glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(prevFBO));
-            glDeleteFramebuffers(1, &fbo);
-            glDeleteTextures(1, &texColor);
-            glDeleteRenderbuffers(1, &rboDepth);
-            glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
-            return false;
+        if (this->back < this->tiles.size() && this->backRow < this->tiles[this->back].height) {
+            rect = this->tiles[this->back];
+            rect.y += this->backRow;
+            rect.height -= this->backRow;
+            this->backRow = this->tiles[this->back].height;
+            return true;
         }
+        return false;
     }
 
-    // cleanup helper (restores previous GL state and deletes our temporary objects)
-    auto cleanupGL = [&](void) noexcept {
-        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(prevFBO));
-        glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
-        if (fbo) { glDeleteFramebuffers(1, &fbo); fbo = 0; }
-        if (texColor) { glDeleteTextures(1, &texColor); texColor = 0; }
-        if (rboDepth) { glDeleteRenderbuffers(1, &rboDepth); rboDepth = 0; }
-    };
+    bool nextCpuRect(TileRect& rect, uint32_t bandHeight) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (this->back == this->tiles.size() || this->backRow == this->tiles[this->back].height) {
+            if (this->back <= this->front) {
+                return false;
+            }
+            --this->back;
+            this->backRow = 0u;
+        }
+        rect = this->tiles[this->back];
+        rect.y += this->backRow;
+        rect.height = std::min(bandHeight, rect.height - this->backRow);
+        this->backRow += rect.height;
+        return true;
+    }
 
-    bool success = true;
+private:
+    std::mutex mutex;
+    const std::vector<TileRect>& tiles;
+    size_t front = 0;       // next tile of the GPU
+    size_t back;            // tile the CPU threads are working on (tiles.size() if none)
+    uint32_t backRow = 0u;  // rows of the back tile that are taken
+};
+
+/** Same conversion as OpenGL uses for normalized unsigned bytes */
+unsigned char toUnorm8(float value) {
+    return static_cast<unsigned char>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+}
 
-    size_t totalTiles = tilesX * tilesY;
-    size_t processedTiles = 0;
-    std::cout << "\r    Processed " << processedTiles << "/" << totalTiles << " tiles" << std::flush;
+/** Converts the float output of a CPU renderer to the format of the tile renderer */
+const unsigned char* convertCpuPixels(const std::vector<float>& rgba, TileRenderer::Format format, std::vector<unsigned char>& bytes) {
+    if (format == TileRenderer::RGBA32F) {
+        return reinterpret_cast<const unsigned char*>(rgba.data());
+    }
+    bytes.resize(rgba.size());
+    for (size_t i = 0; i < rgba.size(); ++i) {
+        bytes[i] = toUnorm8(rgba[i]);
+    }
+    return bytes.data();
+}
 
-    // ---- render every tile sequentially into the same FBO texture ----------------
-    for (size_t ty = 0; ty < tilesY && success; ++ty) {
-        for (size_t tx = 0; tx < tilesX; ++tx) {
-            const size_t tileW = tileWidths[tx];
-            const size_t tileH = tileHeights[ty];
-
-            // set viewport to the *actual* tile size (we render into the lower-left region
-            // of the attached texture which is allocated at maxTileSize).
-            glBindFramebuffer(GL_FRAMEBUFFER, fbo);
-            glViewport(0, 0, static_cast<int>(tileW), static_cast<int>(tileH));
-            glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
-
-            // set uniforms:
-            // - windowSize is the full capture resolution (shader uses gl_FragCoord + tileOffset divided by windowSize)
-            // - tileOffset is the pixel offset of this tile in the full image
-            model.shader.use();
-            model.shader.setVec2UInt("windowSize", { static_cast<unsigned int>(captureWidth), static_cast<unsigned int>(captureHeight) });
-            // model.shader.setVec2Double("center", { static_cast<double>(centerX), static_cast<double>(centerY) });
-            // model.shader.setDouble("zoomScale", static_cast<double>(zoomScale));
-            const size_t xOffset = tx * maxTileSize;
-            const size_t yOffset = ty * maxTileSize;
-            model.shader.setVec2UInt("tileOffset", { static_cast<unsigned int>(xOffset), static_cast<unsigned int>(yOffset) });
-
-            // draw
-            model.drawCall();
-            glBindVertexArray(vertexArray);
-            glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
-            glFinish();
-
-            // check for GL draw errors
-            {
-                GLenum err = glGetError();
-                if (err != GL_NO_ERROR) {
-                    std::cerr << "    Error: GL error 0x" << std::hex << err << std::dec
-                              << " while drawing tile (" << tx << "," << ty << ")\n";
-                    success = false;
-                    break;
+/**
+ * Renders small patches spread over the image (3 x 3) on both backends and compares them with `CpuRenderer::agrees`
+ * Returns `false` (and prints a warning) if they differ too much for the CPU threads to be used
+ */
+bool checkCpuConsistency(
+    TileRenderer& renderer,
+    const CpuRenderer& cpuRenderer,
+    Model& model,
+    unsigned int vertexArray,
+    size_t captureWidth,
+    size_t captureHeight,
+    const HybridRenderSettings& hybrid,
+    unsigned char* gpuPixels
+) {
+    constexpr size_t PATCHES_PER_AXIS = 3;
+    TileRect probe;
+    // at most a third of the image per axis, so that the patches don't overlap (and never cost more than the image)
+    probe.width = static_cast<uint32_t>(std::max(std::min({ captureWidth / PATCHES_PER_AXIS, renderer.getMaxTileSize(), size_t(32) }), size_t(1)));
+    probe.height = static_cast<uint32_t>(std::max(std::min({ captureHeight / PATCHES_PER_AXIS, renderer.getMaxTileSize(), size_t(32) }), size_t(1)));
+    const size_t pixelCount = static_cast<size_t>(probe.width) * probe.height;
+    std::vector<float> cpuRGBA(pixelCount * 4u);
+    // 8 bit outputs are compared as floats, half a step of slack for their rounding
+    const float tolerance = renderer.getBytesPerPixel() == 4u ? hybrid.tolerance + 0.5f / 255.0f : hybrid.tolerance;
+
+    size_t mismatches = 0;
+    for (size_t patchY = 0; patchY < PATCHES_PER_AXIS; ++patchY) {
+        for (size_t patchX = 0; patchX < PATCHES_PER_AXIS; ++patchX) {
+            // centers at 1/6, 1/2 and 5/6 of the image
+            probe.x = static_cast<uint32_t>((captureWidth - probe.width) * (2u * patchX + 1u) / (2u * PATCHES_PER_AXIS));
+            probe.y = static_cast<uint32_t>((captureHeight - probe.height) * (2u * patchY + 1u) / (2u * PATCHES_PER_AXIS));
+
+            if (!renderer.render(model, vertexArray, captureWidth, captureHeight, probe, gpuPixels)) {
+                return false;
+            }
+            cpuRenderer.render(captureWidth, captureHeight, probe, cpuRGBA.data());
+
+            for (size_t i = 0; i < pixelCount; ++i) {
+                float gpu[4];
+                float cpu[4];
+                for (size_t c = 0; c < 4u; ++c) {
+                    if (renderer.getBytesPerPixel() == 4u) {
+                        gpu[c] = static_cast<float>(gpuPixels[i * 4u + c]) / 255.0f;
+                        cpu[c] = static_cast<float>(toUnorm8(cpuRGBA[i * 4u + c])) / 255.0f;
+                    } else {
+                        std::memcpy(&gpu[c], gpuPixels + (i * 4u + c) * sizeof(float), sizeof(float));
+                        cpu[c] = cpuRGBA[i * 4u + c];
+                    }
                 }
+                mismatches += cpuRenderer.agrees(gpu, cpu, tolerance) ? 0u : 1u;
             }
+        }
+    }
 
-            // read pixels for this tile
-            const size_t tilePixelCount = tileW * tileH;
-            std::vector<unsigned char> tilePixels;
-            try {
-                tilePixels.resize(tilePixelCount * bytesPerPixel);
-            } catch (const std::bad_alloc&) {
-                std::cerr << "    Error: out of memory while allocating tile buffer for tile ("
-                          << tx << "," << ty << ")\n";
-                success = false;
-                break;
-            }
+    const float mismatchRatio = static_cast<float>(mismatches) / static_cast<float>(pixelCount * PATCHES_PER_AXIS * PATCHES_PER_AXIS);
+    if (mismatchRatio > hybrid.maxMismatchRatio) {
+        std::cerr << "    Warning: CPU and GPU results differ on " << 100.0f * mismatchRatio << "% of the probe pixels, the CPU threads are disabled and only the GPU renders" << std::endl;
+        return false;
+    }
+    return true;
+}
 
-            glPixelStorei(GL_PACK_ALIGNMENT, 1);
-            glReadBuffer(GL_COLOR_ATTACHMENT0);
-            glReadPixels(0, 0, static_cast<int>(tileW), static_cast<int>(tileH), GL_RGBA, GL_UNSIGNED_BYTE, tilePixels.data());
-
-            // check glReadPixels
-            {
-                GLenum err = glGetError();
-                if (err != GL_NO_ERROR) {
-                    std::cerr << "    Error: GL error 0x" << std::hex << err << std::dec
-                              << " after glReadPixels for tile (" << tx << "," << ty << ")\n";
-                    success = false;
-                    break;
-                }
-            }
+/**
+ * Renders the model tile by tile into `finalPixels` (rows from top to bottom)
+ * `finalPixels` must hold `captureWidth * captureHeight * bytesPerPixel` bytes
+ */
+bool renderTiles(
+    size_t captureWidth,
+    size_t captureHeight,
+    Model& model,
+    unsigned int vertexArray,
+    size_t maxTileSize,
+    TileRenderer::Format format,
+    const HybridRenderSettings& hybrid,
+    unsigned char* finalPixels
+) {
+    TileRenderer renderer;
+    if (!renderer.create(maxTileSize, format)) {
+        return false;
+    }
+    const size_t bytesPerPixel = renderer.getBytesPerPixel();
+    const std::vector<TileRect> tiles = makeTileGrid(captureWidth, captureHeight, renderer.getMaxTileSize());
 
-            // copy tile rows into final image buffer with vertical flip
-            const size_t xStart = xOffset; // beginning column in final image for this tile
-            for (size_t row = 0; row < tileH; ++row) {
-                // src - row in tile (bottom-to-top coming from glReadPixels)
-                const size_t srcOffset = (row * tileW) * bytesPerPixel;
-                // dst - compute row index in final image (flip vertically)
-                const size_t globalY = ty * maxTileSize + row; // 0 = top of image? careful: we flip below
-                // After flip: destination row index (counting from top=0) is (captureHeight - 1 - globalY)
-                const size_t dstRowIndex = (captureHeight - 1 - globalY);
-                const size_t dstOffset = (dstRowIndex * captureWidth + xStart) * bytesPerPixel;
-
-                // memcpy the actual tileW bytes-per-row
-                std::memcpy(finalPixels.data() + dstOffset, tilePixels.data() + srcOffset, tileW * bytesPerPixel);
-            }
+    // one buffer for all tiles
+    std::vector<unsigned char> tilePixels;
+    try {
+        tilePixels.resize(renderer.getMaxTileSize() * renderer.getMaxTileSize() * bytesPerPixel);
+    } catch (const std::bad_alloc&) {
+        std::cerr << "    Error: out of memory while allocating tile buffer\n";
+        return false;
+    }
 
-            // Update progress
-            ++processedTiles;
-            std::cout << "\r    Processed " << processedTiles << "/" << totalTiles << " tiles" << std::flush;
+    // CPU threads (only if the model has a CPU port that agrees with the shader, or one that the GPU can't match)
+    std::unique_ptr<CpuRenderer> cpuRenderer;
+    if (hybrid.numCpuThreads > 0) {
+        model.shader.setVec2UInt("windowSize", { static_cast<unsigned int>(captureWidth), static_cast<unsigned int>(captureHeight) }); // the port may depend on the pixel size
+        cpuRenderer = model.makeCpuRenderer();
+        if (!cpuRenderer) {
+            std::cerr << "    Warning: " << model.name << " has no CPU port for these settings, the CPU threads are disabled and only the GPU renders" << std::endl;
+        } else if (cpuRenderer->isExclusive()) {
+            std::cout << "    Rendering on the CPU only" << std::endl;
+        } else if (!checkCpuConsistency(renderer, *cpuRenderer, model, vertexArray, captureWidth, captureHeight, hybrid, tilePixels.data())) {
+            cpuRenderer.reset();
         }
     }
-    std::cout << "\n"
-        << "    Start saving file" << std::endl;
 
-    // ---- write out PNG -----------------------------------------------------
-    if (success) {
-        // Ensure parent directory exists
-        std::filesystem::path outPath(filename);
-        if (outPath.has_parent_path()) {
-            std::error_code ec;
-            std::filesystem::create_directories(outPath.parent_path(), ec);
-            if (ec) {
-                std::cerr << "    Error: failed to create parent directories for "
-                            << filename << " (" << ec.message() << ")\n";
-                return false;
-            }
+    HybridTileQueue queue(tiles);
+    std::atomic<bool> abort = false;
+    std::atomic<size_t> cpuPixelCount = 0;
+    std::vector<std::thread> cpuThreads;
+    if (cpuRenderer) {
+        for (unsigned int i = 0; i < hybrid.numCpuThreads; ++i) {
+            cpuThreads.emplace_back([&]() {
+                std::vector<float> rgba;
+                std::vector<unsigned char> bytes;
+                TileRect rect;
+                while (!abort && queue.nextCpuRect(rect, std::max(CPU_BAND_HEIGHT, cpuRenderer->getMinBandHeight()))) {
+                    rgba.resize(static_cast<size_t>(rect.width) * rect.height * 4u);
+                    cpuRenderer->render(captureWidth, captureHeight, rect, rgba.data());
+                    copyTileToImage(rect, convertCpuPixels(rgba, format, bytes), captureWidth, captureHeight, bytesPerPixel, finalPixels);
+                    cpuPixelCount += static_cast<size_t>(rect.width) * rect.height;
+                }
+            });
         }
+    }
 
-        // stride in bytes per row — safe, we've checked bounds earlier
-        const int rowBytes = static_cast<int>(captureWidth * bytesPerPixel);
-        if (stbi_write_png(filename.c_str(),
-                           static_cast<int>(captureWidth),
-                           static_cast<int>(captureHeight),
-                           4,
-                           finalPixels.data(),
-                           rowBytes) == 0)
-        {
-            std::cerr << "    Error: failed to write PNG '" << filename << "'\n";
-            success = false;
+    const size_t totalPixels = captureWidth * captureHeight;
+    size_t gpuPixelCount = 0;
+    size_t processedTiles = 0;
+    auto printProgress = [&]() {
+        if (cpuRenderer) {
+            std::cout << "\r    Processed " << (100u * (gpuPixelCount + cpuPixelCount)) / totalPixels << "% (" << hybrid.numCpuThreads << " CPU threads)" << std::flush;
+        } else {
+            std::cout << "\r    Processed " << processedTiles << "/" << tiles.size() << " tiles" << std::flush;
         }
-        else {
-            std::cout << "    File was saved successfully" << std::endl;
+    };
+    printProgress();
+
+    bool success = true;
+    TileRect rect;
+    while (!(cpuRenderer && cpuRenderer->isExclusive()) && queue.nextGpuRect(rect)) {
+        if (!renderer.render(model, vertexArray, captureWidth, captureHeight, rect, tilePixels.data())) {
+            success = false;
+            abort = true;
+            break;
         }
+        copyTileToImage(rect, tilePixels.data(), captureWidth, captureHeight, bytesPerPixel, finalPixels);
+
+        gpuPixelCount += static_cast<size_t>(rect.width) * rect.height;
+        ++processedTiles;
+        printProgress();
+    }
+    for (std::thread& thread : cpuThreads) {
+        thread.join();
     }
+    printProgress();
+    std::cout << "\n";
 
-    // cleanup and restore GL state
-    cleanupGL();
+    if (success && cpuRenderer) {
+        std::cout << "    CPU threads rendered " << (100u * cpuPixelCount) / totalPixels << "% of the pixels" << std::endl;
+    }
     return success;
 }
 
+template <typename T>
+bool renderTiledHelper(
+    size_t captureWidth,
+    size_t captureHeight,
+    Model& model,
+    unsigned int vertexArray,
+    std::vector<T>& pixels,
+    size_t maxTileSize,
+    TileRenderer::Format format,
+    const HybridRenderSettings& hybrid
+) {
+    // Basic validation
+    if (captureWidth == 0 || captureHeight == 0) {
+        std::cerr << "    Error: invalid dimensions " << captureWidth << "x" << captureHeight << "\n";
+        return false;
+    }
+
+    // Allocate final image buffer (we assemble top-to-bottom rows)
+    const size_t finalSize = captureWidth * captureHeight * TileRenderer::getBytesPerPixel(format);
+    try {
+        pixels.assign(finalSize / sizeof(T), T(0));
+    } catch (const std::bad_alloc&) {
+        std::cerr << "    Error: not enough memory to allocate final image buffer (" << finalSize << " bytes)\n";
+        return false;
+    }
+
+    return renderTiles(captureWidth, captureHeight, model, vertexArray, maxTileSize, format, hybrid, reinterpret_cast<unsigned char*>(pixels.data()));
+}
+
+} // namespace
+
+
+bool renderTiled(
+    size_t captureWidth,
+    size_t captureHeight,
+    Model& model,
+    unsigned int vertexArray,
+    std::vector<unsigned char>& pixels,
+    size_t maxTileSize /* = 2048 */,
+    const HybridRenderSettings& hybrid /* = HybridRenderSettings() */
+) {
+    return renderTiledHelper(captureWidth, captureHeight, model, vertexArray, pixels, maxTileSize, TileRenderer::RGBA8, hybrid);
+}
+
+bool renderTiled(
+    size_t captureWidth,
+    size_t captureHeight,
+    Model& model,
+    unsigned int vertexArray,
+    std::vector<float>& pixels,
+    size_t maxTileSize /* = 2048 */,
+    const HybridRenderSettings& hybrid /* = HybridRenderSettings() */
+) {
+    return renderTiledHelper(captureWidth, captureHeight, model, vertexArray, pixels, maxTileSize, TileRenderer::RGBA32F, hybrid);
+}
+
+bool savePng(const std::string& filename, size_t width, size_t height, const std::vector<unsigned char>& pixels) {
+    // stbi_write_png takes ints — guard against absurd sizes early.
+    if (width > static_cast<size_t>(std::numeric_limits<int>::max()) ||
+        height > static_cast<size_t>(std::numeric_limits<int>::max()))
+    {
+        std::cerr << "    Error: requested image dimensions exceed int limits required by PNG writer\n";
+        return false;
+    }
+
+    std::cout << "    Start saving file" << std::endl;
+
+    // ---- write out PNG -----------------------------------------------------
+    if (!createParentDirectories(filename)) {
+        return false;
+    }
+
+    // stride in bytes per row — safe, we've checked bounds earlier
+    const int rowBytes = static_cast<int>(width * 4u);
+    if (stbi_write_png(filename.c_str(),
+                       static_cast<int>(width),
+                       static_cast<int>(height),
+                       4,
+                       pixels.data(),
+                       rowBytes) == 0)
+    {
+        std::cerr << "    Error: failed to write PNG '" << filename << "'\n";
+        return false;
+    }
+
+    std::cout << "    File was saved successfully" << std::endl;
+    return true;
+}
+
+bool saveScalarField(const std::string& filename, size_t width, size_t height, std::vector<float>& pixels, ScalarFieldHeader header) {
+    if (width > std::numeric_limits<uint32_t>::max() || height > std::numeric_limits<uint32_t>::max()) {
+        std::cerr << "    Error: requested dimensions exceed the limits of the scalar field format\n";
+        return false;
+    }
+
+    // Pack the RGBA pixels to the used channels (in place, the destination never overtakes the source)
+    const size_t channels = header.channels;
+    const size_t pixelCount = width * height;
+    for (size_t i = 0; i < pixelCount; ++i) {
+        for (size_t c = 0; c < channels; ++c) {
+            pixels[i * channels + c] = pixels[i * 4u + c];
+        }
+    }
+    header.width = static_cast<uint32_t>(width);
+    header.height = static_cast<uint32_t>(height);
+
+    std::cout << "    Start saving file" << std::endl;
+    if (!createParentDirectories(filename) || !writeScalarField(filename, header, pixels.data())) {
+        return false;
+    }
+
+    std::cout << "    File was saved successfully" << std::endl;
+    return true;
+}
+
 
+// Probably good tiled ChatGPT implementation ------------------------------
+bool takeScreenshot(
+    std::string filename,
+    size_t captureWidth,
+    size_t captureHeight,
+    Model& model,
+    unsigned int vertexArray,
+    size_t maxTileSize /* = 2048 */,
+    const HybridRenderSettings& hybrid /* = HybridRenderSettings() */
+) {
+    filename = makeUniqueFilename(filename);
+
+    std::cout << "Taking Screenshot \"" << filename << "\" (" << captureWidth << "x" << captureHeight << ")" << std::endl;
+
+    std::vector<unsigned char> finalPixels;
+    if (!renderTiled(captureWidth, captureHeight, model, vertexArray, finalPixels, maxTileSize, hybrid)) {
+        return false;
+    }
+    return savePng(filename, captureWidth, captureHeight, finalPixels);
+}
+
+bool takeScalarFieldScreenshot(
+    std::string filename,
+    size_t captureWidth,
+    size_t captureHeight,
+    Model& model,
+    ScalarFieldHeader header,
+    unsigned int vertexArray,
+    size_t maxTileSize /* = 2048 */,
+    const HybridRenderSettings& hybrid /* = HybridRenderSettings() */
+) {
+    filename = makeUniqueFilename(filename);
+
+    std::cout << "Exporting scalar field \"" << filename << "\" (" << captureWidth << "x" << captureHeight << ", "
+        << header.channels << " channels)" << std::endl;
+
+    if (header.channels == 0 || header.channels > 4) {
+        std::cerr << "    Error: invalid number of channels " << header.channels << "\n";
+        return false;
+    }
+
+    std::vector<float> pixels;
+    if (!renderTiled(captureWidth, captureHeight, model, vertexArray, pixels, maxTileSize, hybrid)) {
+        return false;
+    }
+
+    header.zoomScale = model.shader.getDouble("zoomScale");
+    header.centerX = vec::getX(model.shader.getVec2Double("center"));
+    header.centerY = vec::getY(model.shader.getVec2Double("center"));
+    return saveScalarField(filename, captureWidth, captureHeight, pixels, header);
+}
 
 // // Probably good ChatGPT Implementation -------------------------------------
 // // Save a screenshot of the current scene to `filename` with the requested resolution.
@@ -1,7 +1,121 @@
 #pragma once
 #include <string>
+#include <vector>
+#include <cstdint>
 
 #include "model/model.h"
+#include "scalar_field.h"
+
+/** Returns `filename` or, if such a file exists already, the first free "name_1.ext", "name_2.ext", ... */
+std::string makeUniqueFilename(const std::string& filename);
+
+/** Creates the parent directories of `filename` if necessary, returns `false` on failure (error is printed) */
+bool createParentDirectories(const std::string& filename);
+
+/** Rectangle of pixels in an image, offsets are counted from the bottom left corner (like in OpenGL) */
+struct TileRect {
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+/** Splits an image into tiles of at most `maxTileSize` x `maxTileSize` pixels (row by row, starting at the bottom) */
+std::vector<TileRect> makeTileGrid(size_t captureWidth, size_t captureHeight, size_t maxTileSize);
+
+/** Copies the pixels of a tile as read by glReadPixels (rows from bottom to top) into an image with rows from top to bottom */
+void copyTileToImage(
+    const TileRect& tile,
+    const unsigned char* tilePixels,
+    size_t captureWidth,
+    size_t captureHeight,
+    size_t bytesPerPixel,
+    unsigned char* imagePixels
+);
+
+/**
+ * Offscreen framebuffer for rendering single tiles of a large image
+ * Restores the previously bound framebuffer and viewport when destroyed
+ */
+class TileRenderer {
+public:
+    enum Format {
+        RGBA8 = 0,
+        RGBA32F = 1 // raw (unclamped) shader outputs
+    };
+
+    TileRenderer() = default;
+    TileRenderer(const TileRenderer&) = delete;
+    TileRenderer& operator=(const TileRenderer&) = delete;
+    ~TileRenderer();
+
+    /** Needs a current OpenGL context, `maxTileSize` is clamped to GL_MAX_TEXTURE_SIZE */
+    bool create(size_t maxTileSize, Format format);
+    void destroy();
+
+    /**
+     * Renders `tile` of the whole image (`captureWidth` x `captureHeight`) into `tilePixels` (rows from bottom to top)
+     * The uniforms of the model (view and parameters) must be applied already, `windowSize` and `tileOffset` are set here
+     */
+    bool render(Model& model, unsigned int vertexArray, size_t captureWidth, size_t captureHeight, const TileRect& tile, unsigned char* tilePixels);
+
+    size_t getMaxTileSize() const { return this->maxTileSize; }
+    size_t getBytesPerPixel() const { return getBytesPerPixel(this->format); }
+    static size_t getBytesPerPixel(Format format) { return format == RGBA32F ? 4u * sizeof(float) : 4u; }
+
+private:
+    Format format = RGBA8;
+    size_t maxTileSize = 0;
+    unsigned int texColor = 0;
+    unsigned int rboDepth = 0;
+    unsigned int fbo = 0;
+    int prevFBO = 0;
+    int prevViewport[4] = { 0, 0, 0, 0 };
+};
+
+/**
+ * CPU threads that render parts of a screenshot with the C++ port of the model (see `Model::makeCpuRenderer`) while the GPU renders the rest
+ * The GPU takes whole tiles from the front of the tile grid, the CPU threads take bands of rows from the back
+ */
+struct HybridRenderSettings {
+    unsigned int numCpuThreads = 0; // 0 renders on the GPU only
+    float tolerance = 4.0f / 255.0f; // maximum difference of a channel for a pixel to count as consistent (relative for raw float outputs)
+    float maxMismatchRatio = 0.02f;  // share of inconsistent pixels in the probe, above that the CPU path is disabled (boundary pixels may flip)
+};
+
+/**
+ * Renders the model tile by tile into an RGBA8 buffer (rows from top to bottom)
+ * The uniforms of the model (view and parameters) must be applied already, `windowSize` and `tileOffset` are set here
+ */
+bool renderTiled(
+    size_t captureWidth,
+    size_t captureHeight,
+    Model& model,
+    unsigned int vertexArray,
+    std::vector<unsigned char>& pixels,
+    size_t maxTileSize = 2048,
+    const HybridRenderSettings& hybrid = HybridRenderSettings()
+);
+
+/** Same as above, but renders into an RGBA32F buffer, i.e. raw (unclamped) shader outputs */
+bool renderTiled(
+    size_t captureWidth,
+    size_t captureHeight,
+    Model& model,
+    unsigned int vertexArray,
+    std::vector<float>& pixels,
+    size_t maxTileSize = 2048,
+    const HybridRenderSettings& hybrid = HybridRenderSettings()
+);
+
+/** Saves RGBA8 pixels (rows from top to bottom) as PNG, `filename` is used as is */
+bool savePng(const std::string& filename, size_t width, size_t height, const std::vector<unsigned char>& pixels);
+
+/**
+ * Saves RGBA32F pixels (rows from top to bottom) as scalar field file, `filename` is used as is
+ * The pixels are packed to the channels of `header` in place, size is set here
+ */
+bool saveScalarField(const std::string& filename, size_t width, size_t height, std::vector<float>& pixels, ScalarFieldHeader header);
 
 bool takeScreenshot(
     std::string filename,
@@ -10,7 +124,24 @@ bool takeScreenshot(
     Model& model,
     unsigned int vertexArray,
 
-    size_t maxTileSize = 2048 // maximum tile width/height in pixels
+    size_t maxTileSize = 2048, // maximum tile width/height in pixels
+    const HybridRenderSettings& hybrid = HybridRenderSettings()
+);
+
+/**
+ * Renders the raw scalar field of a model (see `Model::makeScalarFieldModel`) and saves it as scalar field file
+ *
+ * @param header Header as filled in by `Model::makeScalarFieldModel`, size and view are set here
+ */
+bool takeScalarFieldScreenshot(
+    std::string filename,
+    size_t captureWidth,
+    size_t captureHeight,
+    Model& model,
+    ScalarFieldHeader header,
+    unsigned int vertexArray,
+    size_t maxTileSize = 2048,
+    const HybridRenderSettings& hybrid = HybridRenderSettings()
 );
 
 // bool takeScreenshotTiled(
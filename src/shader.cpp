@@ -1,34 +1,55 @@
 #include "shader.h"
 
 #include <regex>
+#include <algorithm> // for std::sort
 #include <string>
 #include <sstream>
 #include <iostream>
 
 using namespace vec;
 
+// Binaries of all programs linked so far (by `programCacheKey`), so that switching back to earlier defines, e.g. the variants of
+// NBodyModel or a super sampling mode, does not compile the shaders again. Only used if the driver supports program binaries
+struct ProgramBinary {
+    GLenum format;
+    std::vector<char> data;
+};
+static std::unordered_map<std::string, ProgramBinary> programBinaryCache;
+
 Shader::Shader(const Shader& other)
-    : vertexShaderSource(other.vertexShaderSource), fragmentShaderSource(other.fragmentShaderSource), defines(other.defines), uniforms(other.uniforms)
+    : vertexShaderSource(other.vertexShaderSource), fragmentShaderSource(other.fragmentShaderSource), computeShaderSource(other.computeShaderSource), defines(other.defines), uniforms(other.uniforms)
     { }
 
 Shader::Shader(Shader&& other) noexcept
     : vertexShader(other.vertexShader),
       fragmentShader(other.fragmentShader),
       shaderProgram(other.shaderProgram),
+      computeShader(other.computeShader),
+      computeProgram(other.computeProgram),
       vertexShaderSource(std::move(other.vertexShaderSource)),
       fragmentShaderSource(std::move(other.fragmentShaderSource)),
+      computeShaderSource(std::move(other.computeShaderSource)),
       defines(std::move(other.defines)),
       uniforms(std::move(other.uniforms))
     {
         other.vertexShader = 0;
         other.fragmentShader = 0;
         other.shaderProgram = 0;
+        other.computeShader = 0;
+        other.computeProgram = 0;
     }
 
 
-Shader::Shader(const std::string& vertexShaderSourcePath, const std::string& fragmentShaderSourcePath) {
-    vertexShaderSource = Shader::loadShaderSourceFromPath(vertexShaderSourcePath);
-    fragmentShaderSource = Shader::loadShaderSourceFromPath(fragmentShaderSourcePath);
+Shader::Shader(const std::string& vertexShaderSourcePath, const std::string& fragmentShaderSourcePath, const std::string& computeShaderSourcePath) {
+    if (!vertexShaderSourcePath.empty()) { // empty for compute only shaders
+        vertexShaderSource = Shader::loadShaderSourceFromPath(vertexShaderSourcePath);
+    }
+    if (!fragmentShaderSourcePath.empty()) {
+        fragmentShaderSource = Shader::loadShaderSourceFromPath(fragmentShaderSourcePath);
+    }
+    if (!computeShaderSourcePath.empty()) {
+        computeShaderSource = Shader::loadShaderSourceFromPath(computeShaderSourcePath);
+    }
 }
 
 Shader::~Shader() {
@@ -40,6 +61,7 @@ Shader& Shader::operator=(const Shader& other) {
 
     this->vertexShaderSource = other.vertexShaderSource;
     this->fragmentShaderSource = other.fragmentShaderSource;
+    this->computeShaderSource = other.computeShaderSource;
     this->defines = other.defines;
     this->uniforms = other.uniforms;
     return *this;
@@ -51,14 +73,19 @@ Shader& Shader::operator=(Shader&& other) noexcept {
     this->vertexShader = other.vertexShader;
     this->fragmentShader = other.fragmentShader;
     this->shaderProgram = other.shaderProgram;
+    this->computeShader = other.computeShader;
+    this->computeProgram = other.computeProgram;
     this->vertexShaderSource = std::move(other.vertexShaderSource);
     this->fragmentShaderSource = std::move(other.fragmentShaderSource);
+    this->computeShaderSource = std::move(other.computeShaderSource);
     this->defines = std::move(other.defines);
     this->uniforms = std::move(other.uniforms);
 
     other.vertexShader = 0;
     other.fragmentShader = 0;
     other.shaderProgram = 0;
+    other.computeShader = 0;
+    other.computeProgram = 0;
 
     return *this;
 }
@@ -90,6 +117,7 @@ void Shader::deleteFragmentShader() {
 }
 
 void Shader::deleteProgram() {
+    deleteCompute(); // compiled again on next use, e.g. with new defines
     if (shaderProgram == 0) { // check needed, since the function might be called before an OpenGL context is created. In that case glDeleteProgram may not be called, not even on 0
         return;
     }
@@ -97,6 +125,17 @@ void Shader::deleteProgram() {
     shaderProgram = 0;
 }
 
+void Shader::deleteCompute() {
+    if (computeShader != 0) { // same checks as above
+        glDeleteShader(computeShader);
+        computeShader = 0;
+    }
+    if (computeProgram != 0) {
+        glDeleteProgram(computeProgram);
+        computeProgram = 0;
+    }
+}
+
 
 void Shader::compileVertexShader() {
     if (vertexShader != 0) {
@@ -120,12 +159,58 @@ void Shader::link() {
     }
 
     shaderProgram = linkShaderProgram(vertexShader, fragmentShader);
+    this->storeProgramBinary(shaderProgram);
+}
+
+void Shader::precompile() {
+    GLint numBinaryFormats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numBinaryFormats);
+    if (numBinaryFormats == 0 || programBinaryCache.contains(this->programCacheKey())) { // nothing to gain
+        return;
+    }
+
+    unsigned int vertex = vertexShader != 0 ? vertexShader : loadShaderFromSource(GL_VERTEX_SHADER, this->prependDefines(this->vertexShaderSource));
+    unsigned int fragment = loadShaderFromSource(GL_FRAGMENT_SHADER, this->prependDefines(this->fragmentShaderSource));
+    unsigned int program = linkShaderProgram(vertex, fragment);
+    this->storeProgramBinary(program);
+
+    glDeleteProgram(program);
+    glDeleteShader(fragment);
+    if (vertex != vertexShader) {
+        glDeleteShader(vertex);
+    }
+}
+
+void Shader::storeProgramBinary(unsigned int program) {
+    GLint linked = 0;
+    GLint binaryLength = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+    if (linked && binaryLength > 0) {
+        ProgramBinary binary;
+        binary.data.resize(static_cast<size_t>(binaryLength));
+        glGetProgramBinary(program, binaryLength, nullptr, &binary.format, binary.data.data());
+        programBinaryCache[this->programCacheKey()] = std::move(binary);
+    }
 }
 
 void Shader::use() const {
     glUseProgram(shaderProgram);
 }
 
+void Shader::useCompute() {
+    if (computeProgram == 0) {
+        if (computeShaderSource.empty()) {
+            std::cerr << "Shader has no compute shader" << std::endl;
+            return;
+        }
+        computeShader = loadShaderFromSource(GL_COMPUTE_SHADER, this->prependDefines(this->computeShaderSource));
+        computeProgram = linkComputeProgram(computeShader);
+    }
+    glUseProgram(computeProgram);
+    this->applyUniforms(computeProgram);
+}
+
 
 // * Uniform setter helpers
 inline void setIntHelper(unsigned int shaderProgram, const std::string& name, int val) { glUniform1i(glGetUniformLocation(shaderProgram, name.c_str()), val); }
@@ -209,6 +294,17 @@ inline void setVec4DoubleArrayHelper(unsigned int shaderProgram, const std::stri
     glUniform4dv(glGetUniformLocation(shaderProgram, name.c_str()), static_cast<GLsizei>(count), vals);
 }
 
+// Components of all tuples in one array, as the glUniform*v functions take them
+template <typename Scalar, typename Tuple>
+std::vector<Scalar> flattenTuples(const std::vector<Tuple>& tuples) {
+    std::vector<Scalar> flat;
+    flat.reserve(tuples.size() * std::tuple_size_v<Tuple>);
+    for (const auto& tuple : tuples) {
+        std::apply([&flat](auto... components) { (flat.push_back(components), ...); }, tuple);
+    }
+    return flat;
+}
+
 
 // * Uniform Setters
 
@@ -621,42 +717,80 @@ auto Shader::getVec4DoubleArray(const std::string& name) -> const std::vector<ve
 void Shader::recompile() {
     this->deleteFragmentShader();
     this->deleteProgram();
-    this->compileFragmentShader();
-    this->link();
+    if (!this->loadCachedProgram()) {
+        this->compileFragmentShader();
+        this->link();
+    }
     this->use();
+    this->applyUniforms(shaderProgram);
+}
+
+void Shader::applyUniforms(unsigned int program) {
     for (const auto& [name, val] : uniforms) {
         if (std::holds_alternative<int>(val))
-            setIntHelper(shaderProgram, name, std::get<int>(val));
+            setIntHelper(program, name, std::get<int>(val));
         else if (std::holds_alternative<vec2int>(val))
-            setVec2IntHelper(shaderProgram, name, std::get<vec2int>(val));
+            setVec2IntHelper(program, name, std::get<vec2int>(val));
         else if (std::holds_alternative<vec3int>(val))
-            setVec3IntHelper(shaderProgram, name, std::get<vec3int>(val));
+            setVec3IntHelper(program, name, std::get<vec3int>(val));
         else if (std::holds_alternative<vec4int>(val))
-            setVec4IntHelper(shaderProgram, name, std::get<vec4int>(val));
+            setVec4IntHelper(program, name, std::get<vec4int>(val));
         else if (std::holds_alternative<uint>(val))
-            setUIntHelper(shaderProgram, name, std::get<uint>(val));
+            setUIntHelper(program, name, std::get<uint>(val));
         else if (std::holds_alternative<vec2uint>(val))
-            setVec2UIntHelper(shaderProgram, name, std::get<vec2uint>(val));
+            setVec2UIntHelper(program, name, std::get<vec2uint>(val));
         else if (std::holds_alternative<vec3uint>(val))
-            setVec3UIntHelper(shaderProgram, name, std::get<vec3uint>(val));
+            setVec3UIntHelper(program, name, std::get<vec3uint>(val));
         else if (std::holds_alternative<vec4uint>(val))
-            setVec4UIntHelper(shaderProgram, name, std::get<vec4uint>(val));
+            setVec4UIntHelper(program, name, std::get<vec4uint>(val));
         else if (std::holds_alternative<float>(val))
-            setFloatHelper(shaderProgram, name, std::get<float>(val));
+            setFloatHelper(program, name, std::get<float>(val));
         else if (std::holds_alternative<vec2>(val))
-            setVec2Helper(shaderProgram, name, std::get<vec2>(val));
+            setVec2Helper(program, name, std::get<vec2>(val));
         else if (std::holds_alternative<vec3>(val))
-            setVec3Helper(shaderProgram, name, std::get<vec3>(val));
+            setVec3Helper(program, name, std::get<vec3>(val));
         else if (std::holds_alternative<vec4>(val))
-            setVec4Helper(shaderProgram, name, std::get<vec4>(val));
+            setVec4Helper(program, name, std::get<vec4>(val));
         else if (std::holds_alternative<double>(val))
-            setDoubleHelper(shaderProgram, name, std::get<double>(val));
+            setDoubleHelper(program, name, std::get<double>(val));
         else if (std::holds_alternative<vec2double>(val))
-            setVec2DoubleHelper(shaderProgram, name, std::get<vec2double>(val));
+            setVec2DoubleHelper(program, name, std::get<vec2double>(val));
         else if (std::holds_alternative<vec3double>(val))
-            setVec3DoubleHelper(shaderProgram, name, std::get<vec3double>(val));
+            setVec3DoubleHelper(program, name, std::get<vec3double>(val));
         else if (std::holds_alternative<vec4double>(val))
-            setVec4DoubleHelper(shaderProgram, name, std::get<vec4double>(val));
+            setVec4DoubleHelper(program, name, std::get<vec4double>(val));
+        else if (const auto* ints = std::get_if<std::vector<int>>(&val))
+            setIntArrayHelper(program, name, ints->data(), static_cast<uint>(ints->size()));
+        else if (const auto* vec2ints = std::get_if<std::vector<vec2int>>(&val))
+            setVec2IntArrayHelper(program, name, flattenTuples<int>(*vec2ints).data(), static_cast<uint>(vec2ints->size()));
+        else if (const auto* vec3ints = std::get_if<std::vector<vec3int>>(&val))
+            setVec3IntArrayHelper(program, name, flattenTuples<int>(*vec3ints).data(), static_cast<uint>(vec3ints->size()));
+        else if (const auto* vec4ints = std::get_if<std::vector<vec4int>>(&val))
+            setVec4IntArrayHelper(program, name, flattenTuples<int>(*vec4ints).data(), static_cast<uint>(vec4ints->size()));
+        else if (const auto* uints = std::get_if<std::vector<uint>>(&val))
+            setUIntArrayHelper(program, name, uints->data(), static_cast<uint>(uints->size()));
+        else if (const auto* vec2uints = std::get_if<std::vector<vec2uint>>(&val))
+            setVec2UIntArrayHelper(program, name, flattenTuples<uint>(*vec2uints).data(), static_cast<uint>(vec2uints->size()));
+        else if (const auto* vec3uints = std::get_if<std::vector<vec3uint>>(&val))
+            setVec3UIntArrayHelper(program, name, flattenTuples<uint>(*vec3uints).data(), static_cast<uint>(vec3uints->size()));
+        else if (const auto* vec4uints = std::get_if<std::vector<vec4uint>>(&val))
+            setVec4UIntArrayHelper(program, name, flattenTuples<uint>(*vec4uints).data(), static_cast<uint>(vec4uints->size()));
+        else if (const auto* floats = std::get_if<std::vector<float>>(&val))
+            setFloatArrayHelper(program, name, floats->data(), static_cast<uint>(floats->size()));
+        else if (const auto* vec2s = std::get_if<std::vector<vec2>>(&val))
+            setVec2ArrayHelper(program, name, flattenTuples<float>(*vec2s).data(), static_cast<uint>(vec2s->size()));
+        else if (const auto* vec3s = std::get_if<std::vector<vec3>>(&val))
+            setVec3ArrayHelper(program, name, flattenTuples<float>(*vec3s).data(), static_cast<uint>(vec3s->size()));
+        else if (const auto* vec4s = std::get_if<std::vector<vec4>>(&val))
+            setVec4ArrayHelper(program, name, flattenTuples<float>(*vec4s).data(), static_cast<uint>(vec4s->size()));
+        else if (const auto* doubles = std::get_if<std::vector<double>>(&val))
+            setDoubleArrayHelper(program, name, doubles->data(), static_cast<uint>(doubles->size()));
+        else if (const auto* vec2doubles = std::get_if<std::vector<vec2double>>(&val))
+            setVec2DoubleArrayHelper(program, name, flattenTuples<double>(*vec2doubles).data(), static_cast<uint>(vec2doubles->size()));
+        else if (const auto* vec3doubles = std::get_if<std::vector<vec3double>>(&val))
+            setVec3DoubleArrayHelper(program, name, flattenTuples<double>(*vec3doubles).data(), static_cast<uint>(vec3doubles->size()));
+        else if (const auto* vec4doubles = std::get_if<std::vector<vec4double>>(&val))
+            setVec4DoubleArrayHelper(program, name, flattenTuples<double>(*vec4doubles).data(), static_cast<uint>(vec4doubles->size()));
     }
 }
 
@@ -711,16 +845,32 @@ unsigned int Shader::loadShaderFromSource(GLenum type, const std::string& shader
     if (!success) {
         char infoLog[512];
         glGetShaderInfoLog(shader, 512, nullptr, infoLog);
-        std::cout << (type == GL_VERTEX_SHADER ? "Vertex" : "Fragment") << " shader failed to compile:\n" << infoLog << std::endl;
+        std::cout << (type == GL_VERTEX_SHADER ? "Vertex" : type == GL_COMPUTE_SHADER ? "Compute" : "Fragment") << " shader failed to compile:\n" << infoLog << std::endl;
     }
     return shader;
 }
 
+unsigned int Shader::linkComputeProgram(unsigned int computeShader) {
+    unsigned int program = glCreateProgram();
+    glAttachShader(program, computeShader);
+    glLinkProgram(program);
+
+    int success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        char infoLog[512];
+        glGetProgramInfoLog(program, 512, nullptr, infoLog);
+        std::cout << "Compute program failed to link: " << infoLog << std::endl;
+    }
+    return program;
+}
+
 unsigned int Shader::linkShaderProgram(unsigned int vertexShader, unsigned int fragmentShader) {
     unsigned int shaderProgram;
     shaderProgram = glCreateProgram();
     glAttachShader(shaderProgram, vertexShader);
     glAttachShader(shaderProgram, fragmentShader);
+    glProgramParameteri(shaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE); // for the program binary cache
     glLinkProgram(shaderProgram);
 
     int success;
@@ -750,6 +900,36 @@ std::pair<std::string_view, std::string_view> splitFirstLine(std::string_view te
     }
 }
 
+std::string Shader::programCacheKey() {
+    std::vector<std::pair<std::string, std::string>> sortedDefines(this->defines.begin(), this->defines.end()); // same key for any order
+    std::sort(sortedDefines.begin(), sortedDefines.end());
+
+    std::string key = this->vertexShaderSource + '\0' + this->fragmentShaderSource;
+    for (const auto& [name, value] : sortedDefines) {
+        key += '\0' + name + ' ' + value;
+    }
+    return key;
+}
+
+bool Shader::loadCachedProgram() {
+    auto it = programBinaryCache.find(this->programCacheKey());
+    if (it == programBinaryCache.end()) {
+        return false;
+    }
+
+    shaderProgram = glCreateProgram();
+    glProgramBinary(shaderProgram, it->second.format, it->second.data.data(), static_cast<GLsizei>(it->second.data.size()));
+    GLint success = 0;
+    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
+    if (!success) { // e.g. the driver was updated, compile as usual
+        glDeleteProgram(shaderProgram);
+        shaderProgram = 0;
+        programBinaryCache.erase(it);
+        return false;
+    }
+    return true;
+}
+
 std::string Shader::prependDefines(const std::string& shaderSource) {
     std::ostringstream oss;
 
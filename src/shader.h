@@ -86,10 +86,11 @@ public:
      * Creates a Shader
      * Note, that the constructor does not compile or link the shaders.
      * 
-     * @param vertexShaderSource Vertex shader source
-     * @param fragmentShaderSource Fragment shader source
+     * @param vertexShaderSource Vertex shader source (may be empty for a shader that is only used with `useCompute`)
+     * @param fragmentShaderSource Fragment shader source (same)
+     * @param computeShaderSourcePath Optional compute shader source, compiled with the same defines on first use (see `useCompute`)
      */
-    Shader(const std::string& vertexShaderSourcePath, const std::string& fragmentShaderSourcePath);
+    Shader(const std::string& vertexShaderSourcePath, const std::string& fragmentShaderSourcePath, const std::string& computeShaderSourcePath = "");
     ~Shader();
 
     Shader& operator=(const Shader& other);
@@ -100,8 +101,11 @@ public:
     void link();
     inline void compileAndLink() { compileVertexShader(); compileFragmentShader(); link(); }
     void use() const;
+    /** Uses the compute program (compiled and linked with the current defines if needed) and applies all uniforms to it, `use` switches back */
+    void useCompute();
     void deleteVertexShader();
     void deleteFragmentShader();
+    void deleteCompute();
     void destroy();
     void deleteShaders();
     void deleteProgram();
@@ -186,16 +190,28 @@ public:
         return defines.at(name);
     }
 
+    inline bool isDefined(const std::string& name) const { return defines.contains(name); }
+
+    /** Compiles and links the fragment shader again (e.g. after changing defines), a program linked before with the same sources and defines is loaded from a cache */
     void recompile();
 
+    /**
+     * Compiles and links the program with the current defines into the program binary cache, without changing the program in use
+     * A later `recompile` with these defines is then fast, e.g. for a precision switch while zooming. Does nothing if the program is cached already
+     */
+    void precompile();
+
 public: // but be careful
 
     unsigned int vertexShader = 0; // for OpenGL 0 is "no shader"
     unsigned int fragmentShader = 0; // for OpenGL 0 is "no shader"
     unsigned int shaderProgram = 0; // for OpenGL 0 is "no program"
+    unsigned int computeShader = 0;
+    unsigned int computeProgram = 0; // separate program, since compute shaders can't be linked with other stages
 
     std::string vertexShaderSource;
     std::string fragmentShaderSource;
+    std::string computeShaderSource; // empty if there is no compute shader
     std::unordered_map<std::string, std::string> defines;
     std::unordered_map<std::string, uniform_t> uniforms;
 
@@ -203,6 +219,15 @@ protected: // helpers
 
     std::string prependDefines(const std::string& shaderSource);
 
+    /** Key of the program in the program binary cache (sources of the vertex and fragment shader and the defines) */
+    std::string programCacheKey();
+
+    /** Loads the program from the program binary cache (without compiling), returns `false` if it is not in there */
+    bool loadCachedProgram();
+
+    /** Stores the binary of a linked program in the program binary cache (under the key of the current defines) */
+    void storeProgramBinary(unsigned int program);
+
     /**
      * Loads shader source code from a path and recursively loads #include dependencies which are literally copy pasted into the source code of the parent shader
      * #includes must be relative to the directory, where the shader file itself is located, i.e. in "res/parent.glsl" includes must be relative to "res/"
@@ -220,6 +245,14 @@ protected: // helpers
      */
     static unsigned int linkShaderProgram(unsigned int vertexShader, unsigned int fragmentShader);
 
+    /**
+     * @return Id of the program object
+     */
+    static unsigned int linkComputeProgram(unsigned int computeShader);
+
+    /** Sets all stored uniforms in `program`, which must be in use */
+    void applyUniforms(unsigned int program);
+
 };
 
 #endif
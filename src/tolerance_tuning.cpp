@@ -0,0 +1,179 @@
+#include "tolerance_tuning.h"
+
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <cmath>
+#include <algorithm>
+
+#include "screenshot.h"
+#include "model/model_rk45.h"
+
+namespace {
+
+enum class ProbeOutput {
+    COLORS,
+    END_STATE,  // state at t_end (see `RK45Model::makeEnergyFieldModel`)
+    START_STATE // state at t0
+};
+
+/** Copy of `model` with atol = rtol = 10^exponent, compiled and with all uniforms applied */
+std::unique_ptr<Model> makeProbeModel(const Model& model, float exponent, ProbeOutput output) {
+    std::unique_ptr<Model> probeModel = model.clone();
+    RK45Model& rk45Model = dynamic_cast<RK45Model&>(*probeModel);
+    rk45Model.setToleranceExponents(exponent, exponent);
+    if (output != ProbeOutput::COLORS) {
+        ScalarFieldHeader header;
+        rk45Model.makeEnergyFieldModel(header, output == ProbeOutput::START_STATE);
+    }
+    probeModel->shader.compileVertexShader();
+    probeModel->shader.recompile(); // variants that were compiled before come from the program binary cache
+    probeModel->applyUniformVariables();
+    return probeModel;
+}
+
+/** Renders the probe and returns its colors (RGBA8) */
+bool renderColors(const Model& model, float exponent, size_t width, size_t height, unsigned int vertexArray, std::vector<unsigned char>& colors) {
+    std::unique_ptr<Model> probeModel = makeProbeModel(model, exponent, ProbeOutput::COLORS);
+    return renderTiled(width, height, *probeModel, vertexArray, colors);
+}
+
+/** Renders the probe and returns the energy of every pixel (NaN where the integration failed) */
+bool renderEnergies(const Model& model, float exponent, ProbeOutput output, size_t width, size_t height, unsigned int vertexArray, std::vector<double>& energies) {
+    std::unique_ptr<Model> probeModel = makeProbeModel(model, exponent, output);
+    std::vector<float> states;
+    if (!renderTiled(width, height, *probeModel, vertexArray, states)) {
+        return false;
+    }
+
+    const RK45Model& rk45Model = dynamic_cast<const RK45Model&>(*probeModel);
+    energies.resize(width * height);
+    for (size_t i = 0; i < energies.size(); ++i) {
+        const float* state = &states[4 * i];
+        const bool failed = std::isnan(state[0]);
+        energies[i] = failed ? std::nan("") : rk45Model.getEnergy(state);
+    }
+    return true;
+}
+
+/** Mean absolute difference of the color channels (without alpha) in [0, 1] */
+float colorDifference(const std::vector<unsigned char>& a, const std::vector<unsigned char>& b) {
+    double sum = 0.0;
+    size_t count = 0;
+    for (size_t i = 0; i + 3 < a.size(); i += 4) {
+        for (size_t channel = 0; channel < 3; ++channel) {
+            sum += std::abs(static_cast<int>(a[i + channel]) - static_cast<int>(b[i + channel]));
+            ++count;
+        }
+    }
+    return count == 0 ? 0.0f : static_cast<float>(sum / (255.0 * static_cast<double>(count)));
+}
+
+/** Mean absolute difference of the energies at t_end to the ones at t0, relative to the largest energy at t0, failed pixels are skipped */
+float energyDrift(const std::vector<double>& startEnergies, const std::vector<double>& energies) {
+    double scale = 0.0;
+    for (double energy : startEnergies) {
+        if (!std::isnan(energy)) {
+            scale = std::max(scale, std::abs(energy));
+        }
+    }
+    if (scale == 0.0) {
+        scale = 1.0;
+    }
+
+    double sum = 0.0;
+    size_t count = 0;
+    for (size_t i = 0; i < startEnergies.size(); ++i) {
+        if (!std::isnan(energies[i])) {
+            sum += std::abs(energies[i] - startEnergies[i]);
+            ++count;
+        }
+    }
+    return count == 0 ? 0.0f : static_cast<float>(sum / (scale * static_cast<double>(count)));
+}
+
+} // namespace
+
+
+bool tuneTolerances(
+    Model& model,
+    size_t captureWidth,
+    size_t captureHeight,
+    unsigned int vertexArray,
+    const ToleranceTuningSettings& settings /* = ToleranceTuningSettings() */,
+    ToleranceTuningResult* result /* = nullptr */
+) {
+    RK45Model* rk45Model = dynamic_cast<RK45Model*>(&model);
+    if (rk45Model == nullptr) {
+        std::cout << "The model \"" << model.name << "\" has no RK45 tolerances" << std::endl;
+        return false;
+    }
+    if (rk45Model->isSymplectic()) {
+        std::cout << "The symplectic methods have a fixed step size instead of tolerances" << std::endl;
+        return false;
+    }
+    if (captureWidth == 0 || captureHeight == 0 || settings.probeSize == 0 || settings.exponentStep <= 0.0f) {
+        std::cerr << "Error: invalid tolerance tuning settings" << std::endl;
+        return false;
+    }
+
+    // Same aspect ratio as the capture, the shorter side is `probeSize` (at most the capture itself)
+    const size_t shorterSide = std::min(captureWidth, captureHeight);
+    const size_t probeSize = std::min(settings.probeSize, shorterSide);
+    const size_t probeWidth = std::max<size_t>(1, (captureWidth * probeSize + shorterSide / 2) / shorterSide);
+    const size_t probeHeight = std::max<size_t>(1, (captureHeight * probeSize + shorterSide / 2) / shorterSide);
+    std::cout << "Tuning RK45 tolerances (probe " << probeWidth << "x" << probeHeight << ")" << std::endl;
+
+    // Reference
+    std::unique_ptr<Model> energyModel = model.clone(); // only to find out whether the model has an energy
+    ScalarFieldHeader header;
+    const bool hasEnergy = dynamic_cast<RK45Model&>(*energyModel).makeEnergyFieldModel(header, true);
+    std::vector<unsigned char> referenceColors;
+    std::vector<double> startEnergies;
+    std::vector<double> referenceEnergies;
+    if (!renderColors(model, settings.referenceExponent, probeWidth, probeHeight, vertexArray, referenceColors)
+        || (hasEnergy && !renderEnergies(model, settings.referenceExponent, ProbeOutput::START_STATE, probeWidth, probeHeight, vertexArray, startEnergies))
+        || (hasEnergy && !renderEnergies(model, settings.referenceExponent, ProbeOutput::END_STATE, probeWidth, probeHeight, vertexArray, referenceEnergies))) {
+        return false;
+    }
+    const float referenceEnergyDrift = hasEnergy ? energyDrift(startEnergies, referenceEnergies) : 0.0f;
+    if (hasEnergy) {
+        std::cout << "    1e" << settings.referenceExponent << ": energy drift " << referenceEnergyDrift << " (reference)" << std::endl;
+    }
+    ToleranceTuningResult accepted;
+    accepted.exponent = settings.referenceExponent;
+    accepted.energyDrift = referenceEnergyDrift;
+
+    // Loosen the tolerances until the probe differs visibly or the energy drifts
+    // The reference drifts too (float precision), so the energy drift may only grow by `maxEnergyDrift` beyond it
+    for (float exponent = settings.referenceExponent + settings.exponentStep; exponent <= settings.loosestExponent + 1e-3f; exponent += settings.exponentStep) {
+        std::vector<unsigned char> colors;
+        std::vector<double> energies;
+        if (!renderColors(model, exponent, probeWidth, probeHeight, vertexArray, colors)
+            || (hasEnergy && !renderEnergies(model, exponent, ProbeOutput::END_STATE, probeWidth, probeHeight, vertexArray, energies))) {
+            return false;
+        }
+
+        ToleranceTuningResult candidate;
+        candidate.exponent = exponent;
+        candidate.colorDifference = colorDifference(referenceColors, colors);
+        candidate.energyDrift = hasEnergy ? energyDrift(startEnergies, energies) : 0.0f;
+        std::cout << "    1e" << exponent << ": color difference " << candidate.colorDifference * 255.0f << "/255";
+        if (hasEnergy) {
+            std::cout << ", energy drift " << candidate.energyDrift;
+        }
+        std::cout << std::endl;
+
+        if (candidate.colorDifference > settings.maxColorDifference || candidate.energyDrift > referenceEnergyDrift + settings.maxEnergyDrift) {
+            break;
+        }
+        accepted = candidate;
+    }
+
+    rk45Model->setToleranceExponents(accepted.exponent, accepted.exponent);
+    std::cout << "    Using atol = rtol = 1e" << accepted.exponent << std::endl;
+    if (result != nullptr) {
+        *result = accepted;
+    }
+    return true;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#ifndef MANDELBROT_TOLERANCETUNING_INCLUDED
+#define MANDELBROT_TOLERANCETUNING_INCLUDED
+
+#include <cstddef>
+
+#include "model/model.h"
+
+struct ToleranceTuningSettings {
+    size_t probeSize = 64; // shorter side of the probe in pixels, the probe is the whole view at a low resolution
+    float referenceExponent = -9.0f; // tolerance of the reference render (atol = rtol = 10^_), tighter ones drift more in single precision
+    float loosestExponent = -3.0f;
+    float exponentStep = 1.0f;
+    float maxColorDifference = 1.0f / 255.0f; // mean absolute difference of the color channels to the reference
+    float maxEnergyDrift = 1e-5f; // mean energy difference to the reference relative to the largest energy (only models with an energy)
+};
+
+struct ToleranceTuningResult {
+    float exponent = 0.0f; // loosest accepted tolerance exponent
+    float colorDifference = 0.0f;
+    float energyDrift = 0.0f;
+};
+
+/**
+ * Finds the loosest RK45 tolerances (atol = rtol) whose output can't be told apart from a render with very tight tolerances
+ *
+ * Renders a probe of the view with `settings.referenceExponent`, then loosens the tolerances step by step until the color difference
+ * to the reference or the energy drift (see `RK45Model::getEnergy`) goes over its threshold. The last accepted tolerances are set
+ * in `model` (e.g. the screenshot model), which needs to be recompiled and have its uniforms applied before rendering with it.
+ *
+ * The uniforms of the model (view and parameters) must be applied already
+ * @return Returns `false` if the model is no RK45Model or uses a fixed step size method (error is printed)
+ */
+bool tuneTolerances(
+    Model& model,
+    size_t captureWidth,
+    size_t captureHeight,
+    unsigned int vertexArray,
+    const ToleranceTuningSettings& settings = ToleranceTuningSettings(),
+    ToleranceTuningResult* result = nullptr
+);
+
+#endif
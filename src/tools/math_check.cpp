@@ -0,0 +1,182 @@
+// Command line tool: validates the double precision functions of res/double_math.glsl against libm and benchmarks them
+// against the float functions of GLSL (what USE_DOUBLE shaders used before)
+//
+// Usage: MandelbrotMathCheck [options]
+//     --values <n>    arguments per function and range (default 1048576)
+//     --repeats <n>   evaluations per argument in the benchmark (default 64)
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <numbers>
+#include <limits>
+#include <random>
+#include <functional>
+#include <stdexcept>
+
+#include <glad/glad.h>
+
+#include "../headless_context.h"
+#include "../shader.h"
+
+namespace {
+
+constexpr double MAX_ULP_ERROR = 4.0; // fdlibm has about 1 ulp, the exit code is 1 above this
+
+struct MathFunction {
+    const char* name;
+    int id; // MATH_FUNCTION in compute_shader_math_check.glsl
+    std::function<double(double, double)> reference;
+    std::function<std::pair<double, double>(std::mt19937_64&)> argument;
+};
+
+struct CheckResult {
+    double maxUlpError = 0.0;
+    double maxAbsoluteError = 0.0;
+    double nanosecondsPerEvaluation = 0.0;
+};
+
+double ulpError(double value, double reference) {
+    if (std::isnan(reference) || std::isinf(reference)) {
+        return value == reference || (std::isnan(value) && std::isnan(reference)) ? 0.0 : std::numeric_limits<double>::infinity();
+    }
+    const double ulp = std::nextafter(std::abs(reference), std::numeric_limits<double>::infinity()) - std::abs(reference);
+    return std::abs(value - reference) / ulp;
+}
+
+/** Evaluates the function in the compute shader (`repeats` times per argument) and returns the results */
+std::vector<double> evaluate(Shader& shader, const std::vector<std::pair<double, double>>& arguments, GLuint repeats, double stepSize, double* nanoseconds) {
+    constexpr GLuint LOCAL_SIZE = 64;
+    GLuint buffers[2];
+    glGenBuffers(2, buffers);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffers[0]);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(arguments.size() * 2 * sizeof(double)), arguments.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffers[1]);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(arguments.size() * sizeof(double)), nullptr, GL_DYNAMIC_READ);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, buffers[0]);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, buffers[1]);
+
+    shader.setUInt("num_values", static_cast<uint>(arguments.size()));
+    shader.setUInt("repeats", repeats);
+    shader.setDouble("step_size", stepSize);
+    shader.useCompute();
+    glFinish();
+    const auto start = std::chrono::steady_clock::now();
+    glDispatchCompute((static_cast<GLuint>(arguments.size()) + LOCAL_SIZE - 1) / LOCAL_SIZE, 1, 1);
+    glFinish();
+    const auto end = std::chrono::steady_clock::now();
+    if (nanoseconds != nullptr) {
+        *nanoseconds = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+
+    std::vector<double> results(arguments.size());
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, static_cast<GLsizeiptr>(results.size() * sizeof(double)), results.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    glDeleteBuffers(2, buffers);
+    return results;
+}
+
+CheckResult check(const MathFunction& function, bool floatFallback, size_t numValues, GLuint repeats) {
+    Shader shader("", "", "../res/compute_shader_math_check.glsl");
+    shader.define("MATH_FUNCTION", std::to_string(function.id));
+    if (floatFallback) {
+        shader.define("FLOAT_FALLBACK", "");
+    }
+
+    std::mt19937_64 random(1234);
+    std::vector<std::pair<double, double>> arguments(numValues);
+    for (auto& argument : arguments) {
+        argument = function.argument(random);
+    }
+
+    CheckResult result;
+    const std::vector<double> values = evaluate(shader, arguments, 1, 0.0, nullptr);
+    for (size_t i = 0; i < numValues; ++i) {
+        const double reference = function.reference(arguments[i].first, arguments[i].second);
+        result.maxUlpError = std::max(result.maxUlpError, ulpError(values[i], reference));
+        if (std::isfinite(reference)) {
+            result.maxAbsoluteError = std::max(result.maxAbsoluteError, std::abs(values[i] - reference));
+        }
+    }
+
+    double nanoseconds = 0.0;
+    evaluate(shader, arguments, repeats, 1e-3, &nanoseconds);
+    result.nanosecondsPerEvaluation = nanoseconds / static_cast<double>(numValues * repeats);
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t numValues = 1u << 20;
+    GLuint repeats = 64;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            auto nextValue = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument("missing value for " + arg);
+                }
+                return argv[++i];
+            };
+            if (arg == "--values") {
+                numValues = std::stoul(nextValue());
+            } else if (arg == "--repeats") {
+                repeats = static_cast<GLuint>(std::stoul(nextValue()));
+            } else {
+                std::cout << "Usage: MandelbrotMathCheck [--values <n>] [--repeats <n>]" << std::endl;
+                return arg == "--help" || arg == "-h" ? 0 : 2;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: invalid arguments (" << e.what() << ")" << std::endl;
+        return 2;
+    }
+
+    HeadlessContext context;
+    if (!context.create()) {
+        return 1;
+    }
+
+    auto uniform = [](double min, double max) {
+        return [min, max](std::mt19937_64& random) { return std::make_pair(std::uniform_real_distribution<double>(min, max)(random), 0.0); };
+    };
+    const std::vector<MathFunction> functions = {
+        { "sin [-pi, pi]", 0, [](double x, double) { return std::sin(x); }, uniform(-std::numbers::pi, std::numbers::pi) },
+        { "sin [-1e5, 1e5]", 0, [](double x, double) { return std::sin(x); }, uniform(-1e5, 1e5) },
+        { "cos [-pi, pi]", 1, [](double x, double) { return std::cos(x); }, uniform(-std::numbers::pi, std::numbers::pi) },
+        { "cos [-1e5, 1e5]", 1, [](double x, double) { return std::cos(x); }, uniform(-1e5, 1e5) },
+        { "exp [-80, 80]", 2, [](double x, double) { return std::exp(x); }, uniform(-80.0, 80.0) },
+        { "exp [-700, 700]", 2, [](double x, double) { return std::exp(x); }, uniform(-700.0, 700.0) },
+        { "log [1e-30, 1e30]", 3, [](double x, double) { return std::log(x); }, [](std::mt19937_64& random) {
+            return std::make_pair(std::pow(10.0, std::uniform_real_distribution<double>(-30.0, 30.0)(random)), 0.0);
+        } },
+        { "log [0.5, 2]", 3, [](double x, double) { return std::log(x); }, uniform(0.5, 2.0) },
+        { "atan(y, x) [-10, 10]^2", 4, [](double x, double y) { return std::atan2(y, x); }, [](std::mt19937_64& random) {
+            std::uniform_real_distribution<double> distribution(-10.0, 10.0);
+            const double x = distribution(random);
+            return std::make_pair(x, distribution(random));
+        } },
+    };
+
+    // The ulp error is relative to the result of libm, the float columns are the functions of GLSL on float(x)
+    std::cout << std::left << std::setw(26) << "function" << std::setw(14) << "max ulp" << std::setw(14) << "max abs"
+              << std::setw(14) << "ns/eval" << std::setw(14) << "float abs" << "float ns/eval" << std::endl;
+    bool success = true;
+    for (const MathFunction& function : functions) {
+        const CheckResult doubleResult = check(function, false, numValues, repeats);
+        const CheckResult floatResult = check(function, true, numValues, repeats);
+        std::cout << std::left << std::setw(26) << function.name << std::setprecision(3)
+                  << std::setw(14) << doubleResult.maxUlpError << std::setw(14) << doubleResult.maxAbsoluteError
+                  << std::setw(14) << doubleResult.nanosecondsPerEvaluation << std::setw(14) << floatResult.maxAbsoluteError
+                  << floatResult.nanosecondsPerEvaluation << std::endl;
+        if (!(doubleResult.maxUlpError <= MAX_ULP_ERROR)) {
+            success = false;
+        }
+    }
+    return success ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+// Command line tool: maps a scalar field file (exported from the app) through a colormap and saves it as PNG
+//
+// Usage: MandelbrotRecolor <input.msf> <output.png> [options]
+//     --colormap <group>/<name>   e.g. "Cyclic/cet_colorwheel" (default depends on the kind of the scalar field)
+//     --color-scale <value>       Mandelbrot: iteration count range covered by the colormap (default 50)
+//                                 double pendulum state: velocity range [-value, value]
+//     --channel <y2|q1|q2|v1|v2>  only for full double pendulum states (default y2)
+//     --threads <n>               default: one thread per hardware thread
+//     --colormaps <path>          default: ../res/colormaps.bin
+//     --list                      list all colormaps and exit
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+
+#include "stb_image_write.h"
+
+#include "../colormaps.h"
+#include "../scalar_field.h"
+
+static void printUsage() {
+    std::cout << "Usage: MandelbrotRecolor <input.msf> <output.png> [--colormap <group>/<name>] [--color-scale <value>]\n"
+              << "                         [--channel <y2|q1|q2|v1|v2>] [--threads <n>] [--colormaps <path>] [--list]" << std::endl;
+}
+
+static void listColormaps() {
+    for (const auto& group : colormaps) {
+        std::cout << group.first << "\n";
+        for (const auto& map : group.second) {
+            std::cout << "    " << group.first << "/" << map.first << "\n";
+        }
+    }
+    std::cout << std::flush;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> positional;
+    std::string colormapArg;
+    std::string colormapsPath = "../res/colormaps.bin";
+    RecolorOptions options;
+    bool list = false;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            auto nextValue = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument("missing value for " + arg);
+                }
+                return argv[++i];
+            };
+
+            if (arg == "--colormap") {
+                colormapArg = nextValue();
+            } else if (arg == "--color-scale") {
+                options.colorScale = std::stof(nextValue());
+            } else if (arg == "--channel") {
+                const std::string channel = nextValue();
+                const char* channels[] = { "q1", "q2", "v1", "v2" };
+                options.channel = -1;
+                for (int c = 0; c < 4; ++c) {
+                    if (channel == channels[c]) options.channel = c;
+                }
+                if (options.channel < 0 && channel != "y2") {
+                    throw std::invalid_argument("unknown channel " + channel);
+                }
+            } else if (arg == "--threads") {
+                options.numThreads = static_cast<unsigned int>(std::stoul(nextValue()));
+            } else if (arg == "--colormaps") {
+                colormapsPath = nextValue();
+            } else if (arg == "--list") {
+                list = true;
+            } else if (arg == "--help" || arg == "-h") {
+                printUsage();
+                return 0;
+            } else {
+                positional.push_back(arg);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: invalid arguments (" << e.what() << ")" << std::endl;
+        printUsage();
+        return 1;
+    }
+
+    loadColormaps(colormapsPath);
+    if (colormaps.empty()) {
+        std::cerr << "Error: failed to load colormaps from '" << colormapsPath << "'" << std::endl;
+        return 1;
+    }
+    if (list) {
+        listColormaps();
+        return 0;
+    }
+    if (positional.size() != 2) {
+        printUsage();
+        return 1;
+    }
+
+    ScalarFieldFile field;
+    if (!field.open(positional[0])) {
+        return 1;
+    }
+    const ScalarFieldHeader& header = field.getHeader();
+    if (header.width > static_cast<uint32_t>(std::numeric_limits<int>::max() / 4) || header.height > static_cast<uint32_t>(std::numeric_limits<int>::max())) {
+        std::cerr << "Error: scalar field is too large for the PNG writer" << std::endl;
+        return 1;
+    }
+
+    // Same defaults as the models in the app
+    if (colormapArg.empty()) {
+        colormapArg = header.kind == ScalarFieldKind::MANDELBROT ? "Cyclic/cet_colorwheel" : "Perceptually Uniform/cet_kbc";
+    }
+    const size_t slash = colormapArg.find('/');
+    const std::string group = slash == std::string::npos ? std::string() : colormapArg.substr(0, slash);
+    const std::string name = slash == std::string::npos ? colormapArg : colormapArg.substr(slash + 1);
+    const std::vector<float>* colormap = findColormap(group, name);
+    if (colormap == nullptr) {
+        std::cerr << "Error: unknown colormap '" << colormapArg << "' (use --list)" << std::endl;
+        return 1;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    std::vector<unsigned char> rgba;
+    recolorScalarField(field, *colormap, isCyclicColormapGroup(group), options, rgba);
+    auto endTime = std::chrono::steady_clock::now();
+    std::cout << "Recolored " << header.width << "x" << header.height << " in "
+              << std::chrono::duration<double, std::milli>(endTime - startTime).count() << " ms" << std::endl;
+
+    if (stbi_write_png(positional[1].c_str(), static_cast<int>(header.width), static_cast<int>(header.height), 4, rgba.data(), static_cast<int>(header.width * 4u)) == 0) {
+        std::cerr << "Error: failed to write PNG '" << positional[1] << "'" << std::endl;
+        return 1;
+    }
+    std::cout << "Saved \"" << positional[1] << "\"" << std::endl;
+    return 0;
+}
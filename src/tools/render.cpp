@@ -0,0 +1,326 @@
+// Command line renderer: renders a model into a PNG (or scalar field) file without a window, e.g. on headless servers or in CI
+//
+// Usage: MandelbrotRender <output.png> [options]
+//     --model <MandelbrotModel|DoublePendulumModel|NBodyModel>   default: MandelbrotModel
+//     --size <width>x<height>                         default: 1920x1080
+//     --zoom <zoomScale>                              size of the shorter side of the image in plane units
+//     --center <x>,<y>
+//     --view <name>                                   use a saved view (saved_views.ini) instead of --zoom and --center
+//     --set <parameter>=<value>                       model parameter, e.g. maxIterations=2000, colormap=Cyclic/cet_colorwheel (repeatable)
+//     --live-quality                                  use the parameters of the live view instead of the screenshot defaults
+//     --scalar-field                                  export the raw scalar field (see MandelbrotRecolor) instead of a PNG
+//     --tune-tolerances                               loosest RK45 tolerances that look the same as very tight ones (see tolerance_tuning.h)
+//     --cost-csv <file>                               render the work heatmap instead (see cost_instrumentation.glsl) and append the totals to a CSV file
+//     --max-tile-size <n>                             default: 2048
+//     --cpu-threads <n>                               render part of the image on n CPU threads while the GPU renders the rest
+//     --workers <n>                                   render the tiles in n worker processes (this binary with --worker)
+//     --remote-worker <command>                       additional worker started with a shell command (repeatable), e.g. "ssh gpu1 'cd MandelbrotApp/bin-Release && ./MandelbrotRender'"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <filesystem>
+
+#include <unistd.h>
+
+#include "../headless_context.h"
+#include "../gl_utility.h"
+#include "../screenshot.h"
+#include "../distributed_render.h"
+#include "../tolerance_tuning.h"
+#include "../cost_counters.h"
+#include "../saved_view.h"
+#include "../model/model_mandelbrot.h"
+#include "../model/model_double_pendulum.h"
+#include "../model/model_n_body.h"
+
+static void printUsage() {
+    std::cout << "Usage: MandelbrotRender <output.png> [--model <MandelbrotModel|DoublePendulumModel|NBodyModel>] [--size <width>x<height>]\n"
+              << "                        [--zoom <zoomScale>] [--center <x>,<y>] [--view <name>] [--set <parameter>=<value>]...\n"
+              << "                        [--live-quality] [--scalar-field] [--tune-tolerances] [--cost-csv <file>]\n"
+              << "                        [--max-tile-size <n>] [--cpu-threads <n>] [--workers <n>] [--remote-worker <command>]..." << std::endl;
+}
+
+/** Splits "a<separator>b" into ("a", "b"), throws if there is no separator */
+static std::pair<std::string, std::string> splitPair(const std::string& string, char separator) {
+    const size_t pos = string.find(separator);
+    if (pos == std::string::npos) {
+        throw std::invalid_argument("expected '" + std::string(1, separator) + "' in " + string);
+    }
+    return { string.substr(0, pos), string.substr(pos + 1) };
+}
+
+/** Quotes an argument for /bin/sh */
+static std::string shellQuote(const std::string& arg) {
+    std::string quoted = "'";
+    for (char c : arg) {
+        if (c == '\'') quoted += "'\\''";
+        else quoted += c;
+    }
+    return quoted + "'";
+}
+
+/** Renders the image with worker processes and saves it, the workers get `workerArgs` (the options of this call) */
+static bool renderWithWorkers(
+    const char* argv0,
+    const std::vector<std::string>& workerArgs,
+    size_t numLocalWorkers,
+    const std::vector<std::string>& remoteWorkers,
+    std::string outputPath,
+    size_t width,
+    size_t height,
+    size_t maxTileSize,
+    bool scalarField
+) {
+    std::error_code ec;
+    std::string executable = std::filesystem::read_symlink("/proc/self/exe", ec).string();
+    if (ec) executable = argv0;
+
+    std::vector<std::vector<std::string>> commands;
+    for (size_t i = 0; i < numLocalWorkers; ++i) {
+        commands.push_back({ executable, "--worker" });
+        commands.back().insert(commands.back().end(), workerArgs.begin(), workerArgs.end());
+    }
+    for (const std::string& remoteWorker : remoteWorkers) {
+        std::string command = remoteWorker + " --worker";
+        for (const std::string& arg : workerArgs) command += " " + shellQuote(arg);
+        commands.push_back({ "/bin/sh", "-c", command });
+    }
+
+    outputPath = makeUniqueFilename(outputPath);
+    std::cout << (scalarField ? "Exporting scalar field \"" : "Taking Screenshot \"") << outputPath << "\" (" << width << "x" << height
+              << ", " << commands.size() << " workers)" << std::endl;
+
+    ScalarFieldHeader header;
+    if (scalarField) {
+        std::vector<float> pixels(width * height * 4u);
+        return renderTilesDistributed(commands, width, height, maxTileSize, TileRenderer::RGBA32F, reinterpret_cast<unsigned char*>(pixels.data()), header)
+            && saveScalarField(outputPath, width, height, pixels, header);
+    }
+    std::vector<unsigned char> pixels(width * height * 4u);
+    return renderTilesDistributed(commands, width, height, maxTileSize, TileRenderer::RGBA8, pixels.data(), header)
+        && savePng(outputPath, width, height, pixels);
+}
+
+int main(int argc, char** argv) {
+    std::string outputPath;
+    std::string modelName = "MandelbrotModel";
+    size_t width = 1920;
+    size_t height = 1080;
+    FixedPoint zoomScale; // 0 means default view of the model
+    FixedPoint centerX;
+    FixedPoint centerY;
+    bool centerGiven = false;
+    std::string viewName;
+    std::vector<std::pair<std::string, std::string>> parameters;
+    bool liveQuality = false;
+    bool scalarField = false;
+    bool tolerancesTuning = false;
+    std::string costCsvPath;
+    size_t maxTileSize = 2048;
+    size_t numWorkers = 0;
+    HybridRenderSettings hybrid;
+    std::vector<std::string> remoteWorkers;
+    bool isWorker = false;
+    std::vector<std::string> workerArgs; // everything that describes the image, passed on to the workers
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            const int argBegin = i;
+            auto nextValue = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument("missing value for " + arg);
+                }
+                return argv[++i];
+            };
+
+            if (arg == "--model") {
+                modelName = nextValue();
+            } else if (arg == "--size") {
+                const auto [w, h] = splitPair(nextValue(), 'x');
+                width = std::stoul(w);
+                height = std::stoul(h);
+            } else if (arg == "--zoom") {
+                zoomScale = FixedPoint::fromString(nextValue());
+            } else if (arg == "--center") {
+                const auto [x, y] = splitPair(nextValue(), ',');
+                centerX = FixedPoint::fromString(x); // all digits, not only those of long double
+                centerY = FixedPoint::fromString(y);
+                centerGiven = true;
+            } else if (arg == "--view") {
+                viewName = nextValue();
+            } else if (arg == "--set") {
+                parameters.push_back(splitPair(nextValue(), '='));
+            } else if (arg == "--live-quality") {
+                liveQuality = true;
+            } else if (arg == "--scalar-field") {
+                scalarField = true;
+            } else if (arg == "--tune-tolerances") {
+                tolerancesTuning = true;
+                continue;
+            } else if (arg == "--cost-csv") {
+                costCsvPath = nextValue();
+                continue;
+            } else if (arg == "--max-tile-size") {
+                maxTileSize = std::stoul(nextValue());
+            } else if (arg == "--cpu-threads") {
+                hybrid.numCpuThreads = static_cast<unsigned int>(std::stoul(nextValue()));
+                continue;
+            } else if (arg == "--workers") {
+                numWorkers = std::stoul(nextValue());
+                continue;
+            } else if (arg == "--remote-worker") {
+                remoteWorkers.push_back(nextValue());
+                continue;
+            } else if (arg == "--worker") {
+                isWorker = true;
+                continue;
+            } else if (arg == "--help" || arg == "-h") {
+                printUsage();
+                return 0;
+            } else if (outputPath.empty() && !arg.starts_with("--")) {
+                outputPath = arg;
+                continue;
+            } else {
+                throw std::invalid_argument("unknown argument " + arg);
+            }
+            workerArgs.insert(workerArgs.end(), argv + argBegin, argv + i + 1);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: invalid arguments (" << e.what() << ")" << std::endl;
+        printUsage();
+        return 2;
+    }
+    if (outputPath.empty() && !isWorker) {
+        printUsage();
+        return 2;
+    }
+
+    if (numWorkers > 0 || !remoteWorkers.empty()) {
+        if (tolerancesTuning) { // every worker would tune on its own GPU, which may not agree
+            std::cerr << "Error: --tune-tolerances can't be used with workers, pass the tuned tolerances with --set atolExponent=... --set rtolExponent=..." << std::endl;
+            return 2;
+        }
+        if (!costCsvPath.empty()) { // the counters are on the GPUs of the workers
+            std::cerr << "Error: --cost-csv can't be used with workers" << std::endl;
+            return 2;
+        }
+        return renderWithWorkers(argv[0], workerArgs, numWorkers, remoteWorkers, outputPath, width, height, maxTileSize, scalarField) ? 0 : 1;
+    }
+
+    // A worker talks to the coordinator over stdin and stdout, so everything it prints goes to stderr
+    const int resultFd = isWorker ? dup(STDOUT_FILENO) : -1;
+    if (isWorker) {
+        std::cout.flush();
+        dup2(STDERR_FILENO, STDOUT_FILENO);
+    }
+
+    // View
+    if (!viewName.empty()) {
+        SavedView::initFromFile();
+        bool found = false;
+        for (const SavedView& savedView : SavedView::allViews) {
+            if (savedView.getName() == viewName) {
+                zoomScale = savedView.getZoomScale();
+                centerX = savedView.getCenter().first;
+                centerY = savedView.getCenter().second;
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            std::cerr << "Error: no saved view named \"" << viewName << "\"" << std::endl;
+            return 1;
+        }
+    }
+
+    HeadlessContext context;
+    if (!context.create()) {
+        return 1;
+    }
+
+    // Model (needs the context, e.g. for the colormap texture)
+    std::unique_ptr<Model> model;
+    if (modelName == "MandelbrotModel") {
+        model = std::make_unique<MandelbrotModel>();
+        if (zoomScale == 0.0L) zoomScale = 3.0L;
+        if (!centerGiven && viewName.empty()) centerX = -0.5L;
+    } else if (modelName == "DoublePendulumModel") {
+        model = std::make_unique<DoublePendulumModel>();
+        if (zoomScale == 0.0L) zoomScale = 6.5L; // all starting angles (q1, q2)
+    } else if (modelName == "NBodyModel") {
+        model = std::make_unique<NBodyModel>();
+        if (zoomScale == 0.0L) zoomScale = 6.0L; // start positions of the last body around the others
+    } else {
+        std::cerr << "Error: unknown model \"" << modelName << "\"" << std::endl;
+        return 2;
+    }
+
+    if (!liveQuality) {
+        model->makeScreenshotModel();
+    }
+    try {
+        for (const auto& [parameter, value] : parameters) {
+            if (!model->setParameter(parameter, value)) {
+                std::cerr << "Error: " << model->name << " has no parameter \"" << parameter << "\"" << std::endl;
+                return 2;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: invalid parameter value (" << e.what() << ")" << std::endl;
+        return 2;
+    }
+
+    const unsigned int vertexArray = createFullscreenQuad();
+    if (tolerancesTuning) { // on a copy that outputs colors (before the model may output the scalar field)
+        std::unique_ptr<Model> tuningModel = model->clone();
+        tuningModel->shader.compileAndLink();
+        tuningModel->shader.use();
+        applyViewUniforms(*tuningModel, static_cast<unsigned int>(width), static_cast<unsigned int>(height), zoomScale, centerX, centerY);
+        tuningModel->applyUniformVariables();
+        ToleranceTuningResult result;
+        if (!tuneTolerances(*tuningModel, width, height, vertexArray, ToleranceTuningSettings(), &result)) {
+            return 1;
+        }
+        model->setParameter("atolExponent", std::to_string(result.exponent));
+        model->setParameter("rtolExponent", std::to_string(result.exponent));
+    }
+
+    if (!costCsvPath.empty()) {
+        model->setCostInstrumentation(true);
+    }
+
+    ScalarFieldHeader header;
+    if (scalarField && !model->makeScalarFieldModel(header)) {
+        std::cerr << "Error: " << model->name << " has no scalar field output" << std::endl;
+        return 1;
+    }
+
+    model->shader.compileAndLink();
+    model->shader.use();
+    applyViewUniforms(*model, static_cast<unsigned int>(width), static_cast<unsigned int>(height), zoomScale, centerX, centerY);
+    model->applyUniformVariables();
+
+    if (isWorker) {
+        header.zoomScale = zoomScale.toDouble();
+        header.centerX = centerX.toDouble();
+        header.centerY = centerY.toDouble();
+        const TileRenderer::Format format = scalarField ? TileRenderer::RGBA32F : TileRenderer::RGBA8;
+        return runTileWorker(*model, vertexArray, width, height, maxTileSize, format, header, STDIN_FILENO, resultFd) ? 0 : 1;
+    }
+
+    const bool success = scalarField
+        ? takeScalarFieldScreenshot(outputPath, width, height, *model, header, vertexArray, maxTileSize, hybrid)
+        : takeScreenshot(outputPath, width, height, *model, vertexArray, maxTileSize, hybrid);
+    if (success && !costCsvPath.empty() && model->readCostCounters()) { // totals of all tiles (the CPU threads are not counted)
+        printCostCounters(std::cout, model->getCostCounters());
+        std::cout << "Heatmap scale: 100000 iterations unless set, e.g. --set costHeatmapMax=" << model->getCostCounters().maxPixelIterations
+                  << " for the maximum of this render" << std::endl;
+        return appendCostCountersCsv(costCsvPath, model->name, model->getCostCounters()) ? 0 : 1;
+    }
+    return success ? 0 : 1;
+}
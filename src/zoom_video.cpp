@@ -0,0 +1,297 @@
+#include "zoom_video.h"
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cmath>
+#include <cstdio> // for std::snprintf
+#include <algorithm>
+#include <chrono>
+
+#include "stb_image_write.h"
+
+#include "screenshot.h"
+#include "app_utility.h"
+#include "gl_utility.h"
+
+namespace {
+
+/** Writes frames either as numbered PNG files or as one Y4M stream */
+class FrameWriter {
+public:
+    FrameWriter(const std::string& _filename, const ZoomVideoSettings& _settings) : filename(_filename), settings(_settings) { }
+
+    bool open() {
+        if (!createParentDirectories(this->filename)) {
+            return false;
+        }
+        if (this->settings.format == ZoomVideoSettings::PNG_SEQUENCE) {
+            const size_t dot = this->filename.find_last_of('.');
+            this->base = dot == std::string::npos ? this->filename : this->filename.substr(0, dot);
+            this->extension = dot == std::string::npos ? ".png" : this->filename.substr(dot);
+            return true;
+        }
+
+        this->stream.open(this->filename, std::ios::binary);
+        if (!this->stream) {
+            std::cerr << "    Error: failed to open '" << this->filename << "' for writing\n";
+            return false;
+        }
+        // 4:4:4 chroma, progressive, square pixels
+        this->stream << "YUV4MPEG2 W" << this->settings.width << " H" << this->settings.height
+            << " F" << this->settings.fps << ":1 Ip A1:1 C444\n";
+        const size_t planeSize = this->settings.width * this->settings.height;
+        this->planes.resize(3u * planeSize);
+        return static_cast<bool>(this->stream);
+    }
+
+    /** @param rgba Frame with rows from top to bottom */
+    bool write(const std::vector<unsigned char>& rgba, size_t frameIndex) {
+        const size_t width = this->settings.width;
+        const size_t height = this->settings.height;
+
+        if (this->settings.format == ZoomVideoSettings::PNG_SEQUENCE) {
+            char number[32];
+            std::snprintf(number, sizeof(number), "_%05zu", frameIndex);
+            const std::string frameFilename = this->base + number + this->extension;
+            if (stbi_write_png(frameFilename.c_str(), static_cast<int>(width), static_cast<int>(height), 4, rgba.data(), static_cast<int>(width * 4u)) == 0) {
+                std::cerr << "    Error: failed to write PNG '" << frameFilename << "'\n";
+                return false;
+            }
+            return true;
+        }
+
+        // RGB to YCbCr (BT.601, limited range), which is what players assume for Y4M without further tags
+        const size_t planeSize = width * height;
+        unsigned char* planeY = this->planes.data();
+        unsigned char* planeCb = planeY + planeSize;
+        unsigned char* planeCr = planeCb + planeSize;
+        parallelFor(planeSize, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const float r = rgba[4u * i + 0u] / 255.0f;
+                const float g = rgba[4u * i + 1u] / 255.0f;
+                const float b = rgba[4u * i + 2u] / 255.0f;
+                planeY[i]  = static_cast<unsigned char>(16.0f  + 65.481f * r + 128.553f * g + 24.966f * b + 0.5f);
+                planeCb[i] = static_cast<unsigned char>(128.0f - 37.797f * r - 74.203f  * g + 112.0f  * b + 0.5f);
+                planeCr[i] = static_cast<unsigned char>(128.0f + 112.0f  * r - 93.786f  * g - 18.214f * b + 0.5f);
+            }
+        });
+
+        this->stream << "FRAME\n";
+        this->stream.write(reinterpret_cast<const char*>(this->planes.data()), static_cast<std::streamsize>(this->planes.size()));
+        if (!this->stream) {
+            std::cerr << "    Error: failed to write frame " << frameIndex << " to '" << this->filename << "'\n";
+            return false;
+        }
+        return true;
+    }
+
+private:
+    std::string filename;
+    const ZoomVideoSettings& settings;
+
+    std::string base; // PNG sequence
+    std::string extension;
+
+    std::ofstream stream; // Y4M
+    std::vector<unsigned char> planes;
+};
+
+/** Renders the model at the given view (rows from top to bottom) */
+bool renderView(Model& model, unsigned int vertexArray, size_t width, size_t height, long double zoomScale, const FixedPoint& centerX, const FixedPoint& centerY, size_t maxTileSize, std::vector<unsigned char>& pixels) {
+    model.shader.use();
+    setViewPositionUniforms(model.shader, zoomScale, centerX, centerY);
+    return renderTiled(width, height, model, vertexArray, pixels, maxTileSize);
+}
+
+/** Box filter weights of one output pixel: the keyframe pixels [first, first + count) with their overlap */
+struct FootprintWeights {
+    static constexpr size_t MAX_TAPS = 4; // footprints are at most 2 keyframe pixels wide
+    size_t first = 0;
+    size_t count = 0;
+    float weights[MAX_TAPS] = {};
+};
+
+/** Overlap of the interval [a, b) in keyframe pixels with the keyframe pixels (normalized to sum 1) */
+FootprintWeights footprintWeights(double a, double b, size_t keyframeSize) {
+    FootprintWeights result;
+    const double size = static_cast<double>(keyframeSize);
+    a = std::clamp(a, 0.0, size);
+    b = std::clamp(b, a, size);
+
+    const size_t first = std::min(static_cast<size_t>(a), keyframeSize - 1);
+    result.first = first;
+    double overlaps[FootprintWeights::MAX_TAPS];
+    double sum = 0.0;
+    for (size_t j = first; j < keyframeSize && result.count < FootprintWeights::MAX_TAPS && static_cast<double>(j) < b; ++j) {
+        const double overlap = std::min(b, static_cast<double>(j + 1)) - std::max(a, static_cast<double>(j));
+        overlaps[result.count++] = overlap;
+        sum += overlap;
+    }
+    if (result.count == 0 || sum <= 0.0) { // degenerate footprint, use the nearest pixel
+        result.count = 1;
+        result.weights[0] = 1.0f;
+        return result;
+    }
+    for (size_t t = 0; t < result.count; ++t) {
+        result.weights[t] = static_cast<float>(overlaps[t] / sum);
+    }
+    return result;
+}
+
+} // namespace
+
+
+bool renderZoomVideo(
+    const std::string& filename,
+    const SavedView& start,
+    const SavedView& end,
+    Model& model,
+    unsigned int vertexArray,
+    const ZoomVideoSettings& settings
+) {
+    const size_t width = settings.width;
+    const size_t height = settings.height;
+    const size_t numFrames = settings.numFrames;
+
+    std::cout << "Rendering zoom video \"" << filename << "\" (" << numFrames << " frames, " << width << "x" << height << ")" << std::endl;
+    if (width == 0 || height == 0 || numFrames == 0 || settings.fps == 0) {
+        std::cerr << "    Error: invalid video settings\n";
+        return false;
+    }
+    if (start.getZoomScale() <= 0.0L || end.getZoomScale() <= 0.0L) {
+        std::cerr << "    Error: invalid zoom scale of a saved view\n";
+        return false;
+    }
+
+    FrameWriter writer(filename, settings);
+    if (!writer.open()) {
+        return false;
+    }
+
+    // Exponential zoom, the center moves linearly with the zoom scale: c(z) = c0 + (c1 - c0) * (z - z0) / (z1 - z0)
+    // Hence every view is the start view scaled about the fixed point f = (c1 - r * c0) / (1 - r) with r = z1 / z0
+    // Zoom scales only need relative precision (long double), the centers keep all digits (FixedPoint)
+    const long double z0 = start.getZoomScale().toLongDouble();
+    const long double z1 = end.getZoomScale().toLongDouble();
+    const auto [c0x, c0y] = start.getCenter();
+    const auto [c1x, c1y] = end.getCenter();
+    const long double ratio = z1 / z0;
+
+    auto frameZoom = [&](size_t frame) -> long double {
+        if (numFrames == 1) return z0;
+        return z0 * std::pow(ratio, static_cast<long double>(frame) / static_cast<long double>(numFrames - 1));
+    };
+    auto frameCenter = [&](size_t frame, long double zoom) -> ComplexNum {
+        if (std::fabs(1.0L - ratio) < 1e-9L) { // pure panning
+            const long double t = numFrames == 1 ? 0.0L : static_cast<long double>(frame) / static_cast<long double>(numFrames - 1);
+            return { c0x + (c1x - c0x) * t, c0y + (c1y - c0y) * t };
+        }
+        const long double s = (zoom - z0) / (z1 - z0);
+        return { c0x + (c1x - c0x) * s, c0y + (c1y - c0y) * s };
+    };
+
+    const long double measure = static_cast<long double>(std::min(width, height)); // same as windowSizeMeasure in the shader
+    const long double zoomMax = std::max(z0, z1);
+    const FixedPoint cMaxX = z0 >= z1 ? c0x : c1x;
+    const FixedPoint cMaxY = z0 >= z1 ? c0y : c1y;
+
+    bool useKeyframes = std::fabs(1.0L - ratio) >= 1e-9L;
+    FixedPoint fx, fy; // fixed point (plane coordinates)
+    double fixedPixelX = 0.0, fixedPixelY = 0.0; // fixed point in frame pixel coordinates (same for every frame, y from the top)
+    if (useKeyframes) {
+        fx = c1x + (c1x - c0x) * (ratio / (1.0L - ratio)); // = (c1 - r * c0) / (1 - r), without dividing a FixedPoint
+        fy = c1y + (c1y - c0y) * (ratio / (1.0L - ratio));
+        fixedPixelX = static_cast<double>(static_cast<long double>(width) / 2.0L + (fx - cMaxX).toLongDouble() * measure / zoomMax);
+        fixedPixelY = static_cast<double>(static_cast<long double>(height) / 2.0L - (fy - cMaxY).toLongDouble() * measure / zoomMax);
+        // Frames are only parts of keyframes, if the fixed point is inside the widest view
+        useKeyframes = fixedPixelX >= 0.0 && fixedPixelX <= static_cast<double>(width)
+            && fixedPixelY >= 0.0 && fixedPixelY <= static_cast<double>(height);
+    }
+    if (!useKeyframes) {
+        std::cout << "    The end view is not inside the start view, rendering every frame directly" << std::endl;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    size_t keyframesRendered = 0;
+
+    std::vector<unsigned char> frame(width * height * 4u);
+    std::vector<unsigned char> keyframe;
+    const size_t keyWidth = 2u * width; // keyframes have twice the output resolution
+    const size_t keyHeight = 2u * height;
+    long keyframeIndex = -1; // index k of the keyframe in `keyframe`, its zoom scale is zoomMax * 2^-k
+
+    for (size_t i = 0; i < numFrames; ++i) {
+        const long double zoom = frameZoom(i);
+
+        if (!useKeyframes) {
+            const ComplexNum center = frameCenter(i, zoom);
+            if (!renderView(model, vertexArray, width, height, zoom, center.first, center.second, settings.maxTileSize, frame)) {
+                return false;
+            }
+        } else {
+            // Keyframe with the smallest zoom scale that still contains the frame
+            long k = static_cast<long>(std::floor(std::log2(zoomMax / zoom) + 1e-9L));
+            k = std::max(k, 0L);
+            while (k > 0 && zoomMax * std::exp2(-static_cast<long double>(k)) < zoom) {
+                --k;
+            }
+            const long double keyZoom = zoomMax * std::exp2(-static_cast<long double>(k));
+
+            if (k != keyframeIndex) {
+                const long double scale = keyZoom / zoomMax;
+                // Keyframes are also views scaled about f, so f has the same (doubled) pixel coordinates in every keyframe
+                if (!renderView(model, vertexArray, keyWidth, keyHeight, keyZoom, fx + (cMaxX - fx) * scale, fy + (cMaxY - fy) * scale, settings.maxTileSize, keyframe)) {
+                    return false;
+                }
+                keyframeIndex = k;
+                ++keyframesRendered;
+            }
+
+            // Frame pixel coordinate X maps to keyframe pixel coordinate 2 * fixedPixel + (X - fixedPixel) * (2 * zoom / keyZoom)
+            const double factor = static_cast<double>(2.0L * zoom / keyZoom); // in (1, 2]
+            std::vector<FootprintWeights> weightsX(width);
+            for (size_t x = 0; x < width; ++x) {
+                const double a = 2.0 * fixedPixelX + (static_cast<double>(x) - fixedPixelX) * factor;
+                weightsX[x] = footprintWeights(a, a + factor, keyWidth);
+            }
+
+            // Area (box filter) downsampling
+            parallelFor(height, [&](size_t rowBegin, size_t rowEnd) {
+                for (size_t y = rowBegin; y < rowEnd; ++y) {
+                    const double a = 2.0 * fixedPixelY + (static_cast<double>(y) - fixedPixelY) * factor;
+                    const FootprintWeights weightsY = footprintWeights(a, a + factor, keyHeight);
+
+                    for (size_t x = 0; x < width; ++x) {
+                        const FootprintWeights& wx = weightsX[x];
+                        float sum[3] = { 0.0f, 0.0f, 0.0f };
+                        for (size_t ty = 0; ty < weightsY.count; ++ty) {
+                            const unsigned char* row = keyframe.data() + ((weightsY.first + ty) * keyWidth + wx.first) * 4u;
+                            for (size_t tx = 0; tx < wx.count; ++tx) {
+                                const float weight = weightsY.weights[ty] * wx.weights[tx];
+                                sum[0] += weight * row[4u * tx + 0u];
+                                sum[1] += weight * row[4u * tx + 1u];
+                                sum[2] += weight * row[4u * tx + 2u];
+                            }
+                        }
+                        unsigned char* out = frame.data() + (y * width + x) * 4u;
+                        out[0] = static_cast<unsigned char>(std::min(sum[0] + 0.5f, 255.0f));
+                        out[1] = static_cast<unsigned char>(std::min(sum[1] + 0.5f, 255.0f));
+                        out[2] = static_cast<unsigned char>(std::min(sum[2] + 0.5f, 255.0f));
+                        out[3] = 255u;
+                    }
+                }
+            });
+        }
+
+        if (!writer.write(frame, i)) {
+            return false;
+        }
+        std::cout << "    Frame " << (i + 1) << "/" << numFrames << std::endl;
+    }
+
+    auto endTime = std::chrono::steady_clock::now();
+    std::cout << "    Zoom video was saved successfully (" << (useKeyframes ? keyframesRendered : numFrames) << " renders, "
+        << std::chrono::duration<double>(endTime - startTime).count() << " s)" << std::endl;
+    return true;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#ifndef MANDELBROT_ZOOMVIDEO_INCLUDED
+#define MANDELBROT_ZOOMVIDEO_INCLUDED
+
+#include <string>
+
+#include "model/model.h"
+#include "saved_view.h"
+
+struct ZoomVideoSettings {
+    enum Format {
+        PNG_SEQUENCE = 0, // "frame.png" becomes "frame_00000.png", "frame_00001.png", ...
+        Y4M = 1           // single YUV4MPEG2 stream (4:4:4), e.g. for ffmpeg
+    };
+
+    size_t width = 1920;
+    size_t height = 1080;
+    size_t numFrames = 300;
+    unsigned int fps = 30;
+    Format format = PNG_SEQUENCE;
+    size_t maxTileSize = 2048;
+};
+
+/**
+ * Renders an exponential zoom from `start` to `end` as video frames
+ *
+ * The zoom path scales the start view about a fixed point, so every frame is a part of the frame before (when zooming in).
+ * This allows rendering only keyframes (zoom factor 2 apart, at twice the output size) and deriving all frames by downsampling them.
+ * If the path has no such fixed point inside the start view (e.g. the end view is not inside the start view), every frame is rendered directly.
+ *
+ * The uniforms of the model (except the view) must be applied already
+ */
+bool renderZoomVideo(
+    const std::string& filename,
+    const SavedView& start,
+    const SavedView& end,
+    Model& model,
+    unsigned int vertexArray,
+    const ZoomVideoSettings& settings
+);
+
+#endif